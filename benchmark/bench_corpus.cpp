@@ -0,0 +1,182 @@
+/*
+ *  bench_corpus.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements a benchmark that measures encoding and decoding
+ *      throughput over the generated corpus, whose whitespace, separators,
+ *      padding, and leading zeros resemble real traffic far more closely
+ *      than random octets do.
+ *
+ *      Usage: bench_corpus [-dataset=NAME] [-records=N] [-iterations=N]
+ *                          [-seed=N]
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "corpus.h"
+#include "timer.h"
+
+using namespace Terra::Bench;
+
+// Results are stored here so that the calls are not optimized away
+volatile std::size_t Sink;
+
+int main(int argc, char *argv[])
+{
+    std::string dataset_name;
+    std::size_t records = 256;
+    std::size_t iterations = 20;
+    std::uint64_t seed = 1;
+
+    // Parse the command-line arguments
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view argument = argv[i];
+        auto value = argument.substr(argument.find('=') + 1);
+
+        if (argument.starts_with("-dataset="))
+        {
+            dataset_name = value;
+        }
+        else if (argument.starts_with("-records="))
+        {
+            records = std::strtoull(value.data(), nullptr, 10);
+        }
+        else if (argument.starts_with("-iterations="))
+        {
+            iterations = std::strtoull(value.data(), nullptr, 10);
+        }
+        else if (argument.starts_with("-seed="))
+        {
+            seed = std::strtoull(value.data(), nullptr, 10);
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (iterations == 0) iterations = 1;
+
+    std::printf("Throughput in %s per octet (text octets for decode, "
+                "payload octets for encode)\n\n",
+                Timer_Units);
+    std::printf("%-16s %7s %9s %9s %9s %9s\n",
+                "dataset", "records", "dec-span", "dec-alloc",
+                "enc-span", "enc-alloc");
+
+    for (const auto &dataset : GenerateCorpus(records, seed))
+    {
+        if (!dataset_name.empty() && (dataset_name != dataset.name)) continue;
+
+        if (!VerifyDataset(dataset))
+        {
+            std::fprintf(stderr,
+                         "Dataset %s failed verification\n",
+                         dataset.name.c_str());
+            return EXIT_FAILURE;
+        }
+
+        // Determine the total sizes and allocate buffers large enough for
+        // any record
+        std::size_t text_octets = 0;
+        std::size_t payload_octets = 0;
+        std::size_t max_text = 0;
+        std::size_t max_payload = 0;
+        for (const auto &record : dataset.records)
+        {
+            text_octets += record.text.size();
+            payload_octets += record.payload.size();
+            max_text = std::max(max_text, record.text.size());
+            max_payload = std::max(max_payload, record.payload.size());
+        }
+        std::vector<std::uint8_t> decoded(
+            dataset.codec->max_decoded_length(max_text));
+        std::vector<char> encoded(
+            dataset.codec->max_encoded_length(max_payload));
+
+        // Convert total elapsed time into time per octet
+        auto per_octet = [&](std::uint64_t elapsed, std::size_t octets)
+        {
+            return static_cast<double>(elapsed) /
+                   static_cast<double>(octets * iterations);
+        };
+
+        // Decode using the span-output interface
+        std::uint64_t start = StartTimer();
+        for (std::size_t i = 0; i < iterations; i++)
+        {
+            for (const auto &record : dataset.records)
+            {
+                Sink = dataset.decode(record.text, decoded).value_or(0);
+            }
+        }
+        double decode_span = per_octet(StopTimer() - start, text_octets);
+
+        // Decode using the allocating interface
+        start = StartTimer();
+        for (std::size_t i = 0; i < iterations; i++)
+        {
+            for (const auto &record : dataset.records)
+            {
+                std::vector<std::uint8_t> output(
+                    dataset.codec->max_decoded_length(record.text.size()));
+                auto length = dataset.decode(record.text, output);
+                if (length) output.resize(*length);
+                Sink = output.size();
+            }
+        }
+        double decode_alloc = per_octet(StopTimer() - start, text_octets);
+
+        // Encode using the span-output interface
+        start = StartTimer();
+        for (std::size_t i = 0; i < iterations; i++)
+        {
+            for (const auto &record : dataset.records)
+            {
+                Sink = dataset.encode(record.payload, encoded);
+            }
+        }
+        double encode_span = per_octet(StopTimer() - start, payload_octets);
+
+        // Encode using the allocating interface
+        start = StartTimer();
+        for (std::size_t i = 0; i < iterations; i++)
+        {
+            for (const auto &record : dataset.records)
+            {
+                std::string output(
+                    dataset.codec->max_encoded_length(record.payload.size()),
+                    '\0');
+                output.resize(dataset.encode(record.payload, output));
+                Sink = output.size();
+            }
+        }
+        double encode_alloc = per_octet(StopTimer() - start, payload_octets);
+
+        std::printf("%-16s %7zu %9.2f %9.2f %9.2f %9.2f\n",
+                    dataset.name.c_str(),
+                    dataset.records.size(),
+                    decode_span,
+                    decode_alloc,
+                    encode_span,
+                    encode_alloc);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,420 @@
+/*
+ *  bench_latency.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements a microbenchmark that measures the distribution
+ *      of per-call latency for small inputs.  Each call is timed
+ *      individually, either with warm caches (the same call repeated) or
+ *      with cold caches (a buffer larger than the caches is written before
+ *      each call, evicting the lookup tables, code, and data).  The
+ *      difference between the two modes shows the cost of cache misses on
+ *      the lookup tables, while the difference between API layers shows the
+ *      cost of allocation and argument handling.
+ *
+ *      Usage: bench_latency [-codec=NAME] [-sizes=16,32,64,128]
+ *                           [-samples=N] [-cold-samples=N] [-evict=BYTES]
+ *
+ *      When the library is built without bases_COMPACT, the same benchmark
+ *      is also built as bench_latency_compact, linked with a compact build
+ *      of the library, so the cold-call latency of the two may be compared.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <terra/bases/bases_c.h>
+#include "codecs.h"
+#include "timer.h"
+
+using namespace Terra::Bench;
+
+namespace
+{
+
+// C interface functions for each codec, in the same order as Codecs
+struct CFunctions
+{
+    int (*encode)(const uint8_t *, size_t, char *, size_t *);
+    int (*decode)(const char *, size_t, uint8_t *, size_t *);
+};
+
+const CFunctions C_Functions[] =
+{
+    {bases_base16_encode, bases_base16_decode},
+    {bases_base32_encode, bases_base32_decode},
+    {bases_base45_encode, bases_base45_decode},
+    {bases_base58_encode, bases_base58_decode},
+    {bases_base64_encode, bases_base64_decode}
+};
+
+// Benchmark settings
+struct Settings
+{
+    std::string codec;
+    std::vector<std::size_t> sizes{16, 32, 64, 128};
+    std::size_t samples = 20000;
+    std::size_t cold_samples = 300;
+    std::size_t evict_bytes = 32 * 1024 * 1024;
+};
+
+/*
+ *  CacheEvictor
+ *
+ *  Description:
+ *      This object evicts the processor caches by writing to every cache
+ *      line of a buffer that is larger than the last-level cache.
+ *
+ *  Comments:
+ *      Writing (rather than reading) ensures lines are owned by this core,
+ *      so the lookup tables are displaced from every level of the cache.
+ */
+class CacheEvictor
+{
+    public:
+        explicit CacheEvictor(std::size_t size) : buffer(size, 0) {}
+
+        void Evict()
+        {
+            for (std::size_t i = 0; i < buffer.size(); i += 64) buffer[i]++;
+            sink = sink + buffer[buffer.size() / 2];
+        }
+
+    protected:
+        std::vector<std::uint8_t> buffer;
+        volatile std::uint8_t sink = 0;
+};
+
+/*
+ *  Percentile
+ *
+ *  Description:
+ *      Return the given percentile of the sorted samples.
+ *
+ *  Parameters:
+ *      sorted [in]
+ *          Sorted samples.
+ *
+ *      percentile [in]
+ *          Percentile in the range [0, 100].
+ *
+ *  Returns:
+ *      The sample at the requested percentile.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint64_t Percentile(const std::vector<std::uint64_t> &sorted,
+                         double percentile)
+{
+    if (sorted.empty()) return 0;
+
+    auto index = static_cast<std::size_t>(
+        (percentile / 100.0) * static_cast<double>(sorted.size() - 1) + 0.5);
+
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+/*
+ *  MeasureTimerOverhead
+ *
+ *  Description:
+ *      Measure the median cost of an empty timed region.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The median overhead in timer units.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint64_t MeasureTimerOverhead()
+{
+    std::vector<std::uint64_t> samples(10000);
+
+    for (auto &sample : samples)
+    {
+        std::uint64_t start = StartTimer();
+        sample = StopTimer() - start;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    return Percentile(samples, 50.0);
+}
+
+/*
+ *  Measure
+ *
+ *  Description:
+ *      Time each call of the given function individually.
+ *
+ *  Parameters:
+ *      function [in]
+ *          The function to time.
+ *
+ *      samples [in]
+ *          Number of calls to time.
+ *
+ *      evictor [in]
+ *          Cache evictor to run before each call, or nullptr for warm runs.
+ *
+ *      overhead [in]
+ *          Timer overhead to subtract from each sample.
+ *
+ *  Returns:
+ *      The sorted per-call latencies.
+ *
+ *  Comments:
+ *      None.
+ */
+std::vector<std::uint64_t> Measure(const std::function<void()> &function,
+                                   std::size_t samples,
+                                   CacheEvictor *evictor,
+                                   std::uint64_t overhead)
+{
+    std::vector<std::uint64_t> latencies(samples);
+
+    // Warm up (and fault in) everything once
+    function();
+
+    for (auto &latency : latencies)
+    {
+        if (evictor != nullptr) evictor->Evict();
+
+        std::uint64_t start = StartTimer();
+        function();
+        std::uint64_t elapsed = StopTimer() - start;
+
+        latency = (elapsed > overhead) ? (elapsed - overhead) : 0;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+
+    return latencies;
+}
+
+/*
+ *  Report
+ *
+ *  Description:
+ *      Print one line of results.
+ *
+ *  Parameters:
+ *      codec [in]
+ *          Codec name.
+ *
+ *      operation [in]
+ *          "encode" or "decode".
+ *
+ *      size [in]
+ *          Input size in octets.
+ *
+ *      api [in]
+ *          API layer measured.
+ *
+ *      mode [in]
+ *          "warm" or "cold".
+ *
+ *      latencies [in]
+ *          Sorted latencies.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Report(std::string_view codec,
+            std::string_view operation,
+            std::size_t size,
+            std::string_view api,
+            std::string_view mode,
+            const std::vector<std::uint64_t> &latencies)
+{
+    std::printf("%-7.*s %-7.*s %5zu %-6.*s %-5.*s "
+                "%8llu %8llu %8llu %8llu %8llu\n",
+                static_cast<int>(codec.size()), codec.data(),
+                static_cast<int>(operation.size()), operation.data(),
+                size,
+                static_cast<int>(api.size()), api.data(),
+                static_cast<int>(mode.size()), mode.data(),
+                static_cast<unsigned long long>(Percentile(latencies, 50.0)),
+                static_cast<unsigned long long>(Percentile(latencies, 90.0)),
+                static_cast<unsigned long long>(Percentile(latencies, 99.0)),
+                static_cast<unsigned long long>(Percentile(latencies, 99.9)),
+                static_cast<unsigned long long>(latencies.back()));
+}
+
+/*
+ *  ParseSizes
+ *
+ *  Description:
+ *      Parse a comma-separated list of sizes.
+ *
+ *  Parameters:
+ *      text [in]
+ *          The list of sizes.
+ *
+ *  Returns:
+ *      The sizes.
+ *
+ *  Comments:
+ *      None.
+ */
+std::vector<std::size_t> ParseSizes(std::string_view text)
+{
+    std::vector<std::size_t> sizes;
+
+    while (!text.empty())
+    {
+        auto comma = text.find(',');
+        std::string size(text.substr(0, comma));
+        sizes.push_back(std::strtoull(size.c_str(), nullptr, 10));
+        if (comma == std::string_view::npos) break;
+        text.remove_prefix(comma + 1);
+    }
+
+    return sizes;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Settings settings;
+
+    // Parse the command-line arguments
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view argument = argv[i];
+        auto value = argument.substr(argument.find('=') + 1);
+
+        if (argument.starts_with("-codec="))
+        {
+            settings.codec = value;
+        }
+        else if (argument.starts_with("-sizes="))
+        {
+            settings.sizes = ParseSizes(value);
+        }
+        else if (argument.starts_with("-samples="))
+        {
+            settings.samples = std::strtoull(value.data(), nullptr, 10);
+        }
+        else if (argument.starts_with("-cold-samples="))
+        {
+            settings.cold_samples = std::strtoull(value.data(), nullptr, 10);
+        }
+        else if (argument.starts_with("-evict="))
+        {
+            settings.evict_bytes = std::strtoull(value.data(), nullptr, 10);
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (settings.samples == 0) settings.samples = 1;
+    if (settings.cold_samples == 0) settings.cold_samples = 1;
+    if (settings.evict_bytes < 64) settings.evict_bytes = 64;
+
+    CacheEvictor evictor(settings.evict_bytes);
+    std::uint64_t overhead = MeasureTimerOverhead();
+
+#ifdef BENCH_COMPACT
+    std::printf("Library: compact (bases_COMPACT)\n");
+#else
+    std::printf("Library: table-driven\n");
+#endif
+    std::printf("Per-call latency in %s (timer overhead of %llu %s "
+                "subtracted)\n\n",
+                Timer_Units,
+                static_cast<unsigned long long>(overhead),
+                Timer_Units);
+    std::printf("%-7s %-7s %5s %-6s %-5s %8s %8s %8s %8s %8s\n",
+                "codec", "op", "size", "api", "mode",
+                "p50", "p90", "p99", "p99.9", "max");
+
+    for (std::size_t c = 0; c < Codecs.size(); c++)
+    {
+        const Codec &codec = Codecs[c];
+        const CFunctions &c_functions = C_Functions[c];
+
+        if (!settings.codec.empty() && (settings.codec != codec.name))
+        {
+            continue;
+        }
+
+        for (std::size_t size : settings.sizes)
+        {
+            auto input = RandomOctets(size);
+            std::vector<char> encoded(codec.max_encoded_length(size));
+            std::size_t encoded_length = codec.encode(input, encoded);
+            std::string_view text(encoded.data(), encoded_length);
+            std::vector<char> scratch(encoded.size());
+            std::vector<std::uint8_t> decoded(
+                codec.max_decoded_length(encoded_length));
+            volatile std::size_t sink = 0;
+
+            // Functions to measure for each API layer and operation
+            struct Case
+            {
+                const char *operation;
+                const char *api;
+                std::function<void()> function;
+            };
+            const Case cases[] =
+            {
+                {"encode", "span", [&]() {
+                    sink = codec.encode(input, scratch); }},
+                {"encode", "alloc", [&]() {
+                    sink = codec.encode_string(input).size(); }},
+                {"encode", "c", [&]() {
+                    std::size_t length = scratch.size();
+                    c_functions.encode(input.data(), input.size(),
+                                       scratch.data(), &length);
+                    sink = length; }},
+                {"decode", "span", [&]() {
+                    sink = codec.decode(text, decoded).value_or(0); }},
+                {"decode", "alloc", [&]() {
+                    sink = codec.decode_vector(text).size(); }},
+                {"decode", "c", [&]() {
+                    std::size_t length = decoded.size();
+                    c_functions.decode(text.data(), text.size(),
+                                       decoded.data(), &length);
+                    sink = length; }}
+            };
+
+            for (const auto &test : cases)
+            {
+                Report(codec.name, test.operation, size, test.api, "warm",
+                       Measure(test.function, settings.samples, nullptr,
+                               overhead));
+                Report(codec.name, test.operation, size, test.api, "cold",
+                       Measure(test.function, settings.cold_samples,
+                               &evictor, overhead));
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,323 @@
+/*
+ *  bench_replay.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements a benchmark that replays a recorded trace of
+ *      codec calls.  Inputs matching the size and whitespace density of each
+ *      trace entry are generated, the calls are issued in a shuffled order
+ *      having the same mix as the trace, and the time spent in each codec
+ *      and operation is reported.
+ *
+ *      Usage: bench_replay [-api=span|alloc] [-calls=N] [-iterations=N]
+ *                          [-seed=N] TRACE
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "codecs.h"
+#include "timer.h"
+#include "trace.h"
+
+using namespace Terra::Bench;
+
+namespace
+{
+
+// Results are stored here so that the calls are not optimized away
+volatile std::size_t Sink;
+
+// Input prepared for one trace entry
+struct PreparedCall
+{
+    const Codec *codec;
+    Operation operation;
+    std::vector<std::uint8_t> payload;
+    std::string text;
+};
+
+/*
+ *  PrepareCall
+ *
+ *  Description:
+ *      Generate input having the shape described by the trace entry.
+ *
+ *  Parameters:
+ *      codec [in]
+ *          The codec to use.
+ *
+ *      entry [in]
+ *          The trace entry.
+ *
+ *      seed [in]
+ *          Seed for generating the data.
+ *
+ *  Returns:
+ *      The prepared call.
+ *
+ *  Comments:
+ *      For decoding, the largest payload whose encoding fits within the
+ *      non-whitespace part of the text is used, and newlines are spread
+ *      evenly through the text to achieve the whitespace density.
+ */
+PreparedCall PrepareCall(const Codec &codec,
+                         const TraceEntry &entry,
+                         std::uint64_t seed)
+{
+    PreparedCall call{&codec, entry.operation, {}, {}};
+
+    if (entry.operation == Operation::Encode)
+    {
+        call.payload = RandomOctets(entry.size, seed);
+        return call;
+    }
+
+    // Determine the number of whitespace characters
+    std::size_t whitespace = static_cast<std::size_t>(std::lround(
+        static_cast<double>(entry.size * entry.whitespace_permille) / 1000.0));
+    std::size_t characters = entry.size - whitespace;
+
+    // Find the largest payload that encodes within the available space
+    std::string encoded;
+    for (std::size_t length = codec.max_decoded_length(characters) + 1;
+         length > 0;
+         length--)
+    {
+        auto payload = RandomOctets(length - 1, seed);
+        encoded = codec.encode_string(payload);
+        if (encoded.size() <= characters)
+        {
+            call.payload = std::move(payload);
+            break;
+        }
+    }
+
+    // Spread the whitespace evenly through the encoded text
+    std::size_t inserted = 0;
+    for (std::size_t i = 0; i < encoded.size(); i++)
+    {
+        call.text += encoded[i];
+        while (inserted < (whitespace * (i + 1)) / encoded.size())
+        {
+            call.text += '\n';
+            inserted++;
+        }
+    }
+    call.text.append(whitespace - inserted, '\n');
+
+    return call;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    bool allocating = false;
+    std::uint64_t max_calls = 1000000;
+    std::size_t iterations = 1;
+    std::uint64_t seed = 1;
+    std::string trace_file;
+
+    // Parse the command-line arguments
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view argument = argv[i];
+        auto value = argument.substr(argument.find('=') + 1);
+
+        if (argument == "-api=span")
+        {
+            allocating = false;
+        }
+        else if (argument == "-api=alloc")
+        {
+            allocating = true;
+        }
+        else if (argument.starts_with("-calls="))
+        {
+            max_calls = std::strtoull(value.data(), nullptr, 10);
+        }
+        else if (argument.starts_with("-iterations="))
+        {
+            iterations = std::strtoull(value.data(), nullptr, 10);
+        }
+        else if (argument.starts_with("-seed="))
+        {
+            seed = std::strtoull(value.data(), nullptr, 10);
+        }
+        else if (!argument.starts_with("-") && trace_file.empty())
+        {
+            trace_file = argument;
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (trace_file.empty())
+    {
+        std::fprintf(stderr,
+                     "Usage: %s [-api=span|alloc] [-calls=N] "
+                     "[-iterations=N] [-seed=N] TRACE\n",
+                     argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (iterations == 0) iterations = 1;
+    if (max_calls == 0) max_calls = 1;
+
+    // Read the trace
+    std::ifstream stream(trace_file);
+    auto entries = ReadTrace(stream);
+    if (!stream.eof() || !entries || entries->empty())
+    {
+        std::fprintf(stderr, "Unable to read trace %s\n", trace_file.c_str());
+        return EXIT_FAILURE;
+    }
+
+    // Scale the trace down if it contains more than the maximum calls
+    std::uint64_t total = 0;
+    for (const auto &entry : *entries) total += entry.count;
+    double scale = (total > max_calls) ? static_cast<double>(max_calls) /
+                                             static_cast<double>(total)
+                                       : 1.0;
+
+    // Prepare inputs and build the schedule of calls
+    std::vector<PreparedCall> calls;
+    std::vector<std::size_t> schedule;
+    for (const auto &entry : *entries)
+    {
+        const Codec *codec = FindCodec(entry.codec);
+        if (codec == nullptr)
+        {
+            std::fprintf(stderr, "Unknown codec: %s\n", entry.codec.c_str());
+            return EXIT_FAILURE;
+        }
+
+        calls.push_back(PrepareCall(*codec, entry, seed + calls.size()));
+
+        auto count = static_cast<std::uint64_t>(std::llround(
+            static_cast<double>(entry.count) * scale));
+        schedule.insert(schedule.end(),
+                        std::max<std::uint64_t>(count, 1),
+                        calls.size() - 1);
+    }
+
+    // Shuffle the schedule deterministically
+    auto random = RandomOctets(schedule.size() * 4, seed);
+    for (std::size_t i = schedule.size(); i > 1; i--)
+    {
+        std::uint32_t value = static_cast<std::uint32_t>(random[i * 4 - 4]) |
+                              (static_cast<std::uint32_t>(random[i * 4 - 3])
+                               << 8) |
+                              (static_cast<std::uint32_t>(random[i * 4 - 2])
+                               << 16) |
+                              (static_cast<std::uint32_t>(random[i * 4 - 1])
+                               << 24);
+        std::swap(schedule[i - 1], schedule[value % i]);
+    }
+
+    // Allocate output buffers large enough for any call
+    std::size_t max_text = 0;
+    std::size_t max_encoded = 0;
+    for (const auto &call : calls)
+    {
+        max_text = std::max(max_text, call.text.size());
+        max_encoded = std::max(max_encoded,
+                               call.codec->max_encoded_length(
+                                   call.payload.size()));
+    }
+    std::vector<std::uint8_t> decoded(max_text);
+    std::vector<char> encoded(max_encoded);
+
+    // Replay the schedule, accumulating time per codec and operation
+    std::map<std::pair<std::string, Operation>,
+             std::pair<std::uint64_t, std::uint64_t>> results;
+    std::uint64_t replay_time = 0;
+    for (std::size_t iteration = 0; iteration < iterations; iteration++)
+    {
+        for (std::size_t index : schedule)
+        {
+            const PreparedCall &call = calls[index];
+            std::uint64_t start = StartTimer();
+
+            if (call.operation == Operation::Encode)
+            {
+                if (allocating)
+                {
+                    Sink = call.codec->encode_string(call.payload).size();
+                }
+                else
+                {
+                    Sink = call.codec->encode(call.payload, encoded);
+                }
+            }
+            else
+            {
+                if (allocating)
+                {
+                    Sink = call.codec->decode_vector(call.text).size();
+                }
+                else
+                {
+                    Sink = call.codec->decode(call.text, decoded).value_or(0);
+                }
+            }
+
+            std::uint64_t elapsed = StopTimer() - start;
+            auto &result = results[{call.codec->name, call.operation}];
+            result.first++;
+            result.second += elapsed;
+            replay_time += elapsed;
+        }
+    }
+
+    std::printf("Replayed %zu calls x %zu iterations (%s API), "
+                "times in %s\n\n",
+                schedule.size(),
+                iterations,
+                allocating ? "allocating" : "span",
+                Timer_Units);
+    std::printf("%-7s %-7s %10s %12s %14s %7s\n",
+                "codec", "op", "calls", "mean/call", "total", "share");
+
+    for (const auto &[key, result] : results)
+    {
+        std::printf("%-7s %-7s %10llu %12.1f %14llu %6.1f%%\n",
+                    key.first.c_str(),
+                    (key.second == Operation::Encode) ? "encode" : "decode",
+                    static_cast<unsigned long long>(result.first),
+                    static_cast<double>(result.second) /
+                        static_cast<double>(result.first),
+                    static_cast<unsigned long long>(result.second),
+                    100.0 * static_cast<double>(result.second) /
+                        static_cast<double>(replay_time));
+    }
+
+    std::printf("%-7s %-7s %10llu %12.1f %14llu\n",
+                "all", "",
+                static_cast<unsigned long long>(schedule.size() * iterations),
+                static_cast<double>(replay_time) /
+                    static_cast<double>(schedule.size() * iterations),
+                static_cast<unsigned long long>(replay_time));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,303 @@
+/*
+ *  bench_threads.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements a benchmark that measures how throughput scales
+ *      as codec calls are made concurrently from 1 to N threads, each pinned
+ *      to its own processor.  Every codec is encoded and decoded using both
+ *      the allocating and the span-output interfaces.  Poor efficiency for
+ *      the allocating interface relative to the span interface indicates
+ *      allocator contention, while poor efficiency for both indicates shared
+ *      state.  The -shared-counters option places the threads' counters in
+ *      the same cache line to illustrate the cost of false sharing.
+ *
+ *      Usage: bench_threads [-threads=N] [-duration=MS] [-size=N]
+ *                           [-shared-counters]
+ *
+ *  Portability Issues:
+ *      Thread pinning is only performed on Linux.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "codecs.h"
+
+using namespace Terra::Bench;
+
+namespace
+{
+
+// Per-thread operation counter occupying its own cache line
+struct alignas(64) PaddedCounter
+{
+    std::atomic<std::uint64_t> value;
+};
+
+// Per-thread operation counter packed next to the others
+struct PackedCounter
+{
+    std::atomic<std::uint64_t> value;
+};
+
+// Benchmark settings
+struct Settings
+{
+    unsigned threads = std::max(1U, std::thread::hardware_concurrency());
+    std::chrono::milliseconds duration{500};
+    std::size_t size = 64;
+    bool shared_counters = false;
+};
+
+/*
+ *  PinThread
+ *
+ *  Description:
+ *      Pin the calling thread to the given processor.
+ *
+ *  Parameters:
+ *      processor [in]
+ *          Processor number.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This is a no-op on platforms other than Linux.
+ */
+void PinThread([[maybe_unused]] unsigned processor)
+{
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(processor % CPU_SETSIZE, &cpu_set);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+#endif
+}
+
+/*
+ *  Worker
+ *
+ *  Description:
+ *      Repeatedly encode and decode using every codec until told to stop.
+ *
+ *  Parameters:
+ *      allocating [in]
+ *          True to use the allocating interface, false for span-output.
+ *
+ *      size [in]
+ *          Size of the octet string to encode.
+ *
+ *      start [in]
+ *          Flag set when all threads should start.
+ *
+ *      stop [in]
+ *          Flag set when all threads should stop.
+ *
+ *      counter [out]
+ *          Counter incremented for each call.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Each thread has its own input and output buffers, so the only state
+ *      shared between threads is what the library (or allocator) shares.
+ */
+void Worker(bool allocating,
+            std::size_t size,
+            const std::atomic<bool> &start,
+            const std::atomic<bool> &stop,
+            std::atomic<std::uint64_t> &counter)
+{
+    auto input = RandomOctets(size);
+    std::vector<std::string> texts;
+    std::size_t max_encoded = 0;
+    for (const auto &codec : Codecs)
+    {
+        texts.push_back(codec.encode_string(input));
+        max_encoded = std::max(max_encoded, codec.max_encoded_length(size));
+    }
+    std::vector<char> encoded(max_encoded);
+    std::vector<std::uint8_t> decoded(size + 1);
+    std::size_t sink = 0;
+
+    while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+
+    while (!stop.load(std::memory_order_relaxed))
+    {
+        for (std::size_t i = 0; i < Codecs.size(); i++)
+        {
+            const Codec &codec = Codecs[i];
+
+            if (allocating)
+            {
+                sink += codec.encode_string(input).size();
+                sink += codec.decode_vector(texts[i]).size();
+            }
+            else
+            {
+                sink += codec.encode(input, encoded);
+                sink += codec.decode(texts[i], decoded).value_or(0);
+            }
+
+            counter.fetch_add(2, std::memory_order_relaxed);
+        }
+    }
+
+    // Ensure the results are used
+    if (sink == 0) std::fprintf(stderr, "Unexpected result\n");
+}
+
+/*
+ *  Run
+ *
+ *  Description:
+ *      Run the workers on the given number of threads.
+ *
+ *  Parameters:
+ *      settings [in]
+ *          Benchmark settings.
+ *
+ *      threads [in]
+ *          Number of threads to run.
+ *
+ *      allocating [in]
+ *          True to use the allocating interface, false for span-output.
+ *
+ *  Returns:
+ *      Aggregate throughput in calls per second.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename Counter>
+double Run(const Settings &settings, unsigned threads, bool allocating)
+{
+    std::vector<Counter> counters(threads);
+    std::vector<std::thread> workers;
+    std::atomic<bool> start{false};
+    std::atomic<bool> stop{false};
+
+    for (unsigned i = 0; i < threads; i++)
+    {
+        workers.emplace_back([&, i]()
+        {
+            PinThread(i);
+            Worker(allocating, settings.size, start, stop, counters[i].value);
+        });
+    }
+
+    // Start all threads together, then stop them after the duration
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(settings.duration);
+    stop.store(true, std::memory_order_relaxed);
+    for (auto &worker : workers) worker.join();
+    auto end = std::chrono::steady_clock::now();
+
+    std::uint64_t calls = 0;
+    for (const auto &counter : counters) calls += counter.value.load();
+
+    return static_cast<double>(calls) /
+           std::chrono::duration<double>(end - begin).count();
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Settings settings;
+
+    // Parse the command-line arguments
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view argument = argv[i];
+        auto value = argument.substr(argument.find('=') + 1);
+
+        if (argument.starts_with("-threads="))
+        {
+            settings.threads = static_cast<unsigned>(
+                std::strtoul(value.data(), nullptr, 10));
+        }
+        else if (argument.starts_with("-duration="))
+        {
+            settings.duration = std::chrono::milliseconds(
+                std::strtoull(value.data(), nullptr, 10));
+        }
+        else if (argument.starts_with("-size="))
+        {
+            settings.size = std::strtoull(value.data(), nullptr, 10);
+        }
+        else if (argument == "-shared-counters")
+        {
+            settings.shared_counters = true;
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (settings.threads == 0) settings.threads = 1;
+
+    // Use 1, 2, 4, ... threads, ending with the requested number
+    std::vector<unsigned> thread_counts;
+    for (unsigned threads = 1; threads < settings.threads; threads *= 2)
+    {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(settings.threads);
+
+    std::printf("Calls per second over all codecs for %zu-octet inputs "
+                "(efficiency relative to one thread)\n\n",
+                settings.size);
+    std::printf("%7s %14s %10s %14s %10s\n",
+                "threads", "span", "span-eff", "alloc", "alloc-eff");
+
+    double span_base = 0.0;
+    double alloc_base = 0.0;
+    for (unsigned threads : thread_counts)
+    {
+        double span = settings.shared_counters
+                          ? Run<PackedCounter>(settings, threads, false)
+                          : Run<PaddedCounter>(settings, threads, false);
+        double alloc = settings.shared_counters
+                           ? Run<PackedCounter>(settings, threads, true)
+                           : Run<PaddedCounter>(settings, threads, true);
+
+        if (threads == 1)
+        {
+            span_base = span;
+            alloc_base = alloc;
+        }
+
+        std::printf("%7u %14.0f %9.1f%% %14.0f %9.1f%%\n",
+                    threads,
+                    span,
+                    100.0 * span / (span_base * threads),
+                    alloc,
+                    100.0 * alloc / (alloc_base * threads));
+    }
+
+    return EXIT_SUCCESS;
+}
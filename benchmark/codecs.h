@@ -0,0 +1,129 @@
+/*
+ *  codecs.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines a uniform description of each codec so that
+ *      benchmarks can iterate over all of them.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <terra/bases/base16.h>
+#include <terra/bases/base32.h>
+#include <terra/bases/base45.h>
+#include <terra/bases/base58.h>
+#include <terra/bases/base64.h>
+
+namespace Terra::Bench
+{
+
+// Description of a codec's functions
+struct Codec
+{
+    const char *name;
+    std::size_t (*max_encoded_length)(std::size_t);
+    std::size_t (*max_decoded_length)(std::size_t);
+    std::size_t (*encode)(const std::span<const std::uint8_t>,
+                          std::span<char>);
+    std::optional<std::size_t> (*decode)(const std::string_view,
+                                         std::span<std::uint8_t>);
+    std::string (*encode_string)(const std::span<const std::uint8_t>);
+    std::vector<std::uint8_t> (*decode_vector)(const std::string_view);
+};
+
+// All codecs (overloaded functions are selected by the member types)
+inline const std::array<Codec, 5> Codecs =
+{{
+    {"base16", Base16::MaxEncodedLength, Base16::MaxDecodedLength,
+     Base16::Encode, Base16::Decode, Base16::Encode, Base16::Decode},
+    {"base32", Base32::MaxEncodedLength, Base32::MaxDecodedLength,
+     Base32::Encode, Base32::Decode, Base32::Encode, Base32::Decode},
+    {"base45", Base45::MaxEncodedLength, Base45::MaxDecodedLength,
+     Base45::Encode, Base45::Decode, Base45::Encode, Base45::Decode},
+    {"base58", Base58::MaxEncodedLength, Base58::MaxDecodedLength,
+     Base58::Encode, Base58::Decode, Base58::Encode, Base58::Decode},
+    {"base64", Base64::MaxEncodedLength, Base64::MaxDecodedLength,
+     Base64::Encode, Base64::Decode, Base64::Encode, Base64::Decode}
+}};
+
+/*
+ *  FindCodec
+ *
+ *  Description:
+ *      Find the codec having the given name.
+ *
+ *  Parameters:
+ *      name [in]
+ *          Name of the codec (e.g., "base64").
+ *
+ *  Returns:
+ *      A pointer to the codec or nullptr if not found.
+ *
+ *  Comments:
+ *      None.
+ */
+inline const Codec *FindCodec(std::string_view name)
+{
+    for (const auto &codec : Codecs)
+    {
+        if (name == codec.name) return &codec;
+    }
+
+    return nullptr;
+}
+
+/*
+ *  RandomOctets
+ *
+ *  Description:
+ *      Produce deterministic pseudo-random octets.
+ *
+ *  Parameters:
+ *      length [in]
+ *          Number of octets to produce.
+ *
+ *      seed [in]
+ *          Seed for the generator.
+ *
+ *  Returns:
+ *      The octets.
+ *
+ *  Comments:
+ *      A simple xorshift generator is used so results are identical across
+ *      standard library implementations.
+ */
+inline std::vector<std::uint8_t> RandomOctets(std::size_t length,
+                                              std::uint64_t seed = 1)
+{
+    std::vector<std::uint8_t> octets(length);
+    std::uint64_t state = seed * 0x9e3779b97f4a7c15ULL + 1;
+
+    for (auto &octet : octets)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        octet = static_cast<std::uint8_t>(state >> 24);
+    }
+
+    return octets;
+}
+
+} // namespace Terra::Bench
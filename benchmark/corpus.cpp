@@ -0,0 +1,597 @@
+/*
+ *  corpus.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the benchmark corpus generator.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <string>
+#include <terra/bases/base16.h>
+#include <terra/bases/base32.h>
+#include <terra/bases/base45.h>
+#include <terra/bases/base58.h>
+#include <terra/bases/base64.h>
+#include "corpus.h"
+
+namespace Terra::Bench
+{
+
+namespace
+{
+
+// Deterministic xorshift generator
+class Random
+{
+    public:
+        explicit Random(std::uint64_t seed) :
+            state{seed * 0x9e3779b97f4a7c15ULL + 1}
+        {
+        }
+
+        std::uint64_t Next()
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        }
+
+        // Return a value in the range [low, high]
+        std::size_t Range(std::size_t low, std::size_t high)
+        {
+            return low + static_cast<std::size_t>(Next() % (high - low + 1));
+        }
+
+        std::vector<std::uint8_t> Octets(std::size_t length)
+        {
+            std::vector<std::uint8_t> octets(length);
+            for (auto &octet : octets)
+            {
+                octet = static_cast<std::uint8_t>(Next() >> 24);
+            }
+            return octets;
+        }
+
+    protected:
+        std::uint64_t state;
+};
+
+/*
+ *  EncodeText
+ *
+ *  Description:
+ *      Encode the payload using the given span-output encoder.
+ *
+ *  Parameters:
+ *      dataset [in]
+ *          Dataset whose codec and encoder are used.
+ *
+ *      payload [in]
+ *          Octets to encode.
+ *
+ *  Returns:
+ *      The encoded text.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string EncodeText(const Dataset &dataset,
+                       const std::vector<std::uint8_t> &payload)
+{
+    std::string text(dataset.codec->max_encoded_length(payload.size()), '\0');
+    text.resize(dataset.encode(payload, text));
+
+    return text;
+}
+
+/*
+ *  JSONOctets
+ *
+ *  Description:
+ *      Produce octets that look like a compact JSON object, as found in
+ *      JWT headers and claims.
+ *
+ *  Parameters:
+ *      random [in/out]
+ *          Random number generator.
+ *
+ *      length [in]
+ *          Approximate length of the object.
+ *
+ *  Returns:
+ *      The JSON octets.
+ *
+ *  Comments:
+ *      None.
+ */
+std::vector<std::uint8_t> JSONOctets(Random &random, std::size_t length)
+{
+    static constexpr std::string_view Keys[] =
+    {
+        "alg", "typ", "kid", "iss", "sub", "aud", "exp", "iat", "nbf",
+        "scope", "email", "name", "nonce", "azp", "sid"
+    };
+    static constexpr std::string_view Characters =
+        "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-.@";
+    std::string json = "{";
+
+    while (json.size() < length)
+    {
+        if (json.size() > 1) json += ',';
+        json += '"';
+        json += Keys[random.Range(0, std::size(Keys) - 1)];
+        json += "\":";
+
+        // Alternate between numeric values and string values
+        if ((random.Next() & 1) != 0)
+        {
+            json += std::to_string(1700000000 + random.Range(0, 99999999));
+        }
+        else
+        {
+            json += '"';
+            for (std::size_t i = random.Range(4, 24); i > 0; i--)
+            {
+                json += Characters[random.Range(0, Characters.size() - 1)];
+            }
+            json += '"';
+        }
+    }
+    json += '}';
+
+    return {json.begin(), json.end()};
+}
+
+/*
+ *  PEMDataset
+ *
+ *  Description:
+ *      Generate certificate-sized Base64 with lines wrapped at 64
+ *      characters, as in PEM (RFC 7468).
+ *
+ *  Parameters:
+ *      random [in/out]
+ *          Random number generator.
+ *
+ *      records [in]
+ *          Number of records to produce.
+ *
+ *  Returns:
+ *      The dataset.
+ *
+ *  Comments:
+ *      Only the text between the armor lines is included, as that is what
+ *      is passed to the decoder.
+ */
+Dataset PEMDataset(Random &random, std::size_t records)
+{
+    Dataset dataset{"pem-base64",
+                    FindCodec("base64"),
+                    Base64::Encode,
+                    Base64::Decode,
+                    {}};
+
+    for (std::size_t i = 0; i < records; i++)
+    {
+        CorpusRecord record;
+        record.payload = random.Octets(random.Range(600, 2000));
+
+        // Wrap the encoded text into lines of 64 characters
+        std::string encoded = EncodeText(dataset, record.payload);
+        for (std::size_t j = 0; j < encoded.size(); j += 64)
+        {
+            record.text += encoded.substr(j, 64);
+            record.text += '\n';
+        }
+
+        dataset.records.push_back(std::move(record));
+    }
+
+    return dataset;
+}
+
+/*
+ *  JWTDataset
+ *
+ *  Description:
+ *      Generate unpadded base64url segments shaped like those of a JSON Web
+ *      Token (RFC 7519): a short JSON header, a longer JSON claims set, and
+ *      a binary signature.
+ *
+ *  Parameters:
+ *      random [in/out]
+ *          Random number generator.
+ *
+ *      records [in]
+ *          Number of records to produce.
+ *
+ *  Returns:
+ *      The dataset.
+ *
+ *  Comments:
+ *      Each segment is a separate record, since segments are decoded
+ *      individually after splitting on '.'.
+ */
+Dataset JWTDataset(Random &random, std::size_t records)
+{
+    Dataset dataset{
+        "jwt-base64url",
+        FindCodec("base64"),
+        [](const std::span<const std::uint8_t> input, std::span<char> output)
+        {
+            return Base64::Encode(input, output, Base64::URLAlphabet());
+        },
+        [](const std::string_view input, std::span<std::uint8_t> output)
+        {
+            return Base64::Decode(input, output, Base64::URLAlphabet());
+        },
+        {}};
+
+    // Signature lengths for HS256, ES256, ES512, and RS256
+    static constexpr std::size_t Signature_Lengths[] = {32, 64, 132, 256};
+
+    for (std::size_t i = 0; i < records; i++)
+    {
+        CorpusRecord record;
+
+        switch (i % 3)
+        {
+            case 0:
+                record.payload = JSONOctets(random, random.Range(24, 48));
+                break;
+
+            case 1:
+                record.payload = JSONOctets(random, random.Range(80, 480));
+                break;
+
+            default:
+                record.payload = random.Octets(
+                    Signature_Lengths[random.Range(0, 3)]);
+                break;
+        }
+
+        record.text = EncodeText(dataset, record.payload);
+        dataset.records.push_back(std::move(record));
+    }
+
+    return dataset;
+}
+
+/*
+ *  HexDataset
+ *
+ *  Description:
+ *      Generate mixed-case hexadecimal with separators, as found in MAC
+ *      addresses, UUIDs, and key fingerprints.
+ *
+ *  Parameters:
+ *      random [in/out]
+ *          Random number generator.
+ *
+ *      records [in]
+ *          Number of records to produce.
+ *
+ *  Returns:
+ *      The dataset.
+ *
+ *  Comments:
+ *      None.
+ */
+Dataset HexDataset(Random &random, std::size_t records)
+{
+    Dataset dataset{"hex-separators",
+                    FindCodec("base16"),
+                    Base16::Encode,
+                    Base16::Decode,
+                    {}};
+
+    for (std::size_t i = 0; i < records; i++)
+    {
+        CorpusRecord record;
+        std::string encoded;
+
+        switch (i % 4)
+        {
+            case 0:
+                // MAC address (e.g., 3c:A6:...)
+                record.payload = random.Octets(6);
+                encoded = EncodeText(dataset, record.payload);
+                for (std::size_t j = 0; j < encoded.size(); j += 2)
+                {
+                    if (j > 0) record.text += ':';
+                    record.text += encoded.substr(j, 2);
+                }
+                break;
+
+            case 1:
+                // UUID (8-4-4-4-12)
+                record.payload = random.Octets(16);
+                encoded = EncodeText(dataset, record.payload);
+                for (std::size_t j = 0; j < encoded.size(); j++)
+                {
+                    if ((j == 8) || (j == 12) || (j == 16) || (j == 20))
+                    {
+                        record.text += '-';
+                    }
+                    record.text += encoded[j];
+                }
+                break;
+
+            case 2:
+                // Key fingerprint in space-separated groups of four
+                record.payload = random.Octets(20);
+                encoded = EncodeText(dataset, record.payload);
+                for (std::size_t j = 0; j < encoded.size(); j += 4)
+                {
+                    if (j > 0) record.text += ' ';
+                    record.text += encoded.substr(j, 4);
+                }
+                break;
+
+            default:
+                // Hash digest without separators
+                record.payload = random.Octets(32);
+                record.text = EncodeText(dataset, record.payload);
+                break;
+        }
+
+        // Randomly mix the letter case
+        for (auto &c : record.text)
+        {
+            if ((c >= 'A') && (c <= 'F') && ((random.Next() & 1) != 0))
+            {
+                c = static_cast<char>(c - 'A' + 'a');
+            }
+        }
+
+        dataset.records.push_back(std::move(record));
+    }
+
+    return dataset;
+}
+
+/*
+ *  Base58Dataset
+ *
+ *  Description:
+ *      Generate Base58 keys and addresses, many having leading zero octets.
+ *
+ *  Parameters:
+ *      random [in/out]
+ *          Random number generator.
+ *
+ *      records [in]
+ *          Number of records to produce.
+ *
+ *  Returns:
+ *      The dataset.
+ *
+ *  Comments:
+ *      None.
+ */
+Dataset Base58Dataset(Random &random, std::size_t records)
+{
+    Dataset dataset{"base58-keys",
+                    FindCodec("base58"),
+                    Base58::Encode,
+                    Base58::Decode,
+                    {}};
+
+    for (std::size_t i = 0; i < records; i++)
+    {
+        CorpusRecord record;
+
+        // Alternate between 25-octet addresses and 32-octet public keys
+        record.payload = random.Octets(((i % 2) == 0) ? 25 : 32);
+
+        // Give most records between one and four leading zero octets
+        std::size_t zeros = random.Range(0, 4);
+        std::fill_n(record.payload.begin(), zeros, std::uint8_t(0));
+
+        record.text = EncodeText(dataset, record.payload);
+        dataset.records.push_back(std::move(record));
+    }
+
+    return dataset;
+}
+
+/*
+ *  Base32Dataset
+ *
+ *  Description:
+ *      Generate Base32 values of the sizes used for one-time password
+ *      secrets and similar identifiers.
+ *
+ *  Parameters:
+ *      random [in/out]
+ *          Random number generator.
+ *
+ *      records [in]
+ *          Number of records to produce.
+ *
+ *      padded [in]
+ *          True if the '=' padding should be retained.
+ *
+ *  Returns:
+ *      The dataset.
+ *
+ *  Comments:
+ *      None.
+ */
+Dataset Base32Dataset(Random &random, std::size_t records, bool padded)
+{
+    Dataset dataset{padded ? "base32-padded" : "base32-unpadded",
+                    FindCodec("base32"),
+                    Base32::Encode,
+                    Base32::Decode,
+                    {}};
+
+    static constexpr std::size_t Lengths[] = {10, 16, 20, 32, 64};
+
+    for (std::size_t i = 0; i < records; i++)
+    {
+        CorpusRecord record;
+
+        // Use common secret lengths, occasionally an arbitrary length
+        if ((i % 5) == 4)
+        {
+            record.payload = random.Octets(random.Range(1, 100));
+        }
+        else
+        {
+            record.payload = random.Octets(Lengths[random.Range(0, 4)]);
+        }
+
+        record.text = EncodeText(dataset, record.payload);
+        if (!padded)
+        {
+            record.text.erase(record.text.find_last_not_of('=') + 1);
+        }
+
+        dataset.records.push_back(std::move(record));
+    }
+
+    return dataset;
+}
+
+/*
+ *  Base45Dataset
+ *
+ *  Description:
+ *      Generate Base45 payloads of the size found in QR codes, such as
+ *      compressed health certificates (RFC 9285).
+ *
+ *  Parameters:
+ *      random [in/out]
+ *          Random number generator.
+ *
+ *      records [in]
+ *          Number of records to produce.
+ *
+ *  Returns:
+ *      The dataset.
+ *
+ *  Comments:
+ *      The payloads are random since the real payloads are compressed.
+ */
+Dataset Base45Dataset(Random &random, std::size_t records)
+{
+    Dataset dataset{"base45-qr",
+                    FindCodec("base45"),
+                    Base45::Encode,
+                    Base45::Decode,
+                    {}};
+
+    for (std::size_t i = 0; i < records; i++)
+    {
+        CorpusRecord record;
+        record.payload = random.Octets(random.Range(180, 420));
+        record.text = EncodeText(dataset, record.payload);
+        dataset.records.push_back(std::move(record));
+    }
+
+    return dataset;
+}
+
+} // namespace
+
+/*
+ *  GenerateCorpus
+ *
+ *  Description:
+ *      Generate all of the benchmark datasets.
+ *
+ *  Parameters:
+ *      records [in]
+ *          Number of records to produce for each dataset.
+ *
+ *      seed [in]
+ *          Seed for the generator; the same seed always yields the same
+ *          corpus.
+ *
+ *  Returns:
+ *      The generated datasets.
+ *
+ *  Comments:
+ *      Each dataset uses its own generator so that adding a dataset does
+ *      not alter the others.
+ */
+std::vector<Dataset> GenerateCorpus(std::size_t records, std::uint64_t seed)
+{
+    std::vector<Dataset> corpus;
+
+    {
+        Random random(seed);
+        corpus.push_back(PEMDataset(random, records));
+    }
+    {
+        Random random(seed + 1);
+        corpus.push_back(JWTDataset(random, records));
+    }
+    {
+        Random random(seed + 2);
+        corpus.push_back(HexDataset(random, records));
+    }
+    {
+        Random random(seed + 3);
+        corpus.push_back(Base58Dataset(random, records));
+    }
+    {
+        Random random(seed + 4);
+        corpus.push_back(Base32Dataset(random, records, true));
+    }
+    {
+        Random random(seed + 5);
+        corpus.push_back(Base32Dataset(random, records, false));
+    }
+    {
+        Random random(seed + 6);
+        corpus.push_back(Base45Dataset(random, records));
+    }
+
+    return corpus;
+}
+
+/*
+ *  VerifyDataset
+ *
+ *  Description:
+ *      Verify that every record's text decodes to its payload.
+ *
+ *  Parameters:
+ *      dataset [in]
+ *          The dataset to verify.
+ *
+ *  Returns:
+ *      True if all records decode correctly, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool VerifyDataset(const Dataset &dataset)
+{
+    for (const auto &record : dataset.records)
+    {
+        std::vector<std::uint8_t> decoded(
+            dataset.codec->max_decoded_length(record.text.size()));
+        auto length = dataset.decode(record.text, decoded);
+        if (!length) return false;
+        decoded.resize(*length);
+        if (decoded != record.payload) return false;
+    }
+
+    return true;
+}
+
+} // namespace Terra::Bench
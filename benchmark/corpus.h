@@ -0,0 +1,97 @@
+/*
+ *  corpus.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines a generator for deterministic benchmark datasets
+ *      that resemble real traffic: PEM-wrapped Base64, JWT-shaped base64url,
+ *      mixed-case hex with separators, Base58 keys with leading zero octets,
+ *      padded and unpadded Base32, and Base45 QR code payloads.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "codecs.h"
+
+namespace Terra::Bench
+{
+
+// A single encoded value and the octets it represents
+struct CorpusRecord
+{
+    std::vector<std::uint8_t> payload;
+    std::string text;
+};
+
+// A named collection of records and the functions used to process them
+struct Dataset
+{
+    std::string name;
+    const Codec *codec;
+    std::size_t (*encode)(const std::span<const std::uint8_t>,
+                          std::span<char>);
+    std::optional<std::size_t> (*decode)(const std::string_view,
+                                         std::span<std::uint8_t>);
+    std::vector<CorpusRecord> records;
+};
+
+/*
+ *  GenerateCorpus
+ *
+ *  Description:
+ *      Generate all of the benchmark datasets.
+ *
+ *  Parameters:
+ *      records [in]
+ *          Number of records to produce for each dataset.
+ *
+ *      seed [in]
+ *          Seed for the generator; the same seed always yields the same
+ *          corpus.
+ *
+ *  Returns:
+ *      The generated datasets.
+ *
+ *  Comments:
+ *      Each record's text decodes to its payload with the dataset's decode
+ *      function, though encoding the payload with the dataset's encode
+ *      function will not necessarily reproduce the text (e.g., line breaks,
+ *      separators, and letter case are not reproduced).
+ */
+std::vector<Dataset> GenerateCorpus(std::size_t records = 256,
+                                    std::uint64_t seed = 1);
+
+/*
+ *  VerifyDataset
+ *
+ *  Description:
+ *      Verify that every record's text decodes to its payload.
+ *
+ *  Parameters:
+ *      dataset [in]
+ *          The dataset to verify.
+ *
+ *  Returns:
+ *      True if all records decode correctly, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool VerifyDataset(const Dataset &dataset);
+
+} // namespace Terra::Bench
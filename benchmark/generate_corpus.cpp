@@ -0,0 +1,131 @@
+/*
+ *  generate_corpus.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This program writes the benchmark corpus to a directory so that it
+ *      may be inspected or used with other tools.  Each dataset is written
+ *      to a file named <dataset>.txt, with records separated by an empty
+ *      line.  Optionally, a trace of decoding every record is written so
+ *      that bench_replay may replay the corpus workload.
+ *
+ *      Usage: generate_corpus [-records=N] [-seed=N] [-trace=FILE]
+ *                             DIRECTORY
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include "corpus.h"
+#include "trace.h"
+
+using namespace Terra::Bench;
+
+int main(int argc, char *argv[])
+{
+    std::size_t records = 256;
+    std::uint64_t seed = 1;
+    std::filesystem::path directory;
+    std::string trace_file;
+    TraceRecorder recorder;
+
+    // Parse the command-line arguments
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view argument = argv[i];
+        auto value = argument.substr(argument.find('=') + 1);
+
+        if (argument.starts_with("-records="))
+        {
+            records = std::strtoull(value.data(), nullptr, 10);
+        }
+        else if (argument.starts_with("-seed="))
+        {
+            seed = std::strtoull(value.data(), nullptr, 10);
+        }
+        else if (argument.starts_with("-trace="))
+        {
+            trace_file = value;
+        }
+        else if (!argument.starts_with("-") && directory.empty())
+        {
+            directory = argument;
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (directory.empty())
+    {
+        std::fprintf(stderr,
+                     "Usage: %s [-records=N] [-seed=N] [-trace=FILE] "
+                     "DIRECTORY\n",
+                     argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    for (const auto &dataset : GenerateCorpus(records, seed))
+    {
+        // Ensure the generated data is valid before writing it
+        if (!VerifyDataset(dataset))
+        {
+            std::fprintf(stderr,
+                         "Dataset %s failed verification\n",
+                         dataset.name.c_str());
+            return EXIT_FAILURE;
+        }
+
+        auto path = directory / (dataset.name + ".txt");
+        std::ofstream file(path, std::ios::binary);
+
+        for (const auto &record : dataset.records)
+        {
+            recorder.RecordDecode(dataset.codec->name, record.text);
+            file << record.text;
+            if (!record.text.ends_with('\n')) file << '\n';
+            file << '\n';
+        }
+
+        if (!file)
+        {
+            std::fprintf(stderr, "Unable to write %s\n", path.c_str());
+            return EXIT_FAILURE;
+        }
+
+        std::printf("%s: %zu records\n",
+                    path.c_str(),
+                    dataset.records.size());
+    }
+
+    // Write the trace, if requested
+    if (!trace_file.empty())
+    {
+        std::ofstream file(trace_file);
+        recorder.Write(file);
+        if (!file)
+        {
+            std::fprintf(stderr, "Unable to write %s\n", trace_file.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,196 @@
+/*
+ *  pgo_train_c.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This program is the training workload for the bases_c shared
+ *      library.  It reads the corpus written by generate_corpus and decodes
+ *      and re-encodes every record through the C interface.  Since it links
+ *      only with bases_c, it is used both to record a profile of that
+ *      library (bases_PGO=GENERATE) and to train a BOLT-instrumented copy.
+ *
+ *      Usage: pgo_train_c [-iterations=N] DIRECTORY
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <terra/bases/bases_c.h>
+
+namespace
+{
+
+// C interface functions for one dataset
+struct Functions
+{
+    const char *prefix;
+    int (*encode)(const uint8_t *, size_t, char *, size_t *);
+    int (*decode)(const char *, size_t, uint8_t *, size_t *);
+};
+
+// Datasets are recognized by the prefix of their names
+constexpr Functions Dataset_Functions[] =
+{
+    {"jwt-base64url", bases_base64url_encode, bases_base64url_decode},
+    {"pem-base64", bases_base64_encode, bases_base64_decode},
+    {"hex", bases_base16_encode, bases_base16_decode},
+    {"base32", bases_base32_encode, bases_base32_decode},
+    {"base45", bases_base45_encode, bases_base45_decode},
+    {"base58", bases_base58_encode, bases_base58_decode}
+};
+
+/*
+ *  ReadRecords
+ *
+ *  Description:
+ *      Read the records of a corpus file, which are separated by an empty
+ *      line.
+ *
+ *  Parameters:
+ *      path [in]
+ *          Corpus file to read.
+ *
+ *  Returns:
+ *      The records in the file.
+ *
+ *  Comments:
+ *      None.
+ */
+std::vector<std::string> ReadRecords(const std::filesystem::path &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::string contents{std::istreambuf_iterator<char>(file),
+                         std::istreambuf_iterator<char>()};
+    std::vector<std::string> records;
+    std::size_t start = 0;
+
+    while (start < contents.size())
+    {
+        std::size_t end = contents.find("\n\n", start);
+        if (end == std::string::npos) end = contents.size();
+        records.emplace_back(contents.substr(start, end - start));
+        start = end + 2;
+    }
+
+    return records;
+}
+
+} // namespace
+
+// Results are stored here so that the calls are not optimized away
+volatile std::size_t Sink;
+
+int main(int argc, char *argv[])
+{
+    std::size_t iterations = 10;
+    std::filesystem::path directory;
+
+    // Parse the command-line arguments
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view argument = argv[i];
+        auto value = argument.substr(argument.find('=') + 1);
+
+        if (argument.starts_with("-iterations="))
+        {
+            iterations = std::strtoull(value.data(), nullptr, 10);
+        }
+        else if (!argument.starts_with("-") && directory.empty())
+        {
+            directory = argument;
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (directory.empty())
+    {
+        std::fprintf(stderr,
+                     "Usage: %s [-iterations=N] DIRECTORY\n",
+                     argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::size_t datasets = 0;
+
+    for (const auto &functions : Dataset_Functions)
+    {
+        // Process each file whose name starts with the dataset prefix
+        std::error_code error;
+        for (const auto &entry :
+             std::filesystem::directory_iterator(directory, error))
+        {
+            std::string name = entry.path().filename().string();
+            if (!name.starts_with(functions.prefix)) continue;
+
+            auto records = ReadRecords(entry.path());
+
+            for (std::size_t i = 0; i < iterations; i++)
+            {
+                for (const auto &text : records)
+                {
+                    // No encoding is more than twice the length of the
+                    // octets it represents, nor are there more octets
+                    // than characters
+                    std::vector<std::uint8_t> octets(text.size());
+                    std::string encoded(text.size() * 2 + 16, '\0');
+                    std::size_t octets_length = octets.size();
+                    std::size_t encoded_length = encoded.size();
+
+                    if (functions.decode(text.data(),
+                                         text.size(),
+                                         octets.data(),
+                                         &octets_length) != BASES_OK)
+                    {
+                        std::fprintf(stderr,
+                                     "Failed to decode a record in %s\n",
+                                     name.c_str());
+                        return EXIT_FAILURE;
+                    }
+
+                    if (functions.encode(octets.data(),
+                                         octets_length,
+                                         encoded.data(),
+                                         &encoded_length) != BASES_OK)
+                    {
+                        std::fprintf(stderr,
+                                     "Failed to encode a record in %s\n",
+                                     name.c_str());
+                        return EXIT_FAILURE;
+                    }
+
+                    Sink = encoded_length;
+                }
+            }
+
+            std::printf("%-16s %7zu records\n", name.c_str(), records.size());
+            datasets++;
+        }
+    }
+
+    if (datasets == 0)
+    {
+        std::fprintf(stderr, "No corpus found in %s\n", directory.c_str());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,113 @@
+/*
+ *  timer.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines low-overhead timing functions for benchmarks.  On
+ *      x86 processors, the time stamp counter is read with serializing
+ *      instructions so that the measured code cannot be reordered around
+ *      the timer reads.  On other processors, std::chrono::steady_clock is
+ *      used.
+ *
+ *  Portability Issues:
+ *      Time stamp counter values are in reference cycles, which may differ
+ *      from core clock cycles when frequency scaling is active.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_USE_TSC 1
+#elif defined(_M_X64)
+#include <intrin.h>
+#define BENCH_USE_TSC 1
+#endif
+
+namespace Terra::Bench
+{
+
+#ifdef BENCH_USE_TSC
+
+// Units reported by the timer
+constexpr const char *Timer_Units = "cycles";
+
+/*
+ *  StartTimer
+ *
+ *  Description:
+ *      Read the time stamp counter at the start of a measured region.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The time stamp counter value.
+ *
+ *  Comments:
+ *      The lfence instructions ensure prior instructions complete before the
+ *      counter is read and that the measured code does not start early.
+ */
+inline std::uint64_t StartTimer()
+{
+    _mm_lfence();
+    std::uint64_t t = __rdtsc();
+    _mm_lfence();
+
+    return t;
+}
+
+/*
+ *  StopTimer
+ *
+ *  Description:
+ *      Read the time stamp counter at the end of a measured region.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The time stamp counter value.
+ *
+ *  Comments:
+ *      The rdtscp instruction waits for prior instructions to complete and
+ *      the trailing lfence prevents later instructions from starting early.
+ */
+inline std::uint64_t StopTimer()
+{
+    unsigned int aux;
+    std::uint64_t t = __rdtscp(&aux);
+    _mm_lfence();
+
+    return t;
+}
+
+#else
+
+// Units reported by the timer
+constexpr const char *Timer_Units = "ns";
+
+inline std::uint64_t StartTimer()
+{
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+inline std::uint64_t StopTimer()
+{
+    return StartTimer();
+}
+
+#endif
+
+} // namespace Terra::Bench
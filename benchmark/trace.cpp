@@ -0,0 +1,306 @@
+/*
+ *  trace.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the trace recorder and the functions to read
+ *      and write traces.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <bit>
+#include <cctype>
+#include <sstream>
+#include "trace.h"
+
+namespace Terra::Bench
+{
+
+namespace
+{
+
+/*
+ *  QuantizeSize
+ *
+ *  Description:
+ *      Round the size to one of eight steps per power of two.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size to round.
+ *
+ *  Returns:
+ *      The rounded size.
+ *
+ *  Comments:
+ *      Sizes up to 16 are retained exactly.
+ */
+std::size_t QuantizeSize(std::size_t size)
+{
+    if (size <= 16) return size;
+
+    // Determine the step for the power of two containing the size
+    std::size_t step = std::bit_floor(size) / 8;
+
+    return ((size + step / 2) / step) * step;
+}
+
+} // namespace
+
+/*
+ *  TraceRecorder::RecordEncode
+ *
+ *  Description:
+ *      Record an encode call.
+ *
+ *  Parameters:
+ *      codec [in]
+ *          Codec name (e.g., "base64").
+ *
+ *      octets [in]
+ *          Number of octets encoded.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void TraceRecorder::RecordEncode(std::string_view codec, std::size_t octets)
+{
+    Record(codec, Operation::Encode, octets, 0);
+}
+
+/*
+ *  TraceRecorder::RecordDecode
+ *
+ *  Description:
+ *      Record a decode call.
+ *
+ *  Parameters:
+ *      codec [in]
+ *          Codec name (e.g., "base64").
+ *
+ *      text [in]
+ *          Text that was decoded.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void TraceRecorder::RecordDecode(std::string_view codec,
+                                 std::string_view text)
+{
+    std::size_t whitespace = 0;
+
+    // Count the whitespace characters in the text
+    for (char c : text)
+    {
+        if (std::isspace(static_cast<unsigned char>(c)) != 0) whitespace++;
+    }
+
+    // Compute the density in permille, rounded to the nearest 10
+    unsigned permille = 0;
+    if (!text.empty())
+    {
+        permille = static_cast<unsigned>(
+            ((whitespace * 100 + text.size() / 2) / text.size()) * 10);
+    }
+
+    Record(codec, Operation::Decode, text.size(), permille);
+}
+
+/*
+ *  TraceRecorder::Entries
+ *
+ *  Description:
+ *      Return the entries recorded so far.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The trace entries.
+ *
+ *  Comments:
+ *      None.
+ */
+std::vector<TraceEntry> TraceRecorder::Entries() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<TraceEntry> entries;
+
+    for (const auto &[key, count] : counts)
+    {
+        entries.push_back({std::get<0>(key),
+                           std::get<1>(key),
+                           std::get<2>(key),
+                           std::get<3>(key),
+                           count});
+    }
+
+    return entries;
+}
+
+/*
+ *  TraceRecorder::Write
+ *
+ *  Description:
+ *      Write the entries recorded so far to the given stream.
+ *
+ *  Parameters:
+ *      stream [in/out]
+ *          Stream to which the trace is written.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void TraceRecorder::Write(std::ostream &stream) const
+{
+    WriteTrace(stream, Entries());
+}
+
+/*
+ *  TraceRecorder::Record
+ *
+ *  Description:
+ *      Record a call.
+ *
+ *  Parameters:
+ *      codec [in]
+ *          Codec name.
+ *
+ *      operation [in]
+ *          Operation performed.
+ *
+ *      size [in]
+ *          Input size in octets.
+ *
+ *      whitespace_permille [in]
+ *          Whitespace density of the input.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void TraceRecorder::Record(std::string_view codec,
+                           Operation operation,
+                           std::size_t size,
+                           unsigned whitespace_permille)
+{
+    Key key{std::string(codec),
+            operation,
+            QuantizeSize(size),
+            whitespace_permille};
+
+    std::lock_guard<std::mutex> lock(mutex);
+    counts[key]++;
+}
+
+/*
+ *  WriteTrace
+ *
+ *  Description:
+ *      Write the trace entries to the given stream.
+ *
+ *  Parameters:
+ *      stream [in/out]
+ *          Stream to which the trace is written.
+ *
+ *      entries [in]
+ *          Trace entries to write.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void WriteTrace(std::ostream &stream, const std::vector<TraceEntry> &entries)
+{
+    stream << "# codec operation size whitespace-permille count\n";
+
+    for (const auto &entry : entries)
+    {
+        stream << entry.codec << ' '
+               << ((entry.operation == Operation::Encode) ? "encode"
+                                                          : "decode")
+               << ' ' << entry.size << ' ' << entry.whitespace_permille << ' '
+               << entry.count << '\n';
+    }
+}
+
+/*
+ *  ReadTrace
+ *
+ *  Description:
+ *      Read trace entries from the given stream.
+ *
+ *  Parameters:
+ *      stream [in/out]
+ *          Stream from which the trace is read.
+ *
+ *  Returns:
+ *      The trace entries or an empty optional if the trace is malformed.
+ *
+ *  Comments:
+ *      Empty lines and lines starting with '#' are ignored.
+ */
+std::optional<std::vector<TraceEntry>> ReadTrace(std::istream &stream)
+{
+    std::vector<TraceEntry> entries;
+    std::string line;
+
+    while (std::getline(stream, line))
+    {
+        // Skip over comments and empty lines
+        auto start = line.find_first_not_of(" \t\r");
+        if ((start == std::string::npos) || (line[start] == '#')) continue;
+
+        std::istringstream fields(line);
+        TraceEntry entry{};
+        std::string operation;
+
+        if (!(fields >> entry.codec >> operation >> entry.size >>
+              entry.whitespace_permille >> entry.count))
+        {
+            return {};
+        }
+
+        if (operation == "encode")
+        {
+            entry.operation = Operation::Encode;
+        }
+        else if (operation == "decode")
+        {
+            entry.operation = Operation::Decode;
+        }
+        else
+        {
+            return {};
+        }
+
+        if (entry.whitespace_permille >= 1000) return {};
+
+        entries.push_back(entry);
+    }
+
+    return entries;
+}
+
+} // namespace Terra::Bench
@@ -0,0 +1,131 @@
+/*
+ *  trace.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines a compact trace of codec calls, recording for each
+ *      kind of call the codec, operation, input size, and density of
+ *      whitespace in the input, along with the number of such calls.  A
+ *      trace recorded from a production workload may be replayed with
+ *      bench_replay to measure the library against that workload.
+ *
+ *      Traces are stored as text, one entry per line:
+ *
+ *          # codec operation size whitespace-permille count
+ *          base64 decode 1536 15 1200
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace Terra::Bench
+{
+
+// Operation performed by a traced call
+enum class Operation
+{
+    Encode,
+    Decode
+};
+
+// A single kind of call and the number of times it was made
+struct TraceEntry
+{
+    std::string codec;
+    Operation operation;
+    std::size_t size;
+    unsigned whitespace_permille;
+    std::uint64_t count;
+};
+
+/*
+ *  TraceRecorder
+ *
+ *  Description:
+ *      This object aggregates codec calls into trace entries.  It may be
+ *      compiled into an application and called alongside each codec call.
+ *
+ *  Comments:
+ *      Sizes are rounded to one of eight steps per power of two and
+ *      whitespace density to the nearest 10 permille so that the trace stays
+ *      small.  The recorder is thread-safe.
+ */
+class TraceRecorder
+{
+    public:
+        void RecordEncode(std::string_view codec, std::size_t octets);
+        void RecordDecode(std::string_view codec, std::string_view text);
+        std::vector<TraceEntry> Entries() const;
+        void Write(std::ostream &stream) const;
+
+    protected:
+        void Record(std::string_view codec,
+                    Operation operation,
+                    std::size_t size,
+                    unsigned whitespace_permille);
+
+        using Key = std::tuple<std::string, Operation, std::size_t, unsigned>;
+
+        mutable std::mutex mutex;
+        std::map<Key, std::uint64_t> counts;
+};
+
+/*
+ *  WriteTrace
+ *
+ *  Description:
+ *      Write the trace entries to the given stream.
+ *
+ *  Parameters:
+ *      stream [in/out]
+ *          Stream to which the trace is written.
+ *
+ *      entries [in]
+ *          Trace entries to write.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void WriteTrace(std::ostream &stream, const std::vector<TraceEntry> &entries);
+
+/*
+ *  ReadTrace
+ *
+ *  Description:
+ *      Read trace entries from the given stream.
+ *
+ *  Parameters:
+ *      stream [in/out]
+ *          Stream from which the trace is read.
+ *
+ *  Returns:
+ *      The trace entries or an empty optional if the trace is malformed.
+ *
+ *  Comments:
+ *      Empty lines and lines starting with '#' are ignored.
+ */
+std::optional<std::vector<TraceEntry>> ReadTrace(std::istream &stream);
+
+} // namespace Terra::Bench
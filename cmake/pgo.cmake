@@ -0,0 +1,119 @@
+# Build the Base-N Library with profile-guided optimization
+#
+# This script configures a build tree with bases_PGO=GENERATE, runs the
+# training workload (pgo_train and pgo_train_c over the benchmark corpus),
+# and then rebuilds the same tree with bases_PGO=USE.  The profile must be
+# used by the same tree that recorded it, since GCC names profile files after
+# the object files.
+#
+# Usage:
+#     cmake [-DBUILD_DIR=DIR] [-DCOMPARE=ON] [-DBOLT=ON]
+#           [-DCMAKE_CXX_COMPILER=COMPILER] -P cmake/pgo.cmake
+#
+# BUILD_DIR defaults to build-pgo in the current directory.  With COMPARE=ON,
+# a build without profile-guided optimization is made in BUILD_DIR-baseline
+# and bench_corpus is run with each so that the gains may be compared.  With
+# BOLT=ON, llvm-bolt additionally reorders the code of the bases_c shared
+# library using a profile recorded by pgo_train_c.
+
+cmake_minimum_required(VERSION 3.21)
+
+get_filename_component(source_dir "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+
+if(NOT BUILD_DIR)
+    set(BUILD_DIR "build-pgo")
+endif()
+get_filename_component(build_dir "${BUILD_DIR}" ABSOLUTE)
+
+set(profile_dir "${build_dir}/pgo")
+set(corpus_dir "${build_dir}/pgo-corpus")
+set(bench_dir "${build_dir}/benchmark")
+
+set(configure_options
+    -DCMAKE_BUILD_TYPE=Release
+    -Dbases_BUILD_TESTS=OFF
+    -Dbases_BUILD_BENCHMARKS=ON
+    -Dbases_BUILD_SHARED_C=ON
+    -Dbases_PGO_DIR=${profile_dir})
+if(CMAKE_CXX_COMPILER)
+    list(APPEND configure_options -DCMAKE_CXX_COMPILER=${CMAKE_CXX_COMPILER})
+endif()
+if(BOLT)
+    # BOLT requires relocations to be retained in the linked library
+    list(APPEND configure_options
+         "-DCMAKE_SHARED_LINKER_FLAGS=-Wl,--emit-relocs")
+endif()
+
+# Run a command, stopping if it fails
+function(run)
+    execute_process(COMMAND ${ARGN} COMMAND_ERROR_IS_FATAL ANY)
+endfunction()
+
+# Step 1: build the instrumented library and the training programs
+message(STATUS "Building the instrumented library")
+file(REMOVE_RECURSE "${profile_dir}" "${corpus_dir}")
+run(${CMAKE_COMMAND} -S ${source_dir} -B ${build_dir} ${configure_options}
+    -Dbases_PGO=GENERATE)
+run(${CMAKE_COMMAND} --build ${build_dir} --parallel
+    --target pgo_train pgo_train_c generate_corpus)
+
+# Step 2: record the profile by running the training workload
+message(STATUS "Running the training workload")
+run(${bench_dir}/pgo_train)
+run(${bench_dir}/generate_corpus ${corpus_dir})
+run(${bench_dir}/pgo_train_c ${corpus_dir})
+
+# Clang writes raw profiles that must be merged before use
+file(GLOB raw_profiles "${profile_dir}/*.profraw")
+if(raw_profiles)
+    find_program(LLVM_PROFDATA NAMES llvm-profdata REQUIRED)
+    run(${LLVM_PROFDATA} merge -output=${profile_dir}/bases.profdata
+        ${raw_profiles})
+endif()
+
+# Step 3: rebuild the library using the profile
+message(STATUS "Building the optimized library")
+run(${CMAKE_COMMAND} -S ${source_dir} -B ${build_dir} ${configure_options}
+    -Dbases_PGO=USE)
+run(${CMAKE_COMMAND} --build ${build_dir} --parallel)
+
+# Step 4 (optional): reorder the shared library's code with BOLT
+if(BOLT)
+    find_program(LLVM_BOLT NAMES llvm-bolt REQUIRED)
+    file(GLOB shared_library "${build_dir}/src/libbases_c.so")
+    if(NOT shared_library)
+        message(FATAL_ERROR "BOLT requires the bases_c ELF shared library")
+    endif()
+    file(REAL_PATH "${shared_library}" library)
+    set(original "${library}.prebolt")
+    set(bolt_profile "${profile_dir}/bases_c.fdata")
+
+    message(STATUS "Training a BOLT-instrumented bases_c")
+    file(RENAME "${library}" "${original}")
+    run(${LLVM_BOLT} ${original} -instrument
+        -instrumentation-file=${bolt_profile} -o ${library})
+    run(${bench_dir}/pgo_train_c ${corpus_dir})
+
+    message(STATUS "Optimizing bases_c with BOLT")
+    run(${LLVM_BOLT} ${original} -data=${bolt_profile} -o ${library}
+        -reorder-blocks=ext-tsp -reorder-functions=hfsort -split-functions
+        -split-all-cold -icf=1 -dyno-stats)
+endif()
+
+message(STATUS "Optimized library: ${build_dir}/src")
+
+# Optionally build without profile-guided optimization and compare
+if(COMPARE)
+    set(baseline_dir "${build_dir}-baseline")
+
+    message(STATUS "Building the baseline library")
+    run(${CMAKE_COMMAND} -S ${source_dir} -B ${baseline_dir}
+        ${configure_options} -Dbases_PGO=OFF)
+    run(${CMAKE_COMMAND} --build ${baseline_dir} --parallel
+        --target bench_corpus)
+
+    message(STATUS "Baseline:")
+    run(${baseline_dir}/benchmark/bench_corpus)
+    message(STATUS "Profile-guided optimization:")
+    run(${bench_dir}/bench_corpus)
+endif()
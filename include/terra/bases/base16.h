@@ -23,10 +23,20 @@
 #include <span>
 #include <cstdint>
 #include <vector>
+#include <optional>
+#include <terra/bases/executor.h>
+#include <terra/bases/scratch.h>
 
 namespace Terra::Base16
 {
 
+// Rules applied by IsValid()
+enum class Mode
+{
+    Strict,                                     // Canonical encoding only
+    Lenient                                     // Whatever Decode() accepts
+};
+
 /*
  *  Encode
  *
@@ -85,4 +95,265 @@ std::string Encode(const std::span<const std::uint8_t> input);
  */
 std::vector<std::uint8_t> Decode(const std::string_view input);
 
+/*
+ *  MaxEncodedLength
+ *
+ *  Description:
+ *      This function returns the number of characters required to hold the
+ *      Base16 encoding of the given number of octets.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The number of octets to be encoded.
+ *
+ *  Returns:
+ *      The number of characters required for the encoded string.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MaxEncodedLength(std::size_t length);
+
+/*
+ *  MaxDecodedLength
+ *
+ *  Description:
+ *      This function returns the maximum number of octets that may result
+ *      from decoding a Base16-encoded string of the given length.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The length of the Base16-encoded string.
+ *
+ *  Returns:
+ *      The maximum number of octets the string could decode into.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MaxDecodedLength(std::size_t length);
+
+/*
+ *  IsValid
+ *
+ *  Description:
+ *      This function will determine whether the given string is properly
+ *      Base16-encoded without decoding it.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base16-encoded string that is to be validated.
+ *
+ *      mode [in]
+ *          The rules to apply:
+ *          Strict  - The input consists only of Base16 characters (of
+ *                    either case) and has an even length.
+ *          Lenient - The input is accepted exactly as Decode() accepts it:
+ *                    characters outside of the alphabet are skipped, and
+ *                    the number of remaining characters must be even.
+ *
+ *  Returns:
+ *      The exact number of octets the string decodes into, or std::nullopt
+ *      if the string is not valid under the given rules.
+ *
+ *  Comments:
+ *      This function neither allocates memory nor writes any output.  Each
+ *      pair of Base16 characters yields one octet, so a valid string may be
+ *      decoded into a buffer of exactly the returned size.
+ */
+std::optional<std::size_t> IsValid(const std::string_view input,
+                                   Mode mode = Mode::Strict);
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base16,
+ *      writing the encoded characters into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base16.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.  A buffer
+ *          of MaxEncodedLength(input.size()) characters is always sufficient.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      This function does not allocate memory.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output);
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base16-encoded string, writing the
+ *      decoded octets into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base16-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.  A buffer of
+ *          MaxDecodedLength(input.size()) octets is always sufficient.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      The input is interpreted exactly as it is by the Decode() function
+ *      that returns a vector.  This function does not allocate memory.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output);
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base16,
+ *      writing the encoded characters into the given output buffer and
+ *      dividing large inputs into chunks that are encoded in parallel
+ *      using the given executor.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base16.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.  A buffer
+ *          of MaxEncodedLength(input.size()) characters is always sufficient.
+ *
+ *      executor [in]
+ *          The executor on which to run the chunks (e.g., an adapter to the
+ *          application's thread pool or Bases::DefaultExecutor()).
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      The output is identical to that of the serial Encode() function.
+ *      Inputs smaller than a few chunks are encoded on the calling thread.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output,
+                   Bases::Executor &executor);
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base16-encoded string, writing the
+ *      decoded octets into the given output buffer and dividing large
+ *      inputs into chunks that are decoded in parallel using the given
+ *      executor.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base16-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.  A buffer of
+ *          MaxDecodedLength(input.size()) octets is always sufficient.
+ *
+ *      executor [in]
+ *          The executor on which to run the chunks.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      The result is identical to that of the serial Decode() function.
+ *      Chunks can be decoded in parallel only if the characters preceding
+ *      the last chunk are all part of the alphabet (e.g., there are no line
+ *      breaks); other inputs are decoded on the calling thread.  The
+ *      contents of the output buffer beyond the returned length are
+ *      unspecified.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output,
+                                  Bases::Executor &executor);
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base16,
+ *      returning a string that uses the given allocator.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base16.
+ *
+ *      allocator [in]
+ *          Allocator for the returned string (e.g., a
+ *          Bases::ScratchAllocator<char> to draw from the scratch pool).
+ *
+ *  Returns:
+ *      The Base16-encoded text string.
+ *
+ *  Comments:
+ *      None.
+ */
+template<Bases::AllocatorOf<char> Allocator>
+std::basic_string<char, std::char_traits<char>, Allocator> Encode(
+                                    const std::span<const std::uint8_t> input,
+                                    const Allocator &allocator)
+{
+    std::basic_string<char, std::char_traits<char>, Allocator> output(
+        MaxEncodedLength(input.size()), '\0', allocator);
+
+    output.resize(Encode(input, std::span<char>(output)));
+
+    return output;
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base16-encoded string, returning a
+ *      vector that uses the given allocator.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base16-encoded string that is to be decoded.
+ *
+ *      allocator [in]
+ *          Allocator for the returned vector (e.g., a
+ *          Bases::ScratchAllocator<std::uint8_t> to draw from the scratch
+ *          pool).
+ *
+ *  Returns:
+ *      The decoded octets, which will be empty if the input string was
+ *      empty or if the input string was not a properly encoded string.
+ *
+ *  Comments:
+ *      The input is interpreted exactly as it is by the Decode() function
+ *      that returns a std::vector with the default allocator.
+ */
+template<Bases::AllocatorOf<std::uint8_t> Allocator>
+std::vector<std::uint8_t, Allocator> Decode(const std::string_view input,
+                                            const Allocator &allocator)
+{
+    std::vector<std::uint8_t, Allocator> output(
+        MaxDecodedLength(input.size()), allocator);
+
+    output.resize(Decode(input, std::span<std::uint8_t>(output)).value_or(0));
+
+    return output;
+}
+
 } // namespace Terra::Base16
@@ -23,10 +23,20 @@
 #include <span>
 #include <cstdint>
 #include <vector>
+#include <optional>
+#include <terra/bases/executor.h>
+#include <terra/bases/scratch.h>
 
 namespace Terra::Base32
 {
 
+// Rules applied by IsValid()
+enum class Mode
+{
+    Strict,                                     // Canonical encoding only
+    Lenient                                     // Whatever Decode() accepts
+};
+
 /*
  *  Encode
  *
@@ -90,4 +100,298 @@ std::string Encode(const std::span<const std::uint8_t> input);
  */
 std::vector<std::uint8_t> Decode(const std::string_view input);
 
+/*
+ *  MaxEncodedLength
+ *
+ *  Description:
+ *      This function returns the number of characters required to hold the
+ *      Base32 encoding of the given number of octets, including padding.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The number of octets to be encoded.
+ *
+ *  Returns:
+ *      The number of characters required for the encoded string.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MaxEncodedLength(std::size_t length);
+
+/*
+ *  MaxDecodedLength
+ *
+ *  Description:
+ *      This function returns the maximum number of octets that may result
+ *      from decoding a Base32-encoded string of the given length.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The length of the Base32-encoded string.
+ *
+ *  Returns:
+ *      The maximum number of octets the string could decode into.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MaxDecodedLength(std::size_t length);
+
+/*
+ *  IsValid
+ *
+ *  Description:
+ *      This function will determine whether the given string is properly
+ *      Base32-encoded without decoding it.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base32-encoded string that is to be validated.
+ *
+ *      mode [in]
+ *          The rules to apply:
+ *          Strict  - The input consists only of Base32 characters (of
+ *                    either case) and padding, its length is a multiple of
+ *                    eight, padding appears only at the end in a valid
+ *                    amount, and unused trailing bits are zero.
+ *          Lenient - The input is accepted exactly as Decode() accepts it:
+ *                    characters outside of the alphabet are skipped,
+ *                    decoding ceases at the first padding character, and
+ *                    unused trailing bits must be zero.
+ *
+ *  Returns:
+ *      The exact number of octets the string decodes into, or std::nullopt
+ *      if the string is not valid under the given rules.
+ *
+ *  Comments:
+ *      This function neither allocates memory nor writes any output.  The
+ *      returned size excludes the octets implied by padding or a partial
+ *      final group, so it may be smaller than MaxDecodedLength(); a valid
+ *      string may be decoded into a buffer of exactly that size.
+ */
+std::optional<std::size_t> IsValid(const std::string_view input,
+                                   Mode mode = Mode::Strict);
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base32,
+ *      writing the encoded characters into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base32.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.  A buffer
+ *          of MaxEncodedLength(input.size()) characters is always sufficient.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      This function does not allocate memory.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output);
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base32-encoded string, writing the
+ *      decoded octets into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base32-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.  A buffer of
+ *          MaxDecodedLength(input.size()) octets is always sufficient.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      The input is interpreted exactly as it is by the Decode() function
+ *      that returns a vector.  This function does not allocate memory.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output);
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base32,
+ *      writing the encoded characters into the given output buffer and
+ *      dividing large inputs into chunks that are encoded in parallel
+ *      using the given executor.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base32.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.  A buffer
+ *          of MaxEncodedLength(input.size()) characters is always sufficient.
+ *
+ *      executor [in]
+ *          The executor on which to run the chunks (e.g., an adapter to the
+ *          application's thread pool or Bases::DefaultExecutor()).
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      The output is identical to that of the serial Encode() function.
+ *      Inputs smaller than a few chunks are encoded on the calling thread.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output,
+                   Bases::Executor &executor);
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base32-encoded string, writing the
+ *      decoded octets into the given output buffer and dividing large
+ *      inputs into chunks that are decoded in parallel using the given
+ *      executor.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base32-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.  A buffer of
+ *          MaxDecodedLength(input.size()) octets is always sufficient.
+ *
+ *      executor [in]
+ *          The executor on which to run the chunks.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      The result is identical to that of the serial Decode() function.
+ *      Chunks can be decoded in parallel only if the characters preceding
+ *      the last chunk are all part of the alphabet (e.g., there are no line
+ *      breaks); other inputs are decoded on the calling thread.  The
+ *      contents of the output buffer beyond the returned length are
+ *      unspecified.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output,
+                                  Bases::Executor &executor);
+
+/*
+ *  Append
+ *
+ *  Description:
+ *      This function will extend a Base32-encoded string with the encoding
+ *      of additional octets, such that the result is identical to encoding
+ *      the original data followed by the new octets.  Only the trailing
+ *      partial quantum of the existing string is re-encoded, so the cost is
+ *      proportional to the number of octets appended.
+ *
+ *  Parameters:
+ *      encoded [in/out]
+ *          Base32-encoded string produced by Encode() (or a prior call to
+ *          Append()), which is extended in place.
+ *
+ *      input [in]
+ *          Span of octets to append.
+ *
+ *  Returns:
+ *      True if the string was extended, or false if the end of the encoded
+ *      string is not a properly encoded quantum, in which case the string
+ *      is not modified.
+ *
+ *  Comments:
+ *      The encoded string must not contain line breaks or other characters
+ *      outside of the alphabet, other than trailing padding.
+ */
+bool Append(std::string &encoded, const std::span<const std::uint8_t> input);
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base32,
+ *      returning a string that uses the given allocator.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base32.
+ *
+ *      allocator [in]
+ *          Allocator for the returned string (e.g., a
+ *          Bases::ScratchAllocator<char> to draw from the scratch pool).
+ *
+ *  Returns:
+ *      The Base32-encoded text string.
+ *
+ *  Comments:
+ *      None.
+ */
+template<Bases::AllocatorOf<char> Allocator>
+std::basic_string<char, std::char_traits<char>, Allocator> Encode(
+                                    const std::span<const std::uint8_t> input,
+                                    const Allocator &allocator)
+{
+    std::basic_string<char, std::char_traits<char>, Allocator> output(
+        MaxEncodedLength(input.size()), '\0', allocator);
+
+    output.resize(Encode(input, std::span<char>(output)));
+
+    return output;
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base32-encoded string, returning a
+ *      vector that uses the given allocator.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base32-encoded string that is to be decoded.
+ *
+ *      allocator [in]
+ *          Allocator for the returned vector (e.g., a
+ *          Bases::ScratchAllocator<std::uint8_t> to draw from the scratch
+ *          pool).
+ *
+ *  Returns:
+ *      The decoded octets, which will be empty if the input string was
+ *      empty or if the input string was not a properly encoded string.
+ *
+ *  Comments:
+ *      The input is interpreted exactly as it is by the Decode() function
+ *      that returns a std::vector with the default allocator.
+ */
+template<Bases::AllocatorOf<std::uint8_t> Allocator>
+std::vector<std::uint8_t, Allocator> Decode(const std::string_view input,
+                                            const Allocator &allocator)
+{
+    std::vector<std::uint8_t, Allocator> output(
+        MaxDecodedLength(input.size()), allocator);
+
+    output.resize(Decode(input, std::span<std::uint8_t>(output)).value_or(0));
+
+    return output;
+}
+
 } // namespace Terra::Base32
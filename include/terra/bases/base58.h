@@ -22,11 +22,105 @@
 #include <string_view>
 #include <span>
 #include <cstdint>
+#include <memory>
 #include <vector>
+#include <optional>
+#include <terra/bases/scratch.h>
 
 namespace Terra::Base58
 {
 
+// Rules applied by IsValid()
+enum class Mode
+{
+    Strict,                                     // Canonical encoding only
+    Lenient                                     // Whatever Decode() accepts
+};
+
+/*
+ *  Cache
+ *
+ *  Description:
+ *      A bounded cache of the Base58 encodings of 32-octet values (e.g.,
+ *      public keys or hashes) for applications that encode the same values
+ *      repeatedly.  It is consulted by the Encode() functions that take a
+ *      Cache, so that encoding a cached value costs a hash lookup rather
+ *      than a base conversion.
+ *
+ *      Entries are divided among shards, each having its own lock that is
+ *      taken only to insert entries.  Lookups do not take a lock: every
+ *      entry carries a sequence number that a lookup checks before and
+ *      after reading the entry, ignoring it if it was being replaced.
+ *      Within a shard, each value maps to a set of entries, and the entry
+ *      to replace is chosen with the CLOCK algorithm, which evicts an entry
+ *      that has not been found since the set's clock hand last passed it.
+ *
+ *  Comments:
+ *      All member functions may be called from any number of threads
+ *      concurrently.  The capacity is rounded up so that every shard has a
+ *      power of two number of sets.  Counters are updated with relaxed
+ *      atomic operations, so statistics gathered while other threads use
+ *      the cache are approximate.
+ */
+class Cache
+{
+    public:
+        // Length of the values that are cached
+        static constexpr std::size_t Key_Length = 32;
+
+        // Maximum length of the encoding of a Key_Length-octet value
+        static constexpr std::size_t Max_Encoded_Length = 44;
+
+        // Number of entries in each set
+        static constexpr std::size_t Ways = 8;
+
+        // Default number of entries and shards
+        static constexpr std::size_t Default_Capacity = 65536;
+        static constexpr std::size_t Default_Shards = 64;
+
+        // Counters reported by GetStatistics()
+        struct Statistics
+        {
+            std::uint64_t hits = 0;             // Values found
+            std::uint64_t misses = 0;           // Values not found
+            std::uint64_t insertions = 0;       // Entries written
+            std::uint64_t evictions = 0;        // Entries replaced
+        };
+
+        explicit Cache(std::size_t capacity = Default_Capacity,
+                       std::size_t shards = Default_Shards);
+        ~Cache();
+
+        Cache(const Cache &) = delete;
+        Cache &operator=(const Cache &) = delete;
+
+        // Number of entries the cache holds
+        std::size_t Capacity() const noexcept
+        {
+            return shard_count * set_count * Ways;
+        }
+
+        std::size_t Find(const std::span<const std::uint8_t> key,
+                         std::span<char> output);
+        bool Insert(const std::span<const std::uint8_t> key,
+                    const std::string_view encoded);
+        void Clear();
+
+        Statistics GetStatistics() const noexcept;
+        void ResetStatistics() noexcept;
+
+    protected:
+        struct Shard;
+
+        Shard &Locate(const std::span<const std::uint8_t> key,
+                      std::size_t &set) const;
+
+        std::size_t shard_count;
+        std::size_t set_count;
+        unsigned shard_bits;
+        std::unique_ptr<Shard[]> shards;
+};
+
 /*
  *  Encode
  *
@@ -83,4 +177,254 @@ std::string Encode(const std::span<const std::uint8_t> input);
  */
 std::vector<std::uint8_t> Decode(const std::string_view input);
 
+/*
+ *  MaxEncodedLength
+ *
+ *  Description:
+ *      This function returns the maximum number of characters required to hold
+ *      the Base58 encoding of the given number of octets.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The number of octets to be encoded.
+ *
+ *  Returns:
+ *      The number of characters required for the encoded string.
+ *
+ *  Comments:
+ *      The actual length depends on the value being encoded and may be
+ *      shorter.
+ */
+std::size_t MaxEncodedLength(std::size_t length);
+
+/*
+ *  MaxDecodedLength
+ *
+ *  Description:
+ *      This function returns the maximum number of octets that may result
+ *      from decoding a Base58-encoded string of the given length.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The length of the Base58-encoded string.
+ *
+ *  Returns:
+ *      The maximum number of octets the string could decode into.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MaxDecodedLength(std::size_t length);
+
+/*
+ *  IsValid
+ *
+ *  Description:
+ *      This function will determine whether the given string is properly
+ *      Base58-encoded without decoding it.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base58-encoded string that is to be validated.
+ *
+ *      mode [in]
+ *          The rules to apply:
+ *          Strict  - The input consists only of Base58 characters.
+ *          Lenient - The input is accepted exactly as Decode() accepts it:
+ *                    whitespace is skipped, and every other character must
+ *                    be in the alphabet.
+ *
+ *  Returns:
+ *      The exact number of octets the string decodes into, or std::nullopt
+ *      if the string is not valid under the given rules.
+ *
+ *  Comments:
+ *      This function does not write any output.  A valid string may then be
+ *      decoded into a buffer of exactly the returned size.
+ *
+ *      The decoded length is derived from the leading digits in linear time
+ *      without performing the quadratic base conversion, except in the rare
+ *      case that the value lies too close to a power of 256 to be certain,
+ *      in which case the input is decoded into a scratch buffer.
+ */
+std::optional<std::size_t> IsValid(const std::string_view input,
+                                   Mode mode = Mode::Strict);
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base58,
+ *      writing the encoded characters into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base58.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.  A buffer
+ *          of MaxEncodedLength(input.size()) characters is always sufficient.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      This function does not allocate memory.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output);
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base58-encoded string, writing the
+ *      decoded octets into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base58-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.  A buffer of
+ *          MaxDecodedLength(input.size()) octets is always sufficient.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      The input is interpreted exactly as it is by the Decode() function
+ *      that returns a vector.  This function does not allocate memory.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output);
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base58,
+ *      consulting the given cache, and write the encoded characters into
+ *      the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base58.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.  A buffer
+ *          of MaxEncodedLength(input.size()) characters is always sufficient.
+ *
+ *      cache [in/out]
+ *          The cache to consult.  If the input is Cache::Key_Length octets
+ *          long and is not found, its encoding is inserted.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      Inputs of any other length are encoded without consulting the cache.
+ *      This function does not allocate memory.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output,
+                   Cache &cache);
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base58,
+ *      consulting the given cache.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base58.
+ *
+ *      cache [in/out]
+ *          The cache to consult.  If the input is Cache::Key_Length octets
+ *          long and is not found, its encoding is inserted.
+ *
+ *  Returns:
+ *      The Base58-encoded text string.
+ *
+ *  Comments:
+ *      Inputs of any other length are encoded without consulting the cache.
+ */
+std::string Encode(const std::span<const std::uint8_t> input, Cache &cache);
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base58,
+ *      returning a string that uses the given allocator.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base58.
+ *
+ *      allocator [in]
+ *          Allocator for the returned string (e.g., a
+ *          Bases::ScratchAllocator<char> to draw from the scratch pool).
+ *
+ *  Returns:
+ *      The Base58-encoded text string.
+ *
+ *  Comments:
+ *      None.
+ */
+template<Bases::AllocatorOf<char> Allocator>
+std::basic_string<char, std::char_traits<char>, Allocator> Encode(
+                                    const std::span<const std::uint8_t> input,
+                                    const Allocator &allocator)
+{
+    std::basic_string<char, std::char_traits<char>, Allocator> output(
+        MaxEncodedLength(input.size()), '\0', allocator);
+
+    output.resize(Encode(input, std::span<char>(output)));
+
+    return output;
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base58-encoded string, returning a
+ *      vector that uses the given allocator.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base58-encoded string that is to be decoded.
+ *
+ *      allocator [in]
+ *          Allocator for the returned vector (e.g., a
+ *          Bases::ScratchAllocator<std::uint8_t> to draw from the scratch
+ *          pool).
+ *
+ *  Returns:
+ *      The decoded octets, which will be empty if the input string was
+ *      empty or if the input string was not a properly encoded string.
+ *
+ *  Comments:
+ *      The input is interpreted exactly as it is by the Decode() function
+ *      that returns a std::vector with the default allocator.
+ */
+template<Bases::AllocatorOf<std::uint8_t> Allocator>
+std::vector<std::uint8_t, Allocator> Decode(const std::string_view input,
+                                            const Allocator &allocator)
+{
+    std::vector<std::uint8_t, Allocator> output(
+        MaxDecodedLength(input.size()), allocator);
+
+    output.resize(Decode(input, std::span<std::uint8_t>(output)).value_or(0));
+
+    return output;
+}
+
 } // namespace Terra::Base58
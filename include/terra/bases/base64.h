@@ -23,10 +23,308 @@
 #include <span>
 #include <cstdint>
 #include <vector>
+#include <optional>
+#include <array>
+#include <terra/bases/executor.h>
+#include <terra/bases/scratch.h>
 
 namespace Terra::Base64
 {
 
+// Rules applied by IsValid()
+enum class Mode
+{
+    Strict,                                     // Canonical encoding only
+    Lenient,                                    // Whatever Decode() accepts
+    Forgiving                                   // WHATWG forgiving-base64
+};
+
+// Order in which the bits of each group of three octets are assigned to
+// characters
+enum class BitOrder
+{
+    MostSignificantFirst,                       // As specified in RFC 4648
+    LeastSignificantFirst                       // As used by crypt(3) hashes
+};
+
+/*
+ *  Alphabet
+ *
+ *  Description:
+ *      This class holds a 64-character alphabet used for Base64 encoding and
+ *      decoding, along with the reverse lookup table generated from it.  This
+ *      allows variants such as base64url (RFC 4648), bcrypt, crypt(3)
+ *      hashes, or IMAP modified Base64 (RFC 3501) to use the same encoder
+ *      and decoder as the standard alphabet.
+ *
+ *  Comments:
+ *      By default, bits are assigned to characters most significant first as
+ *      specified in RFC 4648.  An alphabet may instead assign them least
+ *      significant first, as the MD5 and SHA-2 based crypt(3) hashes do:
+ *      each group of three octets is taken as a 24-bit little-endian value
+ *      and its 6-bit values are emitted starting with the least significant.
+ *      Such an alphabet's tables are indexed by bit-reversed values, which
+ *      allows the same kernels to serve both orders; Character() and Value()
+ *      always use the values themselves.
+ *
+ *      An alphabet may also be given alternate characters, which are
+ *      accepted when decoding as representing the same values as the
+ *      characters in the same positions (e.g., to decode both standard and
+ *      base64url text).  Encoding always produces the primary characters.
+ *
+ *      Constructing an Alphabet builds its tables, so objects should be
+ *      created once and reused.
+ */
+class Alphabet
+{
+    public:
+        // Value returned by Value() for characters not in the alphabet
+        static constexpr std::uint8_t Invalid_Character = 255;
+
+        explicit Alphabet(const std::string_view characters,
+                          bool padding = true);
+        Alphabet(const std::string_view characters,
+                 bool padding,
+                 const std::string_view alternates);
+        Alphabet(const std::string_view characters,
+                 bool padding,
+                 BitOrder bit_order);
+        ~Alphabet() = default;
+
+        // Return the character representing the given 6-bit value
+        char Character(std::uint8_t value) const noexcept
+        {
+            return table[Index(value & 0x3f)];
+        }
+
+        // Return the 6-bit value of the given character or Invalid_Character
+        std::uint8_t Value(char c) const noexcept
+        {
+            std::uint8_t value = reverse_table[static_cast<std::uint8_t>(c)];
+            return (value == Invalid_Character) ? value : Index(value);
+        }
+
+        // Indicates whether '=' padding is appended when encoding
+        bool Padding() const noexcept { return padding; }
+
+        // Order in which bits are assigned to characters
+        BitOrder Order() const noexcept { return bit_order; }
+
+        // Access to the generated tables (indexed as described above)
+        const std::array<char, 64> &Table() const noexcept { return table; }
+        const std::array<std::uint8_t, 256> &ReverseTable() const noexcept
+        {
+            return reverse_table;
+        }
+
+        // The characters for values 62 and 63 followed by their alternates
+        // if all other characters are those of the standard alphabet in the
+        // standard bit order (so the rest may be computed), else nullptr
+        const char *ComputedCharacters() const noexcept
+        {
+            return computed ? computed_characters.data() : nullptr;
+        }
+
+    protected:
+        // Map a 6-bit value to or from its position in the tables
+        std::uint8_t Index(std::uint8_t value) const noexcept
+        {
+            if (bit_order == BitOrder::MostSignificantFirst) return value;
+            return static_cast<std::uint8_t>(
+                ((value & 0x01) << 5) | ((value & 0x02) << 3) |
+                ((value & 0x04) << 1) | ((value & 0x08) >> 1) |
+                ((value & 0x10) >> 3) | ((value & 0x20) >> 5));
+        }
+
+        std::array<char, 64> table;
+        std::array<std::uint8_t, 256> reverse_table;
+        bool padding;
+        BitOrder bit_order;
+        std::array<char, 4> computed_characters;
+        bool computed;
+};
+
+/*
+ *  StandardAlphabet
+ *
+ *  Description:
+ *      Returns the standard Base64 alphabet (RFC 4648 Section 4).
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A reference to the standard alphabet.
+ *
+ *  Comments:
+ *      The following functions return the other commonly used alphabets:
+ *          URLAlphabet()    - base64url (RFC 4648 Section 5), no padding
+ *          BcryptAlphabet() - "./A-Za-z0-9" as used by bcrypt, no padding
+ *          CryptAlphabet()  - "./0-9A-Za-z" with bits least significant
+ *                             first, as used by MD5 and SHA-2 based crypt(3)
+ *                             hashes, no padding (these hashes permute the
+ *                             digest octets, which the caller must do)
+ *          IMAPAlphabet()   - "A-Za-z0-9+," as used by IMAP (RFC 3501),
+ *                             no padding
+ *          TolerantAlphabet() - Encodes as the standard alphabet, but
+ *                             decodes both standard and base64url text
+ *                             (including a mix of the two)
+ */
+const Alphabet &StandardAlphabet();
+const Alphabet &URLAlphabet();
+const Alphabet &BcryptAlphabet();
+const Alphabet &CryptAlphabet();
+const Alphabet &IMAPAlphabet();
+const Alphabet &TolerantAlphabet();
+
+/*
+ *  RangeDecoder
+ *
+ *  Description:
+ *      This class decodes arbitrary ranges of octets from a large Base64
+ *      string without decoding from the start.  On construction, the input
+ *      is scanned once to build an index: if the input is wrapped into
+ *      lines of a fixed length with a consistent line terminator (e.g., PEM
+ *      or MIME), the location of any octet is computed directly; otherwise,
+ *      the location of every Nth quantum is recorded as a checkpoint and
+ *      the decoder seeks to the nearest checkpoint.
+ *
+ *  Comments:
+ *      The input string is not copied, so it must remain valid and unchanged
+ *      for the lifetime of the object.  Characters outside of the alphabet
+ *      are skipped and decoding ceases at the first padding character, as
+ *      with Decode().
+ */
+class RangeDecoder
+{
+    public:
+        // Default checkpoint interval in decoded octets
+        static constexpr std::size_t Default_Checkpoint_Interval = 4096;
+
+        /*
+         *  RangeDecoder
+         *
+         *  Description:
+         *      Scan the input once to determine its decoded length and to
+         *      build the index used to locate octets.
+         *
+         *  Parameters:
+         *      input [in]
+         *          Base64-encoded string from which ranges will be decoded.
+         *          This must remain valid and unchanged for the lifetime of
+         *          this object.
+         *
+         *      alphabet [in]
+         *          The alphabet the input string was encoded with.  This must
+         *          also outlive this object.
+         *
+         *      checkpoint_interval [in]
+         *          Approximate number of decoded octets between checkpoints,
+         *          used only if the input does not have a fixed layout.  It
+         *          is rounded down to a whole number of 3-octet quanta, with
+         *          a minimum of one quantum.  Smaller values make seeking
+         *          faster at the expense of memory.
+         *
+         *  Returns:
+         *      Nothing.
+         *
+         *  Comments:
+         *      Any input is accepted.  The decoded length is the number of
+         *      octets Decode() would produce for the whole input: characters
+         *      outside of the alphabet are skipped, and everything from the
+         *      first padding character onward is ignored.
+         *
+         *      Recording checkpoints allocates memory, so this may throw
+         *      std::bad_alloc; an input with a fixed layout needs none.
+         */
+        explicit RangeDecoder(
+                const std::string_view input,
+                const Alphabet &alphabet = StandardAlphabet(),
+                std::size_t checkpoint_interval = Default_Checkpoint_Interval);
+        ~RangeDecoder() = default;
+
+        // Total number of octets the input decodes to
+        std::size_t DecodedLength() const noexcept { return decoded_length; }
+
+        // True if octet locations are computed rather than indexed
+        bool FixedLayout() const noexcept { return fixed_layout; }
+
+        /*
+         *  Decode
+         *
+         *  Description:
+         *      Decode the octets starting at the given offset into the given
+         *      output buffer.
+         *
+         *  Parameters:
+         *      offset [in]
+         *          Offset of the first octet to decode.  This must not be
+         *          greater than DecodedLength(); a greater offset yields
+         *          std::nullopt.
+         *
+         *      output [out]
+         *          Buffer into which the decoded octets are written.  Its
+         *          size is the number of octets requested.
+         *
+         *  Returns:
+         *      The number of octets written to the output buffer, or
+         *      std::nullopt if the offset is greater than DecodedLength().
+         *
+         *  Comments:
+         *      A range that extends beyond DecodedLength() is truncated: the
+         *      return value is then DecodedLength() - offset, and the rest of
+         *      the output buffer is left unchanged.  An offset equal to
+         *      DecodedLength() or an empty buffer yields zero.  Nothing is
+         *      written if the offset is out of range.
+         *
+         *      This function does not allocate memory.
+         */
+        std::optional<std::size_t> Decode(std::size_t offset,
+                                          std::span<std::uint8_t> output) const;
+
+        /*
+         *  Decode
+         *
+         *  Description:
+         *      Decode the given number of octets starting at the given
+         *      offset.
+         *
+         *  Parameters:
+         *      offset [in]
+         *          Offset of the first octet to decode.  This must not be
+         *          greater than DecodedLength(); a greater offset yields an
+         *          empty vector.
+         *
+         *      length [in]
+         *          Number of octets to decode.
+         *
+         *  Returns:
+         *      The decoded octets.  The vector holds fewer than the requested
+         *      number of octets if the range extends beyond DecodedLength(),
+         *      and is empty if the offset is greater than DecodedLength().
+         *
+         *  Comments:
+         *      An out-of-range offset is not distinguished from an empty
+         *      range; use the overload taking an output buffer where that
+         *      matters.  The vector is sized to the octets available, so a
+         *      large length does not cause a large allocation.
+         */
+        std::vector<std::uint8_t> Decode(std::size_t offset,
+                                         std::size_t length) const;
+
+    protected:
+        std::size_t Locate(std::size_t quantum) const;
+
+        std::string_view input;
+        const Alphabet &alphabet;
+        std::size_t decoded_length;
+        bool fixed_layout;
+        std::size_t line_length;
+        std::size_t terminator_length;
+        std::size_t checkpoint_quanta;
+        std::vector<std::size_t> checkpoints;
+};
+
 /*
  *  Encode
  *
@@ -88,4 +386,496 @@ std::string Encode(const std::span<const std::uint8_t> input);
  */
 std::vector<std::uint8_t> Decode(const std::string_view input);
 
+/*
+ *  MaxEncodedLength
+ *
+ *  Description:
+ *      This function returns the number of characters required to hold the
+ *      Base64 encoding of the given number of octets, including padding.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The number of octets to be encoded.
+ *
+ *  Returns:
+ *      The number of characters required for the encoded string.
+ *
+ *  Comments:
+ *      The encoded length will be shorter if an alphabet that does not
+ *      use padding is used.
+ */
+std::size_t MaxEncodedLength(std::size_t length);
+
+/*
+ *  MaxDecodedLength
+ *
+ *  Description:
+ *      This function returns the maximum number of octets that may result
+ *      from decoding a Base64-encoded string of the given length.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The length of the Base64-encoded string.
+ *
+ *  Returns:
+ *      The maximum number of octets the string could decode into.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MaxDecodedLength(std::size_t length);
+
+/*
+ *  IsValid
+ *
+ *  Description:
+ *      This function will determine whether the given string is properly
+ *      Base64-encoded without decoding it.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be validated.
+ *
+ *      mode [in]
+ *          The rules to apply:
+ *          Strict  - The input consists only of alphabet characters and
+ *                    padding, padding appears only at the end and only as
+ *                    required to complete the final quantum (for alphabets
+ *                    that call for padding; otherwise, it must be absent),
+ *                    the length is valid, and unused trailing bits are
+ *                    zero.
+ *          Lenient - The input is accepted exactly as Decode() accepts it:
+ *                    characters outside of the alphabet are skipped and
+ *                    decoding ceases at the first padding character, so
+ *                    every input is valid.
+ *          Forgiving - The WHATWG forgiving-base64 rules used by atob()
+ *                      and data: URLs: ASCII whitespace is ignored, any
+ *                      other character outside the alphabet is an error,
+ *                      padding is optional but, if present, must complete
+ *                      the final quantum, a single residual character is a
+ *                      length error, and unused trailing bits may be
+ *                      non-zero.
+ *
+ *      alphabet [in]
+ *          The alphabet the input is expected to use.  If not given, the
+ *          standard alphabet is used.
+ *
+ *  Returns:
+ *      The exact number of octets the string decodes into, or std::nullopt
+ *      if the string is not valid under the given rules.
+ *
+ *  Comments:
+ *      This function neither allocates memory nor writes any output.
+ *      Whether padding is expected in Strict mode depends on the alphabet,
+ *      and a valid string may be decoded into a buffer of exactly the
+ *      returned size using the same alphabet.
+ */
+std::optional<std::size_t> IsValid(const std::string_view input,
+                                   Mode mode = Mode::Strict);
+std::optional<std::size_t> IsValid(const std::string_view input,
+                                   Mode mode,
+                                   const Alphabet &alphabet);
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base64,
+ *      writing the encoded characters into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base64.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.  A buffer
+ *          of MaxEncodedLength(input.size()) characters is always sufficient.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      This function does not allocate memory.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output);
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base64-encoded string, writing the
+ *      decoded octets into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.  A buffer of
+ *          MaxDecodedLength(input.size()) octets is always sufficient.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      The input is interpreted exactly as it is by the Decode() function
+ *      that returns a vector.  This function does not allocate memory.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output);
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base64,
+ *      writing the encoded characters into the given output buffer and
+ *      dividing large inputs into chunks that are encoded in parallel
+ *      using the given executor.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base64.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.  A buffer
+ *          of MaxEncodedLength(input.size()) characters is always sufficient.
+ *
+ *      executor [in]
+ *          The executor on which to run the chunks (e.g., an adapter to the
+ *          application's thread pool or Bases::DefaultExecutor()).
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      The output is identical to that of the serial Encode() function.
+ *      Inputs smaller than a few chunks are encoded on the calling thread.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output,
+                   Bases::Executor &executor);
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base64-encoded string, writing the
+ *      decoded octets into the given output buffer and dividing large
+ *      inputs into chunks that are decoded in parallel using the given
+ *      executor.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.  A buffer of
+ *          MaxDecodedLength(input.size()) octets is always sufficient.
+ *
+ *      executor [in]
+ *          The executor on which to run the chunks.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      The result is identical to that of the serial Decode() function.
+ *      Chunks can be decoded in parallel only if the characters preceding
+ *      the last chunk are all part of the alphabet (e.g., there are no line
+ *      breaks); other inputs are decoded on the calling thread.  The
+ *      contents of the output buffer beyond the returned length are
+ *      unspecified.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output,
+                                  Bases::Executor &executor);
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given binary string into Base64 using
+ *      the specified alphabet.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Binary string to be encoded as Base64.
+ *
+ *      alphabet [in]
+ *          The alphabet to use for encoding.
+ *
+ *  Returns:
+ *      The Base64-encoded text string.
+ *
+ *  Comments:
+ *      Padding characters are appended only if the alphabet calls for them.
+ */
+std::string Encode(const std::string_view input, const Alphabet &alphabet);
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base64 using
+ *      the specified alphabet.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base64.
+ *
+ *      alphabet [in]
+ *          The alphabet to use for encoding.
+ *
+ *  Returns:
+ *      The Base64-encoded text string.
+ *
+ *  Comments:
+ *      Padding characters are appended only if the alphabet calls for them.
+ */
+std::string Encode(const std::span<const std::uint8_t> input,
+                   const Alphabet &alphabet);
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base64-encoded string using the
+ *      specified alphabet.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      alphabet [in]
+ *          The alphabet the input string was encoded with.
+ *
+ *  Returns:
+ *      The decoded octets, which will be empty if the input string was
+ *      empty or if the input string was not a properly encoded string.
+ *
+ *  Comments:
+ *      Decoding ceases at the first '=' character unless '=' is a member of
+ *      the alphabet.  Any other character that is not part of the alphabet
+ *      is silently ignored.
+ */
+std::vector<std::uint8_t> Decode(const std::string_view input,
+                                 const Alphabet &alphabet);
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base64 using
+ *      the specified alphabet, writing the encoded characters into the given
+ *      output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base64.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.  A buffer
+ *          of MaxEncodedLength(input.size()) characters is always sufficient.
+ *
+ *      alphabet [in]
+ *          The alphabet to use for encoding.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      This function does not allocate memory.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output,
+                   const Alphabet &alphabet);
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base64-encoded string using the
+ *      specified alphabet, writing the decoded octets into the given output
+ *      buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.  A buffer of
+ *          MaxDecodedLength(input.size()) octets is always sufficient.
+ *
+ *      alphabet [in]
+ *          The alphabet the input string was encoded with.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the output buffer was too small.
+ *
+ *  Comments:
+ *      This function does not allocate memory.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output,
+                                  const Alphabet &alphabet);
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base64-encoded string only if it is
+ *      valid under the given rules, writing the decoded octets into the
+ *      given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.  A buffer of
+ *          MaxDecodedLength(input.size()) octets is always sufficient.
+ *
+ *      mode [in]
+ *          The rules the input must satisfy (see IsValid()).
+ *
+ *      alphabet [in]
+ *          The alphabet the input string was encoded with.  If not given,
+ *          the standard alphabet is used.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input is not valid under the given rules or the output buffer
+ *      was too small.
+ *
+ *  Comments:
+ *      With Mode::Forgiving, this implements atob() (btoa() is Encode()
+ *      with the standard alphabet).  Whitespace is skipped while decoding,
+ *      so the input need not be cleaned beforehand.  The contents of the
+ *      output buffer are unspecified if the input is not valid.  This
+ *      function does not allocate memory.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output,
+                                  Mode mode);
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output,
+                                  Mode mode,
+                                  const Alphabet &alphabet);
+
+/*
+ *  Append
+ *
+ *  Description:
+ *      This function will extend a Base64-encoded string with the encoding
+ *      of additional octets, such that the result is identical to encoding
+ *      the original data followed by the new octets.  Only the trailing
+ *      partial quantum of the existing string is re-encoded, so the cost is
+ *      proportional to the number of octets appended.
+ *
+ *  Parameters:
+ *      encoded [in/out]
+ *          Base64-encoded string produced by Encode() (or a prior call to
+ *          Append()) with the same alphabet, which is extended in place.
+ *
+ *      input [in]
+ *          Span of octets to append.
+ *
+ *      alphabet [in]
+ *          The alphabet the encoded string uses.  If not given, the standard
+ *          alphabet is used.
+ *
+ *  Returns:
+ *      True if the string was extended, or false if the end of the encoded
+ *      string is not a properly encoded quantum, in which case the string
+ *      is not modified.
+ *
+ *  Comments:
+ *      The encoded string must not contain line breaks or other characters
+ *      outside of the alphabet, other than trailing padding.
+ */
+bool Append(std::string &encoded, const std::span<const std::uint8_t> input);
+bool Append(std::string &encoded,
+            const std::span<const std::uint8_t> input,
+            const Alphabet &alphabet);
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base64,
+ *      returning a string that uses the given allocator.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base64.
+ *
+ *      allocator [in]
+ *          Allocator for the returned string (e.g., a
+ *          Bases::ScratchAllocator<char> to draw from the scratch pool).
+ *
+ *  Returns:
+ *      The Base64-encoded text string.
+ *
+ *  Comments:
+ *      None.
+ */
+template<Bases::AllocatorOf<char> Allocator>
+std::basic_string<char, std::char_traits<char>, Allocator> Encode(
+                                    const std::span<const std::uint8_t> input,
+                                    const Allocator &allocator)
+{
+    std::basic_string<char, std::char_traits<char>, Allocator> output(
+        MaxEncodedLength(input.size()), '\0', allocator);
+
+    output.resize(Encode(input, std::span<char>(output)));
+
+    return output;
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base64-encoded string, returning a
+ *      vector that uses the given allocator.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      allocator [in]
+ *          Allocator for the returned vector (e.g., a
+ *          Bases::ScratchAllocator<std::uint8_t> to draw from the scratch
+ *          pool).
+ *
+ *  Returns:
+ *      The decoded octets, which will be empty if the input string was
+ *      empty or if the input string was not a properly encoded string.
+ *
+ *  Comments:
+ *      The input is interpreted exactly as it is by the Decode() function
+ *      that returns a std::vector with the default allocator.
+ */
+template<Bases::AllocatorOf<std::uint8_t> Allocator>
+std::vector<std::uint8_t, Allocator> Decode(const std::string_view input,
+                                            const Allocator &allocator)
+{
+    std::vector<std::uint8_t, Allocator> output(
+        MaxDecodedLength(input.size()), allocator);
+
+    output.resize(Decode(input, std::span<std::uint8_t>(output)).value_or(0));
+
+    return output;
+}
+
 } // namespace Terra::Base64
@@ -0,0 +1,133 @@
+/*
+ *  bases_c.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines a C interface to the Base-N encoding and decoding
+ *      functions for use by other programming languages.  All functions
+ *      write into buffers owned by the caller.
+ *
+ *      Each function takes a pointer to the output buffer and a pointer to
+ *      the output length.  On input, the output length is the size of the
+ *      output buffer.  On successful return, the output length is the number
+ *      of characters or octets written.  If the buffer is too small (or
+ *      NULL), BASES_ERROR_BUFFER_TOO_SMALL is returned and the output length
+ *      is set to the size of the buffer required.
+ *
+ *      For decoding, the required size is an upper bound that depends only
+ *      on the input length.  If a decode fails and the buffer provided was
+ *      smaller than that bound, BASES_ERROR_BUFFER_TOO_SMALL is returned
+ *      even if the input was also invalid.
+ *
+ *      No function allows a C++ exception to propagate to the caller.  If
+ *      the library fails internally (e.g., memory needed to tune the
+ *      kernels on first use could not be allocated), BASES_ERROR_INTERNAL
+ *      is returned and the output buffer and length are unspecified; the
+ *      call may be retried.
+ *
+ *  Portability Issues:
+ *      Requires C99 or later.
+ */
+
+#ifndef TERRA_BASES_BASES_C_H
+#define TERRA_BASES_BASES_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(BASES_C_EXPORTS)
+#    define BASES_API __declspec(dllexport)
+#  elif defined(BASES_C_SHARED)
+#    define BASES_API __declspec(dllimport)
+#  else
+#    define BASES_API
+#  endif
+#elif defined(__GNUC__)
+#  define BASES_API __attribute__((visibility("default")))
+#else
+#  define BASES_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Status codes returned by all functions */
+#define BASES_OK                        0
+#define BASES_ERROR_BUFFER_TOO_SMALL    1
+#define BASES_ERROR_INVALID_INPUT       2
+#define BASES_ERROR_INVALID_ARGUMENT    3
+#define BASES_ERROR_INTERNAL            4
+
+/* Base16 (hexadecimal, uppercase) */
+BASES_API int bases_base16_encode(const uint8_t *input,
+                                  size_t input_length,
+                                  char *output,
+                                  size_t *output_length);
+BASES_API int bases_base16_decode(const char *input,
+                                  size_t input_length,
+                                  uint8_t *output,
+                                  size_t *output_length);
+
+/* Base32 (RFC 4648) */
+BASES_API int bases_base32_encode(const uint8_t *input,
+                                  size_t input_length,
+                                  char *output,
+                                  size_t *output_length);
+BASES_API int bases_base32_decode(const char *input,
+                                  size_t input_length,
+                                  uint8_t *output,
+                                  size_t *output_length);
+
+/* Base45 (RFC 9285) */
+BASES_API int bases_base45_encode(const uint8_t *input,
+                                  size_t input_length,
+                                  char *output,
+                                  size_t *output_length);
+BASES_API int bases_base45_decode(const char *input,
+                                  size_t input_length,
+                                  uint8_t *output,
+                                  size_t *output_length);
+
+/* Base58 (Bitcoin alphabet) */
+BASES_API int bases_base58_encode(const uint8_t *input,
+                                  size_t input_length,
+                                  char *output,
+                                  size_t *output_length);
+BASES_API int bases_base58_decode(const char *input,
+                                  size_t input_length,
+                                  uint8_t *output,
+                                  size_t *output_length);
+
+/* Base64 (RFC 4648 Section 4) */
+BASES_API int bases_base64_encode(const uint8_t *input,
+                                  size_t input_length,
+                                  char *output,
+                                  size_t *output_length);
+BASES_API int bases_base64_decode(const char *input,
+                                  size_t input_length,
+                                  uint8_t *output,
+                                  size_t *output_length);
+
+/* base64url (RFC 4648 Section 5, without padding) */
+BASES_API int bases_base64url_encode(const uint8_t *input,
+                                     size_t input_length,
+                                     char *output,
+                                     size_t *output_length);
+BASES_API int bases_base64url_decode(const char *input,
+                                     size_t input_length,
+                                     uint8_t *output,
+                                     size_t *output_length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TERRA_BASES_BASES_C_H */
@@ -0,0 +1,126 @@
+/*
+ *  executor.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the executor interface through which the parallel
+ *      encoders and decoders run their work, along with a work-stealing
+ *      thread pool implementing it for standalone use.
+ *
+ *      An application that already has a scheduler can implement Executor
+ *      in terms of it so that large encoding or decoding jobs share the
+ *      application's threads rather than creating their own.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Terra::Bases
+{
+
+/*
+ *  Executor
+ *
+ *  Description:
+ *      Interface to a facility that runs range tasks in parallel.
+ *
+ *  Comments:
+ *      Execute() is given a count and a task, and must call the task with
+ *      disjoint ranges [begin, end) that together cover [0, count), then
+ *      return once every call has returned.  The ranges may be run on any
+ *      threads, including the calling thread, and in any order.  Everything
+ *      the task does must happen before Execute() returns.
+ *
+ *      Tasks given to Execute() by this library do not throw exceptions and
+ *      do not block on other tasks.
+ */
+class Executor
+{
+    public:
+        using RangeTask = std::function<void(std::size_t, std::size_t)>;
+
+        virtual ~Executor() = default;
+
+        virtual void Execute(std::size_t count, const RangeTask &task) = 0;
+};
+
+/*
+ *  WorkStealingExecutor
+ *
+ *  Description:
+ *      A thread pool implementing Executor.  Each worker thread has its own
+ *      queue of ranges; a worker whose queue is empty takes work from the
+ *      other queues.  The thread calling Execute() also runs ranges until
+ *      all ranges have been taken, then waits for the remainder to finish.
+ *
+ *  Comments:
+ *      Execute() may be called from multiple threads concurrently, and from
+ *      within a task.
+ */
+class WorkStealingExecutor final : public Executor
+{
+    public:
+        explicit WorkStealingExecutor(std::size_t threads);
+        ~WorkStealingExecutor() override;
+
+        // Number of worker threads (in addition to calling threads)
+        std::size_t Threads() const noexcept { return workers.size(); }
+
+        void Execute(std::size_t count, const RangeTask &task) override;
+
+    protected:
+        struct Batch;
+        struct Job;
+        struct Queue;
+
+        bool TakeJob(std::size_t index, Job &job);
+        void RunJob(const Job &job);
+        void Work(std::size_t index);
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::atomic<std::size_t> pending;
+        std::atomic<std::size_t> next_queue;
+        std::mutex mutex;
+        std::condition_variable available;
+        bool stop;
+        std::vector<std::thread> workers;
+};
+
+/*
+ *  DefaultExecutor
+ *
+ *  Description:
+ *      Returns the library's shared WorkStealingExecutor, which is created on
+ *      first use with one worker thread fewer than the number of hardware
+ *      threads (the calling thread being the other).
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A reference to the default executor.
+ *
+ *  Comments:
+ *      Applications that manage their own threads should pass their own
+ *      Executor to the parallel functions instead.
+ */
+Executor &DefaultExecutor();
+
+} // namespace Terra::Bases
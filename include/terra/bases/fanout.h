@@ -0,0 +1,102 @@
+/*
+ *  fanout.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines a function to encode one input into several
+ *      encodings at once (e.g., a digest logged as lowercase hex and stored
+ *      as Base64url and Base32).
+ *
+ *      The input is processed in blocks small enough to remain in the
+ *      processor's cache, and each block is passed to every target's
+ *      encoder in turn, so the input is read from memory once regardless
+ *      of the number of targets.  Every output is written into a buffer
+ *      supplied by the caller.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Terra::Bases
+{
+
+// Encodings that may be produced by EncodeFanOut()
+enum class FanOutEncoding
+{
+    Base16,                                     // Uppercase hexadecimal
+    Base16Lowercase,                            // Lowercase hexadecimal
+    Base32,                                     // RFC 4648 Section 6
+    Base64,                                     // RFC 4648 Section 4
+    Base64URL                                   // RFC 4648 Section 5
+};
+
+// An encoding to produce and the buffer that receives it
+struct FanOutTarget
+{
+    FanOutEncoding encoding;                    // Encoding to produce
+    std::span<char> output;                     // Buffer for the output
+    std::size_t length = 0;                     // Characters written
+};
+
+/*
+ *  MaxEncodedLength
+ *
+ *  Description:
+ *      This function returns the number of characters required to hold the
+ *      given number of octets in the given encoding.
+ *
+ *  Parameters:
+ *      encoding [in]
+ *          The encoding.
+ *
+ *      length [in]
+ *          The number of octets to be encoded.
+ *
+ *  Returns:
+ *      The size of a buffer that is always sufficient for EncodeFanOut().
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MaxEncodedLength(FanOutEncoding encoding, std::size_t length);
+
+/*
+ *  EncodeFanOut
+ *
+ *  Description:
+ *      This function will encode the given span of octets into each of the
+ *      given targets, reading the input once.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded.
+ *
+ *      targets [in/out]
+ *          The encodings to produce.  On success, each target's length is
+ *          set to the number of characters written to its output buffer.
+ *
+ *  Returns:
+ *      True if every target was encoded, or false if any target's output
+ *      buffer is smaller than MaxEncodedLength(), in which case nothing is
+ *      written and every length is set to zero.
+ *
+ *  Comments:
+ *      Each output is identical to that of the corresponding encoder (with
+ *      URLAlphabet() for Base64URL).  This function does not allocate memory.
+ */
+bool EncodeFanOut(const std::span<const std::uint8_t> input,
+                  std::span<FanOutTarget> targets);
+
+} // namespace Terra::Bases
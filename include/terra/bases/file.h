@@ -0,0 +1,134 @@
+/*
+ *  file.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines functions to encode or decode an entire file into
+ *      another file using Base16, Base32, or Base64.
+ *
+ *      The input is read in large aligned blocks with several reads and
+ *      writes in flight at once, and each block is passed to the codec's
+ *      kernels as its read completes.  On Linux, the requests are issued
+ *      through io_uring with registered buffers; elsewhere, or if io_uring
+ *      is not available, pread() and pwrite() are used.
+ *
+ *  Portability Issues:
+ *      Available only on POSIX systems.  Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace Terra::Bases
+{
+
+// Encodings supported by EncodeFile() and DecodeFile()
+enum class FileEncoding
+{
+    Base16,
+    Base32,
+    Base64
+};
+
+// Options controlling how files are read and written
+struct FileOptions
+{
+    // Approximate number of octets read per request, which is rounded to
+    // a multiple of the alignment required for direct I/O and limited to
+    // 1 GiB and to the size of the input
+    std::size_t block_size = 1024 * 1024;
+
+    // Number of blocks in flight at once
+    std::size_t queue_depth = 4;
+
+    // Read the input with O_DIRECT, bypassing the page cache, if the file
+    // system supports it
+    bool direct = false;
+
+    // Use io_uring if available (otherwise, pread() and pwrite())
+    bool io_uring = true;
+};
+
+/*
+ *  EncodeFile
+ *
+ *  Description:
+ *      This function will encode the contents of the input file, writing the
+ *      encoded text to the output file.
+ *
+ *  Parameters:
+ *      input_path [in]
+ *          The file to encode.
+ *
+ *      output_path [in]
+ *          The file to which the encoded text is written.  It is created if
+ *          it does not exist and truncated if it does.
+ *
+ *      encoding [in]
+ *          The encoding to use.
+ *
+ *      options [in]
+ *          Options controlling how the files are read and written.
+ *
+ *  Returns:
+ *      The number of characters written, or std::nullopt if a file could
+ *      not be opened, read, or written.
+ *
+ *  Comments:
+ *      The output is identical to that of the codec's Encode() function
+ *      applied to the whole file.  If an error occurs, the output file may
+ *      be partially written.
+ */
+std::optional<std::uint64_t> EncodeFile(const std::string &input_path,
+                                        const std::string &output_path,
+                                        FileEncoding encoding,
+                                        const FileOptions &options = {});
+
+/*
+ *  DecodeFile
+ *
+ *  Description:
+ *      This function will decode the contents of the input file, writing the
+ *      decoded octets to the output file.
+ *
+ *  Parameters:
+ *      input_path [in]
+ *          The file to decode.
+ *
+ *      output_path [in]
+ *          The file to which the decoded octets are written.  It is created
+ *          if it does not exist and truncated if it does.
+ *
+ *      encoding [in]
+ *          The encoding of the input file.
+ *
+ *      options [in]
+ *          Options controlling how the files are read and written.
+ *
+ *  Returns:
+ *      The number of octets written, or std::nullopt if a file could not be
+ *      opened, read, or written, or if the input was not properly encoded.
+ *
+ *  Comments:
+ *      The input is interpreted exactly as it is by the codec's Decode()
+ *      function applied to the whole file, so characters outside of the
+ *      alphabet (e.g., line breaks) are skipped and decoding ceases at the
+ *      first padding character.  If an error occurs, the output file may be
+ *      partially written.
+ */
+std::optional<std::uint64_t> DecodeFile(const std::string &input_path,
+                                        const std::string &output_path,
+                                        FileEncoding encoding,
+                                        const FileOptions &options = {});
+
+} // namespace Terra::Bases
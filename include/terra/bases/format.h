@@ -0,0 +1,326 @@
+/*
+ *  format.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines wrappers that format octets (e.g., digests or
+ *      identifiers) as Base16, Base32, or Base64 directly into an output
+ *      iterator or stream without first encoding them into a temporary
+ *      string:
+ *
+ *          log << "digest=" << Bases::AsHex(digest);
+ *
+ *      FormatTo() writes to any output iterator using options parsed by
+ *      ParseFormatSpec().  The format specification is
+ *      [[fill]align][width][s<sep>][type], where fill and align ('<', '>',
+ *      or '^') and width are as for strings, and only hexadecimal accepts a
+ *      separator character placed between octets (e.g., "s:") and a type of
+ *      'X' (uppercase, the default) or 'x' (lowercase).  Octets are encoded
+ *      a block at a time into a buffer on the stack and copied to the
+ *      output, so no memory is allocated.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <terra/bases/fanout.h>
+
+namespace Terra::Bases
+{
+
+// Formatting options parsed from a format specification
+struct FormatSpec
+{
+    char fill = ' ';                            // Character used to pad
+    char align = '<';                           // '<', '>', or '^'
+    std::size_t width = 0;                      // Minimum width
+    char separator = '\0';                      // Between octets if not '\0'
+    bool lowercase = false;                     // Lowercase hexadecimal
+};
+
+// Octets to be formatted in the given encoding
+template<FanOutEncoding Encoding>
+struct EncodedOctets
+{
+    std::span<const std::uint8_t> octets;
+};
+
+// Functions that wrap octets for formatting
+constexpr EncodedOctets<FanOutEncoding::Base16> AsHex(
+                                    const std::span<const std::uint8_t> octets)
+{
+    return {octets};
+}
+
+constexpr EncodedOctets<FanOutEncoding::Base32> AsBase32(
+                                    const std::span<const std::uint8_t> octets)
+{
+    return {octets};
+}
+
+constexpr EncodedOctets<FanOutEncoding::Base64> AsBase64(
+                                    const std::span<const std::uint8_t> octets)
+{
+    return {octets};
+}
+
+constexpr EncodedOctets<FanOutEncoding::Base64URL> AsBase64URL(
+                                    const std::span<const std::uint8_t> octets)
+{
+    return {octets};
+}
+
+// Octets encoded per call to FormatBlock(): a whole number of Base32 and
+// Base64 quanta, so only the final block produces padding
+constexpr std::size_t Format_Block_Octets = 15 * 16;
+
+// Characters required for the largest block (hexadecimal with separators)
+constexpr std::size_t Format_Block_Characters = Format_Block_Octets * 3;
+
+/*
+ *  ParseFormatSpec
+ *
+ *  Description:
+ *      Parse a format specification for the given encoding.
+ *
+ *  Parameters:
+ *      spec [in]
+ *          The format specification, which ends at the end of the string or
+ *          at the first '}'.
+ *
+ *      encoding [in]
+ *          The encoding to be formatted.
+ *
+ *      parsed [out]
+ *          The parsed formatting options.
+ *
+ *  Returns:
+ *      The number of characters parsed (i.e., the position of the closing
+ *      '}', if present), or std::string_view::npos if the specification is
+ *      invalid for the encoding.
+ *
+ *  Comments:
+ *      This is constexpr so that constant specifications may be parsed at
+ *      compile time.
+ */
+constexpr std::size_t ParseFormatSpec(const std::string_view spec,
+                                      FanOutEncoding encoding,
+                                      FormatSpec &parsed)
+{
+    auto is_align = [](char c)
+    {
+        return (c == '<') || (c == '>') || (c == '^');
+    };
+    bool hex = (encoding == FanOutEncoding::Base16) ||
+               (encoding == FanOutEncoding::Base16Lowercase);
+    std::size_t i = 0;
+
+    parsed = FormatSpec{};
+    parsed.lowercase = (encoding == FanOutEncoding::Base16Lowercase);
+
+    // Fill and alignment
+    if ((spec.size() >= 2) && is_align(spec[1]) && (spec[0] != '{') &&
+        (spec[0] != '}'))
+    {
+        parsed.fill = spec[0];
+        parsed.align = spec[1];
+        i = 2;
+    }
+    else if ((spec.size() >= 1) && is_align(spec[0]))
+    {
+        parsed.align = spec[0];
+        i = 1;
+    }
+
+    // Width
+    while ((i < spec.size()) && (spec[i] >= '0') && (spec[i] <= '9'))
+    {
+        parsed.width = parsed.width * 10 + (spec[i++] - '0');
+    }
+
+    // Separator
+    if (hex && (i < spec.size()) && (spec[i] == 's'))
+    {
+        if ((i + 1 >= spec.size()) || (spec[i + 1] == '{') ||
+            (spec[i + 1] == '}'))
+        {
+            return std::string_view::npos;
+        }
+        parsed.separator = spec[i + 1];
+        i += 2;
+    }
+
+    // Letter case
+    if (hex && (i < spec.size()) && ((spec[i] == 'x') || (spec[i] == 'X')))
+    {
+        parsed.lowercase = (spec[i++] == 'x');
+    }
+
+    if ((i < spec.size()) && (spec[i] != '}')) return std::string_view::npos;
+
+    return i;
+}
+
+/*
+ *  FormattedLength
+ *
+ *  Description:
+ *      Return the number of characters produced by formatting the given
+ *      number of octets, excluding fill characters.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The number of octets.
+ *
+ *      encoding [in]
+ *          The encoding.
+ *
+ *      spec [in]
+ *          The formatting options.
+ *
+ *  Returns:
+ *      The number of characters.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t FormattedLength(std::size_t length,
+                            FanOutEncoding encoding,
+                            const FormatSpec &spec);
+
+/*
+ *  FormatBlock
+ *
+ *  Description:
+ *      Encode one block of octets for formatting.
+ *
+ *  Parameters:
+ *      octets [in]
+ *          All of the octets being formatted.
+ *
+ *      offset [in]
+ *          Offset of the block to encode, which is a multiple of
+ *          Format_Block_Octets.
+ *
+ *      encoding [in]
+ *          The encoding.
+ *
+ *      spec [in]
+ *          The formatting options.
+ *
+ *      output [out]
+ *          Buffer into which the block's characters are written.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer.
+ *
+ *  Comments:
+ *      At most Format_Block_Octets octets are encoded.  A separator is
+ *      written before the first octet of every block other than the first.
+ */
+std::size_t FormatBlock(const std::span<const std::uint8_t> octets,
+                        std::size_t offset,
+                        FanOutEncoding encoding,
+                        const FormatSpec &spec,
+                        std::span<char, Format_Block_Characters> output);
+
+/*
+ *  FormatTo
+ *
+ *  Description:
+ *      Format octets in the given encoding into an output iterator.
+ *
+ *  Parameters:
+ *      out [in]
+ *          The output iterator.
+ *
+ *      octets [in]
+ *          The octets to format.
+ *
+ *      encoding [in]
+ *          The encoding.
+ *
+ *      spec [in]
+ *          The formatting options.
+ *
+ *  Returns:
+ *      The output iterator, advanced past the characters written.
+ *
+ *  Comments:
+ *      No memory is allocated.
+ */
+template<typename OutputIterator>
+OutputIterator FormatTo(OutputIterator out,
+                        const std::span<const std::uint8_t> octets,
+                        FanOutEncoding encoding,
+                        const FormatSpec &spec)
+{
+    std::size_t length = FormattedLength(octets.size(), encoding, spec);
+    std::size_t padding = (spec.width > length) ? spec.width - length : 0;
+    std::size_t before = (spec.align == '>') ? padding :
+                         (spec.align == '^') ? padding / 2 : 0;
+    std::array<char, Format_Block_Characters> buffer;
+
+    out = std::fill_n(out, before, spec.fill);
+
+    for (std::size_t offset = 0; offset < octets.size();
+         offset += Format_Block_Octets)
+    {
+        out = std::copy_n(
+            buffer.data(),
+            FormatBlock(octets, offset, encoding, spec, buffer),
+            out);
+    }
+
+    return std::fill_n(out, padding - before, spec.fill);
+}
+
+/*
+ *  operator<<
+ *
+ *  Description:
+ *      Write octets to a stream in the given encoding using the default
+ *      formatting options.
+ *
+ *  Parameters:
+ *      stream [in]
+ *          The output stream.
+ *
+ *      value [in]
+ *          The octets to write.
+ *
+ *  Returns:
+ *      The output stream.
+ *
+ *  Comments:
+ *      None.
+ */
+template<FanOutEncoding Encoding>
+std::ostream &operator<<(std::ostream &stream,
+                         const EncodedOctets<Encoding> &value)
+{
+    FormatTo(std::ostreambuf_iterator<char>(stream),
+             value.octets,
+             Encoding,
+             FormatSpec{});
+
+    return stream;
+}
+
+} // namespace Terra::Bases
@@ -0,0 +1,109 @@
+/*
+ *  normalize.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines functions to convert Base16, Base32, or Base64
+ *      text into the canonical form of an encoding without decoding it, so
+ *      that encoded identifiers that arrive in different forms (e.g.,
+ *      mixed-case hexadecimal, lowercase or unpadded Base32, or Base64 with
+ *      either alphabet, missing padding, or line breaks) may be compared or
+ *      hashed directly.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <terra/bases/fanout.h>
+
+namespace Terra::Bases
+{
+
+// Additional characters that normalizing may require beyond the length of
+// the input (i.e., the most padding that may be added)
+constexpr std::size_t Max_Normalize_Growth = 6;
+
+/*
+ *  Normalize
+ *
+ *  Description:
+ *      This function will convert encoded text into the canonical form of
+ *      the target encoding, writing it into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Encoded text to normalize.
+ *
+ *      target [in]
+ *          The form to produce.  The input may use any form of the same
+ *          encoding:
+ *          Base16 and Base16Lowercase - hexadecimal digits of either case
+ *          Base32 - the RFC 4648 alphabet in either case, with or without
+ *                   padding
+ *          Base64 and Base64URL - the standard or base64url alphabet, or a
+ *                   mix of the two, with or without padding
+ *
+ *      output [out]
+ *          Buffer into which the normalized text is written, which may be
+ *          the input's own storage to normalize in place.  A buffer of
+ *          input.size() + Max_Normalize_Growth characters is always
+ *          sufficient.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, or
+ *      std::nullopt if the input is not valid or the output buffer was too
+ *      small, in which case the contents of the output buffer are
+ *      unspecified.
+ *
+ *  Comments:
+ *      Whitespace is removed, letter case and the characters for Base64
+ *      values 62 and 63 are translated, padding is added or removed as the
+ *      target requires, and unused trailing bits are set to zero, so the
+ *      result is identical to decoding the input and encoding the octets
+ *      in the target form.  Characters outside the encoding, padding other
+ *      than at the end, and impossible lengths are errors.  The input is
+ *      read once, a block at a time, and no memory is allocated.
+ */
+std::optional<std::size_t> Normalize(const std::string_view input,
+                                     FanOutEncoding target,
+                                     std::span<char> output);
+
+/*
+ *  Normalize
+ *
+ *  Description:
+ *      This function will convert encoded text into the canonical form of
+ *      the target encoding in place.
+ *
+ *  Parameters:
+ *      text [in/out]
+ *          Encoded text to normalize, which is replaced by the normalized
+ *          text on success.
+ *
+ *      target [in]
+ *          The form to produce (see above).
+ *
+ *  Returns:
+ *      True if the text was normalized, or false if it is not valid, in
+ *      which case its contents are unspecified.
+ *
+ *  Comments:
+ *      Memory is allocated only if padding must be added beyond the
+ *      string's capacity.
+ */
+bool Normalize(std::string &text, FanOutEncoding target);
+
+} // namespace Terra::Bases
@@ -0,0 +1,147 @@
+/*
+ *  scratch.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the scratch buffer pool used for temporary buffers
+ *      and, optionally, for the containers returned by the encoders and
+ *      decoders.  Each thread keeps a small cache of recently released
+ *      buffers in a number of size classes so that, once warmed up, calls
+ *      that repeatedly need buffers of similar size do not call the global
+ *      allocator.
+ *
+ *      Buffers may be released by any thread.  A buffer released by a
+ *      thread other than the one that acquired it is returned to the owning
+ *      thread's cache through a lock-free list and is reused by the owning
+ *      thread on its next acquisition.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace Terra::Bases
+{
+
+/*
+ *  AcquireScratch
+ *
+ *  Description:
+ *      Acquire a buffer of at least the given size from the calling thread's
+ *      scratch buffer cache, allocating one if the cache has none.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The number of octets required.
+ *
+ *  Returns:
+ *      A pointer to the buffer, which is suitably aligned for any object of
+ *      fundamental alignment.
+ *
+ *  Comments:
+ *      This will throw std::bad_alloc if memory cannot be allocated.  Buffers
+ *      larger than the largest size class are not cached.
+ */
+void *AcquireScratch(std::size_t size);
+
+/*
+ *  ReleaseScratch
+ *
+ *  Description:
+ *      Release a buffer acquired with AcquireScratch().
+ *
+ *  Parameters:
+ *      buffer [in]
+ *          The buffer to release, which may be nullptr.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The buffer may be released by any thread.  The number of buffers
+ *      cached per thread is bounded; buffers beyond that bound are freed.
+ */
+void ReleaseScratch(void *buffer) noexcept;
+
+/*
+ *  AllocatorOf
+ *
+ *  Description:
+ *      Concept satisfied by allocator types that allocate objects of type T,
+ *      used to select the encoder and decoder overloads that return
+ *      containers using a caller-specified allocator.
+ */
+template<typename A, typename T>
+concept AllocatorOf = requires(A allocator, T *p, std::size_t n)
+{
+    requires std::same_as<typename A::value_type, T>;
+    { allocator.allocate(n) } -> std::same_as<T *>;
+    allocator.deallocate(p, n);
+};
+
+/*
+ *  ScratchAllocator
+ *
+ *  Description:
+ *      Standard allocator that obtains memory from the scratch buffer pool.
+ *      Containers using this allocator may be moved between threads and
+ *      destroyed on any thread.
+ *
+ *  Comments:
+ *      All instances are interchangeable, as the pool is managed by the
+ *      library.
+ */
+template<typename T>
+class ScratchAllocator
+{
+    static_assert(alignof(T) <= alignof(std::max_align_t));
+
+    public:
+        using value_type = T;
+
+        ScratchAllocator() noexcept = default;
+        template<typename U>
+        ScratchAllocator(const ScratchAllocator<U> &) noexcept
+        {
+        }
+
+        T *allocate(std::size_t n)
+        {
+            if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T *>(AcquireScratch(n * sizeof(T)));
+        }
+
+        void deallocate(T *p, std::size_t) noexcept { ReleaseScratch(p); }
+
+        template<typename U>
+        bool operator==(const ScratchAllocator<U> &) const noexcept
+        {
+            return true;
+        }
+};
+
+// Containers drawing their storage from the scratch buffer pool
+using ScratchString =
+    std::basic_string<char, std::char_traits<char>, ScratchAllocator<char>>;
+using ScratchOctets =
+    std::vector<std::uint8_t, ScratchAllocator<std::uint8_t>>;
+
+} // namespace Terra::Bases
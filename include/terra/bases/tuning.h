@@ -0,0 +1,109 @@
+/*
+ *  tuning.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines functions that select, for each codec operation and
+ *      input size class, the fastest of the available implementations
+ *      ("kernels") on the running processor.  Selection may be performed by
+ *      measurement (Tune()) or by importing a configuration previously
+ *      exported from an identical machine.
+ *
+ *      Without tuning, reasonable defaults are used.  If the library is
+ *      built with bases_AUTOTUNE enabled, tuning is performed automatically
+ *      on first use, unless the environment variable BASES_TUNING holds a
+ *      valid configuration, in which case that configuration is imported.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace Terra::Bases
+{
+
+/*
+ *  Tune
+ *
+ *  Description:
+ *      Measure each eligible kernel for each codec operation and size class
+ *      and use the fastest.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The resulting configuration, as would be returned by ExportTuning().
+ *
+ *  Comments:
+ *      This takes a few milliseconds per kernel.  It is safe to call while
+ *      other threads are using the library.
+ */
+std::string Tune();
+
+/*
+ *  ExportTuning
+ *
+ *  Description:
+ *      Return the kernel selections currently in use.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A short configuration string that may be passed to ImportTuning().
+ *
+ *  Comments:
+ *      None.
+ */
+std::string ExportTuning();
+
+/*
+ *  ImportTuning
+ *
+ *  Description:
+ *      Use the kernel selections in the given configuration.
+ *
+ *  Parameters:
+ *      configuration [in]
+ *          Configuration previously returned by Tune() or ExportTuning().
+ *
+ *  Returns:
+ *      True if the configuration was applied, false if it was malformed or
+ *      names a kernel that is not available in this build or on this
+ *      processor, in which case no selections are changed.
+ *
+ *  Comments:
+ *      Operations absent from the configuration retain their current
+ *      selections.
+ */
+bool ImportTuning(std::string_view configuration);
+
+/*
+ *  ResetTuning
+ *
+ *  Description:
+ *      Restore the default kernel selections.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void ResetTuning();
+
+} // namespace Terra::Bases
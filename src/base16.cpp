@@ -16,9 +16,18 @@
  *      Requires C++20 or later.
  */
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstring>
 #include <climits>
+#include <string>
+#include <vector>
 #include <terra/bases/base16.h>
+#include "parallel.h"
+#include "simd.h"
+#include "tuning.h"
+#include "validate.h"
 
 namespace Terra::Base16
 {
@@ -26,16 +35,17 @@ namespace Terra::Base16
 namespace
 {
 
+// Define an value to represent an invalid Base16 character
+constexpr std::uint8_t InvalidBase16Character = 255;
+
+#ifndef BASES_COMPACT
 // Define the table used for converting to Base16
-const char Base16Table[16] =
+constexpr char Base16Table[16] =
 {
     '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C',
     'D', 'E', 'F'
 };
 
-// Define an value to represent an invalid Base16 character
-constexpr std::uint8_t InvalidBase16Character = 255;
-
 // Use the C pre-processor to define a macro that will tell us the integer
 // value for any given Base16 character
 #define B16ToInt(x) ( \
@@ -103,108 +113,232 @@ const std::uint8_t Base16ReverseTable[256] =
     B16ToInt(255)
 };
 
-} // namespace
+// Define a table giving the two Base16 characters for each octet value
+constexpr auto Base16PairTable = []()
+{
+    std::array<char, 512> table{};
+
+    for (std::size_t i = 0; i < 256; i++)
+    {
+        table[i * 2] = Base16Table[i >> 4];
+        table[i * 2 + 1] = Base16Table[i & 0x0f];
+    }
+
+    return table;
+}();
 
 /*
- *  Encode
+ *  ToCharacter
  *
  *  Description:
- *      This function will encode the given binary string into base16.
+ *      Return the Base16 character representing the given 4-bit value.
  *
  *  Parameters:
- *      input [in]
- *          Binary string to be encoded as base16.
+ *      value [in]
+ *          The value, which must be less than 16.
  *
  *  Returns:
- *      The base16-encoded text string.
+ *      The Base16 character.
  *
  *  Comments:
  *      None.
  */
-std::string Encode(const std::string_view input)
+char ToCharacter(std::uint8_t value)
 {
-    // This library assumes the width of char is 8 bits
-    static_assert(CHAR_BIT == 8);
+    return Base16Table[value];
+}
 
-    return Encode(std::span<const std::uint8_t>{
-        reinterpret_cast<const uint8_t *>(input.data()),
-        input.size()});
+/*
+ *  ToValue
+ *
+ *  Description:
+ *      Return the 4-bit value represented by the given Base16 character.
+ *
+ *  Parameters:
+ *      c [in]
+ *          The character.
+ *
+ *  Returns:
+ *      The value, or InvalidBase16Character if the character is not in the
+ *      alphabet.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint8_t ToValue(char c)
+{
+    return Base16ReverseTable[static_cast<std::uint8_t>(c)];
+}
+#else
+/*
+ *  ToCharacter
+ *
+ *  Description:
+ *      Return the Base16 character representing the given 4-bit value.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The value, which must be less than 16.
+ *
+ *  Returns:
+ *      The Base16 character.
+ *
+ *  Comments:
+ *      The character is computed rather than looked up in a table.
+ */
+char ToCharacter(std::uint8_t value)
+{
+    return static_cast<char>(value + ((value < 10) ? '0' : 'A' - 10));
 }
 
 /*
- *  Encode
+ *  ToValue
  *
  *  Description:
- *      This function will encode the given span of octets into Base16.
+ *      Return the 4-bit value represented by the given Base16 character.
+ *
+ *  Parameters:
+ *      c [in]
+ *          The character.
+ *
+ *  Returns:
+ *      The value, or InvalidBase16Character if the character is not in the
+ *      alphabet.
+ *
+ *  Comments:
+ *      The value is computed rather than looked up in a table.  Setting bit
+ *      5 maps 'A'-'F' to 'a'-'f' and no other character into that range.
+ */
+std::uint8_t ToValue(char c)
+{
+    unsigned u = static_cast<std::uint8_t>(c);
+
+    if (u - '0' < 10) return static_cast<std::uint8_t>(u - '0');
+
+    u |= 0x20;
+    if (u - 'a' < 6) return static_cast<std::uint8_t>(u - 'a' + 10);
+
+    return InvalidBase16Character;
+}
+#endif
+
+// Kernel function types
+using EncodeKernel = std::size_t (*)(const std::span<const std::uint8_t>,
+                                     char *);
+using DecodeKernel = std::optional<std::size_t> (*)(const std::string_view,
+                                                    std::span<std::uint8_t>);
+
+/*
+ *  EncodeScalar
+ *
+ *  Description:
+ *      This kernel encodes one 4-bit value at a time.
  *
  *  Parameters:
  *      input [in]
  *          Span of octets to be encoded as Base16.
  *
+ *      output [out]
+ *          Buffer into which the encoded characters are written, which must
+ *          be at least MaxEncodedLength(input.size()) characters.
+ *
  *  Returns:
- *      The Base16-encoded text string.
+ *      The number of characters written to the output buffer.
  *
  *  Comments:
  *      None.
  */
-std::string Encode(const std::span<const std::uint8_t> input)
+std::size_t EncodeScalar(const std::span<const std::uint8_t> input,
+                         char *output)
 {
-    std::string output;                         // Output string
-
-    // Just return an empty string if the input is empty
-    if (input.empty()) return {};
-
-    // Estimate the size of the output to avoid repetitive buffer resizing
-    output.reserve(input.size() * 2);
+    // Pointer to the next output character
+    char *p = output;
 
     // Iterate over the input string
     for (const std::uint8_t octet : input)
     {
         // Write out the two hex characters representing this octet
-        output += Base16Table[(octet >> 4) & 0x0f];
-        output += Base16Table[(octet     ) & 0x0f];
+        *p++ = ToCharacter((octet >> 4) & 0x0f);
+        *p++ = ToCharacter((octet     ) & 0x0f);
     }
 
-    return output;
+    return static_cast<std::size_t>(p - output);
 }
 
+#ifndef BASES_COMPACT
 /*
- *  Decode
+ *  EncodeBlock
  *
  *  Description:
- *      This function will decode the base16-encoded string.
+ *      This kernel encodes one octet at a time using a table of character
+ *      pairs.
  *
  *  Parameters:
  *      input [in]
- *          Base16-encoded string that is to be decoded.
+ *          Span of octets to be encoded as Base16.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written, which must
+ *          be at least MaxEncodedLength(input.size()) characters.
  *
  *  Returns:
- *      The decoded octets, which will be empty if the input string was
- *      empty or if the input string was not a properly encoded string.
+ *      The number of characters written to the output buffer.
  *
  *  Comments:
- *      To allow for spacing, control characters, etc., any character that is
- *      not part of the character set is silently ignored.
+ *      This halves the number of table lookups at the cost of a larger
+ *      table.
+ */
+std::size_t EncodeBlock(const std::span<const std::uint8_t> input,
+                        char *output)
+{
+    // Pointer to the next output character
+    char *p = output;
+
+    // Copy the pair of characters for each octet
+    for (const std::uint8_t octet : input)
+    {
+        std::memcpy(p, &Base16PairTable[octet * 2], 2);
+        p += 2;
+    }
+
+    return static_cast<std::size_t>(p - output);
+}
+
+#endif
+
+/*
+ *  DecodeScalar
  *
- *      For decoding purposes, the alphabet is treated case insensitively.
+ *  Description:
+ *      This kernel decodes one character at a time.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base16-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      Characters that are not part of the alphabet are skipped.
  */
-std::vector<std::uint8_t> Decode(const std::string_view input)
+std::optional<std::size_t> DecodeScalar(const std::string_view input,
+                                        std::span<std::uint8_t> output)
 {
-    std::vector<std::uint8_t> output;           // Output octets
     std::uint_fast32_t group = 0;               // Current bit group
     std::uint_fast32_t group_size = 0;          // How many bits in group
-
-    // Just return an empty string if the input is empty
-    if (input.empty()) return {};
-
-    // Estimate the size of the output to avoid repetitive buffer resizing
-    output.reserve(input.size() / 2);
+    std::size_t length = 0;                     // Octets written to output
 
     // Iterate over the input string
     for (const char c : input)
     {
         // Determine if we have a valid Base16 character
-        std::uint8_t octet = Base16ReverseTable[static_cast<std::uint8_t>(c)];
+        std::uint8_t octet = ToValue(c);
 
         // Skip over any invalid character in the input
         if (octet == InvalidBase16Character) continue;
@@ -221,8 +355,11 @@ std::vector<std::uint8_t> Decode(const std::string_view input)
         // Do we have a full octet?
         if (group_size == 8)
         {
-            // Append the octet to the output string
-            output.push_back(group & 0xff);
+            // Ensure there is space in the output buffer
+            if (length == output.size()) return {};
+
+            // Append the octet to the output buffer
+            output[length++] = group & 0xff;
 
             // Reset group data
             group_size = 0;
@@ -232,7 +369,966 @@ std::vector<std::uint8_t> Decode(const std::string_view input)
     // If there is a partial group (i.e., 4 bits remaining), that is an error
     if (group_size > 0) return {};
 
-    return output;
+    return length;
 }
 
-} // namespace Terra::Base16
+#ifndef BASES_COMPACT
+/*
+ *  DecodeBlock
+ *
+ *  Description:
+ *      This kernel decodes two characters at a time until it encounters a
+ *      character outside of the alphabet, at which point the remaining input
+ *      is decoded with DecodeScalar().
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base16-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      Both lookups are validated with a single test, since an invalid
+ *      character maps to a value having the high bits set.
+ */
+std::optional<std::size_t> DecodeBlock(const std::string_view input,
+                                       std::span<std::uint8_t> output)
+{
+    std::size_t i = 0;                          // Input position
+    std::size_t length = 0;                     // Octets written to output
+
+    // Decode pairs of characters while both are in the alphabet
+    while ((input.size() - i >= 2) && (length < output.size()))
+    {
+        std::uint8_t high =
+            Base16ReverseTable[static_cast<std::uint8_t>(input[i])];
+        std::uint8_t low =
+            Base16ReverseTable[static_cast<std::uint8_t>(input[i + 1])];
+
+        if (((high | low) & 0xf0) != 0) break;
+
+        output[length++] = static_cast<std::uint8_t>((high << 4) | low);
+        i += 2;
+    }
+
+    // Decode anything remaining one character at a time
+    auto remaining = DecodeScalar(input.substr(i), output.subspan(length));
+    if (!remaining) return {};
+
+    return length + *remaining;
+}
+
+// Constants for operating on each octet of a 64-bit word
+constexpr std::uint64_t Octet_Ones = 0x0101010101010101;
+constexpr std::uint64_t Octet_High_Bits = 0x8080808080808080;
+
+/*
+ *  LoadWord
+ *
+ *  Description:
+ *      Load an unsigned integer from memory that may not be aligned, such
+ *      that the octet at the lowest address is least significant.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to the octets to load.
+ *
+ *  Returns:
+ *      The integer value.
+ *
+ *  Comments:
+ *      Compilers reduce this to a single load on little-endian machines.
+ */
+template<typename T>
+T LoadWord(const void *p)
+{
+    const auto *octets = static_cast<const std::uint8_t *>(p);
+    T word = 0;
+
+    for (std::size_t i = 0; i < sizeof(T); i++)
+    {
+        word |= static_cast<T>(octets[i]) << (i * 8);
+    }
+
+    return word;
+}
+
+/*
+ *  StoreWord
+ *
+ *  Description:
+ *      Store an unsigned integer to memory that may not be aligned, such
+ *      that the least significant octet is written to the lowest address.
+ *
+ *  Parameters:
+ *      p [out]
+ *          Pointer to the memory to write.
+ *
+ *      word [in]
+ *          The integer value.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Compilers reduce this to a single store on little-endian machines.
+ */
+template<typename T>
+void StoreWord(void *p, T word)
+{
+    auto *octets = static_cast<std::uint8_t *>(p);
+
+    for (std::size_t i = 0; i < sizeof(T); i++)
+    {
+        octets[i] = static_cast<std::uint8_t>(word >> (i * 8));
+    }
+}
+
+/*
+ *  EncodeWord
+ *
+ *  Description:
+ *      Encode four octets as eight Base16 characters within a 64-bit word.
+ *
+ *  Parameters:
+ *      octets [in]
+ *          The octets to encode, the first being least significant.
+ *
+ *  Returns:
+ *      The characters, the first being least significant.
+ *
+ *  Comments:
+ *      The octets are spread so each occupies 16 bits, then each is split
+ *      into two 4-bit values, and each value is converted to a character by
+ *      adding '0', plus 7 more for values of 10 or greater so that 'A'
+ *      follows '9'.  No carry crosses from one octet into the next.
+ */
+std::uint64_t EncodeWord(std::uint32_t octets)
+{
+    std::uint64_t x = octets;
+
+    // Move each octet into the low half of its own 16-bit lane
+    x = (x | (x << 16)) & 0x0000ffff0000ffff;
+    x = (x | (x <<  8)) & 0x00ff00ff00ff00ff;
+
+    // Place the high 4 bits before the low 4 bits of each octet
+    std::uint64_t values = ((x >> 4) & 0x000f000f000f000f) |
+                           ((x & 0x000f000f000f000f) << 8);
+
+    // Convert each 4-bit value to its character
+    std::uint64_t letters = ((values + 6 * Octet_Ones) >> 4) & Octet_Ones;
+
+    return values + '0' * Octet_Ones + letters * 7;
+}
+
+/*
+ *  InRange
+ *
+ *  Description:
+ *      Determine which octets of a 64-bit word fall within a range.
+ *
+ *  Parameters:
+ *      x [in]
+ *          The word, none of whose octets may have the high bit set.
+ *
+ *      low [in]
+ *          The lowest value in the range.
+ *
+ *      high [in]
+ *          The highest value in the range.
+ *
+ *  Returns:
+ *      A word having the high bit of each octet set if the corresponding
+ *      octet in x is within the range.
+ *
+ *  Comments:
+ *      None.
+ */
+constexpr std::uint64_t InRange(std::uint64_t x,
+                                std::uint8_t low,
+                                std::uint8_t high)
+{
+    return (x + (0x80 - low) * Octet_Ones) &
+           ~(x + (0x7f - high) * Octet_Ones) &
+           Octet_High_Bits;
+}
+
+/*
+ *  DecodeWord
+ *
+ *  Description:
+ *      Decode eight Base16 characters within a 64-bit word as four octets.
+ *
+ *  Parameters:
+ *      characters [in]
+ *          The characters, the first being least significant.
+ *
+ *      octets [out]
+ *          The decoded octets, the first being least significant.
+ *
+ *  Returns:
+ *      True if every character is in the alphabet.  If not, the octets are
+ *      meaningless.
+ *
+ *  Comments:
+ *      Digits have their values in the low 4 bits; letters of either case
+ *      have their values less 9 in the low 4 bits.
+ */
+bool DecodeWord(std::uint64_t characters, std::uint32_t &octets)
+{
+    // Determine which characters are digits and which are letters
+    std::uint64_t digits = InRange(characters, '0', '9');
+    std::uint64_t letters = InRange(characters | (0x20 * Octet_Ones),
+                                    'a',
+                                    'f');
+
+    // Compute the 4-bit value of each character
+    std::uint64_t values = (characters & (0x0f * Octet_Ones)) +
+                           (letters >> 7) * 9;
+
+    // Combine each pair of values into an octet, then gather the octets
+    std::uint64_t x = ((values & 0x00ff00ff00ff00ff) << 4) |
+                      ((values >> 8) & 0x00ff00ff00ff00ff);
+    x = (x | (x >>  8)) & 0x0000ffff0000ffff;
+    x = (x | (x >> 16)) & 0x00000000ffffffff;
+    octets = static_cast<std::uint32_t>(x);
+
+    return ((characters & Octet_High_Bits) == 0) &&
+           ((digits | letters) == Octet_High_Bits);
+}
+
+/*
+ *  EncodeSmall
+ *
+ *  Description:
+ *      This kernel encodes four octets at a time within a 64-bit word,
+ *      handling the final octets with an overlapping load and store rather
+ *      than a scalar tail.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base16.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written, which must
+ *          be at least MaxEncodedLength(input.size()) characters.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer.
+ *
+ *  Comments:
+ *      This is intended for inputs of up to Small_Input_Limit octets (e.g.,
+ *      digests and keys), where it runs without data-dependent branches.
+ */
+std::size_t EncodeSmall(const std::span<const std::uint8_t> input,
+                        char *output)
+{
+    const std::size_t n = input.size();
+
+    // Encode fewer than four octets by way of a zero-filled word
+    if (n < 4)
+    {
+        std::uint8_t octets[4] = {};
+        char characters[8];
+
+        std::copy_n(input.data(), n, octets);
+        StoreWord(characters, EncodeWord(LoadWord<std::uint32_t>(octets)));
+        std::copy_n(characters, n * 2, output);
+
+        return n * 2;
+    }
+
+    // Encode four octets at a time, the last four overlapping as needed
+    for (std::size_t i = 0; i < n; i += 4)
+    {
+        std::size_t offset = std::min(i, n - 4);
+        StoreWord(output + offset * 2,
+                  EncodeWord(LoadWord<std::uint32_t>(input.data() + offset)));
+    }
+
+    return n * 2;
+}
+
+/*
+ *  DecodeSmall
+ *
+ *  Description:
+ *      This kernel decodes eight characters at a time within a 64-bit word,
+ *      handling the final characters with an overlapping load and store
+ *      rather than a scalar tail.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base16-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      Validity is accumulated and tested once at the end.  Input having an
+ *      odd length or characters outside of the alphabet, or an output
+ *      buffer too small to hold the result, is decoded by DecodeBlock().
+ */
+std::optional<std::size_t> DecodeSmall(const std::string_view input,
+                                       std::span<std::uint8_t> output)
+{
+    const std::size_t n = input.size();
+    std::uint32_t octets;
+    bool valid = true;
+
+    // Defer to the general decoder if the input is irregular
+    if (((n % 2) != 0) || (output.size() < n / 2))
+    {
+        return DecodeBlock(input, output);
+    }
+
+    if (n < 8)
+    {
+        // Decode fewer than eight characters by way of a '0'-filled word
+        char characters[8] = {'0', '0', '0', '0', '0', '0', '0', '0'};
+        std::uint8_t decoded[4];
+
+        std::copy_n(input.data(), n, characters);
+        valid = DecodeWord(LoadWord<std::uint64_t>(characters), octets);
+        StoreWord(decoded, octets);
+        std::copy_n(decoded, n / 2, output.data());
+    }
+    else
+    {
+        // Decode eight characters at a time, the last eight overlapping
+        for (std::size_t i = 0; i < n; i += 8)
+        {
+            std::size_t offset = std::min(i, n - 8);
+            valid &= DecodeWord(
+                LoadWord<std::uint64_t>(input.data() + offset),
+                octets);
+            StoreWord(output.data() + offset / 2, octets);
+        }
+    }
+
+    // Defer to the general decoder if any character was not in the alphabet
+    if (!valid) return DecodeBlock(input, output);
+
+    return n / 2;
+}
+
+#ifdef BASES_SIMD
+/*
+ *  EncodeSimd
+ *
+ *  Description:
+ *      This kernel encodes a vector of octets at a time using portable SIMD
+ *      arithmetic, then encodes any residual octets with EncodeBlock().
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base16.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written, which must
+ *          be at least MaxEncodedLength(input.size()) characters.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer.
+ *
+ *  Comments:
+ *      Each octet is widened to a 16-bit lane holding its two characters.
+ */
+std::size_t EncodeSimd(const std::span<const std::uint8_t> input,
+                       char *output)
+{
+    using namespace Bases::Simd;
+    using Wide = Vector<std::uint16_t>;
+    constexpr std::size_t N = Wide::size();
+
+    std::size_t i = 0;                          // Input position
+    char *p = output;                           // Next output character
+
+    // Convert a vector of 4-bit values to hexadecimal characters
+    auto hex = [](const Wide &values)
+    {
+        Wide characters = values + std::uint16_t('0');
+        where(values > 9, characters) += std::uint16_t('A' - '9' - 1);
+        return characters;
+    };
+
+    // Encode a vector of octets at a time
+    for (; input.size() - i >= N; i += N, p += 2 * N)
+    {
+        Wide octets = static_simd_cast<Wide>(
+            Load<std::uint8_t, N>(input.data() + i));
+
+        Store(p, Place(hex(octets >> 4), 0) | Place(hex(octets & 0x0f), 1));
+    }
+
+    // Encode the residual octets
+    p += EncodeBlock(input.subspan(i), p);
+
+    return static_cast<std::size_t>(p - output);
+}
+
+/*
+ *  DecodeSimd
+ *
+ *  Description:
+ *      This kernel decodes a vector of character pairs at a time using
+ *      portable SIMD arithmetic until it encounters a character outside of
+ *      the alphabet, at which point the remaining input is decoded with
+ *      DecodeBlock().
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base16-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      None.
+ */
+std::optional<std::size_t> DecodeSimd(const std::string_view input,
+                                      std::span<std::uint8_t> output)
+{
+    using namespace Bases::Simd;
+    using Wide = Vector<std::uint16_t>;
+    constexpr std::size_t N = Wide::size();
+
+    std::size_t i = 0;                          // Input position
+    std::size_t length = 0;                     // Octets written to output
+
+    // Convert a vector of characters to 4-bit values, or 0x100 if invalid
+    auto nibble = [](const Wide &characters)
+    {
+        Wide digit = characters - std::uint16_t('0');
+        Wide letter = (characters | 0x20) - std::uint16_t('a');
+        Wide values = 0x100;
+        where(letter < 6, values) = letter + 10;
+        where(digit < 10, values) = digit;
+        return values;
+    };
+
+    // Decode a vector of character pairs at a time
+    while ((input.size() - i >= 2 * N) && (output.size() - length >= N))
+    {
+        Wide pairs = Load<std::uint16_t>(input.data() + i);
+        Wide high = nibble(Byte(pairs, 0));
+        Wide low = nibble(Byte(pairs, 1));
+
+        if (any_of((high | low) > 0x0f)) break;
+
+        static_simd_cast<Vector<std::uint8_t, N>>((high << 4) | low)
+            .copy_to(output.data() + length, stdx::element_aligned);
+
+        i += 2 * N;
+        length += N;
+    }
+
+    // Decode anything remaining
+    auto remaining = DecodeBlock(input.substr(i), output.subspan(length));
+    if (!remaining) return {};
+
+    return length + *remaining;
+}
+#endif
+#endif
+
+/*
+ *  RunEncode
+ *
+ *  Description:
+ *      Invoke the given encode kernel repeatedly for tuning.
+ *
+ *  Parameters:
+ *      kernel [in]
+ *          The kernel to invoke.
+ *
+ *      size [in]
+ *          Number of octets to encode.
+ *
+ *      iterations [in]
+ *          Number of times to invoke the kernel.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void RunEncode(EncodeKernel kernel, std::size_t size, std::size_t iterations)
+{
+    Bases::ScratchOctets input(size);
+    Bases::ScratchString output(MaxEncodedLength(size), '\0');
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        input[i] = static_cast<std::uint8_t>(i * 131 + 17);
+    }
+
+    for (std::size_t i = 0; i < iterations; i++) kernel(input, output.data());
+}
+
+/*
+ *  RunDecode
+ *
+ *  Description:
+ *      Invoke the given decode kernel repeatedly for tuning.
+ *
+ *  Parameters:
+ *      kernel [in]
+ *          The kernel to invoke.
+ *
+ *      size [in]
+ *          Number of octets represented by the text to decode.
+ *
+ *      iterations [in]
+ *          Number of times to invoke the kernel.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void RunDecode(DecodeKernel kernel, std::size_t size, std::size_t iterations)
+{
+    Bases::ScratchOctets input(size);
+    Bases::ScratchString text(MaxEncodedLength(size), '\0');
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        input[i] = static_cast<std::uint8_t>(i * 131 + 17);
+    }
+    EncodeScalar(input, text.data());
+
+    for (std::size_t i = 0; i < iterations; i++) kernel(text, input);
+}
+
+// Define the candidate kernels for each operation
+constexpr Bases::Tuning::Kernel<EncodeKernel> Encode_Kernels[] =
+{
+    {"scalar", EncodeScalar, nullptr},
+#ifndef BASES_COMPACT
+    {"block", EncodeBlock, nullptr},
+    {"small", EncodeSmall, nullptr},
+#ifdef BASES_SIMD
+    {"simd", EncodeSimd, nullptr}
+#endif
+#endif
+};
+constexpr Bases::Tuning::Kernel<DecodeKernel> Decode_Kernels[] =
+{
+    {"scalar", DecodeScalar, nullptr},
+#ifndef BASES_COMPACT
+    {"block", DecodeBlock, nullptr},
+    {"small", DecodeSmall, nullptr},
+#ifdef BASES_SIMD
+    {"simd", DecodeSimd, nullptr}
+#endif
+#endif
+};
+
+// Define the default kernels for small and large inputs (the SIMD kernel
+// for large inputs, if present); the compact build has only one kernel
+#if defined(BASES_COMPACT)
+constexpr std::size_t Small_Input_Kernel = 0;
+constexpr std::size_t Large_Input_Kernel = 0;
+#elif defined(BASES_SIMD)
+constexpr std::size_t Small_Input_Kernel = 2;
+constexpr std::size_t Large_Input_Kernel = 3;
+#else
+constexpr std::size_t Small_Input_Kernel = 2;
+constexpr std::size_t Large_Input_Kernel = 1;
+#endif
+
+// Define the kernel selectors
+constinit Bases::Tuning::KernelSelector<EncodeKernel> Encoder(
+    "base16.encode",
+    Encode_Kernels,
+    RunEncode,
+    Small_Input_Kernel,
+    Large_Input_Kernel);
+constinit Bases::Tuning::KernelSelector<DecodeKernel> Decoder(
+    "base16.decode",
+    Decode_Kernels,
+    RunDecode,
+    Small_Input_Kernel,
+    Large_Input_Kernel);
+
+} // namespace
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given binary string into base16.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Binary string to be encoded as base16.
+ *
+ *  Returns:
+ *      The base16-encoded text string.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string Encode(const std::string_view input)
+{
+    // This library assumes the width of char is 8 bits
+    static_assert(CHAR_BIT == 8);
+
+    return Encode(std::span<const std::uint8_t>{
+        reinterpret_cast<const uint8_t *>(input.data()),
+        input.size()});
+}
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base16.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base16.
+ *
+ *  Returns:
+ *      The Base16-encoded text string.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string Encode(const std::span<const std::uint8_t> input)
+{
+    // Just return an empty string if the input is empty
+    if (input.empty()) return {};
+
+    // Create an output string of the required size
+    std::string output(MaxEncodedLength(input.size()), '\0');
+
+    // Encode the input into the output string
+    Encode(input, output);
+
+    return output;
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the base16-encoded string.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base16-encoded string that is to be decoded.
+ *
+ *  Returns:
+ *      The decoded octets, which will be empty if the input string was
+ *      empty or if the input string was not a properly encoded string.
+ *
+ *  Comments:
+ *      To allow for spacing, control characters, etc., any character that is
+ *      not part of the character set is silently ignored.
+ *
+ *      For decoding purposes, the alphabet is treated case insensitively.
+ */
+std::vector<std::uint8_t> Decode(const std::string_view input)
+{
+    // Just return an empty vector if the input is empty
+    if (input.empty()) return {};
+
+    // Create an output vector large enough to hold the decoded octets
+    std::vector<std::uint8_t> output(MaxDecodedLength(input.size()));
+
+    // Decode the input into the output vector
+    auto length = Decode(input, output);
+
+    // If there was an error decoding, return an empty vector
+    if (!length) return {};
+
+    // Adjust the output vector to the actual decoded length
+    output.resize(*length);
+
+    return output;
+}
+
+/*
+ *  MaxEncodedLength
+ *
+ *  Description:
+ *      This function returns the number of characters required to hold the
+ *      Base16 encoding of the given number of octets.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The number of octets to be encoded.
+ *
+ *  Returns:
+ *      The number of characters required for the encoded string.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MaxEncodedLength(std::size_t length)
+{
+    return length * 2;
+}
+
+/*
+ *  MaxDecodedLength
+ *
+ *  Description:
+ *      This function returns the maximum number of octets that may result
+ *      from decoding a Base16-encoded string of the given length.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The length of the Base16-encoded string.
+ *
+ *  Returns:
+ *      The maximum number of octets the string could decode into.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MaxDecodedLength(std::size_t length)
+{
+    return length / 2;
+}
+
+/*
+ *  IsValid
+ *
+ *  Description:
+ *      This function will determine whether the given string is properly
+ *      Base16-encoded without decoding it.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base16-encoded string that is to be validated.
+ *
+ *      mode [in]
+ *          The rules to apply (see the declaration).
+ *
+ *  Returns:
+ *      The exact number of octets the string decodes into, or std::nullopt
+ *      if the string is not valid under the given rules.
+ *
+ *  Comments:
+ *      None.
+ */
+std::optional<std::size_t> IsValid(const std::string_view input, Mode mode)
+{
+    using namespace Bases::Validate;
+
+    // Count the characters that will be decoded
+    std::size_t count = (mode == Mode::Strict) ?
+                            ValidPrefix(input, ToValue) :
+                            CountValid(input, ToValue);
+
+    // In strict mode, every character must be in the alphabet
+    if ((mode == Mode::Strict) && (count != input.size())) return {};
+
+    // Each octet is represented by two characters
+    if ((count % 2) != 0) return {};
+
+    return count / 2;
+}
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base16,
+ *      writing the encoded characters into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base16.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.  A buffer
+ *          of MaxEncodedLength(input.size()) characters is always sufficient.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      This function does not allocate memory.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output)
+{
+    // Ensure the output buffer is large enough
+    if (output.size() < MaxEncodedLength(input.size())) return 0;
+
+    // Encode using the kernel selected for this input size
+    return Encoder.Select(input.size())(input, output.data());
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base16-encoded string, writing the
+ *      decoded octets into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base16-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.  A buffer of
+ *          MaxDecodedLength(input.size()) octets is always sufficient.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      The input is interpreted exactly as it is by the Decode() function
+ *      that returns a vector.  This function does not allocate memory.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output)
+{
+    // Decode using the kernel selected for this input size
+    return Decoder.Select(input.size())(input, output);
+}
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base16,
+ *      encoding large inputs in parallel using the given executor.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base16.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.
+ *
+ *      executor [in]
+ *          The executor on which to run the chunks.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output,
+                   Bases::Executor &executor)
+{
+    // Ensure the output buffer is large enough
+    if (output.size() < MaxEncodedLength(input.size())) return 0;
+
+    // Encode each chunk using the kernel selected for its size
+    return Bases::Parallel::Encode(
+        executor,
+        input,
+        output,
+        1,
+        2,
+        [](const std::span<const std::uint8_t> chunk, char *p)
+        {
+            return Encoder.Select(chunk.size())(chunk, p);
+        });
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base16-encoded string, decoding large
+ *      inputs in parallel using the given executor.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base16-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *      executor [in]
+ *          The executor on which to run the chunks.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      None.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output,
+                                  Bases::Executor &executor)
+{
+    // Decode each chunk using the kernel selected for its size
+    return Bases::Parallel::Decode(
+        executor,
+        input,
+        output,
+        1,
+        2,
+        [](const std::string_view chunk, std::span<std::uint8_t> octets)
+        {
+            return Decoder.Select(chunk.size())(chunk, octets);
+        });
+}
+
+} // namespace Terra::Base16
+
+namespace Terra::Bases::Tuning
+{
+
+/*
+ *  Base16Operations
+ *
+ *  Description:
+ *      Return the tunable Base16 operations.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The kernel selectors for Base16 operations.
+ *
+ *  Comments:
+ *      None.
+ */
+std::span<Operation * const> Base16Operations()
+{
+    static Operation * const operations[] =
+    {
+        &Base16::Encoder,
+        &Base16::Decoder
+    };
+
+    return operations;
+}
+
+} // namespace Terra::Bases::Tuning
@@ -19,11 +19,24 @@
 #include <cstdint>
 #include <limits>
 #include <climits>
+#include <string>
+#include <vector>
 #include <terra/bases/base32.h>
+#include "parallel.h"
+#include "simd.h"
+#include "tuning.h"
+#include "validate.h"
 
 namespace Terra::Base32
 {
 
+// Define the padding octet
+static constexpr char Base32PaddingCharacter = '=';
+
+// Define an value to represent an invalid Base32 character
+static constexpr std::uint8_t InvalidBase32Character = 255;
+
+#ifndef BASES_COMPACT
 // Define the table used for converting to Base32
 static const char Base32Table[32] =
 {
@@ -32,12 +45,6 @@ static const char Base32Table[32] =
     '2', '3', '4', '5', '6', '7'
 };
 
-// Define the padding octet
-static constexpr char Base32PaddingCharacter = '=';
-
-// Define an value to represent an invalid Base32 character
-static constexpr std::uint8_t InvalidBase32Character = 255;
-
 // Use the C pre-processor to define a macro that will tell us the integer
 // value for any given Base32 character
 #define B32ToInt(x) ( \
@@ -115,59 +122,136 @@ static const std::uint8_t Base32ReverseTable[256] =
 };
 
 /*
- *  Encode
+ *  ToCharacter
  *
  *  Description:
- *      This function will encode the given binary string into Base32.
+ *      Return the Base32 character representing the given 5-bit value.
  *
  *  Parameters:
- *      input [in]
- *          Binary string to be encoded as Base32.
+ *      value [in]
+ *          The value, which must be less than 32.
  *
  *  Returns:
- *      The Base32-encoded text string.
+ *      The Base32 character.
  *
  *  Comments:
  *      None.
  */
-std::string Encode(const std::string_view input)
+static char ToCharacter(std::uint8_t value)
 {
-    // This library assumes the width of char is 8 bits
-    static_assert(CHAR_BIT == 8);
+    return Base32Table[value];
+}
 
-    return Encode(std::span<const std::uint8_t>{
-        reinterpret_cast<const uint8_t *>(input.data()),
-        input.size()});
+/*
+ *  ToValue
+ *
+ *  Description:
+ *      Return the 5-bit value represented by the given Base32 character.
+ *
+ *  Parameters:
+ *      c [in]
+ *          The character.
+ *
+ *  Returns:
+ *      The value, or InvalidBase32Character if the character is not in the
+ *      alphabet.
+ *
+ *  Comments:
+ *      None.
+ */
+static std::uint8_t ToValue(char c)
+{
+    return Base32ReverseTable[static_cast<std::uint8_t>(c)];
+}
+#else
+/*
+ *  ToCharacter
+ *
+ *  Description:
+ *      Return the Base32 character representing the given 5-bit value.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The value, which must be less than 32.
+ *
+ *  Returns:
+ *      The Base32 character.
+ *
+ *  Comments:
+ *      The character is computed rather than looked up in a table.
+ */
+static char ToCharacter(std::uint8_t value)
+{
+    return static_cast<char>((value < 26) ? 'A' + value : '2' + value - 26);
 }
 
 /*
- *  Encode
+ *  ToValue
  *
  *  Description:
- *      This function will encode the span of octets into Base32.
+ *      Return the 5-bit value represented by the given Base32 character.
+ *
+ *  Parameters:
+ *      c [in]
+ *          The character.
+ *
+ *  Returns:
+ *      The value, or InvalidBase32Character if the character is not in the
+ *      alphabet.
+ *
+ *  Comments:
+ *      The value is computed rather than looked up in a table.  Setting bit
+ *      5 maps 'A'-'Z' to 'a'-'z' and no other character into that range.
+ */
+static std::uint8_t ToValue(char c)
+{
+    unsigned u = static_cast<std::uint8_t>(c);
+
+    if (u - '2' < 6) return static_cast<std::uint8_t>(u - '2' + 26);
+
+    u |= 0x20;
+    if (u - 'a' < 26) return static_cast<std::uint8_t>(u - 'a');
+
+    return InvalidBase32Character;
+}
+#endif
+
+// Kernel function types
+using EncodeKernel = std::size_t (*)(const std::span<const std::uint8_t>,
+                                     char *);
+using DecodeKernel = std::optional<std::size_t> (*)(const std::string_view,
+                                                    std::span<std::uint8_t>);
+
+/*
+ *  EncodeScalar
+ *
+ *  Description:
+ *      This kernel encodes one octet at a time, emitting each 5-bit value
+ *      as it becomes available.
  *
  *  Parameters:
  *      input [in]
  *          Span of octets to be encoded as Base32.
  *
+ *      output [out]
+ *          Buffer into which the encoded characters are written, which must
+ *          be at least MaxEncodedLength(input.size()) characters.
+ *
  *  Returns:
- *      The Base32-encoded text string.
+ *      The number of characters written to the output buffer.
  *
  *  Comments:
  *      None.
  */
-std::string Encode(const std::span<const std::uint8_t> input)
+static std::size_t EncodeScalar(const std::span<const std::uint8_t> input,
+                                char *output)
 {
-    std::string output;                         // Output string
     std::size_t group = 0;                      // Current bit group
     std::size_t group_size = 0;                 // How many bits in group
     std::size_t quantum = 0;                    // 5-bit groups outputted
 
-    // Just return an empty string if the input is empty
-    if (input.empty()) return {};
-
-    // Estimate the size of the output to avoid repetitive buffer resizing
-    output.reserve(((input.size() / 5) + ((input.size() % 5 > 0) ? 1 : 0)) * 8);
+    // Pointer to the next output character
+    char *p = output;
 
     // Iterate over the input string
     for (const std::uint8_t octet : input)
@@ -183,9 +267,9 @@ std::string Encode(const std::span<const std::uint8_t> input)
 
         while (group_size >= 5)
         {
-            // Convert the top most significant 5 bits using the Base32Table,
+            // Convert the top most significant 5 bits to a character,
             // appending the Base32 character to the string
-            output += Base32Table[(group >> (group_size - 5)) & 0x1f];
+            *p++ = ToCharacter((group >> (group_size - 5)) & 0x1f);
 
             // Note that 5 bits were outputted
             quantum++;
@@ -205,57 +289,104 @@ std::string Encode(const std::span<const std::uint8_t> input)
         // Shift the group so that there is an integral number of 5-bits
         group <<= 5 - (group_size % 5);
 
-        // Convert the residual 5 bits using the Base32Table, appending the
+        // Convert the residual 5 bits to a character, appending the
         // Base32 character to the string
-        output += Base32Table[group & 0x1f];
+        *p++ = ToCharacter(group & 0x1f);
 
         // Note that 5 bits were outputted
         quantum++;
 
         // Add padding characters as required
-        if (quantum < 8) output.append(8 - quantum, Base32PaddingCharacter);
+        for (; quantum < 8; quantum++) *p++ = Base32PaddingCharacter;
     }
 
-    return output;
+    return static_cast<std::size_t>(p - output);
 }
 
+#ifndef BASES_COMPACT
 /*
- *  Decode
+ *  EncodeBlock
  *
  *  Description:
- *      This function will decode the Base32-encoded string.
+ *      This kernel encodes five octets (one 40-bit quantum) at a time, then
+ *      encodes any residual octets with EncodeScalar().
  *
  *  Parameters:
  *      input [in]
- *          Base32-encoded string that is to be decoded.
+ *          Span of octets to be encoded as Base32.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written, which must
+ *          be at least MaxEncodedLength(input.size()) characters.
  *
  *  Returns:
- *      The decoded octets, which will be empty if the input string was
- *      empty or if the input string was not a properly encoded string.
+ *      The number of characters written to the output buffer.
  *
  *  Comments:
- *      The '=' padding character(s) may be missing from the end of the string,
- *      since some implementations fail to add those.  Decoding will cease once
- *      padding characters are encountered and any residual data in the input
- *      string is ignored and not counted as an error.
+ *      None.
+ */
+static std::size_t EncodeBlock(const std::span<const std::uint8_t> input,
+                               char *output)
+{
+    const std::uint8_t *q = input.data();       // Next input octet
+    std::size_t quanta = input.size() / 5;      // Full quanta in input
+    char *p = output;                           // Next output character
+
+    // Encode each full 40-bit quantum as eight characters
+    for (std::size_t i = 0; i < quanta; i++, q += 5)
+    {
+        std::uint64_t group = (static_cast<std::uint64_t>(q[0]) << 32) |
+                              (static_cast<std::uint64_t>(q[1]) << 24) |
+                              (static_cast<std::uint64_t>(q[2]) << 16) |
+                              (static_cast<std::uint64_t>(q[3]) <<  8) |
+                              (static_cast<std::uint64_t>(q[4])      );
+
+        *p++ = Base32Table[(group >> 35) & 0x1f];
+        *p++ = Base32Table[(group >> 30) & 0x1f];
+        *p++ = Base32Table[(group >> 25) & 0x1f];
+        *p++ = Base32Table[(group >> 20) & 0x1f];
+        *p++ = Base32Table[(group >> 15) & 0x1f];
+        *p++ = Base32Table[(group >> 10) & 0x1f];
+        *p++ = Base32Table[(group >>  5) & 0x1f];
+        *p++ = Base32Table[(group      ) & 0x1f];
+    }
+
+    // Encode the residual octets, including any padding
+    p += EncodeScalar(input.subspan(quanta * 5), p);
+
+    return static_cast<std::size_t>(p - output);
+}
+
+#endif
+
+/*
+ *  DecodeScalar
  *
- *      To allow for spacing, control characters, etc., any character that is
- *      not part of the character set is silently ignored.
+ *  Description:
+ *      This kernel decodes one character at a time.
  *
- *      For decoding purposes, the alphabet is treated case insensitively.
+ *  Parameters:
+ *      input [in]
+ *          Base32-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      Characters that are not part of the alphabet are skipped.
  */
-std::vector<std::uint8_t> Decode(const std::string_view input)
+static std::optional<std::size_t> DecodeScalar(
+                                            const std::string_view input,
+                                            std::span<std::uint8_t> output)
 {
-    std::vector<std::uint8_t> output;           // Output string
     std::uint_fast32_t group = 0;               // Current bit group
     std::uint_fast32_t group_size = 0;          // How many bits in group
-
-    // Just return an empty string if the input is empty
-    if (input.empty()) return {};
-
-    // Estimate the size of the output to avoid repetitive buffer resizing
-    output.reserve(
-        static_cast<std::size_t>(static_cast<double>(input.size()) / 1.6));
+    std::size_t length = 0;                     // Octets written to output
 
     // Iterate over the input string
     for (const char c : input)
@@ -264,7 +395,7 @@ std::vector<std::uint8_t> Decode(const std::string_view input)
         if (c == Base32PaddingCharacter) break;
 
         // Determine if we have a valid Base32 character
-        std::uint8_t octet = Base32ReverseTable[static_cast<std::uint8_t>(c)];
+        std::uint8_t octet = ToValue(c);
 
         // Skip over any invalid character in the input
         if (octet == InvalidBase32Character) continue;
@@ -281,8 +412,11 @@ std::vector<std::uint8_t> Decode(const std::string_view input)
         // Do we have at least an octet in the group?
         if (group_size >= 8)
         {
-            // Append the octet to the output string
-            output.push_back((group >> (group_size - 8)) & 0xff);
+            // Ensure there is space in the output buffer
+            if (length == output.size()) return {};
+
+            // Append the octet to the output buffer
+            output[length++] = (group >> (group_size - 8)) & 0xff;
 
             // Adjust the group size value
             group_size -= 8;
@@ -302,7 +436,809 @@ std::vector<std::uint8_t> Decode(const std::string_view input)
         if ((group & (~mask)) != 0) return {};
     }
 
-    return output;
+    return length;
 }
 
-} // namespace Terra::Base32
+#ifndef BASES_COMPACT
+/*
+ *  DecodeBlock
+ *
+ *  Description:
+ *      This kernel decodes eight characters (one 40-bit quantum) at a time
+ *      until it encounters a character outside of the alphabet (including
+ *      padding), at which point the remaining input is decoded with
+ *      DecodeScalar().
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base32-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      All eight lookups are validated with a single test, since an invalid
+ *      character maps to a value having the high bits set.
+ */
+static std::optional<std::size_t> DecodeBlock(const std::string_view input,
+                                              std::span<std::uint8_t> output)
+{
+    std::size_t i = 0;                          // Input position
+    std::size_t length = 0;                     // Octets written to output
+
+    // Decode full quanta while all characters are in the alphabet
+    while ((input.size() - i >= 8) && (output.size() - length >= 5))
+    {
+        std::uint8_t values[8];
+        std::uint8_t invalid = 0;
+
+        for (std::size_t j = 0; j < 8; j++)
+        {
+            values[j] =
+                Base32ReverseTable[static_cast<std::uint8_t>(input[i + j])];
+            invalid |= values[j];
+        }
+
+        if ((invalid & 0xe0) != 0) break;
+
+        std::uint64_t group = 0;
+        for (std::size_t j = 0; j < 8; j++) group = (group << 5) | values[j];
+
+        output[length++] = static_cast<std::uint8_t>(group >> 32);
+        output[length++] = static_cast<std::uint8_t>(group >> 24);
+        output[length++] = static_cast<std::uint8_t>(group >> 16);
+        output[length++] = static_cast<std::uint8_t>(group >>  8);
+        output[length++] = static_cast<std::uint8_t>(group      );
+        i += 8;
+    }
+
+    // Decode anything remaining one character at a time
+    auto remaining = DecodeScalar(input.substr(i), output.subspan(length));
+    if (!remaining) return {};
+
+    return length + *remaining;
+}
+
+#ifdef BASES_SIMD
+/*
+ *  EncodeSimd
+ *
+ *  Description:
+ *      This kernel encodes a vector of 40-bit quanta at a time using
+ *      portable SIMD arithmetic, then encodes any residual octets with
+ *      EncodeBlock().
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base32.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written, which must
+ *          be at least MaxEncodedLength(input.size()) characters.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer.
+ *
+ *  Comments:
+ *      Each quantum occupies a 64-bit lane, which then holds its eight
+ *      characters.
+ */
+static std::size_t EncodeSimd(const std::span<const std::uint8_t> input,
+                              char *output)
+{
+    using namespace Bases::Simd;
+    using Wide = Vector<std::uint64_t>;
+    constexpr std::size_t N = Wide::size();
+
+    std::size_t i = 0;                          // Input position
+    char *p = output;                           // Next output character
+
+    // Encode a vector of quanta at a time
+    for (; input.size() - i >= 5 * N; i += 5 * N, p += 8 * N)
+    {
+        const std::uint8_t *q = input.data() + i;
+        Wide groups([q](auto j)
+        {
+            return (std::uint64_t(q[j * 5    ]) << 32) |
+                   (std::uint64_t(q[j * 5 + 1]) << 24) |
+                   (std::uint64_t(q[j * 5 + 2]) << 16) |
+                   (std::uint64_t(q[j * 5 + 3]) <<  8) |
+                   (std::uint64_t(q[j * 5 + 4])      );
+        });
+        Wide characters = 0;
+
+        // Convert each 5-bit value to a character
+        for (unsigned k = 0; k < 8; k++)
+        {
+            Wide values = (groups >> (35 - k * 5)) & 0x1f;
+            Wide character = values + std::uint64_t('A');
+            where(values > 25, character) = values + std::uint64_t('2' - 26);
+            characters |= Place(character, k);
+        }
+
+        Store(p, characters);
+    }
+
+    // Encode the residual octets, including any padding
+    p += EncodeBlock(input.subspan(i), p);
+
+    return static_cast<std::size_t>(p - output);
+}
+
+/*
+ *  DecodeSimd
+ *
+ *  Description:
+ *      This kernel decodes a vector of 8-character quanta at a time using
+ *      portable SIMD arithmetic until it encounters a character outside of
+ *      the alphabet (including padding), at which point the remaining input
+ *      is decoded with DecodeBlock().
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base32-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      Lowercase letters are accepted, as with the other kernels.
+ */
+static std::optional<std::size_t> DecodeSimd(const std::string_view input,
+                                             std::span<std::uint8_t> output)
+{
+    using namespace Bases::Simd;
+    using Wide = Vector<std::uint64_t>;
+    constexpr std::size_t N = Wide::size();
+
+    std::size_t i = 0;                          // Input position
+    std::size_t length = 0;                     // Octets written to output
+
+    // Decode a vector of quanta at a time
+    while ((input.size() - i >= 8 * N) && (output.size() - length >= 5 * N))
+    {
+        Wide characters = Load<std::uint64_t>(input.data() + i);
+        Wide groups = 0;
+        Wide invalid = 0;
+
+        // Convert each character to its 5-bit value, flagging invalid ones
+        for (unsigned k = 0; k < 8; k++)
+        {
+            Wide character = Byte(characters, k);
+            Wide letter = (character | 0x20) - std::uint64_t('a');
+            Wide digit = character - std::uint64_t('2');
+            Wide values = 0x100;
+            where(digit < 6, values) = digit + 26;
+            where(letter < 26, values) = letter;
+            invalid |= values;
+            groups = (groups << 5) | (values & 0x1f);
+        }
+
+        if (any_of(invalid > 0x1f)) break;
+
+        // Write the five octets of each quantum
+        std::uint64_t quanta[N];
+        groups.copy_to(quanta, stdx::element_aligned);
+        for (std::size_t j = 0; j < N; j++)
+        {
+            output[length++] = static_cast<std::uint8_t>(quanta[j] >> 32);
+            output[length++] = static_cast<std::uint8_t>(quanta[j] >> 24);
+            output[length++] = static_cast<std::uint8_t>(quanta[j] >> 16);
+            output[length++] = static_cast<std::uint8_t>(quanta[j] >>  8);
+            output[length++] = static_cast<std::uint8_t>(quanta[j]      );
+        }
+
+        i += 8 * N;
+    }
+
+    // Decode anything remaining
+    auto remaining = DecodeBlock(input.substr(i), output.subspan(length));
+    if (!remaining) return {};
+
+    return length + *remaining;
+}
+#endif
+#endif
+
+/*
+ *  RunEncode
+ *
+ *  Description:
+ *      Invoke the given encode kernel repeatedly for tuning.
+ *
+ *  Parameters:
+ *      kernel [in]
+ *          The kernel to invoke.
+ *
+ *      size [in]
+ *          Number of octets to encode.
+ *
+ *      iterations [in]
+ *          Number of times to invoke the kernel.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+static void RunEncode(EncodeKernel kernel,
+                      std::size_t size,
+                      std::size_t iterations)
+{
+    Bases::ScratchOctets input(size);
+    Bases::ScratchString output(MaxEncodedLength(size), '\0');
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        input[i] = static_cast<std::uint8_t>(i * 131 + 17);
+    }
+
+    for (std::size_t i = 0; i < iterations; i++) kernel(input, output.data());
+}
+
+/*
+ *  RunDecode
+ *
+ *  Description:
+ *      Invoke the given decode kernel repeatedly for tuning.
+ *
+ *  Parameters:
+ *      kernel [in]
+ *          The kernel to invoke.
+ *
+ *      size [in]
+ *          Number of octets represented by the text to decode.
+ *
+ *      iterations [in]
+ *          Number of times to invoke the kernel.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+static void RunDecode(DecodeKernel kernel,
+                      std::size_t size,
+                      std::size_t iterations)
+{
+    Bases::ScratchOctets input(size);
+    Bases::ScratchString text(MaxEncodedLength(size), '\0');
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        input[i] = static_cast<std::uint8_t>(i * 131 + 17);
+    }
+    EncodeScalar(input, text.data());
+
+    for (std::size_t i = 0; i < iterations; i++) kernel(text, input);
+}
+
+// Define the candidate kernels for each operation
+static constexpr Bases::Tuning::Kernel<EncodeKernel> Encode_Kernels[] =
+{
+    {"scalar", EncodeScalar, nullptr},
+#ifndef BASES_COMPACT
+    {"block", EncodeBlock, nullptr},
+#ifdef BASES_SIMD
+    {"simd", EncodeSimd, nullptr}
+#endif
+#endif
+};
+static constexpr Bases::Tuning::Kernel<DecodeKernel> Decode_Kernels[] =
+{
+    {"scalar", DecodeScalar, nullptr},
+#ifndef BASES_COMPACT
+    {"block", DecodeBlock, nullptr},
+#ifdef BASES_SIMD
+    {"simd", DecodeSimd, nullptr}
+#endif
+#endif
+};
+
+// Define the default kernel (the compact build has only one kernel)
+#ifdef BASES_COMPACT
+static constexpr std::size_t Default_Kernel = 0;
+#else
+static constexpr std::size_t Default_Kernel = 1;
+#endif
+
+// Define the kernel selectors
+static constinit Bases::Tuning::KernelSelector<EncodeKernel> Encoder(
+    "base32.encode", Encode_Kernels, RunEncode, Default_Kernel, Default_Kernel);
+static constinit Bases::Tuning::KernelSelector<DecodeKernel> Decoder(
+    "base32.decode", Decode_Kernels, RunDecode, Default_Kernel, Default_Kernel);
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given binary string into Base32.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Binary string to be encoded as Base32.
+ *
+ *  Returns:
+ *      The Base32-encoded text string.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string Encode(const std::string_view input)
+{
+    // This library assumes the width of char is 8 bits
+    static_assert(CHAR_BIT == 8);
+
+    return Encode(std::span<const std::uint8_t>{
+        reinterpret_cast<const uint8_t *>(input.data()),
+        input.size()});
+}
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the span of octets into Base32.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base32.
+ *
+ *  Returns:
+ *      The Base32-encoded text string.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string Encode(const std::span<const std::uint8_t> input)
+{
+    // Just return an empty string if the input is empty
+    if (input.empty()) return {};
+
+    // Create an output string of the maximum required size
+    std::string output(MaxEncodedLength(input.size()), '\0');
+
+    // Encode the input into the output string
+    output.resize(Encode(input, output));
+
+    return output;
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base32-encoded string.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base32-encoded string that is to be decoded.
+ *
+ *  Returns:
+ *      The decoded octets, which will be empty if the input string was
+ *      empty or if the input string was not a properly encoded string.
+ *
+ *  Comments:
+ *      The '=' padding character(s) may be missing from the end of the string,
+ *      since some implementations fail to add those.  Decoding will cease once
+ *      padding characters are encountered and any residual data in the input
+ *      string is ignored and not counted as an error.
+ *
+ *      To allow for spacing, control characters, etc., any character that is
+ *      not part of the character set is silently ignored.
+ *
+ *      For decoding purposes, the alphabet is treated case insensitively.
+ */
+std::vector<std::uint8_t> Decode(const std::string_view input)
+{
+    // Just return an empty vector if the input is empty
+    if (input.empty()) return {};
+
+    // Create an output vector large enough to hold the decoded octets
+    std::vector<std::uint8_t> output(MaxDecodedLength(input.size()));
+
+    // Decode the input into the output vector
+    auto length = Decode(input, output);
+
+    // If there was an error decoding, return an empty vector
+    if (!length) return {};
+
+    // Adjust the output vector to the actual decoded length
+    output.resize(*length);
+
+    return output;
+}
+
+/*
+ *  MaxEncodedLength
+ *
+ *  Description:
+ *      This function returns the number of characters required to hold the
+ *      Base32 encoding of the given number of octets, including padding.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The number of octets to be encoded.
+ *
+ *  Returns:
+ *      The number of characters required for the encoded string.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MaxEncodedLength(std::size_t length)
+{
+    return ((length / 5) + ((length % 5 > 0) ? 1 : 0)) * 8;
+}
+
+/*
+ *  MaxDecodedLength
+ *
+ *  Description:
+ *      This function returns the maximum number of octets that may result
+ *      from decoding a Base32-encoded string of the given length.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The length of the Base32-encoded string.
+ *
+ *  Returns:
+ *      The maximum number of octets the string could decode into.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MaxDecodedLength(std::size_t length)
+{
+    return (length * 5) / 8;
+}
+
+/*
+ *  IsValid
+ *
+ *  Description:
+ *      This function will determine whether the given string is properly
+ *      Base32-encoded without decoding it.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base32-encoded string that is to be validated.
+ *
+ *      mode [in]
+ *          The rules to apply (see the declaration).
+ *
+ *  Returns:
+ *      The exact number of octets the string decodes into, or std::nullopt
+ *      if the string is not valid under the given rules.
+ *
+ *  Comments:
+ *      Unused trailing bits are those that do not complete an octet.
+ */
+std::optional<std::size_t> IsValid(const std::string_view input, Mode mode)
+{
+    using namespace Bases::Validate;
+
+    std::string_view text = input;
+    std::size_t count = 0;
+
+    if (mode == Mode::Strict)
+    {
+        // The length must be a whole number of quanta
+        if ((input.size() % 8) != 0) return {};
+
+        // Set aside the trailing padding
+        std::size_t data = input.find_last_not_of(Base32PaddingCharacter);
+        data = (data == std::string_view::npos) ? 0 : data + 1;
+        text = input.substr(0, data);
+
+        // Everything else must be in the alphabet
+        count = ValidPrefix(text, ToValue);
+        if (count != text.size()) return {};
+
+        // A partial quantum must have 2, 4, 5, or 7 characters
+        std::size_t residual = count % 8;
+        if ((residual == 1) || (residual == 3) || (residual == 6)) return {};
+
+        // Padding must complete the final quantum and nothing more
+        if ((input.size() - data) != (residual ? 8 - residual : 0)) return {};
+    }
+    else
+    {
+        // Decoding ceases at the first padding character
+        text = input.substr(0, input.find(Base32PaddingCharacter));
+        count = CountValid(text, ToValue);
+    }
+
+    // Bits that do not complete an octet must be zero
+    if (!TrailingBitsZero(text, ToValue, 5, (count * 5) % 8))
+    {
+        return {};
+    }
+
+    return count * 5 / 8;
+}
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base32,
+ *      writing the encoded characters into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base32.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.  A buffer
+ *          of MaxEncodedLength(input.size()) characters is always sufficient.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      This function does not allocate memory.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output)
+{
+    // Ensure the output buffer is large enough
+    if (output.size() < MaxEncodedLength(input.size())) return 0;
+
+    // Encode using the kernel selected for this input size
+    return Encoder.Select(input.size())(input, output.data());
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base32-encoded string, writing the
+ *      decoded octets into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base32-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.  A buffer of
+ *          MaxDecodedLength(input.size()) octets is always sufficient.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      The input is interpreted exactly as it is by the Decode() function
+ *      that returns a vector.  This function does not allocate memory.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output)
+{
+    // Decode using the kernel selected for this input size
+    return Decoder.Select(input.size())(input, output);
+}
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base32,
+ *      encoding large inputs in parallel using the given executor.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base32.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.
+ *
+ *      executor [in]
+ *          The executor on which to run the chunks.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output,
+                   Bases::Executor &executor)
+{
+    // Ensure the output buffer is large enough
+    if (output.size() < MaxEncodedLength(input.size())) return 0;
+
+    // Encode each chunk using the kernel selected for its size
+    return Bases::Parallel::Encode(
+        executor,
+        input,
+        output,
+        5,
+        8,
+        [](const std::span<const std::uint8_t> chunk, char *p)
+        {
+            return Encoder.Select(chunk.size())(chunk, p);
+        });
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base32-encoded string, decoding large
+ *      inputs in parallel using the given executor.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base32-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *      executor [in]
+ *          The executor on which to run the chunks.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      None.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output,
+                                  Bases::Executor &executor)
+{
+    // Decode each chunk using the kernel selected for its size
+    return Bases::Parallel::Decode(
+        executor,
+        input,
+        output,
+        5,
+        8,
+        [](const std::string_view chunk, std::span<std::uint8_t> octets)
+        {
+            return Decoder.Select(chunk.size())(chunk, octets);
+        });
+}
+
+/*
+ *  Append
+ *
+ *  Description:
+ *      This function will extend a Base32-encoded string with the encoding
+ *      of additional octets, re-encoding only the trailing partial quantum
+ *      of the existing string.
+ *
+ *  Parameters:
+ *      encoded [in/out]
+ *          Base32-encoded string that is extended in place.
+ *
+ *      input [in]
+ *          Span of octets to append.
+ *
+ *  Returns:
+ *      True if the string was extended, or false if the end of the encoded
+ *      string is not a properly encoded quantum, in which case the string
+ *      is not modified.
+ *
+ *  Comments:
+ *      The string's capacity grows geometrically, so the amortized cost of
+ *      each call is proportional to the number of octets appended.
+ */
+bool Append(std::string &encoded, const std::span<const std::uint8_t> input)
+{
+    std::uint8_t head[5];                       // Partial quantum + new octets
+    std::size_t head_length = 0;                // Octets in head
+    std::uint_fast64_t group = 0;               // Bits of the partial quantum
+
+    // Determine the length excluding any padding characters
+    std::size_t length = encoded.size();
+    while ((length > 0) && (encoded[length - 1] == Base32PaddingCharacter))
+    {
+        length--;
+    }
+
+    // The partial quantum must have 2, 4, 5, or 7 characters and, if
+    // padded, the padding must complete the quantum
+    std::size_t partial = length % 8;
+    std::size_t padding = encoded.size() - length;
+    if ((partial == 1) || (partial == 3) || (partial == 6) ||
+        ((padding > 0) && ((partial == 0) || (partial + padding != 8))))
+    {
+        return false;
+    }
+
+    // Recover the octets held in the trailing partial quantum
+    for (std::size_t i = length - partial; i < length; i++)
+    {
+        std::uint8_t value = ToValue(encoded[i]);
+        if (value == InvalidBase32Character) return false;
+        group = (group << 5) | value;
+    }
+    group <<= (40 - partial * 5);
+    for (std::size_t i = 0; i < (partial * 5) / 8; i++)
+    {
+        head[head_length++] = (group >> (32 - i * 8)) & 0xff;
+    }
+
+    // Nothing further to do if there is nothing to append
+    if (input.empty()) return true;
+
+    // Complete the partial quantum with the first of the new octets
+    std::size_t consumed = 0;
+    if (head_length > 0)
+    {
+        while ((head_length < 5) && (consumed < input.size()))
+        {
+            head[head_length++] = input[consumed++];
+        }
+    }
+    auto remainder = input.subspan(consumed);
+
+    // Remove the partial quantum and make room for the new characters
+    encoded.resize(length - partial + MaxEncodedLength(head_length) +
+                   MaxEncodedLength(remainder.size()));
+    std::span<char> output(encoded.data() + length - partial,
+                           encoded.size() - (length - partial));
+
+    // Encode the completed quantum followed by the remaining octets
+    std::size_t written =
+        Encode(std::span<const std::uint8_t>(head, head_length), output);
+    written += Encode(remainder, output.subspan(written));
+
+    // Trim any space not needed
+    encoded.resize(length - partial + written);
+
+    return true;
+}
+
+} // namespace Terra::Base32
+
+namespace Terra::Bases::Tuning
+{
+
+/*
+ *  Base32Operations
+ *
+ *  Description:
+ *      Return the tunable Base32 operations.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The kernel selectors for Base32 operations.
+ *
+ *  Comments:
+ *      None.
+ */
+std::span<Operation * const> Base32Operations()
+{
+    static Operation * const operations[] =
+    {
+        &Base32::Encoder,
+        &Base32::Decoder
+    };
+
+    return operations;
+}
+
+} // namespace Terra::Bases::Tuning
@@ -17,12 +17,18 @@
  */
 
 #include <cstdint>
+#include <bit>
 #include <climits>
 #include <terra/bases/base45.h>
+#include "validate.h"
 
 namespace Terra::Base45
 {
 
+// Define an value to represent an invalid Base45 character
+static constexpr std::uint8_t InvalidBase45Character = 255;
+
+#ifndef BASES_COMPACT
 // Define the table used for converting to Base45
 static const char Base45Table[45] =
 {
@@ -32,9 +38,6 @@ static const char Base45Table[45] =
     '*', '+', '-', '.', '/', ':'
 };
 
-// Define an value to represent an invalid Base45 character
-static constexpr std::uint8_t InvalidBase45Character = 255;
-
 // Use the C pre-processor to define a macro that will tell us the integer
 // value for any given Base45 character
 #define B45ToInt(x) ( \
@@ -108,6 +111,136 @@ static const std::uint8_t Base45ReverseTable[256] =
     B45ToInt(255)
 };
 
+/*
+ *  ToCharacter
+ *
+ *  Description:
+ *      Return the Base45 character representing the given value.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The value, which must be less than 45.
+ *
+ *  Returns:
+ *      The Base45 character.
+ *
+ *  Comments:
+ *      None.
+ */
+static char ToCharacter(std::uint8_t value)
+{
+    return Base45Table[value];
+}
+
+/*
+ *  ToValue
+ *
+ *  Description:
+ *      Return the value represented by the given Base45 character.
+ *
+ *  Parameters:
+ *      c [in]
+ *          The character.
+ *
+ *  Returns:
+ *      The value, or InvalidBase45Character if the character is not in the
+ *      alphabet.
+ *
+ *  Comments:
+ *      None.
+ */
+static std::uint8_t ToValue(char c)
+{
+    return Base45ReverseTable[static_cast<std::uint8_t>(c)];
+}
+#else
+// The symbols of the alphabet (values 36 through 44) as offsets from ' ',
+// packed five bits each, and as a mask having those offsets' bits set
+static constexpr std::uint64_t Symbol_Offsets = []()
+{
+    std::uint64_t offsets = 0;
+    const char symbols[] = " $%*+-./:";
+
+    for (std::size_t i = 0; i < 9; i++)
+    {
+        offsets |= static_cast<std::uint64_t>(symbols[i] - ' ') << (i * 5);
+    }
+
+    return offsets;
+}();
+static constexpr std::uint32_t Symbol_Mask = []()
+{
+    std::uint32_t mask = 0;
+
+    for (std::size_t i = 0; i < 9; i++)
+    {
+        mask |= std::uint32_t(1) << ((Symbol_Offsets >> (i * 5)) & 0x1f);
+    }
+
+    return mask;
+}();
+
+/*
+ *  ToCharacter
+ *
+ *  Description:
+ *      Return the Base45 character representing the given value.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The value, which must be less than 45.
+ *
+ *  Returns:
+ *      The Base45 character.
+ *
+ *  Comments:
+ *      The character is computed rather than looked up in a table.
+ */
+static char ToCharacter(std::uint8_t value)
+{
+    if (value < 10) return static_cast<char>('0' + value);
+    if (value < 36) return static_cast<char>('A' + value - 10);
+
+    return static_cast<char>(
+        ' ' + ((Symbol_Offsets >> ((value - 36) * 5)) & 0x1f));
+}
+
+/*
+ *  ToValue
+ *
+ *  Description:
+ *      Return the value represented by the given Base45 character.
+ *
+ *  Parameters:
+ *      c [in]
+ *          The character.
+ *
+ *  Returns:
+ *      The value, or InvalidBase45Character if the character is not in the
+ *      alphabet.
+ *
+ *  Comments:
+ *      The value is computed rather than looked up in a table.
+ */
+static std::uint8_t ToValue(char c)
+{
+    unsigned u = static_cast<std::uint8_t>(c);
+
+    if (u - '0' < 10) return static_cast<std::uint8_t>(u - '0');
+    if (u - 'A' < 26) return static_cast<std::uint8_t>(u - 'A' + 10);
+
+    // A symbol's value follows those of the symbols preceding it
+    u -= ' ';
+    if ((u < 32) && (((Symbol_Mask >> u) & 1) != 0))
+    {
+        return static_cast<std::uint8_t>(
+            36 + std::popcount(Symbol_Mask & ((1u << u) - 1)));
+    }
+
+    return InvalidBase45Character;
+}
+#endif
+
 /*
  *  Encode
  *
@@ -152,25 +285,198 @@ std::string Encode(const std::string_view input)
  */
 std::string Encode(const std::span<const std::uint8_t> input)
 {
-    std::string output;                         // Output string
-    std::size_t group = 0;                      // Group of 16 bits
-    std::size_t group_size = 0;                 // How many octets in group
-
     // Just return an empty string if the input is empty
     if (input.empty()) return {};
 
-    // Reserve space for output
-    if ((input.size() & 1) == 0)
+    // Create an output string of the maximum required size
+    std::string output(MaxEncodedLength(input.size()), '\0');
+
+    // Encode the input into the output string
+    output.resize(Encode(input, output));
+
+    return output;
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base45-encoded string.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base45-encoded string that is to be decoded.
+ *
+ *  Returns:
+ *      The decoded octets, which will be empty if the input string was
+ *      empty or if the input string was not a properly encoded string.
+ *
+ *  Comments:
+ *      To allow for whitespace and multi-line input, any character that is not
+ *      part of the Base45 character set is silently ignored.
+ *
+ *      The alphabet is treated case sensitively as required by RFC 9285.
+ *      Lowercase characters are ignored.
+ */
+std::vector<std::uint8_t> Decode(const std::string_view input)
+{
+    // Just return an empty vector if the input is empty
+    if (input.empty()) return {};
+
+    // Create an output vector large enough to hold the decoded octets
+    std::vector<std::uint8_t> output(MaxDecodedLength(input.size()));
+
+    // Decode the input into the output vector
+    auto length = Decode(input, output);
+
+    // If there was an error decoding, return an empty vector
+    if (!length) return {};
+
+    // Adjust the output vector to the actual decoded length
+    output.resize(*length);
+
+    return output;
+}
+
+/*
+ *  MaxEncodedLength
+ *
+ *  Description:
+ *      This function returns the number of characters required to hold the
+ *      Base45 encoding of the given number of octets.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The number of octets to be encoded.
+ *
+ *  Returns:
+ *      The number of characters required for the encoded string.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MaxEncodedLength(std::size_t length)
+{
+    // Each pair of octets produces three characters and an odd octet two
+    return ((length >> 1) * 3) + ((length & 1) * 2);
+}
+
+/*
+ *  MaxDecodedLength
+ *
+ *  Description:
+ *      This function returns the maximum number of octets that may result
+ *      from decoding a Base45-encoded string of the given length.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The length of the Base45-encoded string.
+ *
+ *  Returns:
+ *      The maximum number of octets the string could decode into.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MaxDecodedLength(std::size_t length)
+{
+    // Each three characters produce two octets and two characters one
+    return ((length / 3) * 2) + (((length % 3) == 2) ? 1 : 0);
+}
+
+/*
+ *  IsValid
+ *
+ *  Description:
+ *      This function will determine whether the given string is properly
+ *      Base45-encoded without decoding it.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base45-encoded string that is to be validated.
+ *
+ *      mode [in]
+ *          The rules to apply (see the declaration).
+ *
+ *  Returns:
+ *      The exact number of octets the string decodes into, or std::nullopt
+ *      if the string is not valid under the given rules.
+ *
+ *  Comments:
+ *      None.
+ */
+std::optional<std::size_t> IsValid(const std::string_view input, Mode mode)
+{
+    using namespace Bases::Validate;
+
+    if (mode == Mode::Lenient)
     {
-        // Even size = input size + (input size / 2)
-        output.reserve(input.size() + (input.size() >> 1));
+        // Count the characters that will be decoded
+        std::size_t count = CountValid(input, ToValue);
+
+        // A residual single character is a length error
+        if ((count % 3) == 1) return {};
+
+        return (count / 3) * 2 + (count % 3) / 2;
     }
-    else
+
+    // Every character must be in the alphabet, with no residual single
+    if (ValidPrefix(input, ToValue) != input.size()) return {};
+    if ((input.size() % 3) == 1) return {};
+
+    // Each group must represent a value that fits in its octets
+    std::size_t i = 0;
+    for (; input.size() - i >= 3; i += 3)
+    {
+        std::uint_fast32_t value = ToValue(input[i]) +
+                                   ToValue(input[i + 1]) * 45 +
+                                   ToValue(input[i + 2]) * 2025;
+        if (value > 0xffff) return {};
+    }
+    if (i < input.size())
     {
-        // Even size = input size + (input size / 2) + 1
-        output.reserve(input.size() + (input.size() >> 1) + 1);
+        std::uint_fast32_t value = ToValue(input[i]) +
+                                   ToValue(input[i + 1]) * 45;
+        if (value > 0xff) return {};
     }
 
+    return (input.size() / 3) * 2 + (input.size() % 3) / 2;
+}
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base45,
+ *      writing the encoded characters into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base45.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.  A buffer
+ *          of MaxEncodedLength(input.size()) characters is always sufficient.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      This function does not allocate memory.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output)
+{
+    std::size_t group = 0;                      // Group of 16 bits
+    std::size_t group_size = 0;                 // How many octets in group
+
+    // Ensure the output buffer is large enough
+    if (output.size() < MaxEncodedLength(input.size())) return 0;
+
+    // Pointer to the next output character
+    char *p = output.data();
+
     // Iterate over the input string to form 16-bit groups
     for (const uint8_t octet : input)
     {
@@ -186,11 +492,11 @@ std::string Encode(const std::span<const std::uint8_t> input)
         // Check if the group is full
         if (group_size == 2)
         {
-            // Convert one group at a time using the Base45Table, appending
+            // Convert one group at a time to characters, appending
             // Base45 characters to the string for each group
-            output += Base45Table[(group       ) % 45];
-            output += Base45Table[(group /   45) % 45];
-            output += Base45Table[(group / 2025) % 45];
+            *p++ = ToCharacter((group       ) % 45);
+            *p++ = ToCharacter((group /   45) % 45);
+            *p++ = ToCharacter((group / 2025) % 45);
 
             // Reset group data
             group_size = 0;
@@ -201,54 +507,51 @@ std::string Encode(const std::span<const std::uint8_t> input)
     // Do we have a partial group to consider?
     if (group_size > 0)
     {
-        // Convert the last group using the Base45Table, appending Base45
+        // Convert the last group to characters, appending Base45
         // characters to the string
-        output += Base45Table[(group     ) % 45];
-        output += Base45Table[(group / 45) % 45];
+        *p++ = ToCharacter((group     ) % 45);
+        *p++ = ToCharacter((group / 45) % 45);
     }
 
-    return output;
+    return static_cast<std::size_t>(p - output.data());
 }
 
 /*
  *  Decode
  *
  *  Description:
- *      This function will decode the Base45-encoded string.
+ *      This function will decode the Base45-encoded string, writing the
+ *      decoded octets into the given output buffer.
  *
  *  Parameters:
  *      input [in]
  *          Base45-encoded string that is to be decoded.
  *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.  A buffer of
+ *          MaxDecodedLength(input.size()) octets is always sufficient.
+ *
  *  Returns:
- *      The decoded octets, which will be empty if the input string was
- *      empty or if the input string was not a properly encoded string.
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
  *
  *  Comments:
- *      To allow for whitespace and multi-line input, any character that is not
- *      part of the Base45 character set is silently ignored.
- *
- *      The alphabet is treated case sensitively as required by RFC 9285.
- *      Lowercase characters are ignored.
+ *      The input is interpreted exactly as it is by the Decode() function
+ *      that returns a vector.  This function does not allocate memory.
  */
-std::vector<std::uint8_t> Decode(const std::string_view input)
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output)
 {
-    std::vector<std::uint8_t> output;           // Output string
     std::uint_fast32_t group = 0;               // Group of 24 bits
     std::uint_fast32_t group_size = 0;          // How many octets in group
-
-    // Just return an empty string if the input is empty
-    if (input.empty()) return {};
-
-    // Reserve space for output (= input size / 1.5)
-    output.reserve(
-        static_cast<std::size_t>(static_cast<double>(input.size()) / 1.5));
+    std::size_t length = 0;                     // Octets written to output
 
     // Iterate over the input string
     for (const char c : input)
     {
         // Determine if we have a valid Base45 character
-        std::uint8_t octet = Base45ReverseTable[static_cast<std::uint8_t>(c)];
+        std::uint8_t octet = ToValue(c);
 
         // Skip over any invalid character in the input
         if (octet == InvalidBase45Character) continue;
@@ -270,9 +573,12 @@ std::vector<std::uint8_t> Decode(const std::string_view input)
                                             ((group >>  8) & 0xff) * 45 +
                                             ((group      ) & 0xff) * 2025;
 
-            // Append the octets to the output string
-            output.push_back((octet_pair >> 8) & 0xff);
-            output.push_back((octet_pair     ) & 0xff);
+            // Ensure there is space in the output buffer
+            if (output.size() - length < 2) return {};
+
+            // Append the octets to the output buffer
+            output[length++] = (octet_pair >> 8) & 0xff;
+            output[length++] = (octet_pair     ) & 0xff;
 
             // Reset group data
             group_size = 0;
@@ -287,12 +593,15 @@ std::vector<std::uint8_t> Decode(const std::string_view input)
         // string length error
         if (group_size != 2) return {};
 
+        // Ensure there is space in the output buffer
+        if (length == output.size()) return {};
+
         // Compute the octet value to convert
-        output.push_back((((group >> 8) & 0xff) +
-                          ((group     ) & 0xff) * 45) & 0xff);
+        output[length++] = (((group >> 8) & 0xff) +
+                            ((group     ) & 0xff) * 45) & 0xff;
     }
 
-    return output;
+    return length;
 }
 
 } // namespace Terra::Base45
@@ -18,12 +18,26 @@
 
 #include <cstdint>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cctype>
 #include <climits>
+#include <cmath>
+#include <cstring>
+#include <mutex>
 #include <terra/bases/base58.h>
 
 namespace Terra::Base58
 {
 
+// Number of leading digits whose value IsValid() computes exactly
+static constexpr std::size_t Prefix_Digits = 10;
+
+// Define an value to represent an invalid Base58 character
+static constexpr std::uint8_t InvalidBase58Character = 255;
+
+#ifndef BASES_COMPACT
 // Define the table used for converting to Base58
 static const char Base58Table[58] =
 {
@@ -34,9 +48,6 @@ static const char Base58Table[58] =
     'u', 'v', 'w', 'x', 'y', 'z'
 };
 
-// Define an value to represent an invalid Base58 character
-static constexpr std::uint8_t InvalidBase58Character = 255;
-
 // Use the C pre-processor to define a macro that will tell us the integer
 // value for any given Base58 character
 #define B58ToInt(x) ( \
@@ -113,15 +124,119 @@ static const std::uint8_t Base58ReverseTable[256] =
     B58ToInt(255)
 };
 
+/*
+ *  ToCharacter
+ *
+ *  Description:
+ *      Return the Base58 character representing the given value.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The value, which must be less than 58.
+ *
+ *  Returns:
+ *      The Base58 character.
+ *
+ *  Comments:
+ *      None.
+ */
+static char ToCharacter(std::uint8_t value)
+{
+    return Base58Table[value];
+}
+
+/*
+ *  ToValue
+ *
+ *  Description:
+ *      Return the value represented by the given Base58 character.
+ *
+ *  Parameters:
+ *      c [in]
+ *          The character.
+ *
+ *  Returns:
+ *      The value, or InvalidBase58Character if the character is not in the
+ *      alphabet.
+ *
+ *  Comments:
+ *      None.
+ */
+static std::uint8_t ToValue(char c)
+{
+    return Base58ReverseTable[static_cast<std::uint8_t>(c)];
+}
+#else
+/*
+ *  ToCharacter
+ *
+ *  Description:
+ *      Return the Base58 character representing the given value.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The value, which must be less than 58.
+ *
+ *  Returns:
+ *      The Base58 character.
+ *
+ *  Comments:
+ *      The character is computed rather than looked up in a table.
+ */
+static char ToCharacter(std::uint8_t value)
+{
+    // The alphabet is six runs of consecutive characters
+    if (value <  9) return static_cast<char>('1' + value);
+    if (value < 17) return static_cast<char>('A' + value - 9);
+    if (value < 22) return static_cast<char>('J' + value - 17);
+    if (value < 33) return static_cast<char>('P' + value - 22);
+    if (value < 44) return static_cast<char>('a' + value - 33);
+
+    return static_cast<char>('m' + value - 44);
+}
+
+/*
+ *  ToValue
+ *
+ *  Description:
+ *      Return the value represented by the given Base58 character.
+ *
+ *  Parameters:
+ *      c [in]
+ *          The character.
+ *
+ *  Returns:
+ *      The value, or InvalidBase58Character if the character is not in the
+ *      alphabet.
+ *
+ *  Comments:
+ *      The value is computed rather than looked up in a table.
+ */
+static std::uint8_t ToValue(char c)
+{
+    unsigned u = static_cast<std::uint8_t>(c);
+
+    // The alphabet is six runs of consecutive characters
+    if (u - '1' <  9) return static_cast<std::uint8_t>(u - '1');
+    if (u - 'A' <  8) return static_cast<std::uint8_t>(u - 'A' + 9);
+    if (u - 'J' <  5) return static_cast<std::uint8_t>(u - 'J' + 17);
+    if (u - 'P' < 11) return static_cast<std::uint8_t>(u - 'P' + 22);
+    if (u - 'a' < 11) return static_cast<std::uint8_t>(u - 'a' + 33);
+    if (u - 'm' < 14) return static_cast<std::uint8_t>(u - 'm' + 44);
+
+    return InvalidBase58Character;
+}
+#endif
+
 /*
  *  Encode
  *
  *  Description:
- *      This function will encode the given string into Base58.
+ *      This function will encode the given binary string into Base58.
  *
  *  Parameters:
  *      input [in]
- *          String to be encoded as Base58.
+ *          Binary string to be encoded as Base58.
  *
  *  Returns:
  *      The Base58-encoded text string.
@@ -143,11 +258,11 @@ std::string Encode(const std::string_view input)
  *  Encode
  *
  *  Description:
- *      This function will encode the given binary string into Base58.
+ *      This function will encode the span of octets into Base58.
  *
  *  Parameters:
  *      input [in]
- *          Binary string to be encoded as Base58.
+ *          Span of octets to be encoded as Base58.
  *
  *  Returns:
  *      The Base58-encoded text string.
@@ -157,16 +272,221 @@ std::string Encode(const std::string_view input)
  */
 std::string Encode(const std::span<const std::uint8_t> input)
 {
-    // Get the initial input length
-    std::size_t input_length = input.size();
+    // Just return an empty string if the input is empty
+    if (input.empty()) return {};
 
-    // If the input length is 0, return an empty string
-    if (input_length == 0) return {};
+    // Create an output string of the maximum required size
+    std::string output(MaxEncodedLength(input.size()), '\0');
+
+    // Encode the input into the output string
+    output.resize(Encode(input, output));
+
+    return output;
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base58-encoded string.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base58-encoded string that is to be decoded.
+ *
+ *  Returns:
+ *      The decoded octets, which will be empty if the input string was
+ *      empty or if the input string was not a properly encoded string.
+ *
+ *  Comments:
+ *      To allow for whitespace and multi-line input, any whitespace character
+ *      is silently ignored (including spaces, tabs, new lines, etc).
+ */
+std::vector<std::uint8_t> Decode(const std::string_view input)
+{
+    // Just return an empty vector if the input is empty
+    if (input.empty()) return {};
+
+    // Create an output vector large enough to hold the decoded octets
+    std::vector<std::uint8_t> output(MaxDecodedLength(input.size()));
+
+    // Decode the input into the output vector
+    auto length = Decode(input, output);
+
+    // If there was an error decoding, return an empty vector
+    if (!length) return {};
+
+    // Adjust the output vector to the actual decoded length
+    output.resize(*length);
+
+    return output;
+}
 
+/*
+ *  MaxEncodedLength
+ *
+ *  Description:
+ *      This function returns the maximum number of characters required to hold
+ *      the Base58 encoding of the given number of octets.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The number of octets to be encoded.
+ *
+ *  Returns:
+ *      The number of characters required for the encoded string.
+ *
+ *  Comments:
+ *      The actual length depends on the value being encoded and may be
+ *      shorter.
+ */
+std::size_t MaxEncodedLength(std::size_t length)
+{
     // Per the implementation in the Bitcoin Core code, the expected length is
     // log(256) / log(58) octets larger than the input
-    std::size_t max_output_length = input_length * 137 / 100 + 1;
-    std::string output(max_output_length, 0);
+    return length * 137 / 100 + 1;
+}
+
+/*
+ *  MaxDecodedLength
+ *
+ *  Description:
+ *      This function returns the maximum number of octets that may result
+ *      from decoding a Base58-encoded string of the given length.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The length of the Base58-encoded string.
+ *
+ *  Returns:
+ *      The maximum number of octets the string could decode into.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MaxDecodedLength(std::size_t length)
+{
+    // Per the implementation in the Bitcoin Core code, the typical length is
+    // (log(58) / log(256)) times the input length; the worst case is that
+    // the decoded length is the same (e.g., all 1s decode as a string of 0x00
+    // values having the same octet length)
+    return length;
+}
+
+/*
+ *  IsValid
+ *
+ *  Description:
+ *      This function will determine whether the given string is properly
+ *      Base58-encoded without decoding it.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base58-encoded string that is to be validated.
+ *
+ *      mode [in]
+ *          The rules to apply (see the declaration).
+ *
+ *  Returns:
+ *      The exact number of octets the string decodes into, or std::nullopt
+ *      if the string is not valid under the given rules.
+ *
+ *  Comments:
+ *      The decoded value lies between P * 58^m and (P + 1) * 58^m, where P
+ *      is the value of the leading digits and m is the number of digits
+ *      that follow.  If the base-256 logarithms of both bounds have the
+ *      same integer part, that determines the number of octets; otherwise,
+ *      the input is decoded to find out.
+ */
+std::optional<std::size_t> IsValid(const std::string_view input, Mode mode)
+{
+    std::size_t zeros = 0;                      // Leading zero octets
+    std::size_t digits = 0;                     // Digits following zeros
+    std::uint64_t prefix = 0;                   // Value of leading digits
+
+    // Classify each character, noting the value of the leading digits
+    for (const char c : input)
+    {
+        std::uint8_t value = ToValue(c);
+
+        if (value == InvalidBase58Character)
+        {
+            // Whitespace is skipped when decoding
+            if ((mode == Mode::Lenient) &&
+                (std::isspace(static_cast<unsigned char>(c)) != 0))
+            {
+                continue;
+            }
+            return {};
+        }
+
+        // Each leading '1' represents a zero octet
+        if ((digits == 0) && (value == 0))
+        {
+            zeros++;
+            continue;
+        }
+
+        if (digits < Prefix_Digits) prefix = prefix * 58 + value;
+        digits++;
+    }
+
+    // If the prefix is the whole value, count its octets directly
+    if (digits <= Prefix_Digits)
+    {
+        return zeros + (std::bit_width(prefix) + 7) / 8;
+    }
+
+    // Bound the number of bits in the value
+    double scale = static_cast<double>(digits - Prefix_Digits) *
+                   std::log2(58.0);
+    double low = std::log2(static_cast<double>(prefix)) + scale;
+    double high = std::log2(static_cast<double>(prefix + 1)) + scale;
+    double margin = 1e-9 + high * 1e-12;
+    double low_octets = std::floor((low - margin) / 8);
+    double high_octets = std::floor((high + margin) / 8);
+
+    // If both bounds need the same number of octets, that is the answer
+    if (low_octets == high_octets)
+    {
+        return zeros + static_cast<std::size_t>(low_octets) + 1;
+    }
+
+    // Otherwise, decode the input to determine its length
+    Bases::ScratchOctets buffer(MaxDecodedLength(input.size()));
+    return Decode(input, buffer);
+}
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base58,
+ *      writing the encoded characters into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base58.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.  A buffer
+ *          of MaxEncodedLength(input.size()) characters is always sufficient.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      This function does not allocate memory.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output)
+{
+    // Get the initial input length
+    std::size_t input_length = input.size();
+
+    // If the input length is 0, return an empty string
+    if (input_length == 0) return 0;
 
     // Initialize the count of leading zeros
     std::size_t zeros = 0;
@@ -174,83 +494,86 @@ std::string Encode(const std::span<const std::uint8_t> input)
     // Count the leading zeros
     for(std::size_t i = 0; (i < input_length) && (input[i] == 0); i++) zeros++;
 
-    std::size_t output_length = zeros;
+    // Each leading zero is represented by a single character
+    if (zeros > output.size()) return 0;
+
+    // Base58 digits are computed least significant first into the output
+    std::size_t digits = 0;
 
     // Iterate over the input string
     for (std::size_t i = zeros; i < input_length; i++)
     {
         std::uint32_t carry = static_cast<std::uint8_t>(input[i]);
 
-        // Iterate over the output string to incrementally convert bases
-        for (std::size_t j = zeros; j < max_output_length; j++)
+        // Iterate over the output digits to incrementally convert bases
+        for (std::size_t j = 0; j < digits; j++)
         {
-            // At the end of the output buffer?
-            if (j == output_length)
-            {
-                // Break if there are no more carry bits
-                if (carry == 0) break;
-
-                // Increment the output length
-                output_length++;
-            }
-            carry += static_cast<std::uint8_t>(output[j - zeros]) << 8;
-            output[j - zeros] =
+            carry += static_cast<std::uint8_t>(output[j]) << 8;
+            output[j] =
                 static_cast<char>(static_cast<std::uint8_t>(carry % 58));
             carry /= 58;
         }
 
-        // If there are remaining carry bits, this is an error
-        if (carry > 0) return {};
+        // Append digits while there are remaining carry bits
+        while (carry > 0)
+        {
+            // If the output buffer is full, this is an error
+            if (zeros + digits == output.size()) return 0;
+
+            output[digits++] =
+                static_cast<char>(static_cast<std::uint8_t>(carry % 58));
+            carry /= 58;
+        }
     }
 
-    // Truncate the output string to the correct size (counted 0s at the end)
-    output.resize(output_length);
+    // Leading zeros are represented by the digit value 0
+    std::fill(output.begin() + digits, output.begin() + digits + zeros, 0);
+
+    // Determine the total length of the encoded string
+    std::size_t output_length = digits + zeros;
 
     // Perform Base58 character substitution
-    for (std::size_t i = 0; i <= output_length; i++)
+    for (std::size_t i = 0; i < output_length; i++)
     {
-        output[i] = Base58Table[static_cast<std::uint8_t>(output[i])];
+        output[i] = ToCharacter(static_cast<std::uint8_t>(output[i]));
     }
 
     // Reverse the order of character string
-    std::reverse(std::begin(output), std::end(output));
+    std::reverse(output.begin(), output.begin() + output_length);
 
-    return output;
+    return output_length;
 }
 
 /*
  *  Decode
  *
  *  Description:
- *      This function will decode the Base58-encoded string.
+ *      This function will decode the Base58-encoded string, writing the
+ *      decoded octets into the given output buffer.
  *
  *  Parameters:
  *      input [in]
  *          Base58-encoded string that is to be decoded.
  *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.  A buffer of
+ *          MaxDecodedLength(input.size()) octets is always sufficient.
+ *
  *  Returns:
- *      The decoded octets, which will be empty if the input string was
- *      empty or if the input string was not a properly encoded string.
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
  *
  *  Comments:
- *      To allow for whitespace and multi-line input, any whitespace character
- *      is silently ignored (including spaces, tabs, new lines, etc).
+ *      The input is interpreted exactly as it is by the Decode() function
+ *      that returns a vector.  This function does not allocate memory.
  */
-std::vector<std::uint8_t> Decode(const std::string_view input)
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output)
 {
     // Get the initial input length
     std::size_t input_length = input.length();
 
-    // If the input length is 0, return an empty string
-    if (input_length == 0) return {};
-
-    // Per the implementation in the Bitcoin Core code, the typical length is
-    // (log(58) / log(256)) times the input length; the worst case is that
-    // the decoded length is the same (e.g., all 1s decode as a string of 0x00
-    // values having the same octet length)
-    std::size_t max_output_length = input_length;
-    std::vector<std::uint8_t> output(max_output_length, 0);
-
     // Initialize the count of leading zeros
     std::size_t zeros = 0;
 
@@ -269,7 +592,7 @@ std::vector<std::uint8_t> Decode(const std::string_view input)
         }
 
         // Skip over whitespace
-        if (std::isspace(input[i]) != 0)
+        if (std::isspace(static_cast<unsigned char>(input[i])) != 0)
         {
             digits_start++;
             continue;
@@ -279,51 +602,605 @@ std::vector<std::uint8_t> Decode(const std::string_view input)
         break;
     }
 
-    // Start with an assumed output length of 0
+    // Each leading zero is represented by a single octet
+    if (zeros > output.size()) return {};
+
+    // Octets are computed least significant first into the output
     std::size_t output_length = 0;
 
     // Iterate over the Base58 input string, ignoring whitespace
     for (std::size_t i = digits_start; i < input_length; i++)
     {
         // Skip over whitespace
-        if (std::isspace(input[i]) != 0) continue;
+        if (std::isspace(static_cast<unsigned char>(input[i])) != 0) continue;
 
         // Translate the character to the Base58 integer value
-        std::uint32_t carry =
-            Base58ReverseTable[static_cast<std::uint8_t>(input[i])];
+        std::uint32_t carry = ToValue(input[i]);
 
         // If it is not a valid character, return an empty string
         if (carry == InvalidBase58Character) return {};
 
-        // Iterate over the output string to incrementally convert bases
-        for (std::size_t j = 0; j < max_output_length; j++)
+        // Iterate over the output octets to incrementally convert bases
+        for (std::size_t j = 0; j < output_length; j++)
         {
-            // At the end of the output buffer?
-            if (j == output_length)
+            carry += 58 * static_cast<std::uint32_t>(output[j]);
+            output[j] = static_cast<std::uint8_t>(carry % 256);
+            carry /= 256;
+        }
+
+        // Append octets while there are remaining carry bits
+        while (carry > 0)
+        {
+            // If the output buffer is full, this is an error
+            if (zeros + output_length == output.size()) return {};
+
+            output[output_length++] = static_cast<std::uint8_t>(carry % 256);
+            carry /= 256;
+        }
+    }
+
+    // Append the count of zeros
+    std::fill(output.begin() + output_length,
+              output.begin() + output_length + zeros,
+              0);
+    output_length += zeros;
+
+    // Reverse the order of the binary output
+    std::reverse(output.begin(), output.begin() + output_length);
+
+    return output_length;
+}
+
+// Number of 64-bit words holding a cached value and its encoding
+static constexpr std::size_t Key_Words = Cache::Key_Length / 8;
+static constexpr std::size_t Text_Words =
+    (Cache::Max_Encoded_Length + 7) / 8;
+
+// A cache entry; a length of zero indicates that the entry is empty
+struct CacheEntry
+{
+    std::atomic<std::uint32_t> sequence{0};     // Odd while being written
+    std::atomic<std::uint8_t> length{0};        // Length of the encoding
+    std::atomic<bool> referenced{false};        // Found since last passed
+    std::array<std::atomic<std::uint64_t>, Key_Words> key{};
+    std::array<std::atomic<std::uint64_t>, Text_Words> text{};
+};
+
+// A set of entries to which a value maps, with its CLOCK hand
+struct CacheSet
+{
+    std::array<CacheEntry, Cache::Ways> entries;
+    std::size_t hand = 0;                       // Guarded by the shard lock
+};
+
+// A shard, whose lock serializes insertions into its sets
+struct Cache::Shard
+{
+    std::mutex mutex;
+    std::unique_ptr<CacheSet[]> sets;
+    alignas(64) std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+    std::atomic<std::uint64_t> insertions{0};
+    std::atomic<std::uint64_t> evictions{0};
+};
+
+/*
+ *  LoadKey
+ *
+ *  Description:
+ *      Load a cache key into 64-bit words.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The Cache::Key_Length octets of the key.
+ *
+ *  Returns:
+ *      The key as words.
+ *
+ *  Comments:
+ *      Words are copied in native byte order; they are only compared.
+ */
+static std::array<std::uint64_t, Key_Words> LoadKey(
+                                        const std::span<const std::uint8_t> key)
+{
+    std::array<std::uint64_t, Key_Words> words;
+
+    std::memcpy(words.data(), key.data(), Cache::Key_Length);
+
+    return words;
+}
+
+/*
+ *  WriteEntry
+ *
+ *  Description:
+ *      Replace the contents of a cache entry.
+ *
+ *  Parameters:
+ *      entry [in/out]
+ *          The entry to write.
+ *
+ *      key [in]
+ *          The key to store.
+ *
+ *      encoded [in]
+ *          The encoding to store, which is empty to clear the entry.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The caller must hold the shard lock.  The sequence number is odd
+ *      while the entry is written so that concurrent lookups ignore it.
+ */
+static void WriteEntry(CacheEntry &entry,
+                       const std::array<std::uint64_t, Key_Words> &key,
+                       const std::string_view encoded)
+{
+    std::array<std::uint64_t, Text_Words> text{};
+    std::uint32_t sequence = entry.sequence.load(std::memory_order_relaxed);
+
+    if (!encoded.empty())
+    {
+        std::memcpy(text.data(), encoded.data(), encoded.size());
+    }
+
+    // Mark the entry as being written before changing its contents
+    entry.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (std::size_t i = 0; i < Key_Words; i++)
+    {
+        entry.key[i].store(key[i], std::memory_order_relaxed);
+    }
+    for (std::size_t i = 0; i < Text_Words; i++)
+    {
+        entry.text[i].store(text[i], std::memory_order_relaxed);
+    }
+    entry.length.store(static_cast<std::uint8_t>(encoded.size()),
+                       std::memory_order_relaxed);
+    entry.referenced.store(false, std::memory_order_relaxed);
+
+    // Publish the new contents
+    entry.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/*
+ *  ReadEntry
+ *
+ *  Description:
+ *      Read a cache entry if it holds the given key.
+ *
+ *  Parameters:
+ *      entry [in]
+ *          The entry to read.
+ *
+ *      key [in]
+ *          The key being sought.
+ *
+ *      text [out]
+ *          The encoding, if the entry holds the key.
+ *
+ *  Returns:
+ *      The length of the encoding, or zero if the entry is empty, holds
+ *      another key, or was being written while it was read.
+ *
+ *  Comments:
+ *      No lock is taken.
+ */
+static std::size_t ReadEntry(const CacheEntry &entry,
+                             const std::array<std::uint64_t, Key_Words> &key,
+                             std::array<std::uint64_t, Text_Words> &text)
+{
+    std::uint32_t sequence = entry.sequence.load(std::memory_order_acquire);
+
+    // Skip entries that are being written
+    if ((sequence & 1) != 0) return 0;
+
+    // Compare the key before reading the encoding
+    for (std::size_t i = 0; i < Key_Words; i++)
+    {
+        if (entry.key[i].load(std::memory_order_relaxed) != key[i]) return 0;
+    }
+    std::size_t length = entry.length.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < Text_Words; i++)
+    {
+        text[i] = entry.text[i].load(std::memory_order_relaxed);
+    }
+
+    // Discard what was read if the entry changed in the meantime
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (entry.sequence.load(std::memory_order_relaxed) != sequence) return 0;
+
+    return length;
+}
+
+/*
+ *  Cache::Cache
+ *
+ *  Description:
+ *      Constructor for the Cache object, which allocates every entry.
+ *
+ *  Parameters:
+ *      capacity [in]
+ *          The minimum number of entries to hold.
+ *
+ *      shards [in]
+ *          The number of shards, which is rounded up to a power of two.
+ *          More shards reduce contention among threads inserting entries.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Each entry occupies approximately 96 octets.
+ */
+Cache::Cache(std::size_t capacity, std::size_t shards) :
+    shard_count{std::bit_ceil(std::max<std::size_t>(shards, 1))},
+    set_count{std::bit_ceil(std::max<std::size_t>(
+        (capacity + shard_count * Ways - 1) / (shard_count * Ways), 1))},
+    shard_bits{static_cast<unsigned>(std::countr_zero(shard_count))},
+    shards{std::make_unique<Shard[]>(shard_count)}
+{
+    for (std::size_t i = 0; i < shard_count; i++)
+    {
+        this->shards[i].sets = std::make_unique<CacheSet[]>(set_count);
+    }
+}
+
+/*
+ *  Cache::~Cache
+ *
+ *  Description:
+ *      Destructor for the Cache object.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+Cache::~Cache() = default;
+
+/*
+ *  Cache::Locate
+ *
+ *  Description:
+ *      Determine the shard and set to which a key maps.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The Key_Length octets of the key.
+ *
+ *      set [out]
+ *          The index of the set within the shard.
+ *
+ *  Returns:
+ *      The shard.
+ *
+ *  Comments:
+ *      Cached values are typically hashes or keys, so a simple mix of their
+ *      words distributes them well.
+ */
+Cache::Shard &Cache::Locate(const std::span<const std::uint8_t> key,
+                            std::size_t &set) const
+{
+    auto words = LoadKey(key);
+    std::uint64_t hash = words[0] ^ std::rotl(words[1], 17) ^
+                         std::rotl(words[2], 31) ^ std::rotl(words[3], 47);
+
+    hash *= 0x9e3779b97f4a7c15;
+    hash ^= hash >> 29;
+
+    set = static_cast<std::size_t>(hash >> shard_bits) & (set_count - 1);
+
+    return shards[static_cast<std::size_t>(hash) & (shard_count - 1)];
+}
+
+/*
+ *  Cache::Find
+ *
+ *  Description:
+ *      Look up the encoding of a value.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The value, which must be Key_Length octets long.
+ *
+ *      output [out]
+ *          Buffer into which the encoding is written if found.
+ *
+ *  Returns:
+ *      The length of the encoding, or zero if the value was not found, the
+ *      key is not Key_Length octets long, or the output buffer is too small.
+ *
+ *  Comments:
+ *      No lock is taken.  A value being inserted by another thread may not
+ *      be found.
+ */
+std::size_t Cache::Find(const std::span<const std::uint8_t> key,
+                        std::span<char> output)
+{
+    std::array<std::uint64_t, Text_Words> text;
+    std::size_t set_index;
+
+    if (key.size() != Key_Length) return 0;
+
+    Shard &shard = Locate(key, set_index);
+    CacheSet &set = shard.sets[set_index];
+    auto words = LoadKey(key);
+
+    for (auto &entry : set.entries)
+    {
+        std::size_t length = ReadEntry(entry, words, text);
+        if ((length == 0) || (length > output.size())) continue;
+
+        // Mark the entry as recently used, avoiding needless writes
+        if (!entry.referenced.load(std::memory_order_relaxed))
+        {
+            entry.referenced.store(true, std::memory_order_relaxed);
+        }
+
+        std::memcpy(output.data(), text.data(), length);
+        shard.hits.fetch_add(1, std::memory_order_relaxed);
+
+        return length;
+    }
+
+    shard.misses.fetch_add(1, std::memory_order_relaxed);
+
+    return 0;
+}
+
+/*
+ *  Cache::Insert
+ *
+ *  Description:
+ *      Insert the encoding of a value, evicting another entry if the set to
+ *      which it maps is full.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The value, which must be Key_Length octets long.
+ *
+ *      encoded [in]
+ *          The Base58 encoding of the value.
+ *
+ *  Returns:
+ *      True if the entry was inserted or was already present, or false if
+ *      the key or encoding has an invalid length.
+ *
+ *  Comments:
+ *      The encoding is not verified; callers must insert correct encodings.
+ */
+bool Cache::Insert(const std::span<const std::uint8_t> key,
+                   const std::string_view encoded)
+{
+    std::array<std::uint64_t, Text_Words> text;
+    std::size_t set_index;
+
+    if ((key.size() != Key_Length) || encoded.empty() ||
+        (encoded.size() > Max_Encoded_Length))
+    {
+        return false;
+    }
+
+    Shard &shard = Locate(key, set_index);
+    CacheSet &set = shard.sets[set_index];
+    auto words = LoadKey(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // Another thread may have inserted the value already
+    for (auto &entry : set.entries)
+    {
+        if (ReadEntry(entry, words, text) > 0) return true;
+    }
+
+    // Advance the clock hand past recently used entries, clearing their
+    // reference bits, until reaching an empty or unused entry
+    while (true)
+    {
+        CacheEntry &entry = set.entries[set.hand];
+        set.hand = (set.hand + 1) % Ways;
+
+        if (entry.length.load(std::memory_order_relaxed) != 0)
+        {
+            if (entry.referenced.exchange(false, std::memory_order_relaxed))
             {
-                // Break if there are no more carry bits
-                if (carry == 0) break;
+                continue;
+            }
+            shard.evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        WriteEntry(entry, words, encoded);
+        shard.insertions.fetch_add(1, std::memory_order_relaxed);
+
+        break;
+    }
+
+    return true;
+}
 
-                // Increment the output length
-                output_length++;
+/*
+ *  Cache::Clear
+ *
+ *  Description:
+ *      Remove every entry from the cache.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Statistics are not reset.
+ */
+void Cache::Clear()
+{
+    for (std::size_t i = 0; i < shard_count; i++)
+    {
+        std::lock_guard<std::mutex> lock(shards[i].mutex);
+
+        for (std::size_t j = 0; j < set_count; j++)
+        {
+            for (auto &entry : shards[i].sets[j].entries)
+            {
+                if (entry.length.load(std::memory_order_relaxed) == 0)
+                {
+                    continue;
+                }
+                WriteEntry(entry, {}, {});
             }
-            carry += 58 * static_cast<std::uint8_t>(output[j]);
-            output[j] = static_cast<char>(carry % 256);
-            carry /= 256;
+            shards[i].sets[j].hand = 0;
         }
+    }
+}
+
+/*
+ *  Cache::GetStatistics
+ *
+ *  Description:
+ *      Return the sum of every shard's counters.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The counters.  The hit rate is hits / (hits + misses).
+ *
+ *  Comments:
+ *      None.
+ */
+Cache::Statistics Cache::GetStatistics() const noexcept
+{
+    Statistics statistics;
+
+    for (std::size_t i = 0; i < shard_count; i++)
+    {
+        const Shard &shard = shards[i];
 
-        // If there are remaining carry bits, this is an error
-        if (carry > 0) return {};
+        statistics.hits += shard.hits.load(std::memory_order_relaxed);
+        statistics.misses += shard.misses.load(std::memory_order_relaxed);
+        statistics.insertions +=
+            shard.insertions.load(std::memory_order_relaxed);
+        statistics.evictions +=
+            shard.evictions.load(std::memory_order_relaxed);
     }
 
-    // Adjust the output length
-    output.resize(output_length);
+    return statistics;
+}
 
-    // Append the count of zeros
-    if (zeros > 0) output.resize(output.size() + zeros, 0);
+/*
+ *  Cache::ResetStatistics
+ *
+ *  Description:
+ *      Set every counter to zero.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Cache::ResetStatistics() noexcept
+{
+    for (std::size_t i = 0; i < shard_count; i++)
+    {
+        shards[i].hits.store(0, std::memory_order_relaxed);
+        shards[i].misses.store(0, std::memory_order_relaxed);
+        shards[i].insertions.store(0, std::memory_order_relaxed);
+        shards[i].evictions.store(0, std::memory_order_relaxed);
+    }
+}
 
-    // Reverse the order of the binary output
-    std::reverse(std::begin(output), std::end(output));
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base58,
+ *      consulting the given cache, and write the encoded characters into
+ *      the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base58.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.  A buffer
+ *          of MaxEncodedLength(input.size()) characters is always sufficient.
+ *
+ *      cache [in/out]
+ *          The cache to consult.  If the input is Cache::Key_Length octets
+ *          long and is not found, its encoding is inserted.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      Inputs of any other length are encoded without consulting the cache.
+ *      This function does not allocate memory.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output,
+                   Cache &cache)
+{
+    // Only values of the cached length are looked up
+    if (input.size() != Cache::Key_Length) return Encode(input, output);
+
+    // Return the cached encoding, if present
+    std::size_t length = cache.Find(input, output);
+    if (length > 0) return length;
+
+    // Encode the input and remember the result
+    length = Encode(input, output);
+    if (length > 0)
+    {
+        cache.Insert(input, std::string_view(output.data(), length));
+    }
+
+    return length;
+}
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base58,
+ *      consulting the given cache.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base58.
+ *
+ *      cache [in/out]
+ *          The cache to consult.  If the input is Cache::Key_Length octets
+ *          long and is not found, its encoding is inserted.
+ *
+ *  Returns:
+ *      The Base58-encoded text string.
+ *
+ *  Comments:
+ *      Inputs of any other length are encoded without consulting the cache.
+ */
+std::string Encode(const std::span<const std::uint8_t> input, Cache &cache)
+{
+    // Just return an empty string if the input is empty
+    if (input.empty()) return {};
+
+    // Create an output string of the maximum required size
+    std::string output(MaxEncodedLength(input.size()), '\0');
+
+    // Encode the input into the output string
+    output.resize(Encode(input, output, cache));
 
     return output;
 }
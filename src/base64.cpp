@@ -16,13 +16,39 @@
  *      Requires C++20 or later.
  */
 
+#include <algorithm>
 #include <cstdint>
 #include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 #include <terra/bases/base64.h>
+#include "parallel.h"
+#include "simd.h"
+#include "tuning.h"
+#include "validate.h"
 
 namespace Terra::Base64
 {
 
+// Define the padding octet
+static constexpr char Base64PaddingCharacter = '=';
+
+// Define an value to represent an invalid Base64 character
+static constexpr std::uint8_t InvalidBase64Character = 255;
+
+// Characters for values 0 through 61 that kernels may compute rather than
+// look up, shared by the standard alphabet and several others
+static constexpr std::string_view Computed_Characters =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+// The standard alphabet's characters for values 62 and 63, followed by
+// their alternates (see Alphabet::ComputedCharacters())
+static constexpr char Standard_Computed_Characters[] = {'+', '/', '+', '/'};
+
+#ifndef BASES_COMPACT
 // Define the table used for converting to Base64
 static const char Base64Table[64] =
 {
@@ -33,12 +59,6 @@ static const char Base64Table[64] =
     '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
 };
 
-// Define the padding octet
-static constexpr char Base64PaddingCharacter = '=';
-
-// Define an value to represent an invalid Base64 character
-static constexpr std::uint8_t InvalidBase64Character = 255;
-
 // Use the C pre-processor to define a macro that will tell us the integer
 // value for any given Base64 character
 #define B64ToInt(x) ( \
@@ -117,60 +137,190 @@ static const std::uint8_t Base64ReverseTable[256] =
     B64ToInt(255)
 };
 
+// Tables passed to the kernels for the standard alphabet
+static constexpr const char *Standard_Table = Base64Table;
+static constexpr const std::uint8_t *Standard_Reverse_Table =
+    Base64ReverseTable;
+
 /*
- *  Encode
+ *  ToCharacter
  *
  *  Description:
- *      This function will encode the given string into Base64.
+ *      Return the character representing the given 6-bit value.
  *
  *  Parameters:
- *      input [in]
- *          String to be encoded as Base64.
+ *      value [in]
+ *          The value, which must be less than 64.
+ *
+ *      table [in]
+ *          Table of 64 characters used to represent each 6-bit value.
  *
  *  Returns:
- *      The Base64-encoded text string.
+ *      The character.
  *
  *  Comments:
  *      None.
  */
-std::string Encode(const std::string_view input)
+static char ToCharacter(std::uint8_t value, const char *table)
 {
-    // This library assumes the width of char is 8 bits
-    static_assert(CHAR_BIT == 8);
+    return table[value];
+}
 
-    return Encode(std::span<const std::uint8_t>{
-        reinterpret_cast<const uint8_t *>(input.data()),
-        input.size()});
+/*
+ *  ToValue
+ *
+ *  Description:
+ *      Return the 6-bit value represented by the given character.
+ *
+ *  Parameters:
+ *      c [in]
+ *          The character.
+ *
+ *      reverse_table [in]
+ *          Table of 256 values mapping characters to 6-bit values, with
+ *          characters not in the alphabet mapped to InvalidBase64Character.
+ *
+ *  Returns:
+ *      The value, or InvalidBase64Character if the character is not in the
+ *      alphabet.
+ *
+ *  Comments:
+ *      None.
+ */
+static std::uint8_t ToValue(char c, const std::uint8_t *reverse_table)
+{
+    return reverse_table[static_cast<std::uint8_t>(c)];
 }
+#else
+// The standard alphabet is computed rather than looked up, so the kernels
+// are given no tables for it
+static constexpr const char *Standard_Table = nullptr;
+static constexpr const std::uint8_t *Standard_Reverse_Table = nullptr;
 
 /*
- *  Encode
+ *  ToCharacter
  *
  *  Description:
- *      This function will encode the span of octets into Base64.
+ *      Return the character representing the given 6-bit value.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The value, which must be less than 64.
+ *
+ *      table [in]
+ *          Table of 64 characters used to represent each 6-bit value, or
+ *          nullptr for the standard alphabet.
+ *
+ *  Returns:
+ *      The character.
+ *
+ *  Comments:
+ *      Characters of the standard alphabet are computed rather than looked
+ *      up in a table.
+ */
+static char ToCharacter(std::uint8_t value, const char *table)
+{
+    if (table != nullptr) return table[value];
+
+    if (value < 26) return static_cast<char>('A' + value);
+    if (value < 52) return static_cast<char>('a' + value - 26);
+    if (value < 62) return static_cast<char>('0' + value - 52);
+
+    return (value == 62) ? '+' : '/';
+}
+
+/*
+ *  ToValue
+ *
+ *  Description:
+ *      Return the 6-bit value represented by the given character.
+ *
+ *  Parameters:
+ *      c [in]
+ *          The character.
+ *
+ *      reverse_table [in]
+ *          Table of 256 values mapping characters to 6-bit values, with
+ *          characters not in the alphabet mapped to InvalidBase64Character,
+ *          or nullptr for the standard alphabet.
+ *
+ *  Returns:
+ *      The value, or InvalidBase64Character if the character is not in the
+ *      alphabet.
+ *
+ *  Comments:
+ *      Values of the standard alphabet are computed rather than looked up
+ *      in a table.
+ */
+static std::uint8_t ToValue(char c, const std::uint8_t *reverse_table)
+{
+    unsigned u = static_cast<std::uint8_t>(c);
+
+    if (reverse_table != nullptr) return reverse_table[u];
+
+    if (u - 'A' < 26) return static_cast<std::uint8_t>(u - 'A');
+    if (u - 'a' < 26) return static_cast<std::uint8_t>(u - 'a' + 26);
+    if (u - '0' < 10) return static_cast<std::uint8_t>(u - '0' + 52);
+    if (u == '+') return 62;
+    if (u == '/') return 63;
+
+    return InvalidBase64Character;
+}
+#endif
+
+// Kernel function types
+using EncodeKernel = std::size_t (*)(const std::span<const std::uint8_t>,
+                                     char *,
+                                     const char *,
+                                     bool,
+                                     const char *);
+using DecodeKernel = std::optional<std::size_t> (*)(const std::string_view,
+                                                    std::span<std::uint8_t>,
+                                                    const std::uint8_t *,
+                                                    const char *);
+
+/*
+ *  EncodeScalar
+ *
+ *  Description:
+ *      This kernel encodes one octet at a time, emitting four characters
+ *      each time a 24-bit group is complete.
  *
  *  Parameters:
  *      input [in]
  *          Span of octets to be encoded as Base64.
  *
+ *      output [out]
+ *          Buffer into which the encoded characters are written, which must
+ *          be at least MaxEncodedLength(input.size()) characters.
+ *
+ *      table [in]
+ *          Table of 64 characters used to represent each 6-bit value, or
+ *          nullptr for the standard alphabet in the compact build.
+ *
+ *      padding [in]
+ *          True if padding characters should be appended to the output.
+ *
+ *      computed [in]
+ *          Not used by this kernel (see EncodeSimd()).
+ *
  *  Returns:
- *      The Base64-encoded text string.
+ *      The number of characters written to the output buffer.
  *
  *  Comments:
  *      None.
  */
-std::string Encode(const std::span<const std::uint8_t> input)
+static std::size_t EncodeScalar(const std::span<const std::uint8_t> input,
+                                char *output,
+                                const char *table,
+                                bool padding,
+                                const char *)
 {
-    std::string output;                         // Output string
     std::size_t group = 0;                      // Group of 24 bits
     std::size_t group_size = 0;                 // How many bits in group
 
-    // Just return an empty string if the input is empty
-    if (input.empty()) return {};
-
-    // Estimate the size of the output to avoid repetitive buffer resizing
-    output.reserve((((4 * input.size()) / 3) + 3) &
-                   ~static_cast<std::size_t>(3));
+    // Pointer to the next output character
+    char *p = output;
 
     // Iterate over the input string to form 24-bit groups
     for (const std::uint8_t octet : input)
@@ -187,12 +337,12 @@ std::string Encode(const std::span<const std::uint8_t> input)
         // Check if the group is full
         if (group_size == 24)
         {
-            // Convert 6 bits at a time using the Base64Table, appending Base64
+            // Convert 6 bits at a time using the table, appending Base64
             // characters to the string for each of the 6 bits
-            output += Base64Table[(group >> 18) & 0x3f];
-            output += Base64Table[(group >> 12) & 0x3f];
-            output += Base64Table[(group >> 6 ) & 0x3f];
-            output += Base64Table[(group      ) & 0x3f];
+            *p++ = ToCharacter((group >> 18) & 0x3f, table);
+            *p++ = ToCharacter((group >> 12) & 0x3f, table);
+            *p++ = ToCharacter((group >> 6 ) & 0x3f, table);
+            *p++ = ToCharacter((group      ) & 0x3f, table);
 
             // Reset group data
             group_size = 0;
@@ -206,73 +356,79 @@ std::string Encode(const std::span<const std::uint8_t> input)
         // Shift the group variable so we have a full 24 bits of data
         group <<= (24 - group_size);
 
-        // Convert 6 bits at a time using the Base64Table
-        output += Base64Table[(group >> 18) & 0x3f];
-        output += Base64Table[(group >> 12) & 0x3f];
-        if (group_size == 8)
-        {
-            // We have only one residual octet, so we append two padding octets
-            output += Base64PaddingCharacter;
-            output += Base64PaddingCharacter;
-        }
-        else
+        // Convert 6 bits at a time using the table
+        *p++ = ToCharacter((group >> 18) & 0x3f, table);
+        *p++ = ToCharacter((group >> 12) & 0x3f, table);
+
+        // If there are two residual octets, there are 6 more bits to output
+        if (group_size == 16) *p++ = ToCharacter((group >> 6) & 0x3f, table);
+
+        // Append one padding character per missing character, if requested
+        if (padding)
         {
-            // We have two residual octets, so we have an additional 6 bits
-            // to output and then one padding octet
-            output += Base64Table[(group >> 6) & 0x3f];
-            output += Base64PaddingCharacter;
+            *p++ = Base64PaddingCharacter;
+            if (group_size == 8) *p++ = Base64PaddingCharacter;
         }
     }
 
-    return output;
+    return static_cast<std::size_t>(p - output);
 }
 
 /*
- *  Decode
+ *  DecodeScalar
  *
  *  Description:
- *      This function will decode the Base64-encoded string.
+ *      This kernel decodes one character at a time using the given reverse
+ *      lookup table.
  *
  *  Parameters:
  *      input [in]
  *          Base64-encoded string that is to be decoded.
  *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *      reverse_table [in]
+ *          Table of 256 values mapping characters to 6-bit values, with
+ *          characters not in the alphabet mapped to InvalidBase64Character,
+ *          or nullptr for the standard alphabet in the compact build.
+ *
+ *      computed [in]
+ *          Not used by this kernel (see DecodeSimd()).
+ *
  *  Returns:
- *      The decoded octets, which will be empty if the input string was
- *      empty or if the input string was not a properly encoded string.
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the output buffer was too small.
  *
  *  Comments:
- *      The '=' padding character(s) may be missing from the end of the string,
- *      since some implementations fail to add those.  Decoding will cease once
- *      padding characters are encountered and any residual data in the input
- *      string is ignored and not counted as an error.
- *
- *      To allow for spacing, control characters, etc., any character that is
- *      not part of the character set is silently ignored.
+ *      Decoding ceases at the first padding character, unless the padding
+ *      character is a member of the alphabet.
  */
-std::vector<std::uint8_t> Decode(const std::string_view input)
+static std::optional<std::size_t> DecodeScalar(
+                                        const std::string_view input,
+                                        std::span<std::uint8_t> output,
+                                        const std::uint8_t *reverse_table,
+                                        const char *)
 {
-    std::vector<std::uint8_t> output;           // Output octets
     std::uint_fast32_t group = 0;               // Group of 24 bits
     std::uint_fast32_t group_size = 0;          // How many bits in group
-
-    // Just return an empty string if the input is empty
-    if (input.empty()) return {};
-
-    // Estimate the size of the output to avoid repetitive buffer resizing
-    output.reserve(((3 * input.size()) / 4) + 1);
+    std::size_t length = 0;                     // Octets written to output
 
     // Iterate over the input span
     for (const char c : input)
     {
-        // Terminate the loop if we find a padding character
-        if (c == Base64PaddingCharacter) break;
-
         // Determine if we have a valid Base64 character
-        std::uint8_t octet = Base64ReverseTable[static_cast<std::uint8_t>(c)];
+        std::uint8_t octet = ToValue(c, reverse_table);
+
+        // Check for characters outside of the alphabet
+        if (octet == InvalidBase64Character)
+        {
+            // Terminate the loop if we find a padding character
+            if (c == Base64PaddingCharacter) break;
 
-        // Skip over any invalid character in the input
-        if (octet == InvalidBase64Character) continue;
+            // Skip over any other invalid character in the input
+            continue;
+        }
 
         // Shift the group by 6 bits (no effect if group == 0)
         group <<= 6;
@@ -286,10 +442,13 @@ std::vector<std::uint8_t> Decode(const std::string_view input)
         // Check if the group is full
         if (group_size == 24)
         {
-            // Append the octets to the output string
-            output.push_back((group >> 16) & 0xff);
-            output.push_back((group >>  8) & 0xff);
-            output.push_back((group      ) & 0xff);
+            // Ensure there is space in the output buffer
+            if (output.size() - length < 3) return {};
+
+            // Append the octets to the output buffer
+            output[length++] = (group >> 16) & 0xff;
+            output[length++] = (group >>  8) & 0xff;
+            output[length++] = (group      ) & 0xff;
 
             // Reset group data
             group_size = 0;
@@ -303,16 +462,2664 @@ std::vector<std::uint8_t> Decode(const std::string_view input)
         // Shift all bits in the group left, padding the group with zeros
         group <<= (24 - group_size);
 
-        // Append the octets to the output string
-        output.push_back((group >> 16) & 0xff);
-        if (group_size >= 16)
+        // Ensure there is space in the output buffer
+        if (output.size() - length < ((group_size >= 16) ? 2 : 1)) return {};
+
+        // Append the octets to the output buffer
+        output[length++] = (group >> 16) & 0xff;
+        if (group_size >= 16) output[length++] = (group >> 8) & 0xff;
+    }
+
+    return length;
+}
+
+#ifndef BASES_COMPACT
+/*
+ *  EncodeBlock
+ *
+ *  Description:
+ *      This kernel encodes three octets (one 24-bit quantum) at a time, then
+ *      encodes any residual octets with EncodeScalar().
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base64.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written, which must
+ *          be at least MaxEncodedLength(input.size()) characters.
+ *
+ *      table [in]
+ *          Table of 64 characters used to represent each 6-bit value.
+ *
+ *      padding [in]
+ *          True if padding characters should be appended to the output.
+ *
+ *      computed [in]
+ *          Not used by this kernel (see EncodeSimd()).
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+static std::size_t EncodeBlock(const std::span<const std::uint8_t> input,
+                               char *output,
+                               const char *table,
+                               bool padding,
+                               const char *)
+{
+    const std::uint8_t *q = input.data();       // Next input octet
+    std::size_t quanta = input.size() / 3;      // Full quanta in input
+    char *p = output;                           // Next output character
+
+    // Encode each full 24-bit quantum as four characters
+    for (std::size_t i = 0; i < quanta; i++, q += 3)
+    {
+        std::uint32_t group = (static_cast<std::uint32_t>(q[0]) << 16) |
+                              (static_cast<std::uint32_t>(q[1]) <<  8) |
+                              (static_cast<std::uint32_t>(q[2])      );
+
+        p[0] = table[(group >> 18) & 0x3f];
+        p[1] = table[(group >> 12) & 0x3f];
+        p[2] = table[(group >>  6) & 0x3f];
+        p[3] = table[(group      ) & 0x3f];
+        p += 4;
+    }
+
+    // Encode the residual octets, including any padding
+    p += EncodeScalar(input.subspan(quanta * 3), p, table, padding, nullptr);
+
+    return static_cast<std::size_t>(p - output);
+}
+
+/*
+ *  DecodeBlock
+ *
+ *  Description:
+ *      This kernel decodes four characters (one 24-bit quantum) at a time
+ *      until it encounters a character outside of the alphabet (including
+ *      padding), at which point the remaining input is decoded with
+ *      DecodeScalar().
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *      reverse_table [in]
+ *          Table of 256 values mapping characters to 6-bit values, with
+ *          characters not in the alphabet mapped to InvalidBase64Character.
+ *
+ *      computed [in]
+ *          Not used by this kernel (see DecodeSimd()).
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the output buffer was too small.
+ *
+ *  Comments:
+ *      All four lookups are validated with a single test, since an invalid
+ *      character maps to a value having the high bits set.
+ */
+static std::optional<std::size_t> DecodeBlock(
+                                        const std::string_view input,
+                                        std::span<std::uint8_t> output,
+                                        const std::uint8_t *reverse_table,
+                                        const char *)
+{
+    std::size_t i = 0;                          // Input position
+    std::size_t length = 0;                     // Octets written to output
+
+    // Decode full quanta while all characters are in the alphabet
+    while ((input.size() - i >= 4) && (output.size() - length >= 3))
+    {
+        std::uint32_t a = reverse_table[static_cast<std::uint8_t>(input[i])];
+        std::uint32_t b =
+            reverse_table[static_cast<std::uint8_t>(input[i + 1])];
+        std::uint32_t c =
+            reverse_table[static_cast<std::uint8_t>(input[i + 2])];
+        std::uint32_t d =
+            reverse_table[static_cast<std::uint8_t>(input[i + 3])];
+
+        if (((a | b | c | d) & 0xc0) != 0) break;
+
+        std::uint32_t group = (a << 18) | (b << 12) | (c << 6) | d;
+
+        output[length++] = static_cast<std::uint8_t>(group >> 16);
+        output[length++] = static_cast<std::uint8_t>(group >>  8);
+        output[length++] = static_cast<std::uint8_t>(group      );
+        i += 4;
+    }
+
+    // Decode anything remaining one character at a time
+    auto remaining = DecodeScalar(input.substr(i),
+                                  output.subspan(length),
+                                  reverse_table,
+                                  nullptr);
+    if (!remaining) return {};
+
+    return length + *remaining;
+}
+
+/*
+ *  EncodeSmall
+ *
+ *  Description:
+ *      This kernel encodes six octets at a time as eight characters written
+ *      with a single store, and encodes the residual octets without
+ *      branching on their number.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base64.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written, which must
+ *          be at least MaxEncodedLength(input.size()) characters.
+ *
+ *      table [in]
+ *          Table of 64 characters used to represent each 6-bit value.
+ *
+ *      padding [in]
+ *          True if padding characters should be appended to the output.
+ *
+ *      computed [in]
+ *          Not used by this kernel (see EncodeSimd()).
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer.
+ *
+ *  Comments:
+ *      This is intended for inputs of up to Small_Input_Limit octets (e.g.,
+ *      digests and keys).  The residual octets are encoded from a
+ *      zero-filled quantum, with the characters to emit selected by the
+ *      number of residual octets rather than by separate code paths.
+ */
+static std::size_t EncodeSmall(const std::span<const std::uint8_t> input,
+                               char *output,
+                               const char *table,
+                               bool padding,
+                               const char *)
+{
+    const std::uint8_t *q = input.data();       // Next input octet
+    const std::size_t quanta = input.size() / 3;
+    const std::size_t residual = input.size() % 3;
+    char *p = output;                           // Next output character
+    char characters[8];
+
+    // Encode each pair of full quanta as eight characters
+    for (std::size_t i = 0; i + 2 <= quanta; i += 2, q += 6, p += 8)
+    {
+        std::uint64_t group = (static_cast<std::uint64_t>(q[0]) << 40) |
+                              (static_cast<std::uint64_t>(q[1]) << 32) |
+                              (static_cast<std::uint64_t>(q[2]) << 24) |
+                              (static_cast<std::uint64_t>(q[3]) << 16) |
+                              (static_cast<std::uint64_t>(q[4]) <<  8) |
+                              (static_cast<std::uint64_t>(q[5])      );
+
+        for (std::size_t j = 0; j < 8; j++)
         {
-            output.push_back((group >> 8) & 0xff);
-            if (group_size == 24) output.push_back((group) & 0xff);
+            characters[j] = table[(group >> (42 - j * 6)) & 0x3f];
         }
+        std::memcpy(p, characters, 8);
     }
 
-    return output;
+    // Encode any remaining full quantum
+    if ((quanta % 2) != 0)
+    {
+        std::uint32_t group = (static_cast<std::uint32_t>(q[0]) << 16) |
+                              (static_cast<std::uint32_t>(q[1]) <<  8) |
+                              (static_cast<std::uint32_t>(q[2])      );
+
+        for (std::size_t j = 0; j < 4; j++)
+        {
+            characters[j] = table[(group >> (18 - j * 6)) & 0x3f];
+        }
+        std::memcpy(p, characters, 4);
+        q += 3;
+        p += 4;
+    }
+
+    // Encode the residual octets from a zero-filled quantum
+    std::uint8_t last[3] = {};
+    std::copy_n(q, residual, last);
+    std::uint32_t group = (static_cast<std::uint32_t>(last[0]) << 16) |
+                          (static_cast<std::uint32_t>(last[1]) <<  8);
+    characters[0] = table[(group >> 18) & 0x3f];
+    characters[1] = table[(group >> 12) & 0x3f];
+    characters[2] = (residual == 2) ? table[(group >> 6) & 0x3f] :
+                                      Base64PaddingCharacter;
+    characters[3] = Base64PaddingCharacter;
+
+    // Emit nothing, the significant characters, or a padded quantum
+    std::size_t count = (residual == 0) ? 0 : padding ? 4 : residual + 1;
+    std::copy_n(characters, count, p);
+
+    return static_cast<std::size_t>(p - output) + count;
 }
 
-} // namespace Terra::Base64
+/*
+ *  DecodeSmall
+ *
+ *  Description:
+ *      This kernel decodes four characters at a time, accumulating the
+ *      validity of every character and testing it once at the end, and
+ *      decodes the residual characters without branching on their number.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *      reverse_table [in]
+ *          Table of 256 values mapping characters to 6-bit values, with
+ *          characters not in the alphabet mapped to InvalidBase64Character.
+ *
+ *      computed [in]
+ *          Not used by this kernel (see DecodeSimd()).
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the output buffer was too small.
+ *
+ *  Comments:
+ *      Up to two trailing padding characters are set aside first.  Input
+ *      containing any other character outside of the alphabet, or an output
+ *      buffer too small to hold the result, is decoded by DecodeBlock().
+ */
+static std::optional<std::size_t> DecodeSmall(
+                                        const std::string_view input,
+                                        std::span<std::uint8_t> output,
+                                        const std::uint8_t *reverse_table,
+                                        const char *)
+{
+    std::size_t n = input.size();
+
+    // Set aside trailing padding, unless it is a member of the alphabet
+    if (reverse_table[static_cast<std::uint8_t>(Base64PaddingCharacter)] ==
+        InvalidBase64Character)
+    {
+        n -= (n > 0) && (input[n - 1] == Base64PaddingCharacter);
+        n -= (n > 0) && (input[n - 1] == Base64PaddingCharacter);
+    }
+
+    // Residual characters produce 0, 1, 1, or 2 octets, as in DecodeScalar()
+    const std::size_t quanta = n / 4;
+    const std::size_t residual = n % 4;
+    const std::size_t length = quanta * 3 + (residual + 1) / 2;
+
+    // Defer to the general decoder if the output buffer is too small
+    if (output.size() < length)
+    {
+        return DecodeBlock(input, output, reverse_table, nullptr);
+    }
+
+    const char *c = input.data();               // Next input character
+    std::uint8_t *o = output.data();            // Next output octet
+    std::uint32_t invalid = 0;                  // Union of all values
+
+    // Decode each full quantum
+    for (std::size_t i = 0; i < quanta; i++, c += 4, o += 3)
+    {
+        std::uint32_t a = reverse_table[static_cast<std::uint8_t>(c[0])];
+        std::uint32_t b = reverse_table[static_cast<std::uint8_t>(c[1])];
+        std::uint32_t d = reverse_table[static_cast<std::uint8_t>(c[2])];
+        std::uint32_t e = reverse_table[static_cast<std::uint8_t>(c[3])];
+        invalid |= a | b | d | e;
+
+        std::uint32_t group = (a << 18) | (b << 12) | (d << 6) | e;
+        o[0] = static_cast<std::uint8_t>(group >> 16);
+        o[1] = static_cast<std::uint8_t>(group >>  8);
+        o[2] = static_cast<std::uint8_t>(group      );
+    }
+
+    // Decode the residual characters as a zero-filled quantum
+    std::uint32_t group = 0;
+    for (std::size_t i = 0; i < 3; i++)
+    {
+        std::uint32_t value =
+            (i < residual) ? reverse_table[static_cast<std::uint8_t>(c[i])] :
+                             0;
+        invalid |= value;
+        group |= (value & 0x3f) << (18 - i * 6);
+    }
+    std::uint8_t last[2] = {static_cast<std::uint8_t>(group >> 16),
+                            static_cast<std::uint8_t>(group >>  8)};
+    std::copy_n(last, (residual + 1) / 2, o);
+
+    // Defer to the general decoder if any character was not in the alphabet
+    if ((invalid & 0xc0) != 0)
+    {
+        return DecodeBlock(input, output, reverse_table, nullptr);
+    }
+
+    return length;
+}
+
+#ifdef BASES_SIMD
+/*
+ *  EncodeSimd
+ *
+ *  Description:
+ *      This kernel encodes a vector of 24-bit quanta at a time using
+ *      portable SIMD arithmetic, then encodes any residual octets with
+ *      EncodeBlock().
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base64.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written, which must
+ *          be at least MaxEncodedLength(input.size()) characters.
+ *
+ *      table [in]
+ *          Table of 64 characters used to represent each 6-bit value.
+ *
+ *      padding [in]
+ *          True if padding characters should be appended to the output.
+ *
+ *      computed [in]
+ *          The alphabet's characters for values 62 and 63, followed by their
+ *          alternates, if the alphabet's other characters may be computed
+ *          (see Alphabet::ComputedCharacters()), or nullptr otherwise.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer.
+ *
+ *  Comments:
+ *      Characters are computed arithmetically, so only alphabets that share
+ *      the first 62 characters of the standard alphabet (e.g., base64url)
+ *      are encoded with SIMD; others, for which computed is nullptr, are
+ *      encoded with EncodeBlock().
+ */
+static std::size_t EncodeSimd(const std::span<const std::uint8_t> input,
+                              char *output,
+                              const char *table,
+                              bool padding,
+                              const char *computed)
+{
+    using namespace Bases::Simd;
+    using Wide = Vector<std::uint32_t>;
+    constexpr std::size_t N = Wide::size();
+
+    std::size_t i = 0;                          // Input position
+    char *p = output;                           // Next output character
+
+    // Use the block kernel for alphabets that cannot be computed
+    if (computed == nullptr)
+    {
+        return EncodeBlock(input, output, table, padding, nullptr);
+    }
+
+    const auto character_62 = static_cast<std::uint8_t>(computed[0]);
+    const auto character_63 = static_cast<std::uint8_t>(computed[1]);
+
+    // Encode a vector of quanta at a time
+    for (; input.size() - i >= 3 * N; i += 3 * N, p += 4 * N)
+    {
+        const std::uint8_t *q = input.data() + i;
+        Wide groups([q](auto j)
+        {
+            return (std::uint32_t(q[j * 3    ]) << 16) |
+                   (std::uint32_t(q[j * 3 + 1]) <<  8) |
+                   (std::uint32_t(q[j * 3 + 2])      );
+        });
+        Wide characters = 0;
+
+        // Convert each 6-bit value to a character
+        for (unsigned k = 0; k < 4; k++)
+        {
+            Wide values = (groups >> (18 - k * 6)) & 0x3f;
+            Wide character = values + std::uint32_t('A');
+            where(values > 25, character) = values + std::uint32_t('a' - 26);
+            where(values > 51, character) = values - std::uint32_t(52 - '0');
+            where(values == 62, character) = character_62;
+            where(values == 63, character) = character_63;
+            characters |= Place(character, k);
+        }
+
+        Store(p, characters);
+    }
+
+    // Encode the residual octets, including any padding
+    p += EncodeBlock(input.subspan(i), p, table, padding, nullptr);
+
+    return static_cast<std::size_t>(p - output);
+}
+
+/*
+ *  DecodeSimd
+ *
+ *  Description:
+ *      This kernel decodes a vector of 4-character quanta at a time using
+ *      portable SIMD arithmetic until it encounters a character outside of
+ *      the alphabet (including padding), at which point the remaining input
+ *      is decoded with DecodeBlock().
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *      reverse_table [in]
+ *          Table of 256 values mapping characters to 6-bit values, with
+ *          characters not in the alphabet mapped to InvalidBase64Character.
+ *
+ *      computed [in]
+ *          The alphabet's characters for values 62 and 63, followed by their
+ *          alternates, if the alphabet's other characters may be computed
+ *          (see Alphabet::ComputedCharacters()), or nullptr otherwise.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the output buffer was too small.
+ *
+ *  Comments:
+ *      As with EncodeSimd(), only alphabets that share the first 62
+ *      characters of the standard alphabet are decoded with SIMD; others
+ *      are decoded with DecodeBlock().  Alternate characters for values
+ *      other than 62 and 63 are treated as characters outside of the
+ *      alphabet, so input containing them is decoded with DecodeBlock()
+ *      from that point.
+ */
+static std::optional<std::size_t> DecodeSimd(
+                                        const std::string_view input,
+                                        std::span<std::uint8_t> output,
+                                        const std::uint8_t *reverse_table,
+                                        const char *computed)
+{
+    using namespace Bases::Simd;
+    using Wide = Vector<std::uint32_t>;
+    constexpr std::size_t N = Wide::size();
+
+    std::size_t i = 0;                          // Input position
+    std::size_t length = 0;                     // Octets written to output
+
+    // Use the block kernel for alphabets that cannot be computed
+    if (computed == nullptr)
+    {
+        return DecodeBlock(input, output, reverse_table, nullptr);
+    }
+
+    const std::uint32_t character_62 = static_cast<std::uint8_t>(computed[0]);
+    const std::uint32_t character_63 = static_cast<std::uint8_t>(computed[1]);
+    const std::uint32_t alternate_62 = static_cast<std::uint8_t>(computed[2]);
+    const std::uint32_t alternate_63 = static_cast<std::uint8_t>(computed[3]);
+
+    // Decode a vector of quanta at a time
+    while ((input.size() - i >= 4 * N) && (output.size() - length >= 3 * N))
+    {
+        Wide characters = Load<std::uint32_t>(input.data() + i);
+        Wide groups = 0;
+        Wide invalid = 0;
+
+        // Convert each character to its 6-bit value, flagging invalid ones
+        for (unsigned k = 0; k < 4; k++)
+        {
+            Wide character = Byte(characters, k);
+            Wide upper = character - std::uint32_t('A');
+            Wide lower = character - std::uint32_t('a');
+            Wide digit = character - std::uint32_t('0');
+            Wide values = 0x100;
+            where(upper < 26, values) = upper;
+            where(lower < 26, values) = lower + 26;
+            where(digit < 10, values) = digit + 52;
+            where(character == character_62, values) = 62;
+            where(character == character_63, values) = 63;
+            where(character == alternate_62, values) = 62;
+            where(character == alternate_63, values) = 63;
+            invalid |= values;
+            groups = (groups << 6) | (values & 0x3f);
+        }
+
+        if (any_of(invalid > 0x3f)) break;
+
+        // Write the three octets of each quantum
+        std::uint32_t quanta[N];
+        groups.copy_to(quanta, stdx::element_aligned);
+        for (std::size_t j = 0; j < N; j++)
+        {
+            output[length++] = static_cast<std::uint8_t>(quanta[j] >> 16);
+            output[length++] = static_cast<std::uint8_t>(quanta[j] >>  8);
+            output[length++] = static_cast<std::uint8_t>(quanta[j]      );
+        }
+
+        i += 4 * N;
+    }
+
+    // Decode anything remaining
+    auto remaining = DecodeBlock(input.substr(i),
+                                 output.subspan(length),
+                                 reverse_table,
+                                 nullptr);
+    if (!remaining) return {};
+
+    return length + *remaining;
+}
+#endif
+#endif
+
+/*
+ *  RunEncode
+ *
+ *  Description:
+ *      Invoke the given encode kernel repeatedly for tuning.
+ *
+ *  Parameters:
+ *      kernel [in]
+ *          The kernel to invoke.
+ *
+ *      size [in]
+ *          Number of octets to encode.
+ *
+ *      iterations [in]
+ *          Number of times to invoke the kernel.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+static void RunEncode(EncodeKernel kernel,
+                      std::size_t size,
+                      std::size_t iterations)
+{
+    Bases::ScratchOctets input(size);
+    Bases::ScratchString output(MaxEncodedLength(size), '\0');
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        input[i] = static_cast<std::uint8_t>(i * 131 + 17);
+    }
+
+    for (std::size_t i = 0; i < iterations; i++)
+    {
+        kernel(input,
+               output.data(),
+               Standard_Table,
+               true,
+               Standard_Computed_Characters);
+    }
+}
+
+/*
+ *  RunDecode
+ *
+ *  Description:
+ *      Invoke the given decode kernel repeatedly for tuning.
+ *
+ *  Parameters:
+ *      kernel [in]
+ *          The kernel to invoke.
+ *
+ *      size [in]
+ *          Number of octets represented by the text to decode.
+ *
+ *      iterations [in]
+ *          Number of times to invoke the kernel.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+static void RunDecode(DecodeKernel kernel,
+                      std::size_t size,
+                      std::size_t iterations)
+{
+    Bases::ScratchOctets input(size);
+    Bases::ScratchString text(MaxEncodedLength(size), '\0');
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        input[i] = static_cast<std::uint8_t>(i * 131 + 17);
+    }
+    EncodeScalar(input, text.data(), Standard_Table, true, nullptr);
+
+    for (std::size_t i = 0; i < iterations; i++)
+    {
+        kernel(text,
+               input,
+               Standard_Reverse_Table,
+               Standard_Computed_Characters);
+    }
+}
+
+// Define the candidate kernels for each operation
+static constexpr Bases::Tuning::Kernel<EncodeKernel> Encode_Kernels[] =
+{
+    {"scalar", EncodeScalar, nullptr},
+#ifndef BASES_COMPACT
+    {"block", EncodeBlock, nullptr},
+    {"small", EncodeSmall, nullptr},
+#ifdef BASES_SIMD
+    {"simd", EncodeSimd, nullptr}
+#endif
+#endif
+};
+static constexpr Bases::Tuning::Kernel<DecodeKernel> Decode_Kernels[] =
+{
+    {"scalar", DecodeScalar, nullptr},
+#ifndef BASES_COMPACT
+    {"block", DecodeBlock, nullptr},
+    {"small", DecodeSmall, nullptr},
+#ifdef BASES_SIMD
+    {"simd", DecodeSimd, nullptr}
+#endif
+#endif
+};
+
+// Define the default kernels for small and large inputs (the compact build
+// has only one kernel)
+#ifdef BASES_COMPACT
+static constexpr std::size_t Small_Input_Kernel = 0;
+static constexpr std::size_t Large_Input_Kernel = 0;
+#else
+static constexpr std::size_t Small_Input_Kernel = 2;
+static constexpr std::size_t Large_Input_Kernel = 1;
+#endif
+
+// Define the kernel selectors
+static constinit Bases::Tuning::KernelSelector<EncodeKernel> Encoder(
+    "base64.encode",
+    Encode_Kernels,
+    RunEncode,
+    Small_Input_Kernel,
+    Large_Input_Kernel);
+static constinit Bases::Tuning::KernelSelector<DecodeKernel> Decoder(
+    "base64.decode",
+    Decode_Kernels,
+    RunDecode,
+    Small_Input_Kernel,
+    Large_Input_Kernel);
+
+/*
+ *  EncodeOctets
+ *
+ *  Description:
+ *      This function will encode the span of octets into Base64 using the
+ *      given character table, writing the output into the given buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base64.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.
+ *
+ *      table [in]
+ *          Table of 64 characters used to represent each 6-bit value.
+ *
+ *      padding [in]
+ *          True if padding characters should be appended to the output.
+ *
+ *      computed [in]
+ *          The alphabet's characters for values 62 and 63 followed by their
+ *          alternates if its other characters may be computed, or nullptr.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      None.
+ */
+static std::size_t EncodeOctets(const std::span<const std::uint8_t> input,
+                                std::span<char> output,
+                                const char *table,
+                                bool padding,
+                                const char *computed)
+{
+    // Ensure the output buffer is large enough
+    if (output.size() < MaxEncodedLength(input.size())) return 0;
+
+    // Encode using the kernel selected for this input size
+    return Encoder.Select(input.size())(input,
+                                        output.data(),
+                                        table,
+                                        padding,
+                                        computed);
+}
+
+/*
+ *  DecodeText
+ *
+ *  Description:
+ *      This function will decode the Base64-encoded string using the given
+ *      reverse lookup table, writing the output into the given buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *      reverse_table [in]
+ *          Table of 256 values mapping characters to 6-bit values, with
+ *          characters not in the alphabet mapped to InvalidBase64Character.
+ *
+ *      computed [in]
+ *          The alphabet's characters for values 62 and 63 followed by their
+ *          alternates if its other characters may be computed, or nullptr.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the output buffer was too small.
+ *
+ *  Comments:
+ *      Decoding ceases at the first padding character, unless the padding
+ *      character is a member of the alphabet.
+ */
+static std::optional<std::size_t> DecodeText(
+                                        const std::string_view input,
+                                        std::span<std::uint8_t> output,
+                                        const std::uint8_t *reverse_table,
+                                        const char *computed)
+{
+    // Decode using the kernel selected for this input size
+    return Decoder.Select(input.size())(input,
+                                        output,
+                                        reverse_table,
+                                        computed);
+}
+
+/*
+ *  ReverseBits
+ *
+ *  Description:
+ *      Reverse the order of the bits in each octet if the alphabet assigns
+ *      bits to characters least significant first.
+ *
+ *  Parameters:
+ *      octets [in/out]
+ *          The octets to modify.
+ *
+ *      alphabet [in]
+ *          The alphabet in use.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Encoding octets least significant first is the same as encoding the
+ *      bit-reversed octets most significant first with a table indexed by
+ *      bit-reversed values, which is how such alphabets are stored.  So,
+ *      octets are reversed on the way into the encoder and out of the
+ *      decoder.
+ */
+static void ReverseBits(std::span<std::uint8_t> octets,
+                        const Alphabet &alphabet)
+{
+    if (alphabet.Order() == BitOrder::MostSignificantFirst) return;
+
+    for (auto &octet : octets)
+    {
+        octet = static_cast<std::uint8_t>(((octet & 0xf0) >> 4) |
+                                          ((octet & 0x0f) << 4));
+        octet = static_cast<std::uint8_t>(((octet & 0xcc) >> 2) |
+                                          ((octet & 0x33) << 2));
+        octet = static_cast<std::uint8_t>(((octet & 0xaa) >> 1) |
+                                          ((octet & 0x55) << 1));
+    }
+}
+
+/*
+ *  EncodeAlphabet
+ *
+ *  Description:
+ *      This function will encode the span of octets into Base64 using the
+ *      given alphabet, writing the output into the given buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base64.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.
+ *
+ *      alphabet [in]
+ *          The alphabet to use for encoding.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      If the alphabet assigns bits least significant first, the input is
+ *      reversed into a local buffer one block at a time, so memory is not
+ *      allocated.
+ */
+static std::size_t EncodeAlphabet(const std::span<const std::uint8_t> input,
+                                  std::span<char> output,
+                                  const Alphabet &alphabet)
+{
+    const char *table = alphabet.Table().data();
+
+    if (alphabet.Order() == BitOrder::MostSignificantFirst)
+    {
+        return EncodeOctets(input,
+                            output,
+                            table,
+                            alphabet.Padding(),
+                            alphabet.ComputedCharacters());
+    }
+
+    // Ensure the output buffer is large enough
+    if (output.size() < MaxEncodedLength(input.size())) return 0;
+
+    // Encode blocks of whole quanta, so only the last may be partial
+    std::uint8_t block[768];
+    std::size_t length = 0;
+    for (std::size_t offset = 0; offset < input.size(); offset += sizeof(block))
+    {
+        auto chunk = input.subspan(offset,
+                                   std::min(sizeof(block),
+                                            input.size() - offset));
+        std::copy(chunk.begin(), chunk.end(), block);
+        ReverseBits(std::span(block, chunk.size()), alphabet);
+        length += EncodeOctets(std::span(block, chunk.size()),
+                               output.subspan(length),
+                               table,
+                               alphabet.Padding(),
+                               alphabet.ComputedCharacters());
+    }
+
+    return length;
+}
+
+/*
+ *  IsForgivingWhitespace
+ *
+ *  Description:
+ *      Determine whether the character is ASCII whitespace as defined by the
+ *      WHATWG Infra Standard.
+ *
+ *  Parameters:
+ *      c [in]
+ *          The character to test.
+ *
+ *  Returns:
+ *      True if the character is a tab, line feed, form feed, carriage
+ *      return, or space.
+ *
+ *  Comments:
+ *      Unlike std::isspace(), vertical tab is not whitespace.
+ */
+static constexpr bool IsForgivingWhitespace(char c)
+{
+    return (c == '\t') || (c == '\n') || (c == '\f') || (c == '\r') ||
+           (c == ' ');
+}
+
+/*
+ *  ScanForgiving
+ *
+ *  Description:
+ *      This function applies the WHATWG forgiving-base64 rules to the input,
+ *      passing each run of alphabet characters to the given function.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be scanned.
+ *
+ *      reverse_table [in]
+ *          Table of 256 values mapping characters to 6-bit values, with
+ *          characters not in the alphabet mapped to InvalidBase64Character.
+ *
+ *      on_run [in]
+ *          Function called with each run of alphabet characters, in order,
+ *          returning false to stop the scan.
+ *
+ *  Returns:
+ *      The number of alphabet characters in the input, or std::nullopt if
+ *      the input is not valid or a call to on_run returned false.
+ *
+ *  Comments:
+ *      Whitespace is ignored.  After it is removed, the input is valid if
+ *      the only other characters are up to two padding characters that end
+ *      a string whose length is a multiple of four, and the number of
+ *      alphabet characters does not leave a remainder of one when divided
+ *      by four.  Unused trailing bits need not be zero.
+ */
+template<typename RunFunction>
+static std::optional<std::size_t> ScanForgiving(
+                                        const std::string_view input,
+                                        const std::uint8_t *reverse_table,
+                                        RunFunction on_run)
+{
+    auto classify = [reverse_table](char c)
+    {
+        return ToValue(c, reverse_table);
+    };
+    std::size_t data = 0;                       // Alphabet characters
+    std::size_t padding = 0;                    // Padding characters
+    std::size_t i = 0;                          // Input position
+
+    while (i < input.size())
+    {
+        // Pass along the run of alphabet characters beginning here
+        std::size_t run =
+            Bases::Validate::ValidPrefix(input.substr(i), classify);
+        if (run > 0)
+        {
+            if ((padding > 0) || !on_run(input.substr(i, run))) return {};
+            data += run;
+            i += run;
+            continue;
+        }
+
+        // Otherwise, only padding and whitespace are permitted
+        if (input[i] == Base64PaddingCharacter)
+        {
+            padding++;
+        }
+        else if (!IsForgivingWhitespace(input[i]))
+        {
+            return {};
+        }
+        i++;
+    }
+
+    // Padding is removed only if it completes the final quantum
+    if ((padding > 2) || ((padding > 0) && (((data + padding) % 4) != 0)))
+    {
+        return {};
+    }
+
+    // A single residual character is a length error
+    if ((data % 4) == 1) return {};
+
+    return data;
+}
+
+/*
+ *  DecodeForgiving
+ *
+ *  Description:
+ *      This function will decode the Base64-encoded string using the given
+ *      reverse lookup table according to the WHATWG forgiving-base64 rules,
+ *      writing the output into the given buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *      reverse_table [in]
+ *          Table of 256 values mapping characters to 6-bit values, with
+ *          characters not in the alphabet mapped to InvalidBase64Character.
+ *
+ *      computed [in]
+ *          The alphabet's characters for values 62 and 63 followed by their
+ *          alternates if its other characters may be computed, or nullptr.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input is not valid or the output buffer was too small.
+ *
+ *  Comments:
+ *      The input is not copied to remove whitespace.  Instead, the whole
+ *      quanta of each run of alphabet characters are decoded in place by
+ *      the selected kernel, and the characters of a quantum divided by
+ *      whitespace are gathered and decoded separately.  The contents of the
+ *      output buffer are unspecified if the input is not valid.
+ */
+static std::optional<std::size_t> DecodeForgiving(
+                                        const std::string_view input,
+                                        std::span<std::uint8_t> output,
+                                        const std::uint8_t *reverse_table,
+                                        const char *computed)
+{
+    char quantum[4];                            // Quantum split by whitespace
+    std::size_t gathered = 0;                   // Characters in quantum
+    std::size_t length = 0;                     // Octets written to output
+
+    // Decode the given characters, appending to the output
+    auto decode = [&](const std::string_view text)
+    {
+        auto decoded = DecodeText(text,
+                                  output.subspan(length),
+                                  reverse_table,
+                                  computed);
+        if (!decoded) return false;
+        length += *decoded;
+        return true;
+    };
+
+    auto decode_run = [&](std::string_view run)
+    {
+        // Complete a quantum begun in an earlier run
+        if (gathered > 0)
+        {
+            while ((gathered < 4) && !run.empty())
+            {
+                quantum[gathered++] = run.front();
+                run.remove_prefix(1);
+            }
+            if (gathered < 4) return true;
+            gathered = 0;
+            if (!decode(std::string_view(quantum, 4))) return false;
+        }
+
+        // Decode the whole quanta and set aside the rest
+        std::size_t whole = run.size() - (run.size() % 4);
+        if ((whole > 0) && !decode(run.substr(0, whole))) return false;
+        for (char c : run.substr(whole)) quantum[gathered++] = c;
+
+        return true;
+    };
+
+    if (!ScanForgiving(input, reverse_table, decode_run)) return {};
+
+    // Decode the final partial quantum, discarding unused bits
+    if ((gathered > 0) && !decode(std::string_view(quantum, gathered)))
+    {
+        return {};
+    }
+
+    return length;
+}
+
+/*
+ *  ValidateText
+ *
+ *  Description:
+ *      This function will determine whether the given string is properly
+ *      Base64-encoded using the given reverse lookup table.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be validated.
+ *
+ *      mode [in]
+ *          The rules to apply.
+ *
+ *      reverse_table [in]
+ *          Table of 256 values mapping characters to 6-bit values, with
+ *          characters not in the alphabet mapped to InvalidBase64Character.
+ *
+ *      padding [in]
+ *          True if the alphabet calls for padding.
+ *
+ *  Returns:
+ *      The exact number of octets the string decodes into, or std::nullopt
+ *      if the string is not valid under the given rules.
+ *
+ *  Comments:
+ *      The padding character is treated as data if it is a member of the
+ *      alphabet.
+ */
+static std::optional<std::size_t> ValidateText(
+                                        const std::string_view input,
+                                        Mode mode,
+                                        const std::uint8_t *reverse_table,
+                                        bool padding)
+{
+    using namespace Bases::Validate;
+
+    // Determine whether the padding character terminates the data
+    const bool terminator =
+        ToValue(Base64PaddingCharacter, reverse_table) ==
+        InvalidBase64Character;
+
+    // Classify characters using the given table
+    auto classify = [reverse_table](char c)
+    {
+        return ToValue(c, reverse_table);
+    };
+
+    if (mode == Mode::Forgiving)
+    {
+        auto data = ScanForgiving(input,
+                                  reverse_table,
+                                  [](std::string_view) { return true; });
+        if (!data) return {};
+
+        // Residual characters produce 0, 1, or 2 octets
+        return *data * 3 / 4;
+    }
+
+    if (mode == Mode::Lenient)
+    {
+        // Count the characters before any padding, skipping all others
+        std::size_t count = CountValid(
+            terminator ? input.substr(0, input.find(Base64PaddingCharacter)) :
+                         input,
+            classify);
+
+        // Residual characters produce 0, 1, 1, or 2 octets
+        return (count / 4) * 3 + (count % 4 + 1) / 2;
+    }
+
+    std::string_view text = input;
+
+    // Set aside up to two trailing padding characters, if called for
+    if (padding && terminator)
+    {
+        if ((input.size() % 4) != 0) return {};
+        std::size_t data = input.find_last_not_of(Base64PaddingCharacter);
+        data = (data == std::string_view::npos) ? 0 : data + 1;
+        if (input.size() - data > 2) return {};
+        text = input.substr(0, data);
+    }
+
+    // Everything else must be in the alphabet
+    std::size_t count = ValidPrefix(text, classify);
+    if (count != text.size()) return {};
+
+    // A single residual character is a length error
+    if ((count % 4) == 1) return {};
+
+    // Bits that do not complete an octet must be zero
+    if (!TrailingBitsZero(text, classify, 6, (count * 6) % 8)) return {};
+
+    return count * 3 / 4;
+}
+
+/*
+ *  Alphabet::Alphabet
+ *
+ *  Description:
+ *      Constructor for the Alphabet object, which generates the reverse
+ *      lookup table for the given characters.
+ *
+ *  Parameters:
+ *      characters [in]
+ *          The 64 characters of the alphabet, ordered by the 6-bit value
+ *          each represents.
+ *
+ *      padding [in]
+ *          True if '=' padding should be appended when encoding.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the alphabet does not contain
+ *      exactly 64 distinct characters, or if it contains the '=' character
+ *      while padding is requested.
+ */
+Alphabet::Alphabet(const std::string_view characters, bool padding) :
+    table{},
+    padding{padding},
+    bit_order{BitOrder::MostSignificantFirst},
+    computed_characters{},
+    computed{false}
+{
+    // Ensure the alphabet is of the correct length
+    if (characters.size() != table.size())
+    {
+        throw std::invalid_argument("Base64 alphabet must have 64 characters");
+    }
+
+    // Initially, mark all characters as invalid
+    reverse_table.fill(InvalidBase64Character);
+
+    for (std::size_t i = 0; i < characters.size(); i++)
+    {
+        const auto c = static_cast<std::uint8_t>(characters[i]);
+
+        // Ensure the character is not repeated
+        if (reverse_table[c] != InvalidBase64Character)
+        {
+            throw std::invalid_argument(
+                "Base64 alphabet characters must be unique");
+        }
+
+        // The padding character cannot also be a member of the alphabet
+        if (padding && (characters[i] == Base64PaddingCharacter))
+        {
+            throw std::invalid_argument(
+                "Base64 alphabet cannot contain the padding character");
+        }
+
+        table[i] = characters[i];
+        reverse_table[c] = static_cast<std::uint8_t>(i);
+    }
+
+    // Note whether kernels may compute all but the last two characters
+    computed = characters.starts_with(Computed_Characters);
+    computed_characters = {characters[62],
+                           characters[63],
+                           characters[62],
+                           characters[63]};
+}
+
+/*
+ *  Alphabet::Alphabet
+ *
+ *  Description:
+ *      Constructor for the Alphabet object, which generates the reverse
+ *      lookup table for the given characters and alternate characters.
+ *
+ *  Parameters:
+ *      characters [in]
+ *          The 64 characters of the alphabet, ordered by the 6-bit value
+ *          each represents.  These are produced when encoding.
+ *
+ *      padding [in]
+ *          True if '=' padding should be appended when encoding.
+ *
+ *      alternates [in]
+ *          64 characters that are also accepted when decoding, each
+ *          representing the same value as the character at the same
+ *          position in the alphabet.  A character may appear in both
+ *          strings only in the same position.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument for the same reasons as the
+ *      other constructor, or if an alternate character would represent two
+ *      different values.
+ */
+Alphabet::Alphabet(const std::string_view characters,
+                   bool padding,
+                   const std::string_view alternates) :
+    Alphabet(characters, padding)
+{
+    // Ensure the alternates are of the correct length
+    if (alternates.size() != table.size())
+    {
+        throw std::invalid_argument(
+            "Base64 alternate characters must number 64");
+    }
+
+    for (std::size_t i = 0; i < alternates.size(); i++)
+    {
+        const auto c = static_cast<std::uint8_t>(alternates[i]);
+
+        // Ensure the character does not already represent another value
+        if ((reverse_table[c] != InvalidBase64Character) &&
+            (reverse_table[c] != i))
+        {
+            throw std::invalid_argument(
+                "Base64 alternate characters must not be ambiguous");
+        }
+
+        // The padding character cannot also be a member of the alphabet
+        if (padding && (alternates[i] == Base64PaddingCharacter))
+        {
+            throw std::invalid_argument(
+                "Base64 alphabet cannot contain the padding character");
+        }
+
+        reverse_table[c] = static_cast<std::uint8_t>(i);
+    }
+
+    // Kernels that compute characters accept alternates only for values 62
+    // and 63; others are left to the lookup tables
+    computed_characters[2] = alternates[62];
+    computed_characters[3] = alternates[63];
+}
+
+/*
+ *  Alphabet::Alphabet
+ *
+ *  Description:
+ *      Constructor for the Alphabet object, which generates the lookup
+ *      tables for the given characters and bit order.
+ *
+ *  Parameters:
+ *      characters [in]
+ *          The 64 characters of the alphabet, ordered by the 6-bit value
+ *          each represents.
+ *
+ *      padding [in]
+ *          True if '=' padding should be appended when encoding.
+ *
+ *      bit_order [in]
+ *          The order in which bits are assigned to characters.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument for the same reasons as the
+ *      first constructor.
+ */
+Alphabet::Alphabet(const std::string_view characters,
+                   bool padding,
+                   BitOrder bit_order) :
+    Alphabet(characters, padding)
+{
+    this->bit_order = bit_order;
+
+    // Characters may only be computed in the standard bit order
+    if (bit_order == BitOrder::LeastSignificantFirst) computed = false;
+
+    // Place each character at the position given by its bit-reversed value
+    for (std::size_t i = 0; i < characters.size(); i++)
+    {
+        const auto index = Index(static_cast<std::uint8_t>(i));
+
+        table[index] = characters[i];
+        reverse_table[static_cast<std::uint8_t>(characters[i])] = index;
+    }
+}
+
+/*
+ *  StandardAlphabet
+ *
+ *  Description:
+ *      Returns the standard Base64 alphabet (RFC 4648 Section 4).
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A reference to the standard alphabet.
+ *
+ *  Comments:
+ *      None.
+ */
+const Alphabet &StandardAlphabet()
+{
+    static const Alphabet alphabet(
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/");
+
+    return alphabet;
+}
+
+/*
+ *  URLAlphabet
+ *
+ *  Description:
+ *      Returns the base64url alphabet (RFC 4648 Section 5).
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A reference to the base64url alphabet.
+ *
+ *  Comments:
+ *      Padding is not produced, as is customary for base64url.
+ */
+const Alphabet &URLAlphabet()
+{
+    static const Alphabet alphabet(
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_",
+        false);
+
+    return alphabet;
+}
+
+/*
+ *  BcryptAlphabet
+ *
+ *  Description:
+ *      Returns the alphabet used by bcrypt.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A reference to the bcrypt alphabet.
+ *
+ *  Comments:
+ *      None.
+ */
+const Alphabet &BcryptAlphabet()
+{
+    static const Alphabet alphabet(
+        "./ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+        false);
+
+    return alphabet;
+}
+
+/*
+ *  CryptAlphabet
+ *
+ *  Description:
+ *      Returns the alphabet used by the MD5 and SHA-2 based crypt(3)
+ *      hashes ("$1$", "$5$", and "$6$").
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A reference to the crypt alphabet.
+ *
+ *  Comments:
+ *      These hashes assign bits least significant first.  They also
+ *      reorder the digest octets before encoding them, which is specific to
+ *      each hash and not done here.
+ */
+const Alphabet &CryptAlphabet()
+{
+    static const Alphabet alphabet(
+        "./0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz",
+        false,
+        BitOrder::LeastSignificantFirst);
+
+    return alphabet;
+}
+
+/*
+ *  IMAPAlphabet
+ *
+ *  Description:
+ *      Returns the alphabet used by IMAP modified Base64 (RFC 3501).
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A reference to the IMAP alphabet.
+ *
+ *  Comments:
+ *      None.
+ */
+const Alphabet &IMAPAlphabet()
+{
+    static const Alphabet alphabet(
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+,",
+        false);
+
+    return alphabet;
+}
+
+/*
+ *  TolerantAlphabet
+ *
+ *  Description:
+ *      Returns an alphabet that encodes as the standard alphabet, but also
+ *      decodes base64url characters ('-' and '_').
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A reference to the tolerant alphabet.
+ *
+ *  Comments:
+ *      Since the two alphabets differ only in the characters for 62 and 63
+ *      and padding is optional when decoding, text using either alphabet
+ *      (or both) is decoded in one pass.
+ */
+const Alphabet &TolerantAlphabet()
+{
+    static const Alphabet alphabet(
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+        true,
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_");
+
+    return alphabet;
+}
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given string into Base64.
+ *
+ *  Parameters:
+ *      input [in]
+ *          String to be encoded as Base64.
+ *
+ *  Returns:
+ *      The Base64-encoded text string.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string Encode(const std::string_view input)
+{
+    // This library assumes the width of char is 8 bits
+    static_assert(CHAR_BIT == 8);
+
+    return Encode(std::span<const std::uint8_t>{
+        reinterpret_cast<const uint8_t *>(input.data()),
+        input.size()});
+}
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the span of octets into Base64.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base64.
+ *
+ *  Returns:
+ *      The Base64-encoded text string.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string Encode(const std::span<const std::uint8_t> input)
+{
+    // Just return an empty string if the input is empty
+    if (input.empty()) return {};
+
+    // Create an output string of the required size
+    std::string output(MaxEncodedLength(input.size()), '\0');
+
+    // Encode the input into the output string
+    EncodeOctets(input,
+                 output,
+                 Standard_Table,
+                 true,
+                 Standard_Computed_Characters);
+
+    return output;
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base64-encoded string.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *  Returns:
+ *      The decoded octets, which will be empty if the input string was
+ *      empty or if the input string was not a properly encoded string.
+ *
+ *  Comments:
+ *      The '=' padding character(s) may be missing from the end of the string,
+ *      since some implementations fail to add those.  Decoding will cease once
+ *      padding characters are encountered and any residual data in the input
+ *      string is ignored and not counted as an error.
+ *
+ *      To allow for spacing, control characters, etc., any character that is
+ *      not part of the character set is silently ignored.
+ */
+std::vector<std::uint8_t> Decode(const std::string_view input)
+{
+    // Just return an empty vector if the input is empty
+    if (input.empty()) return {};
+
+    // Create an output vector large enough to hold the decoded octets
+    std::vector<std::uint8_t> output(MaxDecodedLength(input.size()));
+
+    // Decode the input into the output vector and adjust its length
+    output.resize(
+        DecodeText(input,
+                   output,
+                   Standard_Reverse_Table,
+                   Standard_Computed_Characters).value_or(0));
+
+    return output;
+}
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given string into Base64 using the
+ *      specified alphabet.
+ *
+ *  Parameters:
+ *      input [in]
+ *          String to be encoded as Base64.
+ *
+ *      alphabet [in]
+ *          The alphabet to use for encoding.
+ *
+ *  Returns:
+ *      The Base64-encoded text string.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string Encode(const std::string_view input, const Alphabet &alphabet)
+{
+    return Encode(std::span<const std::uint8_t>{
+                      reinterpret_cast<const uint8_t *>(input.data()),
+                      input.size()},
+                  alphabet);
+}
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the span of octets into Base64 using the
+ *      specified alphabet.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base64.
+ *
+ *      alphabet [in]
+ *          The alphabet to use for encoding.
+ *
+ *  Returns:
+ *      The Base64-encoded text string.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string Encode(const std::span<const std::uint8_t> input,
+                   const Alphabet &alphabet)
+{
+    // Just return an empty string if the input is empty
+    if (input.empty()) return {};
+
+    // Create an output string of the maximum required size
+    std::string output(MaxEncodedLength(input.size()), '\0');
+
+    // Encode the input into the output string and adjust its length
+    output.resize(EncodeAlphabet(input, output, alphabet));
+
+    return output;
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base64-encoded string using the
+ *      specified alphabet.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      alphabet [in]
+ *          The alphabet the input string was encoded with.
+ *
+ *  Returns:
+ *      The decoded octets, which will be empty if the input string was
+ *      empty or if the input string was not a properly encoded string.
+ *
+ *  Comments:
+ *      Decoding ceases at the first '=' character unless '=' is a member of
+ *      the alphabet.  Any other character that is not part of the alphabet
+ *      is silently ignored.
+ */
+std::vector<std::uint8_t> Decode(const std::string_view input,
+                                 const Alphabet &alphabet)
+{
+    // Just return an empty vector if the input is empty
+    if (input.empty()) return {};
+
+    // Create an output vector large enough to hold the decoded octets
+    std::vector<std::uint8_t> output(MaxDecodedLength(input.size()));
+
+    // Decode the input into the output vector and adjust its length
+    output.resize(
+        DecodeText(input,
+                   output,
+                   alphabet.ReverseTable().data(),
+                   alphabet.ComputedCharacters()).value_or(0));
+    ReverseBits(output, alphabet);
+
+    return output;
+}
+
+/*
+ *  MaxEncodedLength
+ *
+ *  Description:
+ *      This function returns the number of characters required to hold the
+ *      Base64 encoding of the given number of octets, including padding.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The number of octets to be encoded.
+ *
+ *  Returns:
+ *      The number of characters required for the encoded string.
+ *
+ *  Comments:
+ *      The encoded length will be shorter if an alphabet that does not
+ *      use padding is used.
+ */
+std::size_t MaxEncodedLength(std::size_t length)
+{
+    return ((length / 3) + ((length % 3 > 0) ? 1 : 0)) * 4;
+}
+
+/*
+ *  MaxDecodedLength
+ *
+ *  Description:
+ *      This function returns the maximum number of octets that may result
+ *      from decoding a Base64-encoded string of the given length.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The length of the Base64-encoded string.
+ *
+ *  Returns:
+ *      The maximum number of octets the string could decode into.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MaxDecodedLength(std::size_t length)
+{
+    // Each four characters produce three octets, while residual characters
+    // produce one octet for one or two characters and two octets for three
+    return ((length / 4) * 3) + (((length % 4) + 1) / 2);
+}
+
+/*
+ *  IsValid
+ *
+ *  Description:
+ *      This function will determine whether the given string is properly
+ *      Base64-encoded without decoding it.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be validated.
+ *
+ *      mode [in]
+ *          The rules to apply (see the declaration).
+ *
+ *  Returns:
+ *      The exact number of octets the string decodes into, or std::nullopt
+ *      if the string is not valid under the given rules.
+ *
+ *  Comments:
+ *      None.
+ */
+std::optional<std::size_t> IsValid(const std::string_view input, Mode mode)
+{
+    return ValidateText(input, mode, Standard_Reverse_Table, true);
+}
+
+/*
+ *  IsValid
+ *
+ *  Description:
+ *      This function will determine whether the given string is properly
+ *      Base64-encoded using the specified alphabet without decoding it.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be validated.
+ *
+ *      mode [in]
+ *          The rules to apply (see the declaration).
+ *
+ *      alphabet [in]
+ *          The alphabet the input is expected to use.
+ *
+ *  Returns:
+ *      The exact number of octets the string decodes into, or std::nullopt
+ *      if the string is not valid under the given rules.
+ *
+ *  Comments:
+ *      None.
+ */
+std::optional<std::size_t> IsValid(const std::string_view input,
+                                   Mode mode,
+                                   const Alphabet &alphabet)
+{
+    return ValidateText(input,
+                        mode,
+                        alphabet.ReverseTable().data(),
+                        alphabet.Padding());
+}
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base64,
+ *      writing the encoded characters into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base64.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.  A buffer
+ *          of MaxEncodedLength(input.size()) characters is always sufficient.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      This function does not allocate memory.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output)
+{
+    return EncodeOctets(input,
+                        output,
+                        Standard_Table,
+                        true,
+                        Standard_Computed_Characters);
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base64-encoded string, writing the
+ *      decoded octets into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.  A buffer of
+ *          MaxDecodedLength(input.size()) octets is always sufficient.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      The input is interpreted exactly as it is by the Decode() function
+ *      that returns a vector.  This function does not allocate memory.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output)
+{
+    return DecodeText(input,
+                      output,
+                      Standard_Reverse_Table,
+                      Standard_Computed_Characters);
+}
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base64,
+ *      encoding large inputs in parallel using the given executor.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base64.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.
+ *
+ *      executor [in]
+ *          The executor on which to run the chunks.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output,
+                   Bases::Executor &executor)
+{
+    // Ensure the output buffer is large enough
+    if (output.size() < MaxEncodedLength(input.size())) return 0;
+
+    // Encode each chunk using the kernel selected for its size
+    return Bases::Parallel::Encode(
+        executor,
+        input,
+        output,
+        3,
+        4,
+        [](const std::span<const std::uint8_t> chunk, char *p)
+        {
+            return Encoder.Select(chunk.size())(
+                                            chunk,
+                                            p,
+                                            Standard_Table,
+                                            true,
+                                            Standard_Computed_Characters);
+        });
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base64-encoded string, decoding large
+ *      inputs in parallel using the given executor.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *      executor [in]
+ *          The executor on which to run the chunks.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input string was not a properly encoded string or if the output
+ *      buffer was too small.
+ *
+ *  Comments:
+ *      None.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output,
+                                  Bases::Executor &executor)
+{
+    // Decode each chunk using the kernel selected for its size
+    return Bases::Parallel::Decode(
+        executor,
+        input,
+        output,
+        3,
+        4,
+        [](const std::string_view chunk, std::span<std::uint8_t> octets)
+        {
+            return Decoder.Select(chunk.size())(
+                                            chunk,
+                                            octets,
+                                            Standard_Reverse_Table,
+                                            Standard_Computed_Characters);
+        });
+}
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      This function will encode the given span of octets into Base64 using
+ *      the specified alphabet, writing the encoded characters into the given
+ *      output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded as Base64.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written.  A buffer
+ *          of MaxEncodedLength(input.size()) characters is always sufficient.
+ *
+ *      alphabet [in]
+ *          The alphabet to use for encoding.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, which will be
+ *      zero if the input is empty or if the output buffer is too small.
+ *
+ *  Comments:
+ *      This function does not allocate memory.
+ */
+std::size_t Encode(const std::span<const std::uint8_t> input,
+                   std::span<char> output,
+                   const Alphabet &alphabet)
+{
+    return EncodeAlphabet(input, output, alphabet);
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base64-encoded string using the
+ *      specified alphabet, writing the decoded octets into the given output
+ *      buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.  A buffer of
+ *          MaxDecodedLength(input.size()) octets is always sufficient.
+ *
+ *      alphabet [in]
+ *          The alphabet the input string was encoded with.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the output buffer was too small.
+ *
+ *  Comments:
+ *      This function does not allocate memory.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output,
+                                  const Alphabet &alphabet)
+{
+    auto length = DecodeText(input,
+                             output,
+                             alphabet.ReverseTable().data(),
+                             alphabet.ComputedCharacters());
+    if (length) ReverseBits(output.first(*length), alphabet);
+
+    return length;
+}
+
+/*
+ *  DecodeChecked
+ *
+ *  Description:
+ *      This function will decode the Base64-encoded string using the given
+ *      reverse lookup table only if it is valid under the given rules.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *      mode [in]
+ *          The rules the input must satisfy.
+ *
+ *      reverse_table [in]
+ *          Table of 256 values mapping characters to 6-bit values, with
+ *          characters not in the alphabet mapped to InvalidBase64Character.
+ *
+ *      padding [in]
+ *          True if the alphabet calls for padding.
+ *
+ *      computed [in]
+ *          The alphabet's characters for values 62 and 63 followed by their
+ *          alternates if its other characters may be computed, or nullptr.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input is not valid or the output buffer was too small.
+ *
+ *  Comments:
+ *      Forgiving input is validated while it is decoded; strict input is
+ *      validated first, since it is decoded with the lenient decoder.
+ */
+static std::optional<std::size_t> DecodeChecked(
+                                        const std::string_view input,
+                                        std::span<std::uint8_t> output,
+                                        Mode mode,
+                                        const std::uint8_t *reverse_table,
+                                        bool padding,
+                                        const char *computed)
+{
+    switch (mode)
+    {
+        case Mode::Forgiving:
+            return DecodeForgiving(input, output, reverse_table, computed);
+
+        case Mode::Strict:
+            if (!ValidateText(input, mode, reverse_table, padding)) return {};
+            break;
+
+        case Mode::Lenient:
+            break;
+    }
+
+    return DecodeText(input, output, reverse_table, computed);
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base64-encoded string only if it is
+ *      valid under the given rules, writing the decoded octets into the
+ *      given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *      mode [in]
+ *          The rules the input must satisfy (see IsValid()).
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input is not valid or the output buffer was too small.
+ *
+ *  Comments:
+ *      This function does not allocate memory.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output,
+                                  Mode mode)
+{
+    return DecodeChecked(input,
+                         output,
+                         mode,
+                         Standard_Reverse_Table,
+                         true,
+                         Standard_Computed_Characters);
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      This function will decode the Base64-encoded string using the
+ *      specified alphabet only if it is valid under the given rules,
+ *      writing the decoded octets into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *      mode [in]
+ *          The rules the input must satisfy (see IsValid()).
+ *
+ *      alphabet [in]
+ *          The alphabet the input string was encoded with.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt if
+ *      the input is not valid or the output buffer was too small.
+ *
+ *  Comments:
+ *      This function does not allocate memory.
+ */
+std::optional<std::size_t> Decode(const std::string_view input,
+                                  std::span<std::uint8_t> output,
+                                  Mode mode,
+                                  const Alphabet &alphabet)
+{
+    auto length = DecodeChecked(input,
+                                output,
+                                mode,
+                                alphabet.ReverseTable().data(),
+                                alphabet.Padding(),
+                                alphabet.ComputedCharacters());
+    if (length) ReverseBits(output.first(*length), alphabet);
+
+    return length;
+}
+
+/*
+ *  Append
+ *
+ *  Description:
+ *      This function will extend a Base64-encoded string with the encoding
+ *      of additional octets using the standard alphabet.
+ *
+ *  Parameters:
+ *      encoded [in/out]
+ *          Base64-encoded string that is extended in place.
+ *
+ *      input [in]
+ *          Span of octets to append.
+ *
+ *  Returns:
+ *      True if the string was extended, or false if the end of the encoded
+ *      string is not a properly encoded quantum.
+ *
+ *  Comments:
+ *      None.
+ */
+bool Append(std::string &encoded, const std::span<const std::uint8_t> input)
+{
+    return Append(encoded, input, StandardAlphabet());
+}
+
+/*
+ *  Append
+ *
+ *  Description:
+ *      This function will extend a Base64-encoded string with the encoding
+ *      of additional octets, re-encoding only the trailing partial quantum
+ *      of the existing string.
+ *
+ *  Parameters:
+ *      encoded [in/out]
+ *          Base64-encoded string that is extended in place.
+ *
+ *      input [in]
+ *          Span of octets to append.
+ *
+ *      alphabet [in]
+ *          The alphabet the encoded string uses.
+ *
+ *  Returns:
+ *      True if the string was extended, or false if the end of the encoded
+ *      string is not a properly encoded quantum, in which case the string
+ *      is not modified.
+ *
+ *  Comments:
+ *      The string's capacity grows geometrically, so the amortized cost of
+ *      each call is proportional to the number of octets appended.
+ */
+bool Append(std::string &encoded,
+            const std::span<const std::uint8_t> input,
+            const Alphabet &alphabet)
+{
+    std::uint8_t head[3] = {};                  // Partial quantum + new octets
+    std::size_t head_length = 0;                // Octets in head
+    std::uint_fast32_t group = 0;               // Bits of the partial quantum
+
+    // Determine the length excluding any padding characters
+    std::size_t length = encoded.size();
+    if (alphabet.Value(Base64PaddingCharacter) == InvalidBase64Character)
+    {
+        while ((length > 0) &&
+               (encoded[length - 1] == Base64PaddingCharacter) &&
+               (encoded.size() - length < 2))
+        {
+            length--;
+        }
+    }
+
+    // The partial quantum must have 2 or 3 characters and, if padded, the
+    // padding must complete the quantum
+    std::size_t partial = length % 4;
+    std::size_t padding = encoded.size() - length;
+    if ((partial == 1) || ((padding > 0) && (partial + padding != 4)))
+    {
+        return false;
+    }
+
+    // Recover the octets held in the trailing partial quantum
+    const auto &reverse_table = alphabet.ReverseTable();
+    for (std::size_t i = length - partial; i < length; i++)
+    {
+        std::uint8_t value =
+            reverse_table[static_cast<std::uint8_t>(encoded[i])];
+        if (value == Alphabet::Invalid_Character) return false;
+        group = (group << 6) | value;
+    }
+    group <<= (24 - partial * 6);
+    if (partial >= 2) head[head_length++] = (group >> 16) & 0xff;
+    if (partial == 3) head[head_length++] = (group >> 8) & 0xff;
+    ReverseBits(head, alphabet);
+
+    // Nothing further to do if there is nothing to append
+    if (input.empty()) return true;
+
+    // Complete the partial quantum with the first of the new octets
+    std::size_t consumed = 0;
+    if (head_length > 0)
+    {
+        while ((head_length < 3) && (consumed < input.size()))
+        {
+            head[head_length++] = input[consumed++];
+        }
+    }
+    auto remainder = input.subspan(consumed);
+
+    // Remove the partial quantum and make room for the new characters
+    encoded.resize(length - partial + MaxEncodedLength(head_length) +
+                   MaxEncodedLength(remainder.size()));
+    std::span<char> output(encoded.data() + length - partial,
+                           encoded.size() - (length - partial));
+
+    // Encode the completed quantum followed by the remaining octets
+    std::size_t written =
+        Encode(std::span<const std::uint8_t>(head, head_length),
+               output,
+               alphabet);
+    written += Encode(remainder, output.subspan(written), alphabet);
+
+    // Trim any space not needed (e.g., when the alphabet has no padding)
+    encoded.resize(length - partial + written);
+
+    return true;
+}
+
+/*
+ *  RangeDecoder::RangeDecoder
+ *
+ *  Description:
+ *      Constructor for the RangeDecoder object, which scans the input to
+ *      build the index used to locate octets.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Base64-encoded string from which ranges will be decoded.  This
+ *          must remain valid for the lifetime of this object.
+ *
+ *      alphabet [in]
+ *          The alphabet the input string was encoded with.
+ *
+ *      checkpoint_interval [in]
+ *          Approximate number of decoded octets between checkpoints, used
+ *          only if the input does not have a fixed layout.  Smaller values
+ *          make seeking faster at the expense of memory.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      A fixed layout is one where the input begins with a character of the
+ *      alphabet and every line other than the last has the same number of
+ *      characters and is followed by the same sequence of non-alphabet
+ *      characters (e.g., "\r\n").
+ */
+RangeDecoder::RangeDecoder(const std::string_view input,
+                           const Alphabet &alphabet,
+                           std::size_t checkpoint_interval) :
+    input{input},
+    alphabet{alphabet},
+    decoded_length{0},
+    fixed_layout{true},
+    line_length{0},
+    terminator_length{0},
+    checkpoint_quanta{std::max<std::size_t>(checkpoint_interval / 3, 1)}
+{
+    const std::uint8_t *reverse_table = alphabet.ReverseTable().data();
+    const std::size_t checkpoint_characters = checkpoint_quanta * 4;
+    std::size_t characters = 0;                 // Alphabet characters seen
+    std::size_t line_characters = 0;            // Characters in this line
+    std::size_t terminator_start = 0;           // Start of line terminator
+    std::string_view terminator;                // First line terminator
+    bool in_terminator = false;                 // Within a line terminator
+
+    // Scan the input, stopping at the first padding character
+    for (std::size_t i = 0; i < input.size(); i++)
+    {
+        const char c = input[i];
+
+        // Check for characters outside of the alphabet
+        if (reverse_table[static_cast<std::uint8_t>(c)] ==
+            InvalidBase64Character)
+        {
+            if (c == Base64PaddingCharacter) break;
+
+            // Note the start of a line terminator
+            if (!in_terminator)
+            {
+                in_terminator = true;
+                terminator_start = i;
+            }
+
+            continue;
+        }
+
+        // Check the preceding line's length and terminator
+        if (in_terminator)
+        {
+            auto current = input.substr(terminator_start, i - terminator_start);
+
+            if (line_length == 0)
+            {
+                // Leading non-alphabet characters preclude a fixed layout
+                if (line_characters == 0) fixed_layout = false;
+
+                line_length = line_characters;
+                terminator = current;
+            }
+            else if ((line_characters != line_length) ||
+                     (current != terminator))
+            {
+                fixed_layout = false;
+            }
+
+            line_characters = 0;
+            in_terminator = false;
+        }
+
+        // Record a checkpoint at the start of every Nth quantum
+        if ((characters % checkpoint_characters) == 0)
+        {
+            checkpoints.push_back(i);
+        }
+
+        characters++;
+        line_characters++;
+    }
+
+    // The final line may be shorter than the others, but not longer
+    if ((line_length > 0) && (line_characters > line_length))
+    {
+        fixed_layout = false;
+    }
+
+    // Without line terminators, the layout is a single line
+    if (line_length == 0) line_length = characters;
+    terminator_length = terminator.size();
+
+    // Checkpoints are not needed if octet positions can be computed
+    if (fixed_layout) checkpoints = {};
+
+    // Determine the decoded length, including any partial final group as
+    // Decode() would produce it
+    decoded_length = (characters / 4) * 3;
+    if ((characters % 4) > 0) decoded_length += ((characters % 4) == 3) ? 2 : 1;
+}
+
+/*
+ *  RangeDecoder::Decode
+ *
+ *  Description:
+ *      Decode a range of octets into the given output buffer.
+ *
+ *  Parameters:
+ *      offset [in]
+ *          Offset of the first octet to decode.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.  Its size is
+ *          the number of octets requested.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, which is less
+ *      than requested only if the range extends beyond DecodedLength(), or
+ *      std::nullopt if the offset is greater than DecodedLength().
+ *
+ *  Comments:
+ *      This function does not allocate memory.
+ */
+std::optional<std::size_t> RangeDecoder::Decode(
+                                        std::size_t offset,
+                                        std::span<std::uint8_t> output) const
+{
+    const std::uint8_t *reverse_table = alphabet.ReverseTable().data();
+    std::uint_fast32_t group = 0;               // Group of 24 bits
+    std::uint_fast32_t group_size = 0;          // How many bits in group
+    std::size_t length = 0;                     // Octets written to output
+
+    // Ensure the offset is within the decoded data
+    if (offset > decoded_length) return {};
+
+    // Determine how many octets will be produced
+    const std::size_t requested =
+        std::min(output.size(), decoded_length - offset);
+    if (requested == 0) return 0;
+
+    // Determine the number of octets to discard from the first quantum
+    std::size_t skip = offset % 3;
+
+    // Emit an octet, discarding those that precede the offset
+    auto emit = [&](std::uint8_t octet)
+    {
+        if (skip > 0)
+        {
+            skip--;
+            return;
+        }
+        output[length++] = octet;
+    };
+
+    // Decode from the start of the quantum containing the offset
+    for (std::size_t i = Locate(offset / 3);
+         (i < input.size()) && (length < requested);
+         i++)
+    {
+        const char c = input[i];
+        std::uint8_t value = reverse_table[static_cast<std::uint8_t>(c)];
+
+        // Check for characters outside of the alphabet
+        if (value == InvalidBase64Character)
+        {
+            if (c == Base64PaddingCharacter) break;
+            continue;
+        }
+
+        // Add these 6 bits to the group
+        group = (group << 6) | (value & 0x3f);
+        group_size += 6;
+
+        // Emit the octets once the group is full
+        if (group_size == 24)
+        {
+            emit((group >> 16) & 0xff);
+            if (length < requested) emit((group >> 8) & 0xff);
+            if (length < requested) emit(group & 0xff);
+            group = 0;
+            group_size = 0;
+        }
+    }
+
+    // Emit any octets from a partial final group
+    if ((length < requested) && (group_size > 0))
+    {
+        group <<= (24 - group_size);
+        emit((group >> 16) & 0xff);
+        if ((length < requested) && (group_size >= 16))
+        {
+            emit((group >> 8) & 0xff);
+        }
+    }
+
+    ReverseBits(output.first(length), alphabet);
+
+    return length;
+}
+
+/*
+ *  RangeDecoder::Decode
+ *
+ *  Description:
+ *      Decode a range of octets.
+ *
+ *  Parameters:
+ *      offset [in]
+ *          Offset of the first octet to decode.
+ *
+ *      length [in]
+ *          Number of octets to decode.
+ *
+ *  Returns:
+ *      The decoded octets, which will be fewer than requested if the range
+ *      extends beyond DecodedLength() and empty if the offset is greater
+ *      than DecodedLength().
+ *
+ *  Comments:
+ *      None.
+ */
+std::vector<std::uint8_t> RangeDecoder::Decode(std::size_t offset,
+                                               std::size_t length) const
+{
+    // Ensure the offset is within the decoded data
+    if (offset > decoded_length) return {};
+
+    // Create an output vector no larger than the available octets
+    std::vector<std::uint8_t> output(
+        std::min(length, decoded_length - offset));
+
+    // Decode the range into the output vector
+    output.resize(Decode(offset, output).value_or(0));
+
+    return output;
+}
+
+/*
+ *  RangeDecoder::Locate
+ *
+ *  Description:
+ *      Find the position in the input of the first character of the given
+ *      quantum.
+ *
+ *  Parameters:
+ *      quantum [in]
+ *          Index of the 4-character quantum.
+ *
+ *  Returns:
+ *      The position of the quantum's first character in the input, or the
+ *      input length if the quantum lies beyond the input.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t RangeDecoder::Locate(std::size_t quantum) const
+{
+    const std::size_t character = quantum * 4;
+
+    // Compute the position directly if the layout is fixed
+    if (fixed_layout)
+    {
+        if (line_length == 0) return input.size();
+
+        return std::min(character +
+                            (character / line_length) * terminator_length,
+                        input.size());
+    }
+
+    // Start at the nearest preceding checkpoint
+    std::size_t checkpoint = quantum / checkpoint_quanta;
+    if (checkpoint >= checkpoints.size()) return input.size();
+    std::size_t position = checkpoints[checkpoint];
+
+    // Skip over the alphabet characters between the checkpoint and quantum
+    const std::uint8_t *reverse_table = alphabet.ReverseTable().data();
+    std::size_t remaining = character - checkpoint * checkpoint_quanta * 4;
+    for (; position < input.size(); position++)
+    {
+        if (reverse_table[static_cast<std::uint8_t>(input[position])] ==
+            InvalidBase64Character)
+        {
+            continue;
+        }
+        if (remaining == 0) break;
+        remaining--;
+    }
+
+    return position;
+}
+
+} // namespace Terra::Base64
+
+namespace Terra::Bases::Tuning
+{
+
+/*
+ *  Base64Operations
+ *
+ *  Description:
+ *      Return the tunable Base64 operations.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The kernel selectors for Base64 operations.
+ *
+ *  Comments:
+ *      None.
+ */
+std::span<Operation * const> Base64Operations()
+{
+    static Operation * const operations[] =
+    {
+        &Base64::Encoder,
+        &Base64::Decoder
+    };
+
+    return operations;
+}
+
+} // namespace Terra::Bases::Tuning
@@ -0,0 +1,337 @@
+/*
+ *  bases_c.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the C interface to the Base-N encoding and
+ *      decoding functions.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#include <cstdint>
+#include <terra/bases/base16.h>
+#include <terra/bases/base32.h>
+#include <terra/bases/base45.h>
+#include <terra/bases/base58.h>
+#include <terra/bases/base64.h>
+#include <terra/bases/bases_c.h>
+
+namespace
+{
+
+/*
+ *  EncodeInto
+ *
+ *  Description:
+ *      This function performs the common steps for all C encoding functions,
+ *      verifying arguments and the output buffer size before encoding.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Pointer to the octets to encode.
+ *
+ *      input_length [in]
+ *          Number of octets to encode.
+ *
+ *      output [out]
+ *          Buffer into which encoded characters are written.
+ *
+ *      output_length [in/out]
+ *          Size of the output buffer on input, number of characters written
+ *          (or required) on output.
+ *
+ *      max_encoded_length [in]
+ *          Function returning the required output buffer size.
+ *
+ *      encode [in]
+ *          Function performing the encoding.
+ *
+ *  Returns:
+ *      A BASES_ status code.
+ *
+ *  Comments:
+ *      Every C function passes through this function or DecodeInto(), which
+ *      ensure that no exception (e.g., std::bad_alloc while the kernels are
+ *      first tuned) propagates into the calling C code.
+ */
+template<typename LengthFunction, typename EncodeFunction>
+int EncodeInto(const std::uint8_t *input,
+               std::size_t input_length,
+               char *output,
+               std::size_t *output_length,
+               LengthFunction max_encoded_length,
+               EncodeFunction encode) noexcept
+try
+{
+    // Verify that the required arguments are present
+    if ((output_length == nullptr) ||
+        ((input == nullptr) && (input_length > 0)))
+    {
+        return BASES_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Determine the required output buffer size
+    std::size_t required = max_encoded_length(input_length);
+
+    // Report the required size if the buffer is missing or too small
+    if (((output == nullptr) && (required > 0)) ||
+        (*output_length < required))
+    {
+        *output_length = required;
+        return BASES_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    // Encode the input directly into the caller's buffer
+    *output_length =
+        encode(std::span<const std::uint8_t>(input, input_length),
+               std::span<char>(output, output ? *output_length : 0));
+
+    return BASES_OK;
+}
+catch (...)
+{
+    return BASES_ERROR_INTERNAL;
+}
+
+/*
+ *  DecodeInto
+ *
+ *  Description:
+ *      This function performs the common steps for all C decoding functions,
+ *      verifying arguments before decoding into the output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Pointer to the encoded characters.
+ *
+ *      input_length [in]
+ *          Number of characters to decode.
+ *
+ *      output [out]
+ *          Buffer into which decoded octets are written.
+ *
+ *      output_length [in/out]
+ *          Size of the output buffer on input, number of octets written
+ *          (or required) on output.
+ *
+ *      max_decoded_length [in]
+ *          Function returning the maximum decoded length.
+ *
+ *      decode [in]
+ *          Function performing the decoding.
+ *
+ *  Returns:
+ *      A BASES_ status code.
+ *
+ *  Comments:
+ *      The caller's buffer may be smaller than the maximum decoded length,
+ *      in which case decoding is attempted and only fails if the decoded
+ *      octets do not fit.  As with EncodeInto(), no exception propagates.
+ */
+template<typename LengthFunction, typename DecodeFunction>
+int DecodeInto(const char *input,
+               std::size_t input_length,
+               std::uint8_t *output,
+               std::size_t *output_length,
+               LengthFunction max_decoded_length,
+               DecodeFunction decode) noexcept
+try
+{
+    // Verify that the required arguments are present
+    if ((output_length == nullptr) ||
+        ((input == nullptr) && (input_length > 0)))
+    {
+        return BASES_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Determine the maximum output buffer size
+    std::size_t required = max_decoded_length(input_length);
+
+    // Report the required size if the buffer is missing
+    if ((output == nullptr) && (required > 0))
+    {
+        *output_length = required;
+        return BASES_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    // Decode the input directly into the caller's buffer
+    auto length =
+        decode(std::string_view(input, input_length),
+               std::span<std::uint8_t>(output, output ? *output_length : 0));
+
+    if (!length)
+    {
+        // A failure with a small buffer may be due to the buffer size
+        if (*output_length < required)
+        {
+            *output_length = required;
+            return BASES_ERROR_BUFFER_TOO_SMALL;
+        }
+
+        return BASES_ERROR_INVALID_INPUT;
+    }
+
+    *output_length = *length;
+
+    return BASES_OK;
+}
+catch (...)
+{
+    return BASES_ERROR_INTERNAL;
+}
+
+} // namespace
+
+extern "C" {
+
+BASES_API int bases_base16_encode(const uint8_t *input,
+                                  size_t input_length,
+                                  char *output,
+                                  size_t *output_length)
+{
+    return EncodeInto(
+        input, input_length, output, output_length,
+        Terra::Base16::MaxEncodedLength,
+        [](auto in, auto out) { return Terra::Base16::Encode(in, out); });
+}
+
+BASES_API int bases_base16_decode(const char *input,
+                                  size_t input_length,
+                                  uint8_t *output,
+                                  size_t *output_length)
+{
+    return DecodeInto(
+        input, input_length, output, output_length,
+        Terra::Base16::MaxDecodedLength,
+        [](auto in, auto out) { return Terra::Base16::Decode(in, out); });
+}
+
+BASES_API int bases_base32_encode(const uint8_t *input,
+                                  size_t input_length,
+                                  char *output,
+                                  size_t *output_length)
+{
+    return EncodeInto(
+        input, input_length, output, output_length,
+        Terra::Base32::MaxEncodedLength,
+        [](auto in, auto out) { return Terra::Base32::Encode(in, out); });
+}
+
+BASES_API int bases_base32_decode(const char *input,
+                                  size_t input_length,
+                                  uint8_t *output,
+                                  size_t *output_length)
+{
+    return DecodeInto(
+        input, input_length, output, output_length,
+        Terra::Base32::MaxDecodedLength,
+        [](auto in, auto out) { return Terra::Base32::Decode(in, out); });
+}
+
+BASES_API int bases_base45_encode(const uint8_t *input,
+                                  size_t input_length,
+                                  char *output,
+                                  size_t *output_length)
+{
+    return EncodeInto(
+        input, input_length, output, output_length,
+        Terra::Base45::MaxEncodedLength,
+        [](auto in, auto out) { return Terra::Base45::Encode(in, out); });
+}
+
+BASES_API int bases_base45_decode(const char *input,
+                                  size_t input_length,
+                                  uint8_t *output,
+                                  size_t *output_length)
+{
+    return DecodeInto(
+        input, input_length, output, output_length,
+        Terra::Base45::MaxDecodedLength,
+        [](auto in, auto out) { return Terra::Base45::Decode(in, out); });
+}
+
+BASES_API int bases_base58_encode(const uint8_t *input,
+                                  size_t input_length,
+                                  char *output,
+                                  size_t *output_length)
+{
+    return EncodeInto(
+        input, input_length, output, output_length,
+        Terra::Base58::MaxEncodedLength,
+        [](auto in, auto out) { return Terra::Base58::Encode(in, out); });
+}
+
+BASES_API int bases_base58_decode(const char *input,
+                                  size_t input_length,
+                                  uint8_t *output,
+                                  size_t *output_length)
+{
+    return DecodeInto(
+        input, input_length, output, output_length,
+        Terra::Base58::MaxDecodedLength,
+        [](auto in, auto out) { return Terra::Base58::Decode(in, out); });
+}
+
+BASES_API int bases_base64_encode(const uint8_t *input,
+                                  size_t input_length,
+                                  char *output,
+                                  size_t *output_length)
+{
+    return EncodeInto(
+        input, input_length, output, output_length,
+        Terra::Base64::MaxEncodedLength,
+        [](auto in, auto out) { return Terra::Base64::Encode(in, out); });
+}
+
+BASES_API int bases_base64_decode(const char *input,
+                                  size_t input_length,
+                                  uint8_t *output,
+                                  size_t *output_length)
+{
+    return DecodeInto(
+        input, input_length, output, output_length,
+        Terra::Base64::MaxDecodedLength,
+        [](auto in, auto out) { return Terra::Base64::Decode(in, out); });
+}
+
+BASES_API int bases_base64url_encode(const uint8_t *input,
+                                     size_t input_length,
+                                     char *output,
+                                     size_t *output_length)
+{
+    return EncodeInto(
+        input, input_length, output, output_length,
+        Terra::Base64::MaxEncodedLength,
+        [](auto in, auto out)
+        {
+            return Terra::Base64::Encode(in,
+                                         out,
+                                         Terra::Base64::URLAlphabet());
+        });
+}
+
+BASES_API int bases_base64url_decode(const char *input,
+                                     size_t input_length,
+                                     uint8_t *output,
+                                     size_t *output_length)
+{
+    return DecodeInto(
+        input, input_length, output, output_length,
+        Terra::Base64::MaxDecodedLength,
+        [](auto in, auto out)
+        {
+            return Terra::Base64::Decode(in,
+                                         out,
+                                         Terra::Base64::URLAlphabet());
+        });
+}
+
+} // extern "C"
@@ -0,0 +1,318 @@
+/*
+ *  executor.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the work-stealing executor used by default for
+ *      parallel encoding and decoding.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#include <algorithm>
+#include <deque>
+#include <terra/bases/executor.h>
+
+namespace Terra::Bases
+{
+
+// Number of ranges created per thread by each call to Execute(), allowing
+// idle threads to take work from busy ones
+static constexpr std::size_t Ranges_Per_Thread = 4;
+
+// State shared by the ranges of one call to Execute()
+struct WorkStealingExecutor::Batch
+{
+    const RangeTask *task;                      // Task to run
+    std::atomic<std::size_t> remaining;         // Ranges not yet complete
+    std::mutex mutex;                           // Guards completion
+    std::condition_variable done;               // Signaled on completion
+};
+
+// A range of a batch
+struct WorkStealingExecutor::Job
+{
+    Batch *batch;
+    std::size_t begin;
+    std::size_t end;
+};
+
+// A worker's queue of jobs
+struct WorkStealingExecutor::Queue
+{
+    std::mutex mutex;
+    std::deque<Job> jobs;
+};
+
+/*
+ *  WorkStealingExecutor::WorkStealingExecutor
+ *
+ *  Description:
+ *      Constructor for the WorkStealingExecutor object, which starts the
+ *      worker threads.
+ *
+ *  Parameters:
+ *      threads [in]
+ *          Number of worker threads to start.  If zero, Execute() runs
+ *          every task on the calling thread.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+WorkStealingExecutor::WorkStealingExecutor(std::size_t threads) :
+    pending{0},
+    next_queue{0},
+    stop{false}
+{
+    for (std::size_t i = 0; i < threads; i++)
+    {
+        queues.push_back(std::make_unique<Queue>());
+    }
+
+    for (std::size_t i = 0; i < threads; i++)
+    {
+        workers.emplace_back(&WorkStealingExecutor::Work, this, i);
+    }
+}
+
+/*
+ *  WorkStealingExecutor::~WorkStealingExecutor
+ *
+ *  Description:
+ *      Destructor for the WorkStealingExecutor object, which stops and joins
+ *      the worker threads.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      No call to Execute() may be in progress.
+ */
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    available.notify_all();
+
+    for (auto &worker : workers) worker.join();
+}
+
+/*
+ *  WorkStealingExecutor::Execute
+ *
+ *  Description:
+ *      Run the task over the range [0, count), returning once complete.
+ *
+ *  Parameters:
+ *      count [in]
+ *          The size of the range.
+ *
+ *      task [in]
+ *          The task to call with each subrange.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The calling thread runs ranges as well, so this may be called from
+ *      within a task without deadlock.
+ */
+void WorkStealingExecutor::Execute(std::size_t count, const RangeTask &task)
+{
+    // Run the task directly if there is nothing to share
+    if (count == 0) return;
+    if (workers.empty() || (count == 1))
+    {
+        task(0, count);
+        return;
+    }
+
+    // Divide the range so that each thread has several ranges to run
+    const std::size_t ranges =
+        std::min(count, (workers.size() + 1) * Ranges_Per_Thread);
+    Batch batch{&task, {ranges}, {}, {}};
+
+    // Distribute the ranges over the queues, starting at a rotating queue
+    const std::size_t first = next_queue.fetch_add(1) % queues.size();
+    for (std::size_t i = 0; i < ranges; i++)
+    {
+        Queue &queue = *queues[(first + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back({&batch,
+                              count * i / ranges,
+                              count * (i + 1) / ranges});
+    }
+
+    // Wake the workers
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending += ranges;
+    }
+    available.notify_all();
+
+    // Run ranges on this thread while any of this batch remain
+    Job job;
+    while ((batch.remaining.load(std::memory_order_acquire) > 0) &&
+           TakeJob(first, job))
+    {
+        RunJob(job);
+    }
+
+    // Wait for ranges running on other threads to complete
+    std::unique_lock<std::mutex> lock(batch.mutex);
+    batch.done.wait(lock, [&]() { return batch.remaining == 0; });
+}
+
+/*
+ *  WorkStealingExecutor::TakeJob
+ *
+ *  Description:
+ *      Take a job, preferring the newest job on the given queue and
+ *      otherwise taking the oldest job on another queue.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The index of the preferred queue.
+ *
+ *      job [out]
+ *          The job taken.
+ *
+ *  Returns:
+ *      True if a job was taken, false if all queues were empty.
+ *
+ *  Comments:
+ *      None.
+ */
+bool WorkStealingExecutor::TakeJob(std::size_t index, Job &job)
+{
+    for (std::size_t i = 0; i < queues.size(); i++)
+    {
+        Queue &queue = *queues[(index + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.jobs.empty()) continue;
+
+        if (i == 0)
+        {
+            job = queue.jobs.back();
+            queue.jobs.pop_back();
+        }
+        else
+        {
+            job = queue.jobs.front();
+            queue.jobs.pop_front();
+        }
+        pending--;
+
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ *  WorkStealingExecutor::RunJob
+ *
+ *  Description:
+ *      Run a job and signal its batch if it was the last to complete.
+ *
+ *  Parameters:
+ *      job [in]
+ *          The job to run.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The batch is signaled while holding its mutex, so the thread waiting
+ *      in Execute() cannot destroy the batch until this function is done
+ *      with it.
+ */
+void WorkStealingExecutor::RunJob(const Job &job)
+{
+    Batch &batch = *job.batch;
+
+    (*batch.task)(job.begin, job.end);
+
+    std::lock_guard<std::mutex> lock(batch.mutex);
+    if (batch.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        batch.done.notify_all();
+    }
+}
+
+/*
+ *  WorkStealingExecutor::Work
+ *
+ *  Description:
+ *      The body of each worker thread.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The index of the worker's own queue.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void WorkStealingExecutor::Work(std::size_t index)
+{
+    Job job;
+
+    while (true)
+    {
+        // Run any available job
+        if (TakeJob(index, job))
+        {
+            RunJob(job);
+            continue;
+        }
+
+        // Wait for more jobs to be queued
+        std::unique_lock<std::mutex> lock(mutex);
+        available.wait(lock, [&]() { return stop || (pending > 0); });
+        if (stop) return;
+    }
+}
+
+/*
+ *  DefaultExecutor
+ *
+ *  Description:
+ *      Returns the library's shared WorkStealingExecutor.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A reference to the default executor.
+ *
+ *  Comments:
+ *      None.
+ */
+Executor &DefaultExecutor()
+{
+    static WorkStealingExecutor executor(
+        std::max(std::thread::hardware_concurrency(), 1u) - 1);
+
+    return executor;
+}
+
+} // namespace Terra::Bases
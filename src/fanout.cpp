@@ -0,0 +1,178 @@
+/*
+ *  fanout.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the function to encode one input into several
+ *      encodings at once.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <terra/bases/base16.h>
+#include <terra/bases/base32.h>
+#include <terra/bases/base64.h>
+#include <terra/bases/fanout.h>
+
+namespace Terra::Bases
+{
+
+// Octets per block: a whole number of Base32 (5-octet) and Base64 (3-octet)
+// quanta, so that no block other than the last produces padding, and small
+// enough that a block and its outputs remain in the L1 cache
+static constexpr std::size_t Block_Octets = 15 * 64;
+
+/*
+ *  EncodeBlock
+ *
+ *  Description:
+ *      Encode one block of input into the given target.
+ *
+ *  Parameters:
+ *      block [in]
+ *          The octets to encode.
+ *
+ *      target [in/out]
+ *          The target, whose length is advanced by the characters written.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The caller has verified that the output buffer is large enough.
+ */
+static void EncodeBlock(const std::span<const std::uint8_t> block,
+                        FanOutTarget &target)
+{
+    std::span<char> output = target.output.subspan(target.length);
+    std::size_t length = 0;
+
+    switch (target.encoding)
+    {
+        case FanOutEncoding::Base16:
+            length = Base16::Encode(block, output);
+            break;
+
+        case FanOutEncoding::Base16Lowercase:
+            length = Base16::Encode(block, output);
+
+            // Setting bit 5 lowercases 'A'-'F' and leaves '0'-'9' unchanged
+            for (std::size_t i = 0; i < length; i++) output[i] |= 0x20;
+            break;
+
+        case FanOutEncoding::Base32:
+            length = Base32::Encode(block, output);
+            break;
+
+        case FanOutEncoding::Base64:
+            length = Base64::Encode(block, output);
+            break;
+
+        case FanOutEncoding::Base64URL:
+            length = Base64::Encode(block, output, Base64::URLAlphabet());
+            break;
+    }
+
+    target.length += length;
+}
+
+/*
+ *  MaxEncodedLength
+ *
+ *  Description:
+ *      This function returns the number of characters required to hold the
+ *      given number of octets in the given encoding.
+ *
+ *  Parameters:
+ *      encoding [in]
+ *          The encoding.
+ *
+ *      length [in]
+ *          The number of octets to be encoded.
+ *
+ *  Returns:
+ *      The size of a buffer that is always sufficient for EncodeFanOut().
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MaxEncodedLength(FanOutEncoding encoding, std::size_t length)
+{
+    switch (encoding)
+    {
+        case FanOutEncoding::Base16:
+        case FanOutEncoding::Base16Lowercase:
+            return Base16::MaxEncodedLength(length);
+
+        case FanOutEncoding::Base32:
+            return Base32::MaxEncodedLength(length);
+
+        default:
+            return Base64::MaxEncodedLength(length);
+    }
+}
+
+/*
+ *  EncodeFanOut
+ *
+ *  Description:
+ *      This function will encode the given span of octets into each of the
+ *      given targets, reading the input once.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Span of octets to be encoded.
+ *
+ *      targets [in/out]
+ *          The encodings to produce.  On success, each target's length is
+ *          set to the number of characters written to its output buffer.
+ *
+ *  Returns:
+ *      True if every target was encoded, or false if any target's output
+ *      buffer is smaller than MaxEncodedLength(), in which case nothing is
+ *      written and every length is set to zero.
+ *
+ *  Comments:
+ *      Each block is a whole number of quanta for every encoding, so the
+ *      remaining output space always covers MaxEncodedLength() of the
+ *      remaining input and no encoder rejects a block.
+ */
+bool EncodeFanOut(const std::span<const std::uint8_t> input,
+                  std::span<FanOutTarget> targets)
+{
+    bool sufficient = true;
+
+    // Verify that every output buffer is large enough
+    for (auto &target : targets)
+    {
+        target.length = 0;
+        if (target.output.size() <
+            MaxEncodedLength(target.encoding, input.size()))
+        {
+            sufficient = false;
+        }
+    }
+    if (!sufficient) return false;
+
+    // Pass each block to every target while it is in the cache
+    for (std::size_t offset = 0; offset < input.size(); offset += Block_Octets)
+    {
+        auto block = input.subspan(offset,
+                                   std::min(Block_Octets,
+                                            input.size() - offset));
+
+        for (auto &target : targets) EncodeBlock(block, target);
+    }
+
+    return true;
+}
+
+} // namespace Terra::Bases
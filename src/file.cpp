@@ -0,0 +1,1285 @@
+/*
+ *  file.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements functions to encode and decode files.
+ *
+ *      Each file is processed as a pipeline of blocks.  Every slot in the
+ *      pipeline has an input and an output buffer; the read of a block is
+ *      issued several blocks ahead of the one being transformed, and the
+ *      write of a transformed block proceeds while later blocks are read
+ *      and transformed.  Blocks are transformed in order, so decoding can
+ *      carry an incomplete quantum from one block to the next.
+ *
+ *      I/O is performed by one of two back ends: one issuing requests
+ *      through io_uring using raw system calls (Linux only), and one using
+ *      pread() and pwrite() that completes each request as it is issued.
+ *
+ *  Portability Issues:
+ *      Requires a POSIX system.  io_uring is used only on Linux.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+#include <terra/bases/base16.h>
+#include <terra/bases/base32.h>
+#include <terra/bases/base64.h>
+#include <terra/bases/file.h>
+
+namespace Terra::Bases
+{
+
+namespace
+{
+
+// Alignment of buffers, file offsets, and request sizes for direct I/O
+constexpr std::size_t IO_Alignment = 4096;
+
+// Largest block size used; requests (including the encoded output of a
+// block, which may be twice its size) must fit in the 32-bit length of an
+// io_uring request
+constexpr std::size_t Max_Block_Size = std::size_t(1) << 30;
+
+// Description of the codec used for a file
+struct Codec
+{
+    std::size_t quantum_octets;                 // Octets per quantum
+    std::size_t quantum_characters;             // Characters per quantum
+    char terminator;                            // Padding character or 0
+    std::size_t (*encode)(std::span<const std::uint8_t>, std::span<char>);
+    std::optional<std::size_t> (*decode)(std::string_view,
+                                         std::span<std::uint8_t>);
+    std::size_t (*max_encoded_length)(std::size_t);
+    std::size_t (*max_decoded_length)(std::size_t);
+};
+
+/*
+ *  GetCodec
+ *
+ *  Description:
+ *      Return the description of the codec for the given encoding.
+ *
+ *  Parameters:
+ *      encoding [in]
+ *          The file encoding.
+ *
+ *  Returns:
+ *      The codec description.
+ *
+ *  Comments:
+ *      None.
+ */
+const Codec &GetCodec(FileEncoding encoding)
+{
+    static const Codec base16 =
+    {
+        1, 2, '\0',
+        [](std::span<const std::uint8_t> in, std::span<char> out)
+        {
+            return Base16::Encode(in, out);
+        },
+        [](std::string_view in, std::span<std::uint8_t> out)
+        {
+            return Base16::Decode(in, out);
+        },
+        Base16::MaxEncodedLength,
+        Base16::MaxDecodedLength
+    };
+    static const Codec base32 =
+    {
+        5, 8, '=',
+        [](std::span<const std::uint8_t> in, std::span<char> out)
+        {
+            return Base32::Encode(in, out);
+        },
+        [](std::string_view in, std::span<std::uint8_t> out)
+        {
+            return Base32::Decode(in, out);
+        },
+        Base32::MaxEncodedLength,
+        Base32::MaxDecodedLength
+    };
+    static const Codec base64 =
+    {
+        3, 4, '=',
+        [](std::span<const std::uint8_t> in, std::span<char> out)
+        {
+            return Base64::Encode(in, out);
+        },
+        [](std::string_view in, std::span<std::uint8_t> out)
+        {
+            return Base64::Decode(in, out);
+        },
+        Base64::MaxEncodedLength,
+        Base64::MaxDecodedLength
+    };
+
+    switch (encoding)
+    {
+        case FileEncoding::Base16:
+            return base16;
+        case FileEncoding::Base32:
+            return base32;
+        default:
+            return base64;
+    }
+}
+
+/*
+ *  SignificantCharacters
+ *
+ *  Description:
+ *      Build a table indicating which characters are part of the codec's
+ *      alphabet.
+ *
+ *  Parameters:
+ *      codec [in]
+ *          The codec description.
+ *
+ *  Returns:
+ *      A table indexed by character that is true for alphabet characters.
+ *
+ *  Comments:
+ *      A character is part of the alphabet if a quantum consisting only of
+ *      that character decodes to a full quantum of octets, so the table
+ *      agrees with the codec's decoder by construction.
+ */
+std::array<bool, 256> SignificantCharacters(const Codec &codec)
+{
+    std::array<bool, 256> table{};
+    std::array<std::uint8_t, 8> octets;
+
+    for (std::size_t c = 0; c < table.size(); c++)
+    {
+        std::string quantum(codec.quantum_characters, static_cast<char>(c));
+        auto length = codec.decode(quantum, octets);
+        table[c] = (length == codec.quantum_octets);
+    }
+
+    return table;
+}
+
+// File descriptor that is closed on destruction
+class FileDescriptor
+{
+    public:
+        explicit FileDescriptor(int fd = -1) : fd{fd} {}
+        ~FileDescriptor() { if (fd >= 0) close(fd); }
+        FileDescriptor(const FileDescriptor &) = delete;
+        FileDescriptor &operator=(const FileDescriptor &) = delete;
+
+        int Get() const noexcept { return fd; }
+
+    protected:
+        int fd;
+};
+
+// Buffer aligned for direct I/O
+struct AlignedDeleter
+{
+    void operator()(std::uint8_t *p) const noexcept { std::free(p); }
+};
+using AlignedBuffer = std::unique_ptr<std::uint8_t[], AlignedDeleter>;
+
+/*
+ *  AllocateAligned
+ *
+ *  Description:
+ *      Allocate a buffer aligned for direct I/O.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The minimum size of the buffer.
+ *
+ *  Returns:
+ *      The buffer, which is empty if memory could not be allocated.
+ *
+ *  Comments:
+ *      The size is rounded up to a multiple of the alignment.
+ */
+AlignedBuffer AllocateAligned(std::size_t size)
+{
+    size = ((size + IO_Alignment - 1) / IO_Alignment) * IO_Alignment;
+
+    return AlignedBuffer(
+        static_cast<std::uint8_t *>(std::aligned_alloc(IO_Alignment, size)));
+}
+
+/*
+ *  ReadFully
+ *
+ *  Description:
+ *      Read from the file at the given offset until the buffer is full or
+ *      the end of the file is reached.
+ *
+ *  Parameters:
+ *      fd [in]
+ *          The file descriptor.
+ *
+ *      buffer [out]
+ *          The buffer into which data is read.
+ *
+ *      length [in]
+ *          The number of octets to read.
+ *
+ *      offset [in]
+ *          The file offset at which to read.
+ *
+ *  Returns:
+ *      The number of octets read, or a negative value on error.
+ *
+ *  Comments:
+ *      None.
+ */
+ssize_t ReadFully(int fd, std::uint8_t *buffer, std::size_t length,
+                  std::uint64_t offset)
+{
+    std::size_t total = 0;
+
+    while (total < length)
+    {
+        ssize_t result = pread(fd, buffer + total, length - total,
+                               static_cast<off_t>(offset + total));
+        if (result < 0)
+        {
+            if (errno == EINTR) continue;
+            return result;
+        }
+        if (result == 0) break;
+        total += static_cast<std::size_t>(result);
+    }
+
+    return static_cast<ssize_t>(total);
+}
+
+/*
+ *  WriteFully
+ *
+ *  Description:
+ *      Write the buffer to the file at the given offset.
+ *
+ *  Parameters:
+ *      fd [in]
+ *          The file descriptor.
+ *
+ *      buffer [in]
+ *          The data to write.
+ *
+ *      length [in]
+ *          The number of octets to write.
+ *
+ *      offset [in]
+ *          The file offset at which to write.
+ *
+ *  Returns:
+ *      True if all data was written.
+ *
+ *  Comments:
+ *      None.
+ */
+bool WriteFully(int fd, const std::uint8_t *buffer, std::size_t length,
+                std::uint64_t offset)
+{
+    std::size_t total = 0;
+
+    while (total < length)
+    {
+        ssize_t result = pwrite(fd, buffer + total, length - total,
+                                static_cast<off_t>(offset + total));
+        if (result < 0)
+        {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        total += static_cast<std::size_t>(result);
+    }
+
+    return true;
+}
+
+// Interface to the I/O back ends; each slot has at most one read and one
+// write outstanding, identified by the slot number
+class IOBackEnd
+{
+    public:
+        virtual ~IOBackEnd() = default;
+
+        virtual bool Read(std::size_t slot, std::size_t length,
+                          std::uint64_t offset) = 0;
+        virtual ssize_t WaitRead(std::size_t slot) = 0;
+        virtual bool Write(std::size_t slot, std::size_t length,
+                           std::uint64_t offset) = 0;
+        virtual bool WaitWrite(std::size_t slot) = 0;
+};
+
+// Back end using pread() and pwrite(), completing requests as issued
+class SyncBackEnd final : public IOBackEnd
+{
+    public:
+        SyncBackEnd(int input, int output,
+                    const std::vector<std::uint8_t *> &input_buffers,
+                    const std::vector<std::uint8_t *> &output_buffers) :
+            input{input},
+            output{output},
+            input_buffers{input_buffers},
+            output_buffers{output_buffers},
+            read_results(input_buffers.size()),
+            write_results(output_buffers.size())
+        {
+        }
+
+        bool Read(std::size_t slot, std::size_t length,
+                  std::uint64_t offset) override
+        {
+            read_results[slot] =
+                ReadFully(input, input_buffers[slot], length, offset);
+            return true;
+        }
+
+        ssize_t WaitRead(std::size_t slot) override
+        {
+            return read_results[slot];
+        }
+
+        bool Write(std::size_t slot, std::size_t length,
+                   std::uint64_t offset) override
+        {
+            write_results[slot] =
+                WriteFully(output, output_buffers[slot], length, offset);
+            return true;
+        }
+
+        bool WaitWrite(std::size_t slot) override
+        {
+            return write_results[slot];
+        }
+
+    protected:
+        int input;
+        int output;
+        std::vector<std::uint8_t *> input_buffers;
+        std::vector<std::uint8_t *> output_buffers;
+        std::vector<ssize_t> read_results;
+        std::vector<char> write_results;
+};
+
+#ifdef __linux__
+
+// Back end issuing requests through io_uring
+class RingBackEnd final : public IOBackEnd
+{
+    public:
+        RingBackEnd(int input, int output,
+                    const std::vector<std::uint8_t *> &input_buffers,
+                    const std::vector<std::uint8_t *> &output_buffers,
+                    std::size_t input_size,
+                    std::size_t output_size);
+        ~RingBackEnd();
+
+        // Indicates whether the ring was successfully created
+        bool Ready() const noexcept { return ring_fd >= 0; }
+
+        bool Read(std::size_t slot, std::size_t length,
+                  std::uint64_t offset) override;
+        ssize_t WaitRead(std::size_t slot) override;
+        bool Write(std::size_t slot, std::size_t length,
+                   std::uint64_t offset) override;
+        bool WaitWrite(std::size_t slot) override;
+
+    protected:
+        bool Submit(std::uint8_t opcode, int fd, std::uint8_t *buffer,
+                    std::size_t length, std::uint64_t offset,
+                    unsigned buffer_index, std::uint64_t user_data);
+        bool Wait(std::uint64_t user_data);
+
+        int input;
+        int output;
+        std::vector<std::uint8_t *> input_buffers;
+        std::vector<std::uint8_t *> output_buffers;
+        bool registered;
+        int ring_fd;
+        void *sq_ring;
+        std::size_t sq_ring_size;
+        void *cq_ring;
+        std::size_t cq_ring_size;
+        io_uring_sqe *sqes;
+        std::size_t sqes_size;
+        unsigned *sq_tail;
+        unsigned *sq_mask;
+        unsigned *sq_array;
+        unsigned *cq_head;
+        unsigned *cq_tail;
+        unsigned *cq_mask;
+        io_uring_cqe *cqes;
+        std::vector<int> results;
+        std::vector<char> complete;
+        std::vector<std::size_t> write_lengths;
+        std::vector<std::uint64_t> write_offsets;
+};
+
+/*
+ *  RingBackEnd::RingBackEnd
+ *
+ *  Description:
+ *      Constructor for the RingBackEnd object, which creates the io_uring
+ *      instance, maps its rings, and registers the slot buffers.
+ *
+ *  Parameters:
+ *      input [in]
+ *          File descriptor of the input file.
+ *
+ *      output [in]
+ *          File descriptor of the output file.
+ *
+ *      input_buffers [in]
+ *          The input buffer of each slot.
+ *
+ *      output_buffers [in]
+ *          The output buffer of each slot.
+ *
+ *      input_size [in]
+ *          The size of each input buffer.
+ *
+ *      output_size [in]
+ *          The size of each output buffer.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Ready() returns false if the ring could not be created.  If the
+ *      buffers cannot be registered (e.g., due to the locked memory limit),
+ *      requests are issued without registered buffers.
+ */
+RingBackEnd::RingBackEnd(int input, int output,
+                         const std::vector<std::uint8_t *> &input_buffers,
+                         const std::vector<std::uint8_t *> &output_buffers,
+                         std::size_t input_size,
+                         std::size_t output_size) :
+    input{input},
+    output{output},
+    input_buffers{input_buffers},
+    output_buffers{output_buffers},
+    registered{false},
+    ring_fd{-1},
+    sq_ring{MAP_FAILED},
+    sq_ring_size{0},
+    cq_ring{MAP_FAILED},
+    cq_ring_size{0},
+    sqes{nullptr},
+    sqes_size{0},
+    results(input_buffers.size() * 2),
+    complete(input_buffers.size() * 2),
+    write_lengths(output_buffers.size()),
+    write_offsets(output_buffers.size())
+{
+    io_uring_params params{};
+
+    // Create the ring with room for a read and a write per slot
+    int fd = static_cast<int>(syscall(__NR_io_uring_setup,
+                                      input_buffers.size() * 2,
+                                      &params));
+    if (fd < 0) return;
+
+    // Map the submission and completion rings
+    sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size = params.cq_off.cqes +
+                   params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+    }
+    sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (sq_ring == MAP_FAILED)
+    {
+        close(fd);
+        return;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        cq_ring = sq_ring;
+    }
+    else
+    {
+        cq_ring = mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (cq_ring == MAP_FAILED)
+        {
+            close(fd);
+            return;
+        }
+    }
+
+    // Map the submission queue entries
+    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    void *entries = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (entries == MAP_FAILED)
+    {
+        close(fd);
+        return;
+    }
+    sqes = static_cast<io_uring_sqe *>(entries);
+
+    // Locate the ring fields
+    auto sq = static_cast<std::uint8_t *>(sq_ring);
+    auto cq = static_cast<std::uint8_t *>(cq_ring);
+    sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+    // Register the buffers: input buffers first, then output buffers
+    std::vector<iovec> iovecs;
+    for (auto buffer : input_buffers) iovecs.push_back({buffer, input_size});
+    for (auto buffer : output_buffers) iovecs.push_back({buffer, output_size});
+    registered = syscall(__NR_io_uring_register,
+                         fd,
+                         IORING_REGISTER_BUFFERS,
+                         iovecs.data(),
+                         static_cast<unsigned>(iovecs.size())) == 0;
+
+    ring_fd = fd;
+}
+
+/*
+ *  RingBackEnd::~RingBackEnd
+ *
+ *  Description:
+ *      Destructor for the RingBackEnd object, which unmaps the rings and
+ *      closes the io_uring instance.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      All requests must have completed.
+ */
+RingBackEnd::~RingBackEnd()
+{
+    if (sqes != nullptr) munmap(sqes, sqes_size);
+    if ((cq_ring != MAP_FAILED) && (cq_ring != sq_ring))
+    {
+        munmap(cq_ring, cq_ring_size);
+    }
+    if (sq_ring != MAP_FAILED) munmap(sq_ring, sq_ring_size);
+    if (ring_fd >= 0) close(ring_fd);
+}
+
+/*
+ *  RingBackEnd::Submit
+ *
+ *  Description:
+ *      Queue a request and submit it to the kernel.
+ *
+ *  Parameters:
+ *      opcode [in]
+ *          The operation (a fixed read or write).
+ *
+ *      fd [in]
+ *          The file descriptor.
+ *
+ *      buffer [in]
+ *          The buffer to read into or write from.
+ *
+ *      length [in]
+ *          The number of octets to transfer.
+ *
+ *      offset [in]
+ *          The file offset.
+ *
+ *      buffer_index [in]
+ *          The index of the registered buffer.
+ *
+ *      user_data [in]
+ *          Value identifying the request's completion.
+ *
+ *  Returns:
+ *      True if the request was submitted, or false if it could not be or
+ *      the length exceeds what a request may specify.
+ *
+ *  Comments:
+ *      If buffers are not registered, the equivalent unregistered
+ *      operation is used.
+ */
+bool RingBackEnd::Submit(std::uint8_t opcode, int fd, std::uint8_t *buffer,
+                         std::size_t length, std::uint64_t offset,
+                         unsigned buffer_index, std::uint64_t user_data)
+{
+    // The request length is limited to 32 bits
+    if (length > std::numeric_limits<std::uint32_t>::max()) return false;
+
+    std::atomic_ref<unsigned> tail(*sq_tail);
+    unsigned index = tail.load(std::memory_order_relaxed) & *sq_mask;
+    io_uring_sqe &sqe = sqes[index];
+
+    // Fill in the submission queue entry
+    std::memset(&sqe, 0, sizeof(sqe));
+    if (registered)
+    {
+        sqe.opcode = opcode;
+        sqe.buf_index = static_cast<std::uint16_t>(buffer_index);
+    }
+    else
+    {
+        sqe.opcode = (opcode == IORING_OP_READ_FIXED) ? IORING_OP_READ :
+                                                        IORING_OP_WRITE;
+    }
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<std::uint64_t>(buffer);
+    sqe.len = static_cast<std::uint32_t>(length);
+    sqe.off = offset;
+    sqe.user_data = user_data;
+
+    // Publish the entry and tell the kernel about it
+    sq_array[index] = index;
+    tail.store(tail.load(std::memory_order_relaxed) + 1,
+               std::memory_order_release);
+    complete[user_data] = false;
+
+    while (syscall(__NR_io_uring_enter, ring_fd, 1, 0, 0, nullptr, 0) < 0)
+    {
+        if (errno != EINTR) return false;
+    }
+
+    return true;
+}
+
+/*
+ *  RingBackEnd::Wait
+ *
+ *  Description:
+ *      Wait for the request identified by the given value to complete.
+ *
+ *  Parameters:
+ *      user_data [in]
+ *          Value identifying the request.
+ *
+ *  Returns:
+ *      True if the request completed, false if waiting failed.
+ *
+ *  Comments:
+ *      Completions of other requests are recorded as they are reaped.
+ */
+bool RingBackEnd::Wait(std::uint64_t user_data)
+{
+    std::atomic_ref<unsigned> head(*cq_head);
+    std::atomic_ref<unsigned> tail(*cq_tail);
+
+    while (!complete[user_data])
+    {
+        // Reap all available completions
+        unsigned current = head.load(std::memory_order_relaxed);
+        unsigned last = tail.load(std::memory_order_acquire);
+        if (current != last)
+        {
+            for (; current != last; current++)
+            {
+                const io_uring_cqe &cqe = cqes[current & *cq_mask];
+                results[cqe.user_data] = cqe.res;
+                complete[cqe.user_data] = true;
+            }
+            head.store(current, std::memory_order_release);
+            continue;
+        }
+
+        // Wait for at least one completion
+        if ((syscall(__NR_io_uring_enter, ring_fd, 0, 1,
+                     IORING_ENTER_GETEVENTS, nullptr, 0) < 0) &&
+            (errno != EINTR))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ *  RingBackEnd::Read
+ *
+ *  Description:
+ *      Issue a read into the slot's input buffer.
+ *
+ *  Parameters:
+ *      slot [in]
+ *          The pipeline slot.
+ *
+ *      length [in]
+ *          The number of octets to read.
+ *
+ *      offset [in]
+ *          The file offset at which to read.
+ *
+ *  Returns:
+ *      True if the request was issued.
+ *
+ *  Comments:
+ *      None.
+ */
+bool RingBackEnd::Read(std::size_t slot, std::size_t length,
+                       std::uint64_t offset)
+{
+    return Submit(IORING_OP_READ_FIXED, input, input_buffers[slot], length,
+                  offset, static_cast<unsigned>(slot), slot * 2);
+}
+
+/*
+ *  RingBackEnd::WaitRead
+ *
+ *  Description:
+ *      Wait for the slot's read to complete.
+ *
+ *  Parameters:
+ *      slot [in]
+ *          The pipeline slot.
+ *
+ *  Returns:
+ *      The number of octets read, or a negative value on error.
+ *
+ *  Comments:
+ *      None.
+ */
+ssize_t RingBackEnd::WaitRead(std::size_t slot)
+{
+    if (!Wait(slot * 2)) return -1;
+
+    return results[slot * 2];
+}
+
+/*
+ *  RingBackEnd::Write
+ *
+ *  Description:
+ *      Issue a write from the slot's output buffer.
+ *
+ *  Parameters:
+ *      slot [in]
+ *          The pipeline slot.
+ *
+ *      length [in]
+ *          The number of octets to write.
+ *
+ *      offset [in]
+ *          The file offset at which to write.
+ *
+ *  Returns:
+ *      True if the request was issued.
+ *
+ *  Comments:
+ *      None.
+ */
+bool RingBackEnd::Write(std::size_t slot, std::size_t length,
+                        std::uint64_t offset)
+{
+    write_lengths[slot] = length;
+    write_offsets[slot] = offset;
+
+    return Submit(IORING_OP_WRITE_FIXED, output, output_buffers[slot], length,
+                  offset,
+                  static_cast<unsigned>(input_buffers.size() + slot),
+                  slot * 2 + 1);
+}
+
+/*
+ *  RingBackEnd::WaitWrite
+ *
+ *  Description:
+ *      Wait for the slot's write to complete.
+ *
+ *  Parameters:
+ *      slot [in]
+ *          The pipeline slot.
+ *
+ *  Returns:
+ *      True if the write completed in full.
+ *
+ *  Comments:
+ *      A write may complete short (e.g., when interrupted by a signal), in
+ *      which case the remainder is submitted again, just as WriteFully()
+ *      does.  A write that makes no progress is an error.
+ */
+bool RingBackEnd::WaitWrite(std::size_t slot)
+{
+    std::size_t written = 0;
+
+    while (true)
+    {
+        if (!Wait(slot * 2 + 1)) return false;
+
+        int result = results[slot * 2 + 1];
+        if (result == -EINTR) result = 0;
+        else if (result <= 0) return false;
+
+        written += static_cast<std::size_t>(result);
+        if (written >= write_lengths[slot]) return true;
+
+        if (!Submit(IORING_OP_WRITE_FIXED,
+                    output,
+                    output_buffers[slot] + written,
+                    write_lengths[slot] - written,
+                    write_offsets[slot] + written,
+                    static_cast<unsigned>(input_buffers.size() + slot),
+                    slot * 2 + 1))
+        {
+            return false;
+        }
+    }
+}
+
+#endif // __linux__
+
+// Function transforming one block: given the block index, the input data,
+// the output buffer, and whether this is the last block, it returns the
+// number of octets written to the output buffer or std::nullopt on error
+using Transform = std::function<std::optional<std::size_t>(
+    std::size_t, std::span<std::uint8_t>, std::span<std::uint8_t>, bool)>;
+
+/*
+ *  ProcessFile
+ *
+ *  Description:
+ *      Read the input file in blocks, transform each block, and write the
+ *      results sequentially to the output file.
+ *
+ *  Parameters:
+ *      input_path [in]
+ *          The input file.
+ *
+ *      output_path [in]
+ *          The output file.
+ *
+ *      options [in]
+ *          Options controlling how the files are read and written.
+ *
+ *      block_unit [in]
+ *          The block size is rounded to a multiple of this value.
+ *
+ *      output_size [in]
+ *          Function returning the output buffer size needed for a block.
+ *
+ *      transform [in]
+ *          Function transforming each block.
+ *
+ *  Returns:
+ *      The number of octets written to the output file, or std::nullopt on
+ *      error.
+ *
+ *  Comments:
+ *      None.
+ */
+std::optional<std::uint64_t> ProcessFile(
+                        const std::string &input_path,
+                        const std::string &output_path,
+                        const FileOptions &options,
+                        std::size_t block_unit,
+                        const std::function<std::size_t(std::size_t)> &
+                            output_size,
+                        const Transform &transform)
+{
+    // Open the input file, using direct I/O if requested and supported
+    int input_fd = -1;
+    bool direct = false;
+#ifdef O_DIRECT
+    if (options.direct)
+    {
+        input_fd = open(input_path.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT);
+        direct = (input_fd >= 0);
+    }
+#endif
+    if (input_fd < 0) input_fd = open(input_path.c_str(), O_RDONLY | O_CLOEXEC);
+    FileDescriptor input(input_fd);
+    if (input.Get() < 0) return {};
+
+    // Short reads are completed from an unaligned offset, which direct I/O
+    // does not permit, so a buffered descriptor is needed for those
+    FileDescriptor buffered_input(
+        direct ? open(input_path.c_str(), O_RDONLY | O_CLOEXEC) : -1);
+    if (direct && (buffered_input.Get() < 0)) return {};
+    const int remainder_fd = direct ? buffered_input.Get() : input.Get();
+
+    // Open the output file
+    FileDescriptor output(open(output_path.c_str(),
+                               O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                               0666));
+    if (output.Get() < 0) return {};
+
+    // Determine the input size
+    struct stat status;
+    if (fstat(input.Get(), &status) != 0) return {};
+    const std::uint64_t input_size = static_cast<std::uint64_t>(status.st_size);
+
+    // Determine the block size, which is a multiple of the block unit no
+    // larger than Max_Block_Size or than needed to hold the whole input,
+    // and the number of blocks
+    const std::uint64_t whole_input =
+        ((input_size + block_unit - 1) / block_unit) * block_unit;
+    const std::size_t block_size = std::max(
+        block_unit,
+        static_cast<std::size_t>(
+            (std::min<std::uint64_t>({options.block_size,
+                                      Max_Block_Size,
+                                      whole_input}) /
+             block_unit) *
+            block_unit));
+    const std::uint64_t blocks = (input_size + block_size - 1) / block_size;
+    const std::size_t slots = static_cast<std::size_t>(
+        std::min<std::uint64_t>(std::max<std::size_t>(options.queue_depth, 1),
+                                std::max<std::uint64_t>(blocks, 1)));
+
+    // Allocate the slot buffers
+    const std::size_t output_buffer_size = output_size(block_size);
+    std::vector<AlignedBuffer> buffers;
+    std::vector<std::uint8_t *> input_buffers;
+    std::vector<std::uint8_t *> output_buffers;
+    for (std::size_t i = 0; i < slots; i++)
+    {
+        buffers.push_back(AllocateAligned(block_size));
+        input_buffers.push_back(buffers.back().get());
+        buffers.push_back(AllocateAligned(output_buffer_size));
+        output_buffers.push_back(buffers.back().get());
+        if (!input_buffers.back() || !output_buffers.back()) return {};
+    }
+
+    // Select the I/O back end
+    std::unique_ptr<IOBackEnd> io;
+#ifdef __linux__
+    if (options.io_uring)
+    {
+        auto ring = std::make_unique<RingBackEnd>(input.Get(),
+                                                  output.Get(),
+                                                  input_buffers,
+                                                  output_buffers,
+                                                  block_size,
+                                                  output_buffer_size);
+        if (ring->Ready()) io = std::move(ring);
+    }
+#endif
+    if (!io)
+    {
+        io = std::make_unique<SyncBackEnd>(input.Get(),
+                                           output.Get(),
+                                           input_buffers,
+                                           output_buffers);
+    }
+
+    std::vector<char> reading(slots, false);
+    std::vector<char> writing(slots, false);
+    std::uint64_t output_offset = 0;
+    bool failed = false;
+
+    // Issue the initial reads
+    for (std::size_t i = 0; (i < slots) && (i < blocks) && !failed; i++)
+    {
+        failed = !io->Read(i, block_size, i * block_size);
+        reading[i] = !failed;
+    }
+
+    // Transform each block in order as its read completes
+    for (std::uint64_t i = 0; (i < blocks) && !failed; i++)
+    {
+        const std::size_t slot = static_cast<std::size_t>(i % slots);
+        const std::uint64_t offset = i * block_size;
+        const std::size_t expected = static_cast<std::size_t>(
+            std::min<std::uint64_t>(block_size, input_size - offset));
+
+        // Wait for the block to be read, completing any short read
+        reading[slot] = false;
+        ssize_t length = io->WaitRead(slot);
+        if (length < 0)
+        {
+            failed = true;
+            break;
+        }
+        if (static_cast<std::size_t>(length) < expected)
+        {
+            ssize_t rest = ReadFully(remainder_fd,
+                                     input_buffers[slot] + length,
+                                     expected - length,
+                                     offset + length);
+            if ((rest < 0) ||
+                (static_cast<std::size_t>(length + rest) != expected))
+            {
+                failed = true;
+                break;
+            }
+        }
+
+        // Ensure the slot's previous write has completed
+        if (writing[slot])
+        {
+            writing[slot] = false;
+            if (!io->WaitWrite(slot))
+            {
+                failed = true;
+                break;
+            }
+        }
+
+        // Transform the block
+        auto produced = transform(
+            static_cast<std::size_t>(i),
+            std::span<std::uint8_t>(input_buffers[slot], expected),
+            std::span<std::uint8_t>(output_buffers[slot], output_buffer_size),
+            i == blocks - 1);
+        if (!produced)
+        {
+            failed = true;
+            break;
+        }
+
+        // Write the result
+        if (*produced > 0)
+        {
+            if (!io->Write(slot, *produced, output_offset))
+            {
+                failed = true;
+                break;
+            }
+            writing[slot] = true;
+            output_offset += *produced;
+        }
+
+        // Read the block that will next use this slot
+        if (i + slots < blocks)
+        {
+            failed = !io->Read(slot, block_size, (i + slots) * block_size);
+            reading[slot] = !failed;
+        }
+    }
+
+    // Wait for outstanding requests before the buffers are released
+    for (std::size_t slot = 0; slot < slots; slot++)
+    {
+        if (reading[slot]) io->WaitRead(slot);
+        if (writing[slot] && !io->WaitWrite(slot)) failed = true;
+    }
+
+    if (failed) return {};
+
+    return output_offset;
+}
+
+} // namespace
+
+/*
+ *  EncodeFile
+ *
+ *  Description:
+ *      This function will encode the contents of the input file, writing the
+ *      encoded text to the output file.
+ *
+ *  Parameters:
+ *      input_path [in]
+ *          The file to encode.
+ *
+ *      output_path [in]
+ *          The file to which the encoded text is written.
+ *
+ *      encoding [in]
+ *          The encoding to use.
+ *
+ *      options [in]
+ *          Options controlling how the files are read and written.
+ *
+ *  Returns:
+ *      The number of characters written, or std::nullopt on error.
+ *
+ *  Comments:
+ *      Blocks hold a whole number of quanta, so each is encoded
+ *      independently and only the last is padded.
+ */
+std::optional<std::uint64_t> EncodeFile(const std::string &input_path,
+                                        const std::string &output_path,
+                                        FileEncoding encoding,
+                                        const FileOptions &options)
+{
+    const Codec &codec = GetCodec(encoding);
+
+    return ProcessFile(
+        input_path,
+        output_path,
+        options,
+        codec.quantum_octets * IO_Alignment,
+        codec.max_encoded_length,
+        [&](std::size_t,
+            std::span<std::uint8_t> input,
+            std::span<std::uint8_t> output,
+            bool) -> std::optional<std::size_t>
+        {
+            return codec.encode(
+                input,
+                std::span<char>(reinterpret_cast<char *>(output.data()),
+                                output.size()));
+        });
+}
+
+/*
+ *  DecodeFile
+ *
+ *  Description:
+ *      This function will decode the contents of the input file, writing the
+ *      decoded octets to the output file.
+ *
+ *  Parameters:
+ *      input_path [in]
+ *          The file to decode.
+ *
+ *      output_path [in]
+ *          The file to which the decoded octets are written.
+ *
+ *      encoding [in]
+ *          The encoding of the input file.
+ *
+ *      options [in]
+ *          Options controlling how the files are read and written.
+ *
+ *  Returns:
+ *      The number of octets written, or std::nullopt on error.
+ *
+ *  Comments:
+ *      A block consisting only of alphabet characters is decoded directly
+ *      by the codec's kernels.  Otherwise, the block's alphabet characters
+ *      are first compacted in place.  Characters that do not complete a
+ *      quantum are carried into the next block, and any remaining at the
+ *      end are decoded by the codec, which applies its usual rules for a
+ *      partial final quantum.
+ */
+std::optional<std::uint64_t> DecodeFile(const std::string &input_path,
+                                        const std::string &output_path,
+                                        FileEncoding encoding,
+                                        const FileOptions &options)
+{
+    const Codec &codec = GetCodec(encoding);
+    const std::array<bool, 256> significant = SignificantCharacters(codec);
+    const std::size_t quantum = codec.quantum_characters;
+    char carry[8];                              // Incomplete quantum
+    std::size_t carry_length = 0;               // Characters in carry
+    bool finished = false;                      // Padding was found
+
+    return ProcessFile(
+        input_path,
+        output_path,
+        options,
+        IO_Alignment,
+        [&](std::size_t block_size)
+        {
+            return codec.max_decoded_length(block_size + quantum);
+        },
+        [&](std::size_t,
+            std::span<std::uint8_t> input,
+            std::span<std::uint8_t> output,
+            bool last) -> std::optional<std::size_t>
+        {
+            std::string_view text(reinterpret_cast<char *>(input.data()),
+                                  input.size());
+            std::size_t length = 0;
+
+            if (!finished && (carry_length == 0))
+            {
+                // Attempt to decode all complete quanta directly
+                std::size_t prefix = (text.size() / quantum) * quantum;
+                auto result = codec.decode(text.substr(0, prefix), output);
+                if (result &&
+                    (*result == (prefix / quantum) * codec.quantum_octets))
+                {
+                    length = *result;
+                    text.remove_prefix(prefix);
+                }
+            }
+
+            if (!finished && !text.empty())
+            {
+                // Compact the alphabet characters, stopping at padding
+                char *compacted = const_cast<char *>(text.data());
+                std::size_t count = 0;
+                for (const char c : text)
+                {
+                    if (significant[static_cast<std::uint8_t>(c)])
+                    {
+                        compacted[count++] = c;
+                    }
+                    else if ((c == codec.terminator) && (c != '\0'))
+                    {
+                        finished = true;
+                        break;
+                    }
+                }
+                std::string_view rest(compacted, count);
+
+                // Complete the carried quantum, if any
+                if (carry_length > 0)
+                {
+                    std::size_t needed = std::min(quantum - carry_length,
+                                                  rest.size());
+                    std::memcpy(carry + carry_length, rest.data(), needed);
+                    carry_length += needed;
+                    rest.remove_prefix(needed);
+                    if (carry_length == quantum)
+                    {
+                        auto result = codec.decode(
+                            std::string_view(carry, quantum),
+                            output.subspan(length));
+                        if (!result) return {};
+                        length += *result;
+                        carry_length = 0;
+                    }
+                }
+
+                // Decode the complete quanta and carry the remainder
+                std::size_t prefix = (rest.size() / quantum) * quantum;
+                auto result = codec.decode(rest.substr(0, prefix),
+                                           output.subspan(length));
+                if (!result) return {};
+                length += *result;
+                rest.remove_prefix(prefix);
+                std::memcpy(carry + carry_length, rest.data(), rest.size());
+                carry_length += rest.size();
+            }
+
+            // Decode any incomplete quantum at the end of the input
+            if (last && (carry_length > 0))
+            {
+                auto result = codec.decode(
+                    std::string_view(carry, carry_length),
+                    output.subspan(length));
+                if (!result) return {};
+                length += *result;
+            }
+
+            return length;
+        });
+}
+
+} // namespace Terra::Bases
@@ -0,0 +1,167 @@
+/*
+ *  format.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the functions used to format octets as Base16,
+ *      Base32, or Base64 into an output iterator.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <terra/bases/base16.h>
+#include <terra/bases/base32.h>
+#include <terra/bases/base64.h>
+#include <terra/bases/format.h>
+
+namespace Terra::Bases
+{
+
+/*
+ *  FormattedLength
+ *
+ *  Description:
+ *      Return the number of characters produced by formatting the given
+ *      number of octets, excluding fill characters.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The number of octets.
+ *
+ *      encoding [in]
+ *          The encoding.
+ *
+ *      spec [in]
+ *          The formatting options.
+ *
+ *  Returns:
+ *      The number of characters.
+ *
+ *  Comments:
+ *      Unlike MaxEncodedLength(), this is exact, since padding characters
+ *      placed before the output depend on it.
+ */
+std::size_t FormattedLength(std::size_t length,
+                            FanOutEncoding encoding,
+                            const FormatSpec &spec)
+{
+    switch (encoding)
+    {
+        case FanOutEncoding::Base16:
+        case FanOutEncoding::Base16Lowercase:
+            if ((spec.separator != '\0') && (length > 0))
+            {
+                return length * 3 - 1;
+            }
+            return length * 2;
+
+        case FanOutEncoding::Base32:
+            return Base32::MaxEncodedLength(length);
+
+        case FanOutEncoding::Base64:
+            return Base64::MaxEncodedLength(length);
+
+        case FanOutEncoding::Base64URL:
+            // The URL alphabet is not padded
+            return (length / 3) * 4 + ((length % 3) ? (length % 3) + 1 : 0);
+    }
+
+    return 0;
+}
+
+/*
+ *  FormatBlock
+ *
+ *  Description:
+ *      Encode one block of octets for formatting.
+ *
+ *  Parameters:
+ *      octets [in]
+ *          All of the octets being formatted.
+ *
+ *      offset [in]
+ *          Offset of the block to encode, which is a multiple of
+ *          Format_Block_Octets.
+ *
+ *      encoding [in]
+ *          The encoding.
+ *
+ *      spec [in]
+ *          The formatting options.
+ *
+ *      output [out]
+ *          Buffer into which the block's characters are written.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer.
+ *
+ *  Comments:
+ *      Hexadecimal with separators is encoded into the end of the buffer
+ *      and then spread toward the front, three characters per octet, which
+ *      never overwrites characters not yet moved.
+ */
+std::size_t FormatBlock(const std::span<const std::uint8_t> octets,
+                        std::size_t offset,
+                        FanOutEncoding encoding,
+                        const FormatSpec &spec,
+                        std::span<char, Format_Block_Characters> output)
+{
+    auto block = octets.subspan(offset,
+                                std::min(Format_Block_Octets,
+                                         octets.size() - offset));
+    std::size_t length = 0;
+
+    switch (encoding)
+    {
+        case FanOutEncoding::Base16:
+        case FanOutEncoding::Base16Lowercase:
+        {
+            // Encode into the end of the buffer if separators will be added
+            std::span<char> hex = (spec.separator != '\0') ?
+                                      output.last(block.size() * 2) :
+                                      output.first(block.size() * 2);
+            length = Base16::Encode(block, hex);
+
+            // Setting bit 5 lowercases 'A'-'F' and leaves '0'-'9' unchanged
+            if (spec.lowercase)
+            {
+                for (auto &c : hex) c |= 0x20;
+            }
+
+            if (spec.separator == '\0') break;
+
+            length = 0;
+            for (std::size_t i = 0; i < block.size(); i++)
+            {
+                if ((offset > 0) || (i > 0)) output[length++] = spec.separator;
+                output[length++] = hex[i * 2];
+                output[length++] = hex[i * 2 + 1];
+            }
+            break;
+        }
+
+        case FanOutEncoding::Base32:
+            length = Base32::Encode(block, output);
+            break;
+
+        case FanOutEncoding::Base64:
+            length = Base64::Encode(block, output);
+            break;
+
+        case FanOutEncoding::Base64URL:
+            length = Base64::Encode(block, output, Base64::URLAlphabet());
+            break;
+    }
+
+    return length;
+}
+
+} // namespace Terra::Bases
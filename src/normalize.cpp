@@ -0,0 +1,419 @@
+/*
+ *  normalize.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements functions to convert Base16, Base32, or Base64
+ *      text into the canonical form of an encoding without decoding it.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <terra/bases/normalize.h>
+
+namespace Terra::Bases
+{
+
+// Classes of input characters; all other values are output characters
+static constexpr char Invalid_Character = 0;
+static constexpr char Skipped_Character = 1;
+static constexpr char Padding_Character = 2;
+
+// Number of characters translated before testing the result
+static constexpr std::size_t Block_Size = 16;
+
+/*
+ *  Translate
+ *
+ *  Description:
+ *      Determine the canonical character of the target encoding that the
+ *      given input character represents.
+ *
+ *  Parameters:
+ *      target [in]
+ *          The form to produce.
+ *
+ *      c [in]
+ *          The input character.
+ *
+ *  Returns:
+ *      The canonical character, or Invalid_Character, Skipped_Character
+ *      (for whitespace), or Padding_Character.
+ *
+ *  Comments:
+ *      This is constexpr so that the translation tables may be built at
+ *      compile time.
+ */
+static constexpr char Translate(FanOutEncoding target, char c)
+{
+    if ((c == ' ') || (c == '\t') || (c == '\n') || (c == '\r') ||
+        (c == '\f') || (c == '\v'))
+    {
+        return Skipped_Character;
+    }
+
+    switch (target)
+    {
+        case FanOutEncoding::Base16:
+        case FanOutEncoding::Base16Lowercase:
+        {
+            if ((c >= '0') && (c <= '9')) return c;
+            char u = static_cast<char>(c & ~0x20);
+            if ((u < 'A') || (u > 'F')) return Invalid_Character;
+            return (target == FanOutEncoding::Base16) ? u :
+                                                        (u | 0x20);
+        }
+
+        case FanOutEncoding::Base32:
+        {
+            if (c == '=') return Padding_Character;
+            if ((c >= '2') && (c <= '7')) return c;
+            char u = static_cast<char>(c & ~0x20);
+            if ((u >= 'A') && (u <= 'Z')) return u;
+            return Invalid_Character;
+        }
+
+        case FanOutEncoding::Base64:
+        case FanOutEncoding::Base64URL:
+        {
+            bool url = (target == FanOutEncoding::Base64URL);
+            if (c == '=') return Padding_Character;
+            if ((c >= 'A') && (c <= 'Z')) return c;
+            if ((c >= 'a') && (c <= 'z')) return c;
+            if ((c >= '0') && (c <= '9')) return c;
+            if ((c == '+') || (c == '-')) return url ? '-' : '+';
+            if ((c == '/') || (c == '_')) return url ? '_' : '/';
+            return Invalid_Character;
+        }
+    }
+
+    return Invalid_Character;
+}
+
+#ifndef BASES_COMPACT
+/*
+ *  MakeTable
+ *
+ *  Description:
+ *      Build the table mapping every character to the result of
+ *      Translate() for the given target.
+ *
+ *  Parameters:
+ *      target [in]
+ *          The form to produce.
+ *
+ *  Returns:
+ *      The translation table.
+ *
+ *  Comments:
+ *      None.
+ */
+static constexpr std::array<char, 256> MakeTable(FanOutEncoding target)
+{
+    std::array<char, 256> table{};
+
+    for (std::size_t i = 0; i < table.size(); i++)
+    {
+        table[i] = Translate(target, static_cast<char>(i));
+    }
+
+    return table;
+}
+
+// Translation tables for each target, in FanOutEncoding order
+static constexpr std::array<char, 256> Translation_Tables[] =
+{
+    MakeTable(FanOutEncoding::Base16),
+    MakeTable(FanOutEncoding::Base16Lowercase),
+    MakeTable(FanOutEncoding::Base32),
+    MakeTable(FanOutEncoding::Base64),
+    MakeTable(FanOutEncoding::Base64URL)
+};
+#endif
+
+/*
+ *  ToValue
+ *
+ *  Description:
+ *      Return the value of a canonical Base32 or Base64 character.
+ *
+ *  Parameters:
+ *      target [in]
+ *          The form to which the character belongs.
+ *
+ *      c [in]
+ *          The canonical character.
+ *
+ *  Returns:
+ *      The value the character represents.
+ *
+ *  Comments:
+ *      None.
+ */
+static std::uint8_t ToValue(FanOutEncoding target, char c)
+{
+    if (target == FanOutEncoding::Base32)
+    {
+        return (c >= 'A') ? c - 'A' : c - '2' + 26;
+    }
+
+    if ((c >= 'A') && (c <= 'Z')) return c - 'A';
+    if ((c >= 'a') && (c <= 'z')) return c - 'a' + 26;
+    if ((c >= '0') && (c <= '9')) return c - '0' + 52;
+    return ((c == '+') || (c == '-')) ? 62 : 63;
+}
+
+/*
+ *  ToCharacter
+ *
+ *  Description:
+ *      Return the canonical Base32 or Base64 character for a value.
+ *
+ *  Parameters:
+ *      target [in]
+ *          The form to produce.
+ *
+ *      value [in]
+ *          The value to represent.
+ *
+ *  Returns:
+ *      The canonical character.
+ *
+ *  Comments:
+ *      None.
+ */
+static char ToCharacter(FanOutEncoding target, std::uint8_t value)
+{
+    if (target == FanOutEncoding::Base32)
+    {
+        return (value < 26) ? 'A' + value : '2' + (value - 26);
+    }
+
+    if (value < 26) return 'A' + value;
+    if (value < 52) return 'a' + (value - 26);
+    if (value < 62) return '0' + (value - 52);
+    if (target == FanOutEncoding::Base64URL) return (value == 62) ? '-' : '_';
+    return (value == 62) ? '+' : '/';
+}
+
+/*
+ *  NormalizeCharacters
+ *
+ *  Description:
+ *      Translate the input into canonical characters, removing whitespace
+ *      and padding and zeroing unused trailing bits.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Encoded text to normalize.
+ *
+ *      target [in]
+ *          The form to produce.
+ *
+ *      output [out]
+ *          Buffer into which the canonical characters are written, which
+ *          may begin at the same location as the input.
+ *
+ *      padding [out]
+ *          The number of padding characters the target requires after the
+ *          characters written.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, or
+ *      std::nullopt if the input is not valid or the output buffer was too
+ *      small.
+ *
+ *  Comments:
+ *      Output is never written ahead of the input position, so the input
+ *      is always read before it is overwritten when normalizing in place.
+ *      A block of characters is translated at once and copied if all are
+ *      canonical characters, which is the usual case.
+ */
+static std::optional<std::size_t> NormalizeCharacters(
+                                                const std::string_view input,
+                                                FanOutEncoding target,
+                                                std::span<char> output,
+                                                std::size_t &padding)
+{
+#ifndef BASES_COMPACT
+    const auto &table = Translation_Tables[static_cast<std::size_t>(target)];
+    auto translate = [&table](char c)
+    {
+        return table[static_cast<std::uint8_t>(c)];
+    };
+#else
+    auto translate = [target](char c) { return Translate(target, c); };
+#endif
+    std::size_t length = 0;                     // Characters written
+    std::size_t padded = 0;                     // Padding characters read
+    std::size_t i = 0;                          // Input position
+
+    while (i < input.size())
+    {
+        // Translate a block at a time while every character is canonical
+        if ((padded == 0) && (input.size() - i >= Block_Size) &&
+            (output.size() - length >= Block_Size))
+        {
+            char block[Block_Size];
+            std::uint8_t lowest = 0xff;
+            for (std::size_t j = 0; j < Block_Size; j++)
+            {
+                block[j] = translate(input[i + j]);
+                lowest = std::min(lowest, static_cast<std::uint8_t>(block[j]));
+            }
+            if (lowest > Padding_Character)
+            {
+                std::memcpy(output.data() + length, block, Block_Size);
+                length += Block_Size;
+                i += Block_Size;
+                continue;
+            }
+        }
+
+        // Otherwise, handle the next few characters individually
+        std::size_t end = std::min(input.size(), i + Block_Size);
+        for (; i < end; i++)
+        {
+            char c = translate(input[i]);
+            if (c == Skipped_Character) continue;
+            if (c == Invalid_Character) return {};
+            if (c == Padding_Character)
+            {
+                padded++;
+                continue;
+            }
+
+            // Data may not follow padding
+            if ((padded > 0) || (length == output.size())) return {};
+            output[length++] = c;
+        }
+    }
+
+    // Determine the characters per quantum and the residual bits
+    std::size_t quantum;
+    std::size_t bits;
+    switch (target)
+    {
+        case FanOutEncoding::Base16:
+        case FanOutEncoding::Base16Lowercase:
+            padding = 0;
+            return ((length % 2) == 0) ? std::optional(length) :
+                                         std::nullopt;
+
+        case FanOutEncoding::Base32:
+            quantum = 8;
+            bits = (length % quantum) * 5 % 8;
+            break;
+
+        default:
+            quantum = 4;
+            bits = (length % quantum) * 6 % 8;
+            break;
+    }
+
+    // Reject lengths that no encoder produces (e.g., a single residual
+    // Base64 character) and excessive padding
+    std::size_t residual = length % quantum;
+    if ((residual > 0) && (bits >= ((quantum == 8) ? 5 : 6))) return {};
+    if (padded > quantum - ((residual > 0) ? residual : quantum)) return {};
+
+    // Set unused trailing bits to zero
+    if (bits > 0)
+    {
+        char &last = output[length - 1];
+        std::uint8_t value = ToValue(target, last);
+        last = ToCharacter(target, value & ~((1u << bits) - 1));
+    }
+
+    padding = ((target == FanOutEncoding::Base64URL) || (residual == 0)) ?
+                  0 :
+                  quantum - residual;
+
+    return length;
+}
+
+/*
+ *  Normalize
+ *
+ *  Description:
+ *      This function will convert encoded text into the canonical form of
+ *      the target encoding, writing it into the given output buffer.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Encoded text to normalize.
+ *
+ *      target [in]
+ *          The form to produce.
+ *
+ *      output [out]
+ *          Buffer into which the normalized text is written, which may be
+ *          the input's own storage.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer, or
+ *      std::nullopt if the input is not valid or the output buffer was too
+ *      small.
+ *
+ *  Comments:
+ *      None.
+ */
+std::optional<std::size_t> Normalize(const std::string_view input,
+                                     FanOutEncoding target,
+                                     std::span<char> output)
+{
+    std::size_t padding = 0;
+
+    auto length = NormalizeCharacters(input, target, output, padding);
+    if (!length || (output.size() - *length < padding)) return {};
+
+    std::fill_n(output.data() + *length, padding, '=');
+
+    return *length + padding;
+}
+
+/*
+ *  Normalize
+ *
+ *  Description:
+ *      This function will convert encoded text into the canonical form of
+ *      the target encoding in place.
+ *
+ *  Parameters:
+ *      text [in/out]
+ *          Encoded text to normalize.
+ *
+ *      target [in]
+ *          The form to produce.
+ *
+ *  Returns:
+ *      True if the text was normalized, or false if it is not valid.
+ *
+ *  Comments:
+ *      None.
+ */
+bool Normalize(std::string &text, FanOutEncoding target)
+{
+    std::size_t padding = 0;
+
+    auto length = NormalizeCharacters(text, target, text, padding);
+    if (!length) return false;
+
+    text.resize(*length);
+    text.append(padding, '=');
+
+    return true;
+}
+
+} // namespace Terra::Bases
@@ -0,0 +1,200 @@
+/*
+ *  parallel.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the functions used by the quantum-based codecs to
+ *      encode and decode large inputs in parallel through an Executor.
+ *
+ *      The input is divided into chunks holding a whole number of quanta,
+ *      so each chunk's output location is known in advance and chunks are
+ *      processed independently.  For decoding, this holds only if every
+ *      character before the final chunk is part of the alphabet; if any
+ *      chunk other than the last decodes to fewer octets than expected, or
+ *      any chunk fails, the input is decoded again serially so that the
+ *      result is always identical to that of the serial decoder.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <terra/bases/executor.h>
+
+namespace Terra::Bases::Parallel
+{
+
+// Approximate number of input octets or characters in each chunk
+constexpr std::size_t Chunk_Size = 65536;
+
+// Inputs smaller than this many chunks are processed serially
+constexpr std::size_t Minimum_Chunks = 2;
+
+/*
+ *  Encode
+ *
+ *  Description:
+ *      Encode the input in parallel chunks using the given executor.
+ *
+ *  Parameters:
+ *      executor [in]
+ *          The executor to run chunks on.
+ *
+ *      input [in]
+ *          Span of octets to be encoded.
+ *
+ *      output [out]
+ *          Buffer into which the encoded characters are written, which the
+ *          caller has verified is large enough.
+ *
+ *      quantum_octets [in]
+ *          Number of octets in each quantum.
+ *
+ *      quantum_characters [in]
+ *          Number of characters each quantum encodes to.
+ *
+ *      encode [in]
+ *          Function encoding a span of octets into a character pointer and
+ *          returning the number of characters written.
+ *
+ *  Returns:
+ *      The number of characters written to the output buffer.
+ *
+ *  Comments:
+ *      Small inputs are encoded on the calling thread.
+ */
+template<typename Function>
+std::size_t Encode(Executor &executor,
+                   const std::span<const std::uint8_t> input,
+                   std::span<char> output,
+                   std::size_t quantum_octets,
+                   std::size_t quantum_characters,
+                   Function encode)
+{
+    const std::size_t chunk_octets = (Chunk_Size / quantum_octets) *
+                                     quantum_octets;
+    const std::size_t chunk_characters = (chunk_octets / quantum_octets) *
+                                         quantum_characters;
+    const std::size_t chunks = (input.size() + chunk_octets - 1) /
+                               chunk_octets;
+    std::size_t last_length = 0;
+
+    // Encode small inputs serially
+    if (chunks < Minimum_Chunks) return encode(input, output.data());
+
+    // Encode each chunk into its place in the output
+    executor.Execute(chunks, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            std::size_t offset = i * chunk_octets;
+            std::size_t length =
+                encode(input.subspan(offset,
+                                     std::min(chunk_octets,
+                                              input.size() - offset)),
+                       output.data() + i * chunk_characters);
+            if (i == chunks - 1) last_length = length;
+        }
+    });
+
+    return (chunks - 1) * chunk_characters + last_length;
+}
+
+/*
+ *  Decode
+ *
+ *  Description:
+ *      Decode the input in parallel chunks using the given executor.
+ *
+ *  Parameters:
+ *      executor [in]
+ *          The executor to run chunks on.
+ *
+ *      input [in]
+ *          Encoded string that is to be decoded.
+ *
+ *      output [out]
+ *          Buffer into which the decoded octets are written.
+ *
+ *      quantum_octets [in]
+ *          Number of octets in each quantum.
+ *
+ *      quantum_characters [in]
+ *          Number of characters in each quantum.
+ *
+ *      decode [in]
+ *          Function decoding a string into a span of octets and returning
+ *          the number of octets written or std::nullopt on error.
+ *
+ *  Returns:
+ *      The number of octets written to the output buffer, or std::nullopt
+ *      on error, exactly as returned by decoding the input serially.
+ *
+ *  Comments:
+ *      Small inputs and inputs containing characters outside the alphabet
+ *      are decoded on the calling thread.
+ */
+template<typename Function>
+std::optional<std::size_t> Decode(Executor &executor,
+                                  const std::string_view input,
+                                  std::span<std::uint8_t> output,
+                                  std::size_t quantum_octets,
+                                  std::size_t quantum_characters,
+                                  Function decode)
+{
+    const std::size_t chunk_characters =
+        (Chunk_Size / quantum_characters) * quantum_characters;
+    const std::size_t chunk_octets =
+        (chunk_characters / quantum_characters) * quantum_octets;
+    const std::size_t chunks = (input.size() + chunk_characters - 1) /
+                               chunk_characters;
+    std::atomic<bool> irregular{false};
+    std::optional<std::size_t> last_length;
+
+    // Decode small inputs serially
+    if (chunks < Minimum_Chunks) return decode(input, output);
+
+    // Decode serially if the output cannot hold every chunk in place
+    const std::size_t full_length = (chunks - 1) * chunk_octets;
+    if (output.size() < full_length) return decode(input, output);
+
+    // Decode each chunk into its place in the output
+    executor.Execute(chunks, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            if (irregular.load(std::memory_order_relaxed)) return;
+
+            auto length = decode(input.substr(i * chunk_characters,
+                                              chunk_characters),
+                                 output.subspan(i * chunk_octets));
+            if (i == chunks - 1)
+            {
+                last_length = length;
+            }
+            else if (length != chunk_octets)
+            {
+                irregular.store(true, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    // Decode serially if the chunks did not decode independently
+    if (irregular || !last_length) return decode(input, output);
+
+    return full_length + *last_length;
+}
+
+} // namespace Terra::Bases::Parallel
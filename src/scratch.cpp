@@ -0,0 +1,484 @@
+/*
+ *  scratch.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the thread-local scratch buffer pool.
+ *
+ *      Every buffer is preceded by a header identifying its size class and
+ *      the cache of the thread that acquired it.  Each cache holds a bounded
+ *      free list per size class, which only the owning thread touches, and
+ *      a lock-free list onto which other threads push the buffers they
+ *      release.  The owning thread moves those buffers onto its free lists
+ *      on its next acquisition.
+ *
+ *      A cache is reference counted, with one reference held by its thread
+ *      and one by each outstanding buffer, so that a cache outlives its
+ *      thread until every buffer acquired from it has been released.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <terra/bases/scratch.h>
+
+namespace Terra::Bases
+{
+
+namespace
+{
+
+// Size classes are powers of two from 64 octets to 64 KiB
+constexpr std::size_t Smallest_Class_Shift = 6;
+constexpr std::size_t Size_Classes = 11;
+constexpr std::size_t Unpooled = Size_Classes;
+
+// Maximum number of buffers each thread caches per size class
+constexpr std::size_t Max_Cached_Buffers = 8;
+
+struct Cache;
+
+// Header preceding each buffer, sized to preserve the buffer's alignment
+struct alignas(std::max_align_t) BufferHeader
+{
+    BufferHeader *next;                         // Next buffer in a list
+    Cache *owner;                               // Cache acquired from
+    std::size_t size_class;                     // Size class or Unpooled
+};
+
+// Per-thread cache of released buffers
+struct Cache
+{
+    std::atomic<std::size_t> references{1};     // Thread + outstanding
+    std::atomic<BufferHeader *> remote{nullptr};// Released by other threads
+    BufferHeader *free[Size_Classes]{};         // Free lists (owner only)
+    std::size_t count[Size_Classes]{};          // Length of each free list
+};
+
+/*
+ *  SizeClass
+ *
+ *  Description:
+ *      Determine the size class for a buffer of the given size.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The number of octets required.
+ *
+ *  Returns:
+ *      The size class, or Unpooled if the size exceeds the largest class.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t SizeClass(std::size_t size)
+{
+    std::size_t size_class = 0;
+
+    while ((std::size_t(1) << (size_class + Smallest_Class_Shift)) < size)
+    {
+        if (++size_class == Size_Classes) return Unpooled;
+    }
+
+    return size_class;
+}
+
+/*
+ *  AllocateBuffer
+ *
+ *  Description:
+ *      Allocate a buffer and its header from the global allocator.
+ *
+ *  Parameters:
+ *      size_class [in]
+ *          The size class of the buffer or Unpooled.
+ *
+ *      size [in]
+ *          The number of octets required, used only if Unpooled.
+ *
+ *  Returns:
+ *      A pointer to the buffer header.
+ *
+ *  Comments:
+ *      This will throw std::bad_alloc if memory cannot be allocated.
+ */
+BufferHeader *AllocateBuffer(std::size_t size_class, std::size_t size)
+{
+    if (size_class != Unpooled)
+    {
+        size = std::size_t(1) << (size_class + Smallest_Class_Shift);
+    }
+
+    void *memory = ::operator new(sizeof(BufferHeader) + size);
+
+    return new (memory) BufferHeader{nullptr, nullptr, size_class};
+}
+
+/*
+ *  FreeBuffer
+ *
+ *  Description:
+ *      Return a buffer and its header to the global allocator.
+ *
+ *  Parameters:
+ *      header [in]
+ *          The buffer header.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void FreeBuffer(BufferHeader *header) noexcept
+{
+    ::operator delete(static_cast<void *>(header));
+}
+
+/*
+ *  CacheBuffer
+ *
+ *  Description:
+ *      Place a buffer on a cache's free list, or free it if the free list
+ *      for its size class is full.
+ *
+ *  Parameters:
+ *      cache [in]
+ *          The calling thread's cache.
+ *
+ *      header [in]
+ *          The buffer header.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Only the owning thread may call this function.
+ */
+void CacheBuffer(Cache *cache, BufferHeader *header) noexcept
+{
+    std::size_t size_class = header->size_class;
+
+    if (cache->count[size_class] == Max_Cached_Buffers)
+    {
+        FreeBuffer(header);
+        return;
+    }
+
+    header->next = cache->free[size_class];
+    cache->free[size_class] = header;
+    cache->count[size_class]++;
+}
+
+/*
+ *  DrainRemote
+ *
+ *  Description:
+ *      Move the buffers released by other threads onto the free lists, or
+ *      free them if the cache's thread has exited.
+ *
+ *  Parameters:
+ *      cache [in]
+ *          The cache to drain.
+ *
+ *      retain [in]
+ *          True to keep the buffers on the free lists.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Only the owning thread, or the last holder of a reference, may call
+ *      this function.
+ */
+void DrainRemote(Cache *cache, bool retain) noexcept
+{
+    BufferHeader *header =
+        cache->remote.exchange(nullptr, std::memory_order_acquire);
+
+    while (header != nullptr)
+    {
+        BufferHeader *next = header->next;
+        if (retain)
+        {
+            CacheBuffer(cache, header);
+        }
+        else
+        {
+            FreeBuffer(header);
+        }
+        header = next;
+    }
+}
+
+/*
+ *  FreeCached
+ *
+ *  Description:
+ *      Free all buffers on a cache's free lists and its list of remote
+ *      releases.
+ *
+ *  Parameters:
+ *      cache [in]
+ *          The cache whose buffers are freed.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Only the owning thread, or the last holder of a reference, may call
+ *      this function.
+ */
+void FreeCached(Cache *cache) noexcept
+{
+    DrainRemote(cache, false);
+
+    for (std::size_t i = 0; i < Size_Classes; i++)
+    {
+        while (cache->free[i] != nullptr)
+        {
+            BufferHeader *next = cache->free[i]->next;
+            FreeBuffer(cache->free[i]);
+            cache->free[i] = next;
+        }
+        cache->count[i] = 0;
+    }
+}
+
+/*
+ *  DestroyCache
+ *
+ *  Description:
+ *      Free all buffers held by a cache and the cache itself.
+ *
+ *  Parameters:
+ *      cache [in]
+ *          The cache to destroy.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This is called when the last reference to the cache is released.
+ */
+void DestroyCache(Cache *cache) noexcept
+{
+    FreeCached(cache);
+
+    delete cache;
+}
+
+/*
+ *  ReleaseReference
+ *
+ *  Description:
+ *      Release a reference to a cache, destroying it if it was the last.
+ *
+ *  Parameters:
+ *      cache [in]
+ *          The cache whose reference is released.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void ReleaseReference(Cache *cache) noexcept
+{
+    if (cache->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        DestroyCache(cache);
+    }
+}
+
+// Owner of the calling thread's cache, which is released at thread exit
+class CacheOwner
+{
+    public:
+        CacheOwner() : cache{new Cache} {}
+        ~CacheOwner();
+
+        Cache *const cache;
+};
+
+// The calling thread's cache, if one has been created and not retired
+thread_local Cache *local_cache = nullptr;
+
+// Set once the calling thread's CacheOwner has been destroyed
+thread_local bool cache_retired = false;
+
+// The calling thread's cache owner, constructed on first use
+thread_local CacheOwner cache_owner;
+
+/*
+ *  CacheOwner::~CacheOwner
+ *
+ *  Description:
+ *      Destructor for the CacheOwner object, which frees the cached buffers
+ *      and releases the thread's reference to its cache.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Buffers that are still outstanding keep the cache alive; they are
+ *      freed when released.
+ */
+CacheOwner::~CacheOwner()
+{
+    local_cache = nullptr;
+    cache_retired = true;
+
+    // Free all cached buffers
+    FreeCached(cache);
+
+    ReleaseReference(cache);
+}
+
+/*
+ *  LocalCache
+ *
+ *  Description:
+ *      Return the calling thread's cache.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The calling thread's cache, or nullptr if the thread is exiting and
+ *      its cache has been retired.
+ *
+ *  Comments:
+ *      None.
+ */
+Cache *LocalCache()
+{
+    if ((local_cache == nullptr) && !cache_retired)
+    {
+        local_cache = cache_owner.cache;
+    }
+
+    return local_cache;
+}
+
+} // namespace
+
+/*
+ *  AcquireScratch
+ *
+ *  Description:
+ *      Acquire a buffer of at least the given size from the calling thread's
+ *      scratch buffer cache, allocating one if the cache has none.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The number of octets required.
+ *
+ *  Returns:
+ *      A pointer to the buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+void *AcquireScratch(std::size_t size)
+{
+    std::size_t size_class = SizeClass(size);
+    Cache *cache = (size_class == Unpooled) ? nullptr : LocalCache();
+    BufferHeader *header;
+
+    // Large buffers and those needed during thread exit are not cached
+    if (cache == nullptr)
+    {
+        header = AllocateBuffer(Unpooled, size);
+        return header + 1;
+    }
+
+    // Reclaim any buffers released by other threads
+    if (cache->remote.load(std::memory_order_relaxed) != nullptr)
+    {
+        DrainRemote(cache, true);
+    }
+
+    // Take a cached buffer if there is one, else allocate one
+    if (cache->free[size_class] != nullptr)
+    {
+        header = cache->free[size_class];
+        cache->free[size_class] = header->next;
+        cache->count[size_class]--;
+    }
+    else
+    {
+        header = AllocateBuffer(size_class, size);
+    }
+
+    // The outstanding buffer holds a reference to the cache
+    header->owner = cache;
+    cache->references.fetch_add(1, std::memory_order_relaxed);
+
+    return header + 1;
+}
+
+/*
+ *  ReleaseScratch
+ *
+ *  Description:
+ *      Release a buffer acquired with AcquireScratch().
+ *
+ *  Parameters:
+ *      buffer [in]
+ *          The buffer to release, which may be nullptr.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void ReleaseScratch(void *buffer) noexcept
+{
+    if (buffer == nullptr) return;
+
+    BufferHeader *header = static_cast<BufferHeader *>(buffer) - 1;
+    Cache *owner = header->owner;
+
+    // Buffers not acquired from a cache are simply freed
+    if (owner == nullptr)
+    {
+        FreeBuffer(header);
+        return;
+    }
+
+    // Buffers released by the owning thread go directly onto its free list
+    if (owner == local_cache)
+    {
+        CacheBuffer(owner, header);
+        owner->references.fetch_sub(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Otherwise, push the buffer onto the owner's list of remote releases
+    header->next = owner->remote.load(std::memory_order_relaxed);
+    while (!owner->remote.compare_exchange_weak(header->next,
+                                                header,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed))
+    {
+    }
+
+    ReleaseReference(owner);
+}
+
+} // namespace Terra::Bases
@@ -0,0 +1,173 @@
+/*
+ *  simd.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines helpers for the portable SIMD kernels, which are
+ *      written with std::experimental::simd (Parallelism TS 2) so that every
+ *      architecture the compiler supports is vectorized from one source.
+ *
+ *      Characters are processed several to a lane: a lane of a wider type
+ *      is loaded from memory and the individual characters are extracted
+ *      with Byte() and placed with Place(), which account for the byte order
+ *      of the processor.
+ *
+ *  Portability Issues:
+ *      Requires <experimental/simd>, which is only used if BASES_SIMD is
+ *      defined.
+ */
+
+#pragma once
+
+#ifdef BASES_SIMD
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <experimental/simd>
+
+namespace Terra::Bases::Simd
+{
+
+namespace stdx = std::experimental;
+
+// Number of lanes of the given type in a native vector register
+template<typename T>
+constexpr std::size_t Lanes = stdx::native_simd<T>::size();
+
+// A vector of N lanes of the given type, using the native representation
+// when N is the native number of lanes
+template<typename T, std::size_t N = Lanes<T>>
+using Vector = std::conditional_t<N == Lanes<T>,
+                                  stdx::native_simd<T>,
+                                  stdx::fixed_size_simd<T, N>>;
+
+/*
+ *  Load
+ *
+ *  Description:
+ *      Load a vector from memory that may not be suitably aligned.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to sizeof(T) * N octets.
+ *
+ *  Returns:
+ *      The vector.
+ *
+ *  Comments:
+ *      The copy is optimized to a single unaligned load.
+ */
+template<typename T, std::size_t N = Lanes<T>>
+Vector<T, N> Load(const void *p)
+{
+    T lanes[N];
+
+    std::memcpy(lanes, p, sizeof(lanes));
+
+    return Vector<T, N>(lanes, stdx::element_aligned);
+}
+
+/*
+ *  Store
+ *
+ *  Description:
+ *      Store a vector to memory that may not be suitably aligned.
+ *
+ *  Parameters:
+ *      p [out]
+ *          Pointer to sizeof(T) * N octets.
+ *
+ *      vector [in]
+ *          The vector to store.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The copy is optimized to a single unaligned store.
+ */
+template<typename V>
+void Store(void *p, const V &vector)
+{
+    typename V::value_type lanes[V::size()];
+
+    vector.copy_to(lanes, stdx::element_aligned);
+    std::memcpy(p, lanes, sizeof(lanes));
+}
+
+/*
+ *  Byte
+ *
+ *  Description:
+ *      Extract the octet at the given memory position from each lane.
+ *
+ *  Parameters:
+ *      vector [in]
+ *          Vector loaded with Load().
+ *
+ *      position [in]
+ *          Position of the octet within the lane as stored in memory.
+ *
+ *  Returns:
+ *      A vector holding the octet in the low bits of each lane.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename V>
+V Byte(const V &vector, unsigned position)
+{
+    using T = typename V::value_type;
+
+    unsigned shift = (std::endian::native == std::endian::little)
+                         ? position * 8
+                         : (sizeof(T) - 1 - position) * 8;
+
+    return (vector >> shift) & T(0xff);
+}
+
+/*
+ *  Place
+ *
+ *  Description:
+ *      Move the octet in the low bits of each lane to the given memory
+ *      position.
+ *
+ *  Parameters:
+ *      vector [in]
+ *          Vector holding an octet in the low bits of each lane.
+ *
+ *      position [in]
+ *          Position of the octet within the lane as it will be stored in
+ *          memory.
+ *
+ *  Returns:
+ *      The shifted vector, which may be combined with others using '|'.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename V>
+V Place(const V &vector, unsigned position)
+{
+    using T = typename V::value_type;
+
+    unsigned shift = (std::endian::native == std::endian::little)
+                         ? position * 8
+                         : (sizeof(T) - 1 - position) * 8;
+
+    return vector << shift;
+}
+
+} // namespace Terra::Bases::Simd
+
+#endif // BASES_SIMD
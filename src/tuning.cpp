@@ -0,0 +1,464 @@
+/*
+ *  tuning.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the functions that measure, bind, export, and
+ *      import kernel selections.
+ *
+ *      The configuration is a string of the form:
+ *
+ *          bases-tuning/1;base16.encode.small=small;base16.encode.large=...
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <terra/bases/tuning.h>
+#include "tuning.h"
+
+namespace Terra::Bases
+{
+
+namespace
+{
+
+// Configuration string prefix, including the format version
+constexpr std::string_view Configuration_Prefix = "bases-tuning/1";
+
+// Names of the size classes as they appear in the configuration
+constexpr std::string_view Size_Class_Names[] = {"small", "large"};
+
+// Unencoded input sizes used to measure each size class
+constexpr std::size_t Measurement_Sizes[] = {32, 4096};
+
+// Minimum duration of a single timed run
+constexpr std::chrono::microseconds Minimum_Run_Time{100};
+
+// Number of timed runs per kernel, of which the fastest is used
+constexpr unsigned Measurement_Runs = 5;
+
+// Serializes changes to the kernel selections
+std::mutex Tuning_Mutex;
+
+/*
+ *  AllOperations
+ *
+ *  Description:
+ *      Return all of the tunable operations.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Pointers to every operation's selector.
+ *
+ *  Comments:
+ *      None.
+ */
+std::vector<Tuning::Operation *> AllOperations()
+{
+    std::vector<Tuning::Operation *> operations;
+
+    for (auto codec_operations : {Tuning::Base16Operations(),
+                                  Tuning::Base32Operations(),
+                                  Tuning::Base64Operations()})
+    {
+        operations.insert(operations.end(),
+                          codec_operations.begin(),
+                          codec_operations.end());
+    }
+
+    return operations;
+}
+
+/*
+ *  Measure
+ *
+ *  Description:
+ *      Measure the time taken by one invocation of the given kernel.
+ *
+ *  Parameters:
+ *      operation [in]
+ *          The operation to measure.
+ *
+ *      candidate [in]
+ *          The kernel to measure.
+ *
+ *      size [in]
+ *          Unencoded input size.
+ *
+ *  Returns:
+ *      The fastest observed time per invocation in nanoseconds.
+ *
+ *  Comments:
+ *      The number of iterations is first increased until a run takes at
+ *      least Minimum_Run_Time so that timer resolution is insignificant.
+ */
+double Measure(const Tuning::Operation &operation,
+               std::size_t candidate,
+               std::size_t size)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Time the given number of iterations
+    auto time_run = [&](std::size_t iterations)
+    {
+        auto start = Clock::now();
+        operation.Run(candidate, size, iterations);
+        return std::chrono::duration<double, std::nano>(Clock::now() - start);
+    };
+
+    // Calibrate the number of iterations
+    std::size_t iterations = 1;
+    auto elapsed = time_run(iterations);
+    while (elapsed < Minimum_Run_Time)
+    {
+        iterations *= 2;
+        elapsed = time_run(iterations);
+    }
+
+    // Retain the fastest of several runs
+    double fastest = elapsed.count() / static_cast<double>(iterations);
+    for (unsigned i = 1; i < Measurement_Runs; i++)
+    {
+        fastest = std::min(fastest,
+                           time_run(iterations).count() /
+                               static_cast<double>(iterations));
+    }
+
+    return fastest;
+}
+
+/*
+ *  ExportLocked
+ *
+ *  Description:
+ *      Produce the configuration string for the current selections.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The configuration string.
+ *
+ *  Comments:
+ *      The caller must hold Tuning_Mutex.
+ */
+std::string ExportLocked()
+{
+    std::string configuration(Configuration_Prefix);
+
+    for (const auto *operation : AllOperations())
+    {
+        for (auto size_class : {Tuning::Small, Tuning::Large})
+        {
+            configuration += ';';
+            configuration += operation->Name();
+            configuration += '.';
+            configuration += Size_Class_Names[size_class];
+            configuration += '=';
+            configuration +=
+                operation->CandidateName(operation->Bound(size_class));
+        }
+    }
+
+    return configuration;
+}
+
+/*
+ *  ImportLocked
+ *
+ *  Description:
+ *      Apply the given configuration string.
+ *
+ *  Parameters:
+ *      configuration [in]
+ *          The configuration string.
+ *
+ *  Returns:
+ *      True if applied, false if the configuration is invalid.
+ *
+ *  Comments:
+ *      The caller must hold Tuning_Mutex.
+ */
+bool ImportLocked(std::string_view configuration)
+{
+    struct Selection
+    {
+        Tuning::Operation *operation;
+        Tuning::SizeClass size_class;
+        std::size_t candidate;
+    };
+    std::vector<Selection> selections;
+    auto operations = AllOperations();
+
+    // Verify the configuration format
+    if (!configuration.starts_with(Configuration_Prefix)) return false;
+    configuration.remove_prefix(Configuration_Prefix.size());
+
+    // Parse each "operation.class=kernel" entry
+    while (!configuration.empty())
+    {
+        if (configuration.front() != ';') return false;
+        configuration.remove_prefix(1);
+
+        auto end = std::min(configuration.find(';'), configuration.size());
+        auto entry = configuration.substr(0, end);
+        configuration.remove_prefix(end);
+
+        auto equals = entry.find('=');
+        if (equals == std::string_view::npos) return false;
+        auto key = entry.substr(0, equals);
+        auto kernel = entry.substr(equals + 1);
+
+        auto dot = key.rfind('.');
+        if (dot == std::string_view::npos) return false;
+        auto name = key.substr(0, dot);
+        auto size_class_name = key.substr(dot + 1);
+
+        // Locate the operation
+        auto operation = std::find_if(
+            operations.begin(),
+            operations.end(),
+            [&](const Tuning::Operation *o) { return name == o->Name(); });
+        if (operation == operations.end()) return false;
+
+        // Locate the size class
+        Tuning::SizeClass size_class;
+        if (size_class_name == Size_Class_Names[Tuning::Small])
+        {
+            size_class = Tuning::Small;
+        }
+        else if (size_class_name == Size_Class_Names[Tuning::Large])
+        {
+            size_class = Tuning::Large;
+        }
+        else
+        {
+            return false;
+        }
+
+        // Locate the kernel, which must be able to run here
+        std::size_t candidate = 0;
+        while ((candidate < (*operation)->Candidates()) &&
+               (kernel != (*operation)->CandidateName(candidate)))
+        {
+            candidate++;
+        }
+        if (candidate == (*operation)->Candidates()) return false;
+        if (!(*operation)->Eligible(candidate)) return false;
+
+        selections.push_back({*operation, size_class, candidate});
+    }
+
+    // The entire configuration is valid, so apply it
+    for (const auto &selection : selections)
+    {
+        selection.operation->Bind(selection.size_class, selection.candidate);
+    }
+
+    return true;
+}
+
+} // namespace
+
+#ifdef BASES_AUTOTUNE
+namespace Tuning
+{
+
+std::atomic<bool> Tuned{false};
+
+/*
+ *  TuneOnce
+ *
+ *  Description:
+ *      Import the configuration in the BASES_TUNING environment variable
+ *      or, if there is none or it is invalid, perform tuning.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This is performed only once, on first use of the library.
+ */
+void TuneOnce()
+{
+    static std::once_flag once;
+
+    std::call_once(once, []()
+    {
+        const char *configuration = std::getenv("BASES_TUNING");
+
+        if ((configuration == nullptr) || !ImportTuning(configuration))
+        {
+            Tune();
+        }
+
+        Tuned.store(true, std::memory_order_release);
+    });
+}
+
+} // namespace Tuning
+#endif
+
+/*
+ *  Tune
+ *
+ *  Description:
+ *      Measure each eligible kernel for each codec operation and size class
+ *      and use the fastest.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The resulting configuration, as would be returned by ExportTuning().
+ *
+ *  Comments:
+ *      This takes a few milliseconds per kernel.  It is safe to call while
+ *      other threads are using the library.
+ */
+std::string Tune()
+{
+    std::lock_guard<std::mutex> lock(Tuning_Mutex);
+
+    for (auto *operation : AllOperations())
+    {
+        for (auto size_class : {Tuning::Small, Tuning::Large})
+        {
+            std::size_t fastest = operation->DefaultCandidate(size_class);
+            double fastest_time = 0.0;
+
+            // Measure each candidate, retaining the fastest
+            for (std::size_t i = 0; i < operation->Candidates(); i++)
+            {
+                if (!operation->Eligible(i)) continue;
+
+                double time =
+                    Measure(*operation, i, Measurement_Sizes[size_class]);
+
+                if ((fastest_time == 0.0) || (time < fastest_time))
+                {
+                    fastest = i;
+                    fastest_time = time;
+                }
+            }
+
+            operation->Bind(size_class, fastest);
+        }
+    }
+
+#ifdef BASES_AUTOTUNE
+    // Automatic tuning is no longer required
+    Tuning::Tuned.store(true, std::memory_order_release);
+#endif
+
+    return ExportLocked();
+}
+
+/*
+ *  ExportTuning
+ *
+ *  Description:
+ *      Return the kernel selections currently in use.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A short configuration string that may be passed to ImportTuning().
+ *
+ *  Comments:
+ *      None.
+ */
+std::string ExportTuning()
+{
+#ifdef BASES_AUTOTUNE
+    // Ensure automatic tuning does not later replace these selections
+    if (!Tuning::Tuned.load(std::memory_order_acquire)) Tuning::TuneOnce();
+#endif
+
+    std::lock_guard<std::mutex> lock(Tuning_Mutex);
+
+    return ExportLocked();
+}
+
+/*
+ *  ImportTuning
+ *
+ *  Description:
+ *      Use the kernel selections in the given configuration.
+ *
+ *  Parameters:
+ *      configuration [in]
+ *          Configuration previously returned by Tune() or ExportTuning().
+ *
+ *  Returns:
+ *      True if the configuration was applied, false if it was malformed or
+ *      names a kernel that is not available in this build or on this
+ *      processor, in which case no selections are changed.
+ *
+ *  Comments:
+ *      Operations absent from the configuration retain their current
+ *      selections.
+ */
+bool ImportTuning(std::string_view configuration)
+{
+    std::lock_guard<std::mutex> lock(Tuning_Mutex);
+
+    if (!ImportLocked(configuration)) return false;
+
+#ifdef BASES_AUTOTUNE
+    // Automatic tuning is no longer required
+    Tuning::Tuned.store(true, std::memory_order_release);
+#endif
+
+    return true;
+}
+
+/*
+ *  ResetTuning
+ *
+ *  Description:
+ *      Restore the default kernel selections.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void ResetTuning()
+{
+    std::lock_guard<std::mutex> lock(Tuning_Mutex);
+
+    for (auto *operation : AllOperations())
+    {
+        for (auto size_class : {Tuning::Small, Tuning::Large})
+        {
+            operation->Bind(size_class,
+                            operation->DefaultCandidate(size_class));
+        }
+    }
+}
+
+} // namespace Terra::Bases
@@ -0,0 +1,187 @@
+/*
+ *  tuning.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the internal machinery used to select among
+ *      alternative kernels for a codec operation.  Each operation has a
+ *      KernelSelector holding its candidate kernels and the kernel bound for
+ *      each input size class.  Codecs call Select() to obtain the kernel to
+ *      invoke; the tuning functions enumerate all selectors to measure and
+ *      bind kernels.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <span>
+
+namespace Terra::Bases::Tuning
+{
+
+// Inputs of at most this many octets or characters are "small"
+constexpr std::size_t Small_Input_Limit = 64;
+
+// Input size classes, each of which is bound to a kernel independently
+enum SizeClass : std::size_t
+{
+    Small = 0,
+    Large = 1
+};
+
+#ifdef BASES_AUTOTUNE
+// Set once tuning (or importing a configuration) has been performed
+extern std::atomic<bool> Tuned;
+
+// Perform tuning if it has not yet been performed
+void TuneOnce();
+#endif
+
+/*
+ *  Operation
+ *
+ *  Description:
+ *      This is the type-independent interface to a KernelSelector, used by
+ *      the tuning functions.
+ *
+ *  Comments:
+ *      Selectors have static storage duration and are constant-initialized,
+ *      so they are never destroyed through this interface.
+ */
+class Operation
+{
+    public:
+        constexpr explicit Operation(const char *name) : name{name} {}
+
+        const char *Name() const { return name; }
+        virtual std::size_t Candidates() const = 0;
+        virtual const char *CandidateName(std::size_t candidate) const = 0;
+        virtual bool Eligible(std::size_t candidate) const = 0;
+        virtual std::size_t DefaultCandidate(SizeClass size_class) const = 0;
+        virtual std::size_t Bound(SizeClass size_class) const = 0;
+        virtual void Bind(SizeClass size_class, std::size_t candidate) = 0;
+        virtual void Run(std::size_t candidate,
+                         std::size_t size,
+                         std::size_t iterations) const = 0;
+
+    protected:
+        ~Operation() = default;
+
+        const char *name;
+};
+
+// A named kernel and an optional test of whether it may run on this machine
+template<typename Function>
+struct Kernel
+{
+    const char *name;
+    Function function;
+    bool (*eligible)();
+};
+
+/*
+ *  KernelSelector
+ *
+ *  Description:
+ *      This object holds the candidate kernels for an operation and the
+ *      kernel currently bound to each size class.
+ *
+ *  Comments:
+ *      The runner is used for tuning: it must invoke the given kernel the
+ *      given number of times on inputs of the given size (in octets of
+ *      unencoded data) and must not call any public codec function.
+ */
+template<typename Function>
+class KernelSelector final : public Operation
+{
+    public:
+        using Runner = void (*)(Function kernel,
+                                std::size_t size,
+                                std::size_t iterations);
+
+        constexpr KernelSelector(const char *name,
+                                 std::span<const Kernel<Function>> kernels,
+                                 Runner runner,
+                                 std::size_t small_default,
+                                 std::size_t large_default) :
+            Operation(name),
+            kernels{kernels},
+            runner{runner},
+            defaults{small_default, large_default},
+            bound{small_default, large_default},
+            active{kernels[small_default].function,
+                   kernels[large_default].function}
+        {
+        }
+
+        // Return the kernel to use for an input of the given size
+        Function Select(std::size_t size) const
+        {
+#ifdef BASES_AUTOTUNE
+            if (!Tuned.load(std::memory_order_acquire)) TuneOnce();
+#endif
+            return active[size > Small_Input_Limit ? Large : Small].load(
+                std::memory_order_relaxed);
+        }
+
+        std::size_t Candidates() const override { return kernels.size(); }
+
+        const char *CandidateName(std::size_t candidate) const override
+        {
+            return kernels[candidate].name;
+        }
+
+        bool Eligible(std::size_t candidate) const override
+        {
+            return (kernels[candidate].eligible == nullptr) ||
+                   kernels[candidate].eligible();
+        }
+
+        std::size_t DefaultCandidate(SizeClass size_class) const override
+        {
+            return defaults[size_class];
+        }
+
+        std::size_t Bound(SizeClass size_class) const override
+        {
+            return bound[size_class].load(std::memory_order_relaxed);
+        }
+
+        void Bind(SizeClass size_class, std::size_t candidate) override
+        {
+            active[size_class].store(kernels[candidate].function,
+                                     std::memory_order_relaxed);
+            bound[size_class].store(candidate, std::memory_order_relaxed);
+        }
+
+        void Run(std::size_t candidate,
+                 std::size_t size,
+                 std::size_t iterations) const override
+        {
+            runner(kernels[candidate].function, size, iterations);
+        }
+
+    protected:
+        std::span<const Kernel<Function>> kernels;
+        Runner runner;
+        std::size_t defaults[2];
+        std::atomic<std::size_t> bound[2];
+        std::atomic<Function> active[2];
+};
+
+// Selectors defined by each codec
+std::span<Operation * const> Base16Operations();
+std::span<Operation * const> Base32Operations();
+std::span<Operation * const> Base64Operations();
+
+} // namespace Terra::Bases::Tuning
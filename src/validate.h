@@ -0,0 +1,167 @@
+/*
+ *  validate.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the character classification functions used by the
+ *      codecs' IsValid() functions.  Each takes a function mapping a
+ *      character to its value (typically a lookup in the codec's reverse
+ *      table), where characters outside of the alphabet map to a value
+ *      having the high bit set and alphabet characters to values below 128.
+ *
+ *      Characters are classified a block at a time by combining their
+ *      values, so the only branch is taken once per block.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Terra::Bases::Validate
+{
+
+// Number of characters classified before testing the result
+constexpr std::size_t Block_Size = 16;
+
+/*
+ *  ValidPrefix
+ *
+ *  Description:
+ *      Determine the length of the longest prefix of the input consisting
+ *      only of alphabet characters.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The characters to classify.
+ *
+ *      classify [in]
+ *          Function returning the value of a character.
+ *
+ *  Returns:
+ *      The length of the prefix, which is input.size() if every character
+ *      is in the alphabet.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename Classify>
+std::size_t ValidPrefix(const std::string_view input, Classify classify)
+{
+    std::size_t i = 0;
+
+    // Classify a block at a time while every character is valid
+    for (; input.size() - i >= Block_Size; i += Block_Size)
+    {
+        std::uint8_t values = 0;
+        for (std::size_t j = 0; j < Block_Size; j++)
+        {
+            values |= classify(input[i + j]);
+        }
+        if ((values & 0x80) != 0) break;
+    }
+
+    // Locate the first invalid character, if any
+    for (; i < input.size(); i++)
+    {
+        if ((classify(input[i]) & 0x80) != 0) break;
+    }
+
+    return i;
+}
+
+/*
+ *  CountValid
+ *
+ *  Description:
+ *      Count the alphabet characters in the input.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The characters to classify.
+ *
+ *      classify [in]
+ *          Function returning the value of a character.
+ *
+ *  Returns:
+ *      The number of characters in the alphabet.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename Classify>
+std::size_t CountValid(const std::string_view input, Classify classify)
+{
+    std::size_t invalid = 0;
+
+    for (const char c : input)
+    {
+        invalid += classify(c) >> 7;
+    }
+
+    return input.size() - invalid;
+}
+
+/*
+ *  TrailingBitsZero
+ *
+ *  Description:
+ *      Determine whether the given number of least significant bits
+ *      represented by the last two alphabet characters are zero.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The characters, whose last two alphabet characters are examined.
+ *
+ *      classify [in]
+ *          Function returning the value of a character.
+ *
+ *      bits_per_character [in]
+ *          The number of bits each character represents.
+ *
+ *      bits [in]
+ *          The number of bits to examine, which must not exceed twice the
+ *          number of bits per character.
+ *
+ *  Returns:
+ *      True if the bits are zero.
+ *
+ *  Comments:
+ *      These are the bits that do not form a complete octet at the end of
+ *      an encoded string; a canonical encoder always sets them to zero.
+ */
+template<typename Classify>
+bool TrailingBitsZero(const std::string_view input,
+                      Classify classify,
+                      std::size_t bits_per_character,
+                      std::size_t bits)
+{
+    std::uint_fast32_t group = 0;
+    std::size_t found = 0;
+
+    if (bits == 0) return true;
+
+    // Gather the values of the last two alphabet characters
+    for (std::size_t i = input.size(); (i > 0) && (found < 2); i--)
+    {
+        std::uint8_t value = classify(input[i - 1]);
+        if ((value & 0x80) != 0) continue;
+        group |= static_cast<std::uint_fast32_t>(value)
+                 << (found * bits_per_character);
+        found++;
+    }
+
+    return (group & ((std::uint_fast32_t(1) << bits) - 1)) == 0;
+}
+
+} // namespace Terra::Bases::Validate
@@ -0,0 +1,607 @@
+/*
+ *  test_allocation.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements tests to verify that the functions documented
+ *      as not allocating memory never call operator new.  The global
+ *      allocation functions are replaced with versions that count calls.
+ *
+ *  Portability Issues:
+ *      Replacing the global allocation functions requires that this test
+ *      is built as its own executable.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <optional>
+#include <cstdlib>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+#include <terra/stf/stf.h>
+#include <terra/bases/base16.h>
+#include <terra/bases/base32.h>
+#include <terra/bases/base45.h>
+#include <terra/bases/base58.h>
+#include <terra/bases/base64.h>
+#include <terra/bases/bases_c.h>
+#include <terra/bases/fanout.h>
+#include <terra/bases/format.h>
+#include <terra/bases/normalize.h>
+#include <terra/bases/scratch.h>
+#include <terra/bases/tuning.h>
+
+using namespace Terra;
+
+namespace
+{
+
+// Count of calls to any form of operator new
+std::atomic<std::size_t> allocation_count{0};
+
+/*
+ *  CountedAllocate
+ *
+ *  Description:
+ *      Allocate memory using malloc(), counting the allocation.
+ *
+ *  Parameters:
+ *      size [in]
+ *          Number of octets to allocate.
+ *
+ *  Returns:
+ *      A pointer to the allocated memory or nullptr on failure.
+ *
+ *  Comments:
+ *      None.
+ */
+void *CountedAllocate(std::size_t size) noexcept
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+/*
+ *  CountedAlignedAllocate
+ *
+ *  Description:
+ *      Allocate aligned memory, counting the allocation.
+ *
+ *  Parameters:
+ *      size [in]
+ *          Number of octets to allocate.
+ *
+ *      alignment [in]
+ *          Required alignment of the memory.
+ *
+ *  Returns:
+ *      A pointer to the allocated memory or nullptr on failure.
+ *
+ *  Comments:
+ *      None.
+ */
+void *CountedAlignedAllocate(std::size_t size, std::align_val_t alignment)
+    noexcept
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    auto align = static_cast<std::size_t>(alignment);
+
+#ifdef _WIN32
+    return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+    // The size passed to aligned_alloc must be a multiple of the alignment
+    return std::aligned_alloc(align, ((size + align - 1) / align) * align);
+#endif
+}
+
+/*
+ *  CountedAlignedFree
+ *
+ *  Description:
+ *      Free memory allocated by CountedAlignedAllocate().
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to the memory to free.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void CountedAlignedFree(void *p) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+/*
+ *  AllocationsDuring
+ *
+ *  Description:
+ *      Return the number of allocations performed while calling the given
+ *      function.
+ *
+ *  Parameters:
+ *      function [in]
+ *          The function to call.
+ *
+ *  Returns:
+ *      The number of calls to operator new.
+ *
+ *  Comments:
+ *      Kernel selection is completed first, since automatic tuning (when
+ *      enabled) allocates memory on first use of the library.
+ */
+template<typename Function>
+std::size_t AllocationsDuring(Function function)
+{
+    Terra::Bases::ExportTuning();
+
+    std::size_t before = allocation_count.load();
+
+    function();
+
+    return allocation_count.load() - before;
+}
+
+/*
+ *  RandomOctets
+ *
+ *  Description:
+ *      Produce a deterministic vector of pseudo-random octets.
+ *
+ *  Parameters:
+ *      length [in]
+ *          Number of octets to produce.
+ *
+ *  Returns:
+ *      The vector of octets.
+ *
+ *  Comments:
+ *      A few leading zero octets are included on every other length to
+ *      exercise the Base58 leading zero logic.
+ */
+std::vector<std::uint8_t> RandomOctets(std::size_t length)
+{
+    std::default_random_engine generator(static_cast<unsigned>(length));
+    std::uniform_int_distribution<unsigned> random_octet(0, 255);
+    std::vector<std::uint8_t> octets(length);
+
+    for (auto &octet : octets) octet = random_octet(generator);
+    for (std::size_t i = 0; (i < 3) && (i < length) && (length & 1); i++)
+    {
+        octets[i] = 0;
+    }
+
+    return octets;
+}
+
+// Input sizes to test
+constexpr std::size_t Maximum_Input_Length = 300;
+
+} // namespace
+
+// Replace the global allocation functions
+void *operator new(std::size_t size)
+{
+    void *p = CountedAllocate(size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void *operator new[](std::size_t size)
+{
+    void *p = CountedAllocate(size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    void *p = CountedAlignedAllocate(size, alignment);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    void *p = CountedAlignedAllocate(size, alignment);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept
+{
+    CountedAlignedFree(p);
+}
+void operator delete[](void *p, std::align_val_t) noexcept
+{
+    CountedAlignedFree(p);
+}
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept
+{
+    CountedAlignedFree(p);
+}
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept
+{
+    CountedAlignedFree(p);
+}
+
+// The following is defined as a macro so that errors will reveal the line
+// number correctly for any failed test; each codec's span functions are
+// exercised for every input length, verifying the round trip as well
+#define VERIFY_NO_ALLOCATIONS(Codec) \
+    for (std::size_t n = 0; n <= Maximum_Input_Length; n++) \
+    { \
+        auto original = RandomOctets(n); \
+        std::vector<char> encoded(Codec::MaxEncodedLength(n)); \
+        std::size_t encoded_length = 0; \
+        STF_ASSERT_EQ(std::size_t(0), AllocationsDuring([&]() { \
+            encoded_length = Codec::Encode(original, encoded); \
+        })); \
+        std::string_view text(encoded.data(), encoded_length); \
+        std::vector<std::uint8_t> decoded( \
+            Codec::MaxDecodedLength(encoded_length)); \
+        std::optional<std::size_t> decoded_length; \
+        STF_ASSERT_EQ(std::size_t(0), AllocationsDuring([&]() { \
+            decoded_length = Codec::Decode(text, decoded); \
+        })); \
+        STF_ASSERT_TRUE(decoded_length.has_value()); \
+        STF_ASSERT_EQ(n, *decoded_length); \
+        decoded.resize(n); \
+        STF_ASSERT_EQ(original, decoded); \
+    }
+
+STF_TEST(Allocation, Base16)
+{
+    VERIFY_NO_ALLOCATIONS(Base16);
+}
+
+STF_TEST(Allocation, Base32)
+{
+    VERIFY_NO_ALLOCATIONS(Base32);
+}
+
+STF_TEST(Allocation, Base45)
+{
+    VERIFY_NO_ALLOCATIONS(Base45);
+}
+
+STF_TEST(Allocation, Base58)
+{
+    VERIFY_NO_ALLOCATIONS(Base58);
+}
+
+STF_TEST(Allocation, Base64)
+{
+    VERIFY_NO_ALLOCATIONS(Base64);
+}
+
+// Each codec's IsValid() is exercised in both modes for every input length,
+// verifying that it reports the decoded length (Base58 is excluded, as it
+// may need to decode into a scratch buffer to determine the length)
+#define VERIFY_VALIDATION_WITHOUT_ALLOCATIONS(Codec) \
+    for (std::size_t n = 0; n <= Maximum_Input_Length; n++) \
+    { \
+        std::string text = Codec::Encode(RandomOctets(n)); \
+        std::optional<std::size_t> strict; \
+        std::optional<std::size_t> lenient; \
+        STF_ASSERT_EQ(std::size_t(0), AllocationsDuring([&]() { \
+            strict = Codec::IsValid(text, Codec::Mode::Strict); \
+            lenient = Codec::IsValid(text, Codec::Mode::Lenient); \
+        })); \
+        STF_ASSERT_TRUE(strict.has_value()); \
+        STF_ASSERT_EQ(n, *strict); \
+        STF_ASSERT_TRUE(lenient.has_value()); \
+        STF_ASSERT_EQ(n, *lenient); \
+    }
+
+STF_TEST(Allocation, IsValid)
+{
+    VERIFY_VALIDATION_WITHOUT_ALLOCATIONS(Base16);
+    VERIFY_VALIDATION_WITHOUT_ALLOCATIONS(Base32);
+    VERIFY_VALIDATION_WITHOUT_ALLOCATIONS(Base45);
+    VERIFY_VALIDATION_WITHOUT_ALLOCATIONS(Base64);
+}
+
+STF_TEST(Allocation, Base64Alphabet)
+{
+    // Construct the alphabet before counting (constructing is permitted to
+    // allocate, though it presently does not)
+    const Base64::Alphabet &alphabet = Base64::URLAlphabet();
+
+    for (std::size_t n = 0; n <= Maximum_Input_Length; n++)
+    {
+        auto original = RandomOctets(n);
+        std::vector<char> encoded(Base64::MaxEncodedLength(n));
+        std::vector<std::uint8_t> decoded(Base64::MaxDecodedLength(
+                                                    encoded.size()));
+        std::size_t encoded_length = 0;
+        std::optional<std::size_t> decoded_length;
+
+        STF_ASSERT_EQ(std::size_t(0), AllocationsDuring([&]() {
+            encoded_length = Base64::Encode(original, encoded, alphabet);
+            decoded_length = Base64::Decode(
+                std::string_view(encoded.data(), encoded_length),
+                decoded,
+                alphabet);
+        }));
+
+        STF_ASSERT_TRUE(decoded_length.has_value());
+        STF_ASSERT_EQ(n, *decoded_length);
+    }
+}
+
+STF_TEST(Allocation, Base64Forgiving)
+{
+    for (std::size_t n = 0; n <= Maximum_Input_Length; n++)
+    {
+        auto original = RandomOctets(n);
+
+        // Whitespace and no padding, as atob() would accept
+        std::string text = Base64::Encode(original);
+        while (text.ends_with('=')) text.pop_back();
+        text.insert(text.size() / 2, " \n\t");
+
+        std::vector<std::uint8_t> decoded(Base64::MaxDecodedLength(
+                                                    text.size()));
+        std::optional<std::size_t> decoded_length;
+
+        STF_ASSERT_EQ(std::size_t(0), AllocationsDuring([&]() {
+            decoded_length = Base64::Decode(text,
+                                            decoded,
+                                            Base64::Mode::Forgiving);
+        }));
+
+        STF_ASSERT_TRUE(decoded_length.has_value());
+        decoded.resize(*decoded_length);
+        STF_ASSERT_EQ(original, decoded);
+    }
+}
+
+STF_TEST(Allocation, Base64Tolerant)
+{
+    const Base64::Alphabet &tolerant = Base64::TolerantAlphabet();
+
+    for (std::size_t n = 0; n <= Maximum_Input_Length; n++)
+    {
+        auto original = RandomOctets(n);
+
+        // Either alphabet is accepted, in every mode
+        for (const std::string &text :
+             {Base64::Encode(original),
+              Base64::Encode(original, Base64::URLAlphabet())})
+        {
+            std::vector<std::uint8_t> decoded(Base64::MaxDecodedLength(
+                                                        text.size()));
+            std::optional<std::size_t> lenient;
+            std::optional<std::size_t> forgiving;
+
+            STF_ASSERT_EQ(std::size_t(0), AllocationsDuring([&]() {
+                lenient = Base64::Decode(text, decoded, tolerant);
+                forgiving = Base64::Decode(text,
+                                           decoded,
+                                           Base64::Mode::Forgiving,
+                                           tolerant);
+            }));
+
+            STF_ASSERT_TRUE(lenient.has_value());
+            STF_ASSERT_TRUE(forgiving.has_value());
+            STF_ASSERT_EQ(n, *forgiving);
+            decoded.resize(*forgiving);
+            STF_ASSERT_EQ(original, decoded);
+        }
+    }
+}
+
+STF_TEST(Allocation, CInterface)
+{
+    char encoded[1024];
+    std::uint8_t decoded[1024];
+
+    for (std::size_t n = 0; n <= Maximum_Input_Length; n++)
+    {
+        auto original = RandomOctets(n);
+        std::size_t encoded_length = sizeof(encoded);
+        std::size_t decoded_length = sizeof(decoded);
+        int encode_result = BASES_ERROR_INVALID_ARGUMENT;
+        int decode_result = BASES_ERROR_INVALID_ARGUMENT;
+
+        STF_ASSERT_EQ(std::size_t(0), AllocationsDuring([&]() {
+            encode_result = bases_base64url_encode(original.data(),
+                                                   original.size(),
+                                                   encoded,
+                                                   &encoded_length);
+            decode_result = bases_base64url_decode(encoded,
+                                                   encoded_length,
+                                                   decoded,
+                                                   &decoded_length);
+        }));
+
+        STF_ASSERT_EQ(BASES_OK, encode_result);
+        STF_ASSERT_EQ(BASES_OK, decode_result);
+        STF_ASSERT_EQ(n, decoded_length);
+    }
+}
+
+STF_TEST(Allocation, ScratchContainers)
+{
+    Bases::ScratchAllocator<char> characters;
+    Bases::ScratchAllocator<std::uint8_t> octets;
+
+    for (std::size_t n : {16, 100, 1000, 10000})
+    {
+        auto original = RandomOctets(n);
+        bool matched = true;
+
+        // Warm up this thread's scratch cache for this size
+        {
+            auto encoded = Base58::Encode(original, characters);
+            auto decoded = Base58::Decode(encoded, octets);
+            auto encoded64 = Base64::Encode(original, characters);
+            auto decoded64 = Base64::Decode(encoded64, octets);
+        }
+
+        // Subsequent calls reuse the cached buffers
+        STF_ASSERT_EQ(std::size_t(0), AllocationsDuring([&]() {
+            for (std::size_t i = 0; i < 10; i++)
+            {
+                auto encoded = Base58::Encode(original, characters);
+                auto decoded = Base58::Decode(encoded, octets);
+                matched &= std::equal(decoded.begin(),
+                                      decoded.end(),
+                                      original.begin(),
+                                      original.end());
+                auto encoded64 = Base64::Encode(original, characters);
+                auto decoded64 = Base64::Decode(encoded64, octets);
+                matched &= std::equal(decoded64.begin(),
+                                      decoded64.end(),
+                                      original.begin(),
+                                      original.end());
+            }
+        }));
+        STF_ASSERT_TRUE(matched);
+    }
+}
+
+STF_TEST(Allocation, FanOut)
+{
+    using Bases::FanOutEncoding;
+    constexpr FanOutEncoding encodings[] =
+    {
+        FanOutEncoding::Base16,
+        FanOutEncoding::Base16Lowercase,
+        FanOutEncoding::Base32,
+        FanOutEncoding::Base64,
+        FanOutEncoding::Base64URL
+    };
+
+    for (std::size_t n = 0; n <= Maximum_Input_Length; n++)
+    {
+        auto original = RandomOctets(n);
+        std::vector<std::vector<char>> buffers;
+        std::vector<Bases::FanOutTarget> targets;
+        bool result = false;
+
+        for (auto encoding : encodings)
+        {
+            buffers.emplace_back(Bases::MaxEncodedLength(encoding, n));
+        }
+        for (std::size_t i = 0; i < buffers.size(); i++)
+        {
+            targets.push_back({encodings[i], buffers[i]});
+        }
+
+        STF_ASSERT_EQ(std::size_t(0), AllocationsDuring([&]() {
+            result = Bases::EncodeFanOut(original, targets);
+        }));
+
+        STF_ASSERT_TRUE(result);
+        STF_ASSERT_EQ(Base32::Encode(original),
+                      std::string(buffers[2].data(), targets[2].length));
+        STF_ASSERT_EQ(Base64::Encode(original),
+                      std::string(buffers[3].data(), targets[3].length));
+    }
+}
+
+STF_TEST(Allocation, FormatTo)
+{
+    using Bases::FanOutEncoding;
+    constexpr FanOutEncoding encodings[] =
+    {
+        FanOutEncoding::Base16,
+        FanOutEncoding::Base32,
+        FanOutEncoding::Base64,
+        FanOutEncoding::Base64URL
+    };
+    Bases::FormatSpec spec;
+
+    // Pad to a width that exceeds the shorter outputs
+    spec.fill = '*';
+    spec.align = '^';
+    spec.width = Maximum_Input_Length;
+
+    for (std::size_t n = 0; n <= Maximum_Input_Length; n++)
+    {
+        auto original = RandomOctets(n);
+
+        for (auto encoding : encodings)
+        {
+            std::size_t length = Bases::FormattedLength(n, encoding, spec);
+            std::vector<char> output(std::max(length, spec.width));
+            char *end = nullptr;
+
+            STF_ASSERT_EQ(std::size_t(0), AllocationsDuring([&]() {
+                end = Bases::FormatTo(output.data(), original, encoding, spec);
+            }));
+
+            STF_ASSERT_EQ(output.size(),
+                          static_cast<std::size_t>(end - output.data()));
+        }
+    }
+}
+
+STF_TEST(Allocation, Normalize)
+{
+    std::vector<char> output(Maximum_Input_Length * 2 +
+                             Bases::Max_Normalize_Growth);
+
+    for (std::size_t n = 0; n <= Maximum_Input_Length; n++)
+    {
+        // Unpadded base64url text with a line break, normalized to Base64
+        std::vector<std::uint8_t> octets = RandomOctets(n);
+        std::string text = Base64::Encode(octets, Base64::URLAlphabet());
+        text.insert(text.size() / 2, "\r\n");
+        std::string expected = Base64::Encode(octets);
+        std::optional<std::size_t> length;
+
+        STF_ASSERT_EQ(std::size_t(0), AllocationsDuring([&]() {
+            length = Bases::Normalize(text,
+                                      Bases::FanOutEncoding::Base64,
+                                      output);
+        }));
+
+        STF_ASSERT_TRUE(length.has_value());
+        STF_ASSERT_EQ(expected, std::string(output.data(), *length));
+    }
+}
+
+STF_TEST(Allocation, CounterWorks)
+{
+    // Ensure the replacement allocation functions are actually in use
+    STF_ASSERT_TRUE(AllocationsDuring([]() {
+        auto encoded = Base64::Encode(std::string(100, 'x'));
+        STF_ASSERT_EQ(std::size_t(136), encoded.size());
+    }) > 0);
+}
@@ -19,6 +19,8 @@
 #include <chrono>
 #include <string>
 #include <cstdint>
+#include <span>
+#include <vector>
 #include <terra/stf/stf.h>
 #include <terra/bases/base16.h>
 
@@ -40,6 +42,33 @@ using namespace Terra;
         STF_ASSERT_EQ(s, expected); \
     }
 
+#define VERIFY_BASE16_SPAN(input, expected) \
+    { \
+        std::string plain = input; \
+        std::string text = expected; \
+        std::span<const std::uint8_t> octets( \
+            reinterpret_cast<const std::uint8_t *>(plain.data()), \
+            plain.size()); \
+        std::vector<char> encoded(Base16::MaxEncodedLength(plain.size())); \
+        std::size_t encoded_length = Base16::Encode(octets, encoded); \
+        STF_ASSERT_EQ(text, std::string(encoded.data(), encoded_length)); \
+        std::vector<std::uint8_t> decoded( \
+            Base16::MaxDecodedLength(text.size())); \
+        auto decoded_length = Base16::Decode(text, decoded); \
+        STF_ASSERT_TRUE(decoded_length.has_value()); \
+        decoded.resize(*decoded_length); \
+        STF_ASSERT_EQ(plain, std::string(decoded.begin(), decoded.end())); \
+        if (!plain.empty()) \
+        { \
+            std::vector<char> small_buffer(text.size() - 1); \
+            STF_ASSERT_EQ(std::size_t(0), \
+                          Base16::Encode(octets, small_buffer)); \
+            std::vector<std::uint8_t> small_octets(plain.size() - 1); \
+            STF_ASSERT_FALSE( \
+                Base16::Decode(text, small_octets).has_value()); \
+        } \
+    }
+
 STF_TEST(Base16, EncodeTests)
 {
     // Test vectors from RFC 4648
@@ -159,3 +188,33 @@ STF_TEST(Base16, ArrayTest)
 
     VERIFY_BASE16_ENCODE(octets, "666F6F626172");
 }
+
+STF_TEST(Base16, SpanTest)
+{
+    // Each octet yields two characters
+    VERIFY_BASE16_SPAN("", "");
+    VERIFY_BASE16_SPAN("f", "66");
+    VERIFY_BASE16_SPAN("foobar", "666F6F626172");
+}
+
+STF_TEST(Base16, IsValidTests)
+{
+    // Valid strings report their decoded length
+    STF_ASSERT_EQ(std::size_t(0), Base16::IsValid(""));
+    STF_ASSERT_EQ(std::size_t(3), Base16::IsValid("666F6f"));
+    STF_ASSERT_EQ(std::size_t(32),
+                  Base16::IsValid(std::string(64, 'a')));
+
+    // Odd lengths and characters outside the alphabet are invalid
+    STF_ASSERT_FALSE(Base16::IsValid("666").has_value());
+    STF_ASSERT_FALSE(Base16::IsValid("66 6F").has_value());
+    STF_ASSERT_FALSE(Base16::IsValid("6G").has_value());
+
+    // Lenient validation accepts what Decode() accepts
+    STF_ASSERT_EQ(std::size_t(2),
+                  Base16::IsValid("66 6F", Base16::Mode::Lenient));
+    STF_ASSERT_EQ(std::size_t(2),
+                  Base16::IsValid("66:6G:F", Base16::Mode::Lenient));
+    STF_ASSERT_FALSE(Base16::IsValid("66 6", Base16::Mode::Lenient)
+                         .has_value());
+}
@@ -19,6 +19,8 @@
 #include <chrono>
 #include <string>
 #include <cstdint>
+#include <span>
+#include <vector>
 #include <terra/stf/stf.h>
 #include <terra/bases/base32.h>
 
@@ -40,6 +42,33 @@ using namespace Terra;
         STF_ASSERT_EQ(s, expected); \
     }
 
+#define VERIFY_BASE32_SPAN(input, expected) \
+    { \
+        std::string plain = input; \
+        std::string text = expected; \
+        std::span<const std::uint8_t> octets( \
+            reinterpret_cast<const std::uint8_t *>(plain.data()), \
+            plain.size()); \
+        std::vector<char> encoded(Base32::MaxEncodedLength(plain.size())); \
+        std::size_t encoded_length = Base32::Encode(octets, encoded); \
+        STF_ASSERT_EQ(text, std::string(encoded.data(), encoded_length)); \
+        std::vector<std::uint8_t> decoded( \
+            Base32::MaxDecodedLength(text.size())); \
+        auto decoded_length = Base32::Decode(text, decoded); \
+        STF_ASSERT_TRUE(decoded_length.has_value()); \
+        decoded.resize(*decoded_length); \
+        STF_ASSERT_EQ(plain, std::string(decoded.begin(), decoded.end())); \
+        if (!plain.empty()) \
+        { \
+            std::vector<char> small_buffer(text.size() - 1); \
+            STF_ASSERT_EQ(std::size_t(0), \
+                          Base32::Encode(octets, small_buffer)); \
+            std::vector<std::uint8_t> small_octets(plain.size() - 1); \
+            STF_ASSERT_FALSE( \
+                Base32::Decode(text, small_octets).has_value()); \
+        } \
+    }
+
 STF_TEST(Base32, EncodeTests)
 {
     // Test vectors from RFC 4648
@@ -142,3 +171,77 @@ STF_TEST(Base32, ArrayTest)
 
     VERIFY_BASE32_ENCODE(octets, "MZXW6YTBOI======");
 }
+
+STF_TEST(Base32, SpanTest)
+{
+    // Test vectors from RFC 4648, covering each amount of padding
+    VERIFY_BASE32_SPAN("", "");
+    VERIFY_BASE32_SPAN("f", "MY======");
+    VERIFY_BASE32_SPAN("fo", "MZXQ====");
+    VERIFY_BASE32_SPAN("foo", "MZXW6===");
+    VERIFY_BASE32_SPAN("foob", "MZXW6YQ=");
+    VERIFY_BASE32_SPAN("fooba", "MZXW6YTB");
+    VERIFY_BASE32_SPAN("foobar", "MZXW6YTBOI======");
+
+    // Unpadded text decodes to the same octets
+    std::uint8_t octets[3];
+    STF_ASSERT_EQ(std::size_t(3), Base32::Decode("MZXW6", octets));
+}
+
+STF_TEST(Base32, AppendTest)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<unsigned> distribution(0, 255);
+
+    // Append random chunks and compare with encoding everything at once
+    std::vector<std::uint8_t> data;
+    std::string encoded;
+    for (std::size_t i = 0; i < 200; i++)
+    {
+        std::vector<std::uint8_t> chunk(distribution(generator) % 12);
+        for (auto &octet : chunk) octet = distribution(generator);
+        data.insert(data.end(), chunk.begin(), chunk.end());
+
+        STF_ASSERT_TRUE(Base32::Append(encoded, chunk));
+        STF_ASSERT_EQ(Base32::Encode(data), encoded);
+    }
+
+    // Strings that do not end with a properly encoded quantum are rejected
+    for (std::string invalid : {"A", "MZXW6=", "MZXW6Y==", "========",
+                                "MZX!", "MY======="})
+    {
+        std::string original = invalid;
+        STF_ASSERT_FALSE(Base32::Append(invalid, data));
+        STF_ASSERT_EQ(original, invalid);
+    }
+}
+
+STF_TEST(Base32, IsValidTests)
+{
+    // Valid strings report their decoded length
+    STF_ASSERT_EQ(std::size_t(0), Base32::IsValid(""));
+    STF_ASSERT_EQ(std::size_t(1), Base32::IsValid("MY======"));
+    STF_ASSERT_EQ(std::size_t(2), Base32::IsValid("MZXQ===="));
+    STF_ASSERT_EQ(std::size_t(3), Base32::IsValid("MZXW6==="));
+    STF_ASSERT_EQ(std::size_t(4), Base32::IsValid("MZXW6YQ="));
+    STF_ASSERT_EQ(std::size_t(6), Base32::IsValid("MZXW6YTBOI======"));
+
+    // Length, padding, alphabet, and trailing bit errors are invalid
+    STF_ASSERT_FALSE(Base32::IsValid("MZXW6").has_value());
+    STF_ASSERT_FALSE(Base32::IsValid("M=======").has_value());
+    STF_ASSERT_FALSE(Base32::IsValid("MZX=====").has_value());
+    STF_ASSERT_FALSE(Base32::IsValid("MZ=W6===").has_value());
+    STF_ASSERT_FALSE(Base32::IsValid("MZXW 6==").has_value());
+    STF_ASSERT_FALSE(Base32::IsValid("MZ======").has_value());
+    STF_ASSERT_FALSE(Base32::IsValid("========").has_value());
+    STF_ASSERT_FALSE(Base32::IsValid("MZXW6YTB========").has_value());
+    STF_ASSERT_FALSE(Base32::IsValid("MZXW6===========").has_value());
+
+    // Lenient validation accepts what Decode() accepts
+    STF_ASSERT_EQ(std::size_t(3),
+                  Base32::IsValid("MZX\nW6", Base32::Mode::Lenient));
+    STF_ASSERT_EQ(std::size_t(1),
+                  Base32::IsValid("MY=XYZ", Base32::Mode::Lenient));
+    STF_ASSERT_FALSE(Base32::IsValid("MZ", Base32::Mode::Lenient)
+                         .has_value());
+}
@@ -19,6 +19,8 @@
 #include <chrono>
 #include <string>
 #include <cstdint>
+#include <span>
+#include <vector>
 #include <terra/stf/stf.h>
 #include <terra/bases/base45.h>
 
@@ -40,6 +42,33 @@ using namespace Terra;
         STF_ASSERT_EQ(s, expected); \
     }
 
+#define VERIFY_BASE45_SPAN(input, expected) \
+    { \
+        std::string plain = input; \
+        std::string text = expected; \
+        std::span<const std::uint8_t> octets( \
+            reinterpret_cast<const std::uint8_t *>(plain.data()), \
+            plain.size()); \
+        std::vector<char> encoded(Base45::MaxEncodedLength(plain.size())); \
+        std::size_t encoded_length = Base45::Encode(octets, encoded); \
+        STF_ASSERT_EQ(text, std::string(encoded.data(), encoded_length)); \
+        std::vector<std::uint8_t> decoded( \
+            Base45::MaxDecodedLength(text.size())); \
+        auto decoded_length = Base45::Decode(text, decoded); \
+        STF_ASSERT_TRUE(decoded_length.has_value()); \
+        decoded.resize(*decoded_length); \
+        STF_ASSERT_EQ(plain, std::string(decoded.begin(), decoded.end())); \
+        if (!plain.empty()) \
+        { \
+            std::vector<char> small_buffer(text.size() - 1); \
+            STF_ASSERT_EQ(std::size_t(0), \
+                          Base45::Encode(octets, small_buffer)); \
+            std::vector<std::uint8_t> small_octets(plain.size() - 1); \
+            STF_ASSERT_FALSE( \
+                Base45::Decode(text, small_octets).has_value()); \
+        } \
+    }
+
 STF_TEST(Base45, EncodeTests)
 {
     // Test vectors from RFC 9285
@@ -176,3 +205,36 @@ STF_TEST(Base45, ArrayTest)
 
     VERIFY_BASE45_ENCODE(octets, "%69 VD92EX0");
 }
+
+STF_TEST(Base45, SpanTest)
+{
+    // Test vectors from RFC 9285, including a final group of one octet
+    VERIFY_BASE45_SPAN("", "");
+    VERIFY_BASE45_SPAN("AB", "BB8");
+    VERIFY_BASE45_SPAN("ietf!", "QED8WEX0");
+    VERIFY_BASE45_SPAN("Hello!!", "%69 VD92EX0");
+}
+
+STF_TEST(Base45, IsValidTests)
+{
+    // Valid strings report their decoded length
+    STF_ASSERT_EQ(std::size_t(0), Base45::IsValid(""));
+    STF_ASSERT_EQ(std::size_t(2), Base45::IsValid("BB8"));
+    STF_ASSERT_EQ(std::size_t(7), Base45::IsValid("%69 VD92EX0"));
+    STF_ASSERT_EQ(std::size_t(2), Base45::IsValid("FGW"));
+    STF_ASSERT_EQ(std::size_t(1), Base45::IsValid("U5"));
+
+    // Length errors, invalid characters, and overflows are invalid
+    STF_ASSERT_FALSE(Base45::IsValid("BB8A").has_value());
+    STF_ASSERT_FALSE(Base45::IsValid("BB8\n").has_value());
+    STF_ASSERT_FALSE(Base45::IsValid("GGW").has_value());
+    STF_ASSERT_FALSE(Base45::IsValid("V5").has_value());
+
+    // Lenient validation accepts what Decode() accepts
+    STF_ASSERT_EQ(std::size_t(2),
+                  Base45::IsValid("BB\n8", Base45::Mode::Lenient));
+    STF_ASSERT_EQ(std::size_t(2),
+                  Base45::IsValid("GGW", Base45::Mode::Lenient));
+    STF_ASSERT_FALSE(Base45::IsValid("BB8A", Base45::Mode::Lenient)
+                         .has_value());
+}
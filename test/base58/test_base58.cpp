@@ -16,9 +16,13 @@
  */
 
 #include <random>
+#include <atomic>
 #include <chrono>
 #include <string>
 #include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
 #include <terra/stf/stf.h>
 #include <terra/bases/base58.h>
 
@@ -40,6 +44,33 @@ using namespace Terra;
         STF_ASSERT_EQ(s, expected); \
     }
 
+#define VERIFY_BASE58_SPAN(input, expected) \
+    { \
+        std::string plain = input; \
+        std::string text = expected; \
+        std::span<const std::uint8_t> octets( \
+            reinterpret_cast<const std::uint8_t *>(plain.data()), \
+            plain.size()); \
+        std::vector<char> encoded(Base58::MaxEncodedLength(plain.size())); \
+        std::size_t encoded_length = Base58::Encode(octets, encoded); \
+        STF_ASSERT_EQ(text, std::string(encoded.data(), encoded_length)); \
+        std::vector<std::uint8_t> decoded( \
+            Base58::MaxDecodedLength(text.size())); \
+        auto decoded_length = Base58::Decode(text, decoded); \
+        STF_ASSERT_TRUE(decoded_length.has_value()); \
+        decoded.resize(*decoded_length); \
+        STF_ASSERT_EQ(plain, std::string(decoded.begin(), decoded.end())); \
+        if (!plain.empty()) \
+        { \
+            std::vector<char> small_buffer(text.size() - 1); \
+            STF_ASSERT_EQ(std::size_t(0), \
+                          Base58::Encode(octets, small_buffer)); \
+            std::vector<std::uint8_t> small_octets(plain.size() - 1); \
+            STF_ASSERT_FALSE( \
+                Base58::Decode(text, small_octets).has_value()); \
+        } \
+    }
+
 STF_TEST(Base58, EncodeTests)
 {
     VERIFY_BASE58_ENCODE("", "");
@@ -153,3 +184,171 @@ STF_TEST(Base58, ArrayTest)
 
     VERIFY_BASE58_ENCODE(octets, "11233QC4");
 }
+
+STF_TEST(Base58, SpanTest)
+{
+    VERIFY_BASE58_SPAN("", "");
+    VERIFY_BASE58_SPAN("Hello World!", "2NEpo7TZRRrLZSi2U");
+
+    // Each leading zero octet is encoded as a leading '1'
+    VERIFY_BASE58_SPAN(std::string(1, '\0'), "1");
+    VERIFY_BASE58_SPAN(std::string("\0\0\x01", 3), "112");
+    VERIFY_BASE58_SPAN(std::string("\0\0Hi", 4), "116Wc");
+}
+
+STF_TEST(Base58, IsValidTests)
+{
+    // Valid strings report their decoded length
+    STF_ASSERT_EQ(std::size_t(0), Base58::IsValid(""));
+    STF_ASSERT_EQ(std::size_t(12), Base58::IsValid("2NEpo7TZRRrLZSi2U"));
+    STF_ASSERT_EQ(std::size_t(3), Base58::IsValid("111"));
+    STF_ASSERT_EQ(std::size_t(4), Base58::IsValid("111z"));
+
+    // Characters outside the alphabet are invalid
+    STF_ASSERT_FALSE(Base58::IsValid("2NEpo7TZRR0LZSi2U").has_value());
+    STF_ASSERT_FALSE(Base58::IsValid("2NEpo7TZRR LZSi2U").has_value());
+
+    // Lenient validation skips whitespace as Decode() does
+    STF_ASSERT_EQ(std::size_t(12),
+                  Base58::IsValid(" 2NEpo7TZRR\nrLZSi2U ",
+                                  Base58::Mode::Lenient));
+    STF_ASSERT_FALSE(Base58::IsValid("2NEpo7TZRR0", Base58::Mode::Lenient)
+                         .has_value());
+
+    // Lengths must be exact for long values, including those at or just
+    // below a power of 256, where the estimate is uncertain
+    std::mt19937 generator(58);
+    std::uniform_int_distribution<unsigned> distribution(0, 255);
+    for (std::size_t length = 1; length < 200; length++)
+    {
+        std::vector<std::vector<std::uint8_t>> values(3);
+        values[0].assign(length, 0xff);
+        values[1].assign(length, 0x00);
+        values[1][0] = 0x01;
+        for (std::size_t i = 0; i < length; i++)
+        {
+            values[2].push_back(std::uint8_t(distribution(generator)));
+        }
+        for (const auto &value : values)
+        {
+            std::string encoded = Base58::Encode(value);
+            STF_ASSERT_EQ(Base58::Decode(encoded).size(),
+                          Base58::IsValid(encoded));
+        }
+    }
+}
+
+STF_TEST(Base58, CacheTest)
+{
+    std::mt19937 generator(32);
+    std::uniform_int_distribution<unsigned> distribution(0, 255);
+    std::vector<std::vector<std::uint8_t>> keys(64);
+    Base58::Cache cache(256, 4);
+
+    for (auto &key : keys)
+    {
+        for (std::size_t i = 0; i < Base58::Cache::Key_Length; i++)
+        {
+            key.push_back(std::uint8_t(distribution(generator)));
+        }
+    }
+    keys[0].assign(Base58::Cache::Key_Length, 0x00);
+    keys[1].assign(Base58::Cache::Key_Length, 0xff);
+
+    STF_ASSERT_EQ(std::size_t(256), cache.Capacity());
+
+    // The first encoding of each key misses and the second hits
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (const auto &key : keys)
+        {
+            STF_ASSERT_EQ(Base58::Encode(key), Base58::Encode(key, cache));
+        }
+    }
+    auto statistics = cache.GetStatistics();
+    STF_ASSERT_EQ(std::uint64_t(64), statistics.hits);
+    STF_ASSERT_EQ(std::uint64_t(64), statistics.misses);
+    STF_ASSERT_EQ(std::uint64_t(64), statistics.insertions);
+
+    // Other lengths bypass the cache
+    std::vector<std::uint8_t> short_key(keys[2].begin(), keys[2].end() - 1);
+    STF_ASSERT_EQ(Base58::Encode(short_key), Base58::Encode(short_key, cache));
+    STF_ASSERT_EQ(std::uint64_t(128),
+                  cache.GetStatistics().hits + cache.GetStatistics().misses);
+
+    // A small output buffer is rejected whether cached or not
+    std::vector<char> output(10);
+    STF_ASSERT_EQ(std::size_t(0), Base58::Encode(keys[2], output, cache));
+
+    // Cleared entries are no longer found
+    cache.Clear();
+    cache.ResetStatistics();
+    STF_ASSERT_EQ(Base58::Encode(keys[3]), Base58::Encode(keys[3], cache));
+    STF_ASSERT_EQ(std::uint64_t(1), cache.GetStatistics().misses);
+
+    // Keys of the wrong length are not inserted
+    STF_ASSERT_FALSE(cache.Insert(short_key, "1"));
+}
+
+STF_TEST(Base58, CacheEvictionTest)
+{
+    std::vector<std::vector<std::uint8_t>> keys;
+    Base58::Cache cache(Base58::Cache::Ways, 1);
+
+    for (std::size_t n = 0; n < 4 * Base58::Cache::Ways; n++)
+    {
+        keys.emplace_back(Base58::Cache::Key_Length, std::uint8_t(n));
+    }
+
+    // Fill the single set, then keep one entry in use
+    for (std::size_t n = 0; n < Base58::Cache::Ways; n++)
+    {
+        Base58::Encode(keys[n], cache);
+    }
+    STF_ASSERT_EQ(std::uint64_t(0), cache.GetStatistics().evictions);
+    for (std::size_t n = Base58::Cache::Ways; n < keys.size(); n++)
+    {
+        STF_ASSERT_EQ(Base58::Encode(keys[0]), Base58::Encode(keys[0], cache));
+        STF_ASSERT_EQ(Base58::Encode(keys[n]), Base58::Encode(keys[n], cache));
+    }
+
+    // The entry in use survived while others were evicted
+    auto statistics = cache.GetStatistics();
+    STF_ASSERT_EQ(std::uint64_t(3 * Base58::Cache::Ways),
+                  statistics.evictions);
+    STF_ASSERT_EQ(std::uint64_t(3 * Base58::Cache::Ways), statistics.hits);
+}
+
+STF_TEST(Base58, CacheConcurrencyTest)
+{
+    std::vector<std::vector<std::uint8_t>> keys;
+    std::vector<std::string> expected;
+    std::vector<std::thread> threads;
+    std::atomic<bool> mismatch = false;
+    Base58::Cache cache(64, 2);
+
+    for (std::size_t n = 0; n < 256; n++)
+    {
+        keys.emplace_back(Base58::Cache::Key_Length, std::uint8_t(n));
+        keys.back()[n % Base58::Cache::Key_Length] ^= 0x5a;
+        expected.push_back(Base58::Encode(keys.back()));
+    }
+
+    // Readers and writers contend for a cache too small for every key
+    for (unsigned t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&, t]() {
+            for (std::size_t i = 0; i < 20000; i++)
+            {
+                std::size_t n = (i * (t + 1) * 7) % keys.size();
+                if (Base58::Encode(keys[n], cache) != expected[n])
+                {
+                    mismatch = true;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) thread.join();
+
+    STF_ASSERT_FALSE(mismatch.load());
+}
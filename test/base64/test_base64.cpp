@@ -16,11 +16,17 @@
  *      None.
  */
 
+#include <algorithm>
 #include <random>
 #include <chrono>
+#include <limits>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <cstdint>
+#include <span>
 #include <vector>
+#include <stdexcept>
 #include <terra/stf/stf.h>
 #include <terra/bases/base64.h>
 
@@ -42,6 +48,47 @@ using namespace Terra;
         STF_ASSERT_EQ(s, expected); \
     }
 
+#define VERIFY_BASE64_ENCODE2(input, alphabet, expected) \
+    { \
+        auto output = Base64::Encode(input, alphabet); \
+        STF_ASSERT_EQ(expected, output); \
+    }
+
+#define VERIFY_BASE64_DECODE2(input, alphabet, expected) \
+    { \
+        std::string s; \
+        auto output = Base64::Decode(input, alphabet); \
+        std::copy(output.begin(), output.end(), std::back_inserter(s)); \
+        STF_ASSERT_EQ(s, expected); \
+    }
+
+#define VERIFY_BASE64_SPAN(input, expected) \
+    { \
+        std::string plain = input; \
+        std::string text = expected; \
+        std::span<const std::uint8_t> octets( \
+            reinterpret_cast<const std::uint8_t *>(plain.data()), \
+            plain.size()); \
+        std::vector<char> encoded(Base64::MaxEncodedLength(plain.size())); \
+        std::size_t encoded_length = Base64::Encode(octets, encoded); \
+        STF_ASSERT_EQ(text, std::string(encoded.data(), encoded_length)); \
+        std::vector<std::uint8_t> decoded( \
+            Base64::MaxDecodedLength(text.size())); \
+        auto decoded_length = Base64::Decode(text, decoded); \
+        STF_ASSERT_TRUE(decoded_length.has_value()); \
+        decoded.resize(*decoded_length); \
+        STF_ASSERT_EQ(plain, std::string(decoded.begin(), decoded.end())); \
+        if (!plain.empty()) \
+        { \
+            std::vector<char> small_buffer(text.size() - 1); \
+            STF_ASSERT_EQ(std::size_t(0), \
+                          Base64::Encode(octets, small_buffer)); \
+            std::vector<std::uint8_t> small_octets(plain.size() - 1); \
+            STF_ASSERT_FALSE( \
+                Base64::Decode(text, small_octets).has_value()); \
+        } \
+    }
+
 STF_TEST(Base64, EncodeTests)
 {
     // Test vectors from RFC 4648
@@ -153,3 +200,513 @@ STF_TEST(Base64, ArrayTest)
 
     VERIFY_BASE64_ENCODE(octets, "JVkA62fm");
 }
+
+STF_TEST(Base64, AlphabetTests)
+{
+    // Standard alphabet should produce the same results as the default
+    VERIFY_BASE64_ENCODE2("foobar", Base64::StandardAlphabet(), "Zm9vYmFy");
+    VERIFY_BASE64_ENCODE2("fooba", Base64::StandardAlphabet(), "Zm9vYmE=");
+
+    // base64url does not use padding
+    std::uint8_t url_octets[] = {0xfb, 0xff, 0xbf, 0xe0};
+    VERIFY_BASE64_ENCODE2(url_octets, Base64::URLAlphabet(), "-_-_4A");
+    VERIFY_BASE64_DECODE2("-_-_4A", Base64::URLAlphabet(),
+                          std::string(url_octets, url_octets + 4));
+
+    // bcrypt and crypt(3) alphabets; the latter assigns bits least
+    // significant first
+    VERIFY_BASE64_ENCODE2("Hello, World!\n",
+                          Base64::BcryptAlphabet(),
+                          "QETqZE6qGDbtakviGOm");
+    VERIFY_BASE64_DECODE2("QETqZE6qGDbtakviGOm",
+                          Base64::BcryptAlphabet(),
+                          "Hello, World!\n");
+    VERIFY_BASE64_ENCODE2("Hello, World!\n",
+                          Base64::CryptAlphabet(),
+                          "6J4Pgx49UQpPml4NVc.");
+    VERIFY_BASE64_DECODE2("6J4Pgx49UQpPml4NVc.",
+                          Base64::CryptAlphabet(),
+                          "Hello, World!\n");
+
+    // IMAP modified Base64 (RFC 3501 example of UTF-16 "日本語")
+    std::uint8_t imap_octets[] = {0x65, 0xe5, 0x67, 0x2c, 0x8a, 0x9e};
+    VERIFY_BASE64_ENCODE2(imap_octets, Base64::IMAPAlphabet(), "ZeVnLIqe");
+    VERIFY_BASE64_DECODE2("ZeVnLIqe", Base64::IMAPAlphabet(),
+                          std::string(imap_octets, imap_octets + 6));
+
+    // A custom alphabet may include '=' if padding is not used
+    Base64::Alphabet equals_alphabet(
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+=",
+        false);
+    VERIFY_BASE64_ENCODE2(url_octets, equals_alphabet, "+=+=4A");
+    VERIFY_BASE64_DECODE2("+=+=4A", equals_alphabet,
+                          std::string(url_octets, url_octets + 4));
+}
+
+STF_TEST(Base64, CryptTests)
+{
+    const auto &crypt = Base64::CryptAlphabet();
+
+    // MD5-crypt digest of "password" with salt "saltsalt", which crypt(3)
+    // renders as "$1$saltsalt$qjXMvbEw8oaL.CzflDtaK/"
+    std::uint8_t digest[] =
+    {
+        0x62, 0xf1, 0x5e, 0xaf, 0x9b, 0xf1, 0x3b, 0x09,
+        0x6d, 0xf3, 0x93, 0x56, 0xf6, 0xfb, 0x0a, 0x80
+    };
+    const std::string hash = "qjXMvbEw8oaL.CzflDtaK/";
+
+    // MD5-crypt encodes the digest octets in this order
+    std::vector<std::uint8_t> octets;
+    for (std::size_t i : {12, 6, 0, 13, 7, 1, 14, 8, 2, 15, 9, 3, 5, 10, 4,
+                          11})
+    {
+        octets.push_back(digest[i]);
+    }
+
+    STF_ASSERT_EQ(hash, Base64::Encode(octets, crypt));
+    STF_ASSERT_EQ(octets, Base64::Decode(hash, crypt));
+    STF_ASSERT_EQ(octets.size(),
+                  Base64::IsValid(hash, Base64::Mode::Strict, crypt));
+
+    // Values are assigned in alphabet order regardless of bit order
+    STF_ASSERT_EQ('/', crypt.Character(1));
+    STF_ASSERT_EQ(std::uint8_t(12), crypt.Value('A'));
+    STF_ASSERT_EQ(Base64::BitOrder::LeastSignificantFirst, crypt.Order());
+
+    // Span, checked, range, and append operations honor the bit order
+    std::vector<std::uint8_t> decoded(octets.size());
+    STF_ASSERT_EQ(octets.size(), Base64::Decode(hash, decoded, crypt));
+    STF_ASSERT_EQ(octets, decoded);
+    STF_ASSERT_EQ(octets.size(),
+                  Base64::Decode(hash,
+                                 decoded,
+                                 Base64::Mode::Forgiving,
+                                 crypt));
+    STF_ASSERT_EQ(octets, decoded);
+    Base64::RangeDecoder range(hash, crypt);
+    STF_ASSERT_EQ(std::vector<std::uint8_t>(octets.begin() + 4,
+                                            octets.begin() + 11),
+                  range.Decode(4, 7));
+    std::string appended = Base64::Encode(
+        std::span(octets).first(5), crypt);
+    STF_ASSERT_TRUE(Base64::Append(appended, std::span(octets).subspan(5),
+                                   crypt));
+    STF_ASSERT_EQ(hash, appended);
+
+    // Long inputs are encoded in several blocks
+    std::vector<std::uint8_t> original(5000);
+    for (std::size_t i = 0; i < original.size(); i++)
+    {
+        original[i] = static_cast<std::uint8_t>(i * 7);
+    }
+    std::string encoded = Base64::Encode(original, crypt);
+    std::vector<std::uint8_t> prefix(original.begin(), original.begin() + 3);
+    STF_ASSERT_EQ(Base64::Encode(prefix, crypt), encoded.substr(0, 4));
+    STF_ASSERT_EQ(original, Base64::Decode(encoded, crypt));
+}
+
+STF_TEST(Base64, TolerantAlphabetTests)
+{
+    const auto &tolerant = Base64::TolerantAlphabet();
+    std::uint8_t octets[] = {0xfb, 0xff, 0xbf, 0xe0};
+    std::string expected(octets, octets + 4);
+
+    // Encoding produces the standard alphabet with padding
+    VERIFY_BASE64_ENCODE2(octets, tolerant, "+/+/4A==");
+
+    // Standard, base64url, and mixed text all decode, padded or not
+    VERIFY_BASE64_DECODE2("+/+/4A==", tolerant, expected);
+    VERIFY_BASE64_DECODE2("-_-_4A", tolerant, expected);
+    VERIFY_BASE64_DECODE2("+_-/4A=", tolerant, expected);
+    VERIFY_BASE64_DECODE2("+_-/\r\n4A", tolerant, expected);
+
+    // Long mixed input decodes through every kernel path
+    std::vector<std::uint8_t> original(5000);
+    for (std::size_t i = 0; i < original.size(); i++)
+    {
+        original[i] = static_cast<std::uint8_t>(0xf8 | i);
+    }
+    std::string encoded = Base64::Encode(original);
+    for (std::size_t i = 0; i < encoded.size(); i += 3)
+    {
+        if (encoded[i] == '+') encoded[i] = '-';
+        if (encoded[i] == '/') encoded[i] = '_';
+    }
+    STF_ASSERT_EQ(original, Base64::Decode(encoded, tolerant));
+    STF_ASSERT_EQ(original.size(),
+                  Base64::IsValid(encoded, Base64::Mode::Strict, tolerant));
+
+    // Alternates may not map a character to two values
+    auto is_rejected = [](std::string_view alternates)
+    {
+        try
+        {
+            Base64::Alphabet alphabet(
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+                "0123456789+/",
+                true,
+                alternates);
+        }
+        catch (const std::invalid_argument &)
+        {
+            return true;
+        }
+        return false;
+    };
+    STF_ASSERT_TRUE(is_rejected("ABC"));
+    STF_ASSERT_TRUE(is_rejected(
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789/+"));
+    STF_ASSERT_TRUE(is_rejected(
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-="));
+    STF_ASSERT_FALSE(is_rejected(
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"));
+}
+
+STF_TEST(Base64, InvalidAlphabetTests)
+{
+    auto is_rejected = [](std::string_view characters, bool padding)
+    {
+        try
+        {
+            Base64::Alphabet alphabet(characters, padding);
+        }
+        catch (const std::invalid_argument &)
+        {
+            return true;
+        }
+        return false;
+    };
+
+    // Too short, too long, and duplicated characters
+    STF_ASSERT_TRUE(is_rejected("ABC", false));
+    STF_ASSERT_TRUE(is_rejected(
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/!",
+        false));
+    STF_ASSERT_TRUE(is_rejected(
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+A",
+        false));
+
+    // The padding character cannot be used if padding is requested
+    STF_ASSERT_TRUE(is_rejected(
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+=",
+        true));
+}
+
+STF_TEST(Base64, AlphabetRandomTest)
+{
+    std::vector<std::uint8_t> original;         // Original octets to encode
+    std::default_random_engine generator(1);
+    std::uniform_int_distribution<unsigned> random_octet(0, 255);
+
+    // Create a random vector of octets
+    for (int i = 0; i < 10000; i++) original.push_back(random_octet(generator));
+
+    // Verify round-trip encoding with each alphabet
+    for (const Base64::Alphabet *alphabet : {&Base64::URLAlphabet(),
+                                             &Base64::BcryptAlphabet(),
+                                             &Base64::CryptAlphabet(),
+                                             &Base64::IMAPAlphabet()})
+    {
+        auto encoded = Base64::Encode(original, *alphabet);
+        STF_ASSERT_EQ(original, Base64::Decode(encoded, *alphabet));
+    }
+}
+
+STF_TEST(Base64, SpanTest)
+{
+    // Test vectors from RFC 4648, covering each amount of padding
+    VERIFY_BASE64_SPAN("", "");
+    VERIFY_BASE64_SPAN("f", "Zg==");
+    VERIFY_BASE64_SPAN("fo", "Zm8=");
+    VERIFY_BASE64_SPAN("foo", "Zm9v");
+    VERIFY_BASE64_SPAN("foobar", "Zm9vYmFy");
+
+    // Padding may be omitted when decoding
+    std::uint8_t octets[2];
+    STF_ASSERT_EQ(std::size_t(2), Base64::Decode("Zm8", octets));
+}
+
+STF_TEST(Base64, RangeDecoderFixedLayout)
+{
+    std::mt19937 generator(1234);
+    std::uniform_int_distribution<unsigned> distribution(0, 255);
+
+    // Create random data and encode it as 64-column PEM-style text
+    std::vector<std::uint8_t> original(5000);
+    for (auto &octet : original) octet = distribution(generator);
+    std::string encoded = Base64::Encode(original);
+    std::string wrapped;
+    for (std::size_t i = 0; i < encoded.size(); i += 64)
+    {
+        wrapped += encoded.substr(i, 64) + "\r\n";
+    }
+
+    Base64::RangeDecoder decoder(wrapped);
+    STF_ASSERT_TRUE(decoder.FixedLayout());
+    STF_ASSERT_EQ(original.size(), decoder.DecodedLength());
+
+    // Decode random ranges and compare with the original
+    std::uniform_int_distribution<std::size_t> offsets(0, original.size());
+    for (std::size_t i = 0; i < 200; i++)
+    {
+        std::size_t offset = offsets(generator);
+        std::size_t length = offsets(generator) % 300;
+        std::size_t available = std::min(length, original.size() - offset);
+        std::vector<std::uint8_t> expected(original.begin() + offset,
+                                           original.begin() + offset +
+                                               available);
+        STF_ASSERT_EQ(expected, decoder.Decode(offset, length));
+    }
+
+    // Ranges at the very end and beyond the end
+    STF_ASSERT_EQ(std::vector<std::uint8_t>{original.back()},
+                  decoder.Decode(original.size() - 1, 10));
+    STF_ASSERT_TRUE(decoder.Decode(original.size(), 10).empty());
+    STF_ASSERT_TRUE(decoder.Decode(original.size() + 1, 10).empty());
+
+    std::vector<std::uint8_t> buffer(10);
+    auto result = decoder.Decode(original.size(), buffer);
+    STF_ASSERT_TRUE(result.has_value());
+    STF_ASSERT_EQ(std::size_t(0), *result);
+    STF_ASSERT_FALSE(decoder.Decode(original.size() + 1, buffer).has_value());
+
+    // A truncated range leaves the rest of the buffer unchanged
+    std::fill(buffer.begin(), buffer.end(), 0xaa);
+    result = decoder.Decode(original.size() - 2, buffer);
+    STF_ASSERT_TRUE(result.has_value());
+    STF_ASSERT_EQ(std::size_t(2), *result);
+    STF_ASSERT_EQ(original[original.size() - 2], buffer[0]);
+    STF_ASSERT_EQ(original.back(), buffer[1]);
+    STF_ASSERT_TRUE(std::all_of(buffer.begin() + 2,
+                                buffer.end(),
+                                [](std::uint8_t octet) {
+                                    return octet == 0xaa;
+                                }));
+
+    // An excessive length is limited to the octets available
+    STF_ASSERT_EQ(std::vector<std::uint8_t>{original.back()},
+                  decoder.Decode(original.size() - 1,
+                                 std::numeric_limits<std::size_t>::max()));
+}
+
+STF_TEST(Base64, RangeDecoderIrregularLayout)
+{
+    std::mt19937 generator(5678);
+    std::uniform_int_distribution<unsigned> distribution(0, 255);
+
+    // Create random data and encode it with irregular whitespace
+    std::vector<std::uint8_t> original(3001);
+    for (auto &octet : original) octet = distribution(generator);
+    std::string encoded = Base64::Encode(original, Base64::URLAlphabet());
+    std::string text = " ";
+    for (std::size_t i = 0; i < encoded.size(); i++)
+    {
+        text += encoded[i];
+        if ((distribution(generator) % 7) == 0) text += " \n";
+    }
+
+    // Use a small checkpoint interval to exercise seeking
+    Base64::RangeDecoder decoder(text, Base64::URLAlphabet(), 30);
+    STF_ASSERT_FALSE(decoder.FixedLayout());
+    STF_ASSERT_EQ(original.size(), decoder.DecodedLength());
+
+    // Decode every offset with a short length and compare
+    for (std::size_t offset = 0; offset <= original.size(); offset++)
+    {
+        std::size_t available = std::min<std::size_t>(5,
+                                                      original.size() - offset);
+        std::vector<std::uint8_t> expected(original.begin() + offset,
+                                           original.begin() + offset +
+                                               available);
+        STF_ASSERT_EQ(expected, decoder.Decode(offset, 5));
+    }
+
+    // The entire range decodes to the original
+    STF_ASSERT_EQ(original, decoder.Decode(0, original.size()));
+}
+
+STF_TEST(Base64, RangeDecoderShortInput)
+{
+    // Partial final groups decode as with Decode()
+    for (std::string input : {"", "Zg==", "Zm8=", "Zm9v", "Zm9vYg", "Zm9vYmE"})
+    {
+        Base64::RangeDecoder decoder(input);
+        auto expected = Base64::Decode(input);
+        STF_ASSERT_EQ(expected.size(), decoder.DecodedLength());
+        STF_ASSERT_EQ(expected, decoder.Decode(0, 100));
+        if (expected.size() > 1)
+        {
+            STF_ASSERT_EQ(std::vector<std::uint8_t>(expected.begin() + 1,
+                                                    expected.end()),
+                          decoder.Decode(1, 100));
+        }
+    }
+}
+
+STF_TEST(Base64, AppendTest)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<unsigned> distribution(0, 255);
+
+    // Append random chunks and compare with encoding everything at once
+    for (auto alphabet : {&Base64::StandardAlphabet(), &Base64::URLAlphabet()})
+    {
+        std::vector<std::uint8_t> data;
+        std::string encoded;
+        for (std::size_t i = 0; i < 200; i++)
+        {
+            std::vector<std::uint8_t> chunk(distribution(generator) % 8);
+            for (auto &octet : chunk) octet = distribution(generator);
+            data.insert(data.end(), chunk.begin(), chunk.end());
+
+            STF_ASSERT_TRUE(Base64::Append(encoded, chunk, *alphabet));
+            STF_ASSERT_EQ(Base64::Encode(data, *alphabet), encoded);
+        }
+    }
+
+    // The standard alphabet is used by default
+    std::string encoded = "Zm9vYg==";
+    const std::string suffix = "ar";
+    STF_ASSERT_TRUE(Base64::Append(
+        encoded,
+        std::span<const std::uint8_t>(
+            reinterpret_cast<const std::uint8_t *>(suffix.data()),
+            suffix.size())));
+    STF_ASSERT_EQ(std::string("Zm9vYmFy"), encoded);
+
+    // Strings that do not end with a properly encoded quantum are rejected
+    for (std::string invalid : {"Z", "Zm9vY", "Zm9v=", "Zm9vYg=", "====",
+                                "Zm9vY!=="})
+    {
+        std::string original = invalid;
+        std::vector<std::uint8_t> data{1, 2, 3};
+        STF_ASSERT_FALSE(Base64::Append(invalid, data));
+        STF_ASSERT_EQ(original, invalid);
+    }
+}
+
+STF_TEST(Base64, IsValidTests)
+{
+    // Valid strings report their decoded length
+    STF_ASSERT_EQ(std::size_t(0), Base64::IsValid(""));
+    STF_ASSERT_EQ(std::size_t(1), Base64::IsValid("Zg=="));
+    STF_ASSERT_EQ(std::size_t(2), Base64::IsValid("Zm8="));
+    STF_ASSERT_EQ(std::size_t(6), Base64::IsValid("Zm9vYmFy"));
+
+    // Length, padding, alphabet, and trailing bit errors are invalid
+    STF_ASSERT_FALSE(Base64::IsValid("Zg").has_value());
+    STF_ASSERT_FALSE(Base64::IsValid("Zg=").has_value());
+    STF_ASSERT_FALSE(Base64::IsValid("Z===").has_value());
+    STF_ASSERT_FALSE(Base64::IsValid("Zm9v\r\nYmFy").has_value());
+    STF_ASSERT_FALSE(Base64::IsValid("Zg==Zg==").has_value());
+    STF_ASSERT_FALSE(Base64::IsValid("Zh==").has_value());
+    STF_ASSERT_FALSE(Base64::IsValid("Zm9=").has_value());
+
+    // Alphabets without padding reject it and allow partial quanta
+    const auto &url = Base64::URLAlphabet();
+    STF_ASSERT_EQ(std::size_t(1),
+                  Base64::IsValid("Zg", Base64::Mode::Strict, url));
+    STF_ASSERT_EQ(std::size_t(2),
+                  Base64::IsValid("-_8", Base64::Mode::Strict, url));
+    STF_ASSERT_FALSE(
+        Base64::IsValid("Zg==", Base64::Mode::Strict, url).has_value());
+    STF_ASSERT_FALSE(
+        Base64::IsValid("Zm9vY", Base64::Mode::Strict, url).has_value());
+
+    // Lenient validation accepts what Decode() accepts
+    STF_ASSERT_EQ(std::size_t(6),
+                  Base64::IsValid("Zm9v\r\nYmFy", Base64::Mode::Lenient));
+    STF_ASSERT_EQ(std::size_t(1),
+                  Base64::IsValid("Zh==Zg==", Base64::Mode::Lenient));
+    STF_ASSERT_EQ(std::size_t(1),
+                  Base64::IsValid("Z", Base64::Mode::Lenient));
+}
+
+STF_TEST(Base64, ForgivingTests)
+{
+    // Decode using the WHATWG forgiving-base64 rules, as atob() does
+    auto atob = [](const std::string_view input) -> std::optional<std::string>
+    {
+        std::vector<std::uint8_t> output(
+            Base64::MaxDecodedLength(input.size()));
+        auto length =
+            Base64::Decode(input, output, Base64::Mode::Forgiving);
+        if (!length) return {};
+
+        // The validated length must agree with the decoded length
+        auto valid = Base64::IsValid(input, Base64::Mode::Forgiving);
+        if (valid != length) return "<length mismatch>";
+
+        return std::string(output.begin(), output.begin() + *length);
+    };
+
+    // Padding is optional, and unused trailing bits are ignored
+    STF_ASSERT_EQ(std::string(""), atob(""));
+    STF_ASSERT_EQ(std::string("f"), atob("Zg=="));
+    STF_ASSERT_EQ(std::string("f"), atob("Zg"));
+    STF_ASSERT_EQ(std::string("fo"), atob("Zm8="));
+    STF_ASSERT_EQ(std::string("fo"), atob("Zm8"));
+    STF_ASSERT_EQ(std::string("f"), atob("Zh=="));
+    STF_ASSERT_EQ(std::string("foobar"), atob("Zm9vYmFy"));
+
+    // ASCII whitespace is ignored anywhere, including within padding
+    STF_ASSERT_EQ(std::string("foobar"), atob(" Zm9v\r\nYm\tFy\f"));
+    STF_ASSERT_EQ(std::string("f"), atob("Z g = ="));
+    STF_ASSERT_EQ(std::string("foob"), atob("Z\nm\n9\nv\nY\ng\n=\n="));
+
+    // Padding must complete the final quantum and end the input
+    STF_ASSERT_FALSE(atob("Zg=").has_value());
+    STF_ASSERT_FALSE(atob("Zg===").has_value());
+    STF_ASSERT_FALSE(atob("Z===").has_value());
+    STF_ASSERT_FALSE(atob("=").has_value());
+    STF_ASSERT_FALSE(atob("====").has_value());
+    STF_ASSERT_FALSE(atob("Zg==Zg==").has_value());
+    STF_ASSERT_FALSE(atob("Zm9v=").has_value());
+
+    // A single residual character is a length error
+    STF_ASSERT_FALSE(atob("Z").has_value());
+    STF_ASSERT_FALSE(atob("Zm9vY").has_value());
+
+    // Other characters, including vertical tab, are errors
+    STF_ASSERT_FALSE(atob("Zm9v\vYmFy").has_value());
+    STF_ASSERT_FALSE(atob("Zm9v-YmFy").has_value());
+    STF_ASSERT_FALSE(atob("Zm9v_").has_value());
+    STF_ASSERT_FALSE(atob("Zm9vYmFy.").has_value());
+
+    // Long inputs broken into lines of any length match Decode()
+    std::vector<std::uint8_t> octets(3000);
+    for (std::size_t i = 0; i < octets.size(); i++) octets[i] = i * 7 + 3;
+    std::string encoded = Base64::Encode(octets);
+    for (std::size_t line : {1, 3, 61, 64, 76})
+    {
+        std::string wrapped;
+        for (std::size_t i = 0; i < encoded.size(); i += line)
+        {
+            wrapped += encoded.substr(i, line) + "\r\n";
+        }
+        STF_ASSERT_EQ(std::string(octets.begin(), octets.end()),
+                      atob(wrapped));
+    }
+
+    // The output buffer must be large enough
+    std::vector<std::uint8_t> small(2);
+    STF_ASSERT_FALSE(
+        Base64::Decode("Zm9v", small, Base64::Mode::Forgiving).has_value());
+
+    // Strict decoding rejects what strict validation rejects
+    std::vector<std::uint8_t> output(16);
+    STF_ASSERT_EQ(std::size_t(1),
+                  Base64::Decode("Zg==", output, Base64::Mode::Strict));
+    STF_ASSERT_FALSE(
+        Base64::Decode("Zg", output, Base64::Mode::Strict).has_value());
+    STF_ASSERT_EQ(std::size_t(1),
+                  Base64::Decode("Zg", output, Base64::Mode::Lenient));
+
+    // Other alphabets are supported
+    STF_ASSERT_EQ(std::size_t(2),
+                  Base64::Decode("-_8\n",
+                                 output,
+                                 Base64::Mode::Forgiving,
+                                 Base64::URLAlphabet()));
+}
@@ -0,0 +1,131 @@
+/*
+ *  test_bases_c.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements test logic for the C interface to the Base-N
+ *      encoding and decoding functions.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <terra/stf/stf.h>
+#include <terra/bases/bases_c.h>
+
+namespace
+{
+
+// Octets of the string "foobar"
+const std::uint8_t Foobar[] = {0x66, 0x6f, 0x6f, 0x62, 0x61, 0x72};
+
+} // namespace
+
+// The following are defined as macros so that errors will reveal
+// the line number correctly for any failed test
+#define VERIFY_C_ENCODE(function, expected) \
+    { \
+        char buffer[64]; \
+        std::size_t length = sizeof(buffer); \
+        STF_ASSERT_EQ(BASES_OK, \
+                      function(Foobar, sizeof(Foobar), buffer, &length)); \
+        STF_ASSERT_EQ(std::string(expected), std::string(buffer, length)); \
+    }
+
+#define VERIFY_C_DECODE(function, input) \
+    { \
+        std::uint8_t buffer[64]; \
+        std::size_t length = sizeof(buffer); \
+        STF_ASSERT_EQ(BASES_OK, \
+                      function(input, std::strlen(input), buffer, &length)); \
+        STF_ASSERT_EQ(sizeof(Foobar), length); \
+        STF_ASSERT_EQ(0, std::memcmp(Foobar, buffer, length)); \
+    }
+
+STF_TEST(BasesC, EncodeTests)
+{
+    VERIFY_C_ENCODE(bases_base16_encode, "666F6F626172");
+    VERIFY_C_ENCODE(bases_base32_encode, "MZXW6YTBOI======");
+    VERIFY_C_ENCODE(bases_base45_encode, "X.CT3EGEC");
+    VERIFY_C_ENCODE(bases_base58_encode, "t1Zv2yaZ");
+    VERIFY_C_ENCODE(bases_base64_encode, "Zm9vYmFy");
+    VERIFY_C_ENCODE(bases_base64url_encode, "Zm9vYmFy");
+}
+
+STF_TEST(BasesC, DecodeTests)
+{
+    VERIFY_C_DECODE(bases_base16_decode, "666F6F626172");
+    VERIFY_C_DECODE(bases_base32_decode, "MZXW6YTBOI======");
+    VERIFY_C_DECODE(bases_base45_decode, "X.CT3EGEC");
+    VERIFY_C_DECODE(bases_base58_decode, "t1Zv2yaZ");
+    VERIFY_C_DECODE(bases_base64_decode, "Zm9vYmFy");
+    VERIFY_C_DECODE(bases_base64url_decode, "Zm9vYmFy");
+}
+
+STF_TEST(BasesC, SizeQueryTests)
+{
+    std::size_t length = 0;
+
+    // Passing a NULL output buffer reports the required size
+    STF_ASSERT_EQ(BASES_ERROR_BUFFER_TOO_SMALL,
+                  bases_base64_encode(Foobar,
+                                      sizeof(Foobar),
+                                      nullptr,
+                                      &length));
+    STF_ASSERT_EQ(std::size_t(8), length);
+
+    // A buffer that is too small reports the required size
+    char buffer[4];
+    length = sizeof(buffer);
+    STF_ASSERT_EQ(BASES_ERROR_BUFFER_TOO_SMALL,
+                  bases_base16_encode(Foobar, sizeof(Foobar), buffer, &length));
+    STF_ASSERT_EQ(std::size_t(12), length);
+
+    // Decoding size query
+    length = 0;
+    STF_ASSERT_EQ(BASES_ERROR_BUFFER_TOO_SMALL,
+                  bases_base64_decode("Zm9vYmFy", 8, nullptr, &length));
+    STF_ASSERT_EQ(std::size_t(6), length);
+
+    // A decode buffer of exactly the decoded size is sufficient, even if
+    // smaller than the maximum decoded length
+    std::uint8_t octets[6];
+    length = sizeof(octets);
+    STF_ASSERT_EQ(BASES_OK,
+                  bases_base64_decode("Zm9v\nYmFy", 9, octets, &length));
+    STF_ASSERT_EQ(std::size_t(6), length);
+}
+
+STF_TEST(BasesC, ErrorTests)
+{
+    std::uint8_t octets[16];
+    std::size_t length = sizeof(octets);
+
+    // Invalid input
+    STF_ASSERT_EQ(BASES_ERROR_INVALID_INPUT,
+                  bases_base16_decode("ABC", 3, octets, &length));
+    length = sizeof(octets);
+    STF_ASSERT_EQ(BASES_ERROR_INVALID_INPUT,
+                  bases_base58_decode("0OIl", 4, octets, &length));
+
+    // Missing arguments
+    STF_ASSERT_EQ(BASES_ERROR_INVALID_ARGUMENT,
+                  bases_base64_decode("Zm9v", 4, octets, nullptr));
+    length = sizeof(octets);
+    STF_ASSERT_EQ(BASES_ERROR_INVALID_ARGUMENT,
+                  bases_base64_decode(nullptr, 4, octets, &length));
+
+    // Empty input is not an error
+    length = sizeof(octets);
+    STF_ASSERT_EQ(BASES_OK, bases_base64_decode(nullptr, 0, octets, &length));
+    STF_ASSERT_EQ(std::size_t(0), length);
+}
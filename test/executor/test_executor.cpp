@@ -0,0 +1,205 @@
+/*
+ *  test_executor.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements test logic for the executor interface, the
+ *      work-stealing executor, and the parallel encoders and decoders.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+#include <terra/stf/stf.h>
+#include <terra/bases/base16.h>
+#include <terra/bases/base32.h>
+#include <terra/bases/base64.h>
+#include <terra/bases/executor.h>
+
+using namespace Terra;
+
+namespace
+{
+
+// Executor that runs tasks serially and counts calls, standing in for an
+// application's own scheduler
+class CountingExecutor : public Bases::Executor
+{
+    public:
+        void Execute(std::size_t count, const RangeTask &task) override
+        {
+            calls++;
+            for (std::size_t i = 0; i < count; i++) task(i, i + 1);
+        }
+
+        std::size_t calls = 0;
+};
+
+/*
+ *  RandomOctets
+ *
+ *  Description:
+ *      Produce a vector of random octets.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The number of octets to produce.
+ *
+ *  Returns:
+ *      The random octets.
+ *
+ *  Comments:
+ *      None.
+ */
+std::vector<std::uint8_t> RandomOctets(std::size_t length)
+{
+    std::mt19937 generator(length);
+    std::uniform_int_distribution<unsigned> distribution(0, 255);
+    std::vector<std::uint8_t> octets(length);
+
+    for (auto &octet : octets) octet = distribution(generator);
+
+    return octets;
+}
+
+} // namespace
+
+STF_TEST(Executor, CoversRange)
+{
+    for (std::size_t threads : {0, 1, 3})
+    {
+        Bases::WorkStealingExecutor executor(threads);
+        STF_ASSERT_EQ(threads, executor.Threads());
+
+        for (std::size_t count : {0, 1, 2, 7, 100, 1000})
+        {
+            std::vector<std::atomic<unsigned>> visits(count);
+            executor.Execute(count, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; i++) visits[i]++;
+            });
+            for (auto &visit : visits) STF_ASSERT_EQ(1u, visit.load());
+        }
+    }
+}
+
+STF_TEST(Executor, NestedAndConcurrent)
+{
+    Bases::WorkStealingExecutor executor(2);
+    std::atomic<std::size_t> total{0};
+
+    // Execute() may be called from several threads and from within tasks
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&]() {
+            executor.Execute(8, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; i++)
+                {
+                    executor.Execute(10, [&](std::size_t b, std::size_t e) {
+                        total += e - b;
+                    });
+                }
+            });
+        });
+    }
+    for (auto &thread : threads) thread.join();
+
+    STF_ASSERT_EQ(std::size_t(4 * 8 * 10), total.load());
+}
+
+// The following is defined as a macro so that errors will reveal the line
+// number correctly for any failed test
+#define VERIFY_PARALLEL(Codec, executor) \
+    for (std::size_t n : {0, 1000, 200000, 333333}) \
+    { \
+        auto original = RandomOctets(n); \
+        std::string expected = Codec::Encode(original); \
+        std::vector<char> encoded(Codec::MaxEncodedLength(n)); \
+        std::size_t length = Codec::Encode(original, encoded, executor); \
+        STF_ASSERT_EQ(expected, std::string(encoded.data(), length)); \
+        std::vector<std::uint8_t> decoded(Codec::MaxDecodedLength(length)); \
+        auto decoded_length = Codec::Decode(expected, decoded, executor); \
+        STF_ASSERT_TRUE(decoded_length.has_value()); \
+        STF_ASSERT_EQ(n, *decoded_length); \
+        decoded.resize(n); \
+        STF_ASSERT_EQ(original, decoded); \
+    }
+
+STF_TEST(Executor, ParallelCodecs)
+{
+    Bases::WorkStealingExecutor executor(3);
+
+    VERIFY_PARALLEL(Base16, executor);
+    VERIFY_PARALLEL(Base32, executor);
+    VERIFY_PARALLEL(Base64, executor);
+    VERIFY_PARALLEL(Base64, Bases::DefaultExecutor());
+}
+
+STF_TEST(Executor, CustomExecutor)
+{
+    CountingExecutor executor;
+
+    VERIFY_PARALLEL(Base64, executor);
+
+    // Only the large inputs were divided among tasks
+    STF_ASSERT_EQ(std::size_t(4), executor.calls);
+
+    // An output buffer that is too small results in nothing being encoded
+    auto original = RandomOctets(200000);
+    std::vector<char> small(Base64::MaxEncodedLength(original.size()) - 1);
+    STF_ASSERT_EQ(std::size_t(0), Base64::Encode(original, small, executor));
+}
+
+STF_TEST(Executor, IrregularInput)
+{
+    Bases::WorkStealingExecutor executor(2);
+    auto original = RandomOctets(300000);
+    std::string encoded = Base64::Encode(original);
+
+    // Line breaks prevent decoding chunks in place, so the serial decoder
+    // is used and the result is unaffected
+    std::string wrapped;
+    for (std::size_t i = 0; i < encoded.size(); i += 76)
+    {
+        wrapped += encoded.substr(i, 76) + "\r\n";
+    }
+    std::vector<std::uint8_t> decoded(Base64::MaxDecodedLength(wrapped.size()));
+    auto length = Base64::Decode(wrapped, decoded, executor);
+    STF_ASSERT_TRUE(length.has_value());
+    decoded.resize(*length);
+    STF_ASSERT_EQ(original, decoded);
+
+    // Padding in the middle ends decoding exactly as it does serially
+    std::string truncated = encoded;
+    truncated[100000] = '=';
+    std::size_t maximum = Base64::MaxDecodedLength(truncated.size());
+    std::vector<std::uint8_t> serial(maximum);
+    std::vector<std::uint8_t> parallel(maximum);
+    auto serial_length = Base64::Decode(truncated, serial);
+    auto parallel_length = Base64::Decode(truncated, parallel, executor);
+    STF_ASSERT_TRUE(serial_length.has_value());
+    STF_ASSERT_EQ(serial_length, parallel_length);
+    serial.resize(*serial_length);
+    parallel.resize(*parallel_length);
+    STF_ASSERT_EQ(serial, parallel);
+
+    // Invalid Base16 input fails as it does serially
+    std::string hex = Base16::Encode(original);
+    hex.push_back('A');
+    std::vector<std::uint8_t> octets(Base16::MaxDecodedLength(hex.size()));
+    STF_ASSERT_EQ(Base16::Decode(hex, octets),
+                  Base16::Decode(hex, octets, executor));
+}
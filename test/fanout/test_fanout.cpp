@@ -0,0 +1,150 @@
+/*
+ *  test_fanout.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements test logic for fan-out encoding.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include <terra/stf/stf.h>
+#include <terra/bases/base16.h>
+#include <terra/bases/base32.h>
+#include <terra/bases/base64.h>
+#include <terra/bases/fanout.h>
+
+using namespace Terra;
+
+namespace
+{
+
+/*
+ *  RandomOctets
+ *
+ *  Description:
+ *      Produce a vector of random octets.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The number of octets to produce.
+ *
+ *  Returns:
+ *      The random octets.
+ *
+ *  Comments:
+ *      None.
+ */
+std::vector<std::uint8_t> RandomOctets(std::size_t length)
+{
+    std::mt19937 generator(length);
+    std::uniform_int_distribution<unsigned> distribution(0, 255);
+    std::vector<std::uint8_t> octets(length);
+
+    for (auto &octet : octets) octet = distribution(generator);
+
+    return octets;
+}
+
+/*
+ *  Lowercase
+ *
+ *  Description:
+ *      Convert a string to lowercase.
+ *
+ *  Parameters:
+ *      text [in]
+ *          The string to convert.
+ *
+ *  Returns:
+ *      The lowercase string.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string Lowercase(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(), [](char c) {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    });
+
+    return text;
+}
+
+} // namespace
+
+STF_TEST(FanOut, MatchesEncoders)
+{
+    for (std::size_t n : {0, 1, 2, 3, 4, 5, 32, 64, 959, 960, 961, 5000})
+    {
+        auto input = RandomOctets(n);
+        std::vector<std::string> expected =
+        {
+            Base16::Encode(input),
+            Lowercase(Base16::Encode(input)),
+            Base32::Encode(input),
+            Base64::Encode(input),
+            Base64::Encode(input, Base64::URLAlphabet())
+        };
+        std::vector<Bases::FanOutEncoding> encodings =
+        {
+            Bases::FanOutEncoding::Base16,
+            Bases::FanOutEncoding::Base16Lowercase,
+            Bases::FanOutEncoding::Base32,
+            Bases::FanOutEncoding::Base64,
+            Bases::FanOutEncoding::Base64URL
+        };
+
+        // Encode into every target at once
+        std::vector<std::vector<char>> buffers;
+        std::vector<Bases::FanOutTarget> targets;
+        for (auto encoding : encodings)
+        {
+            buffers.emplace_back(Bases::MaxEncodedLength(encoding, n));
+        }
+        for (std::size_t i = 0; i < encodings.size(); i++)
+        {
+            targets.push_back({encodings[i], buffers[i]});
+        }
+        STF_ASSERT_TRUE(Bases::EncodeFanOut(input, targets));
+
+        for (std::size_t i = 0; i < targets.size(); i++)
+        {
+            STF_ASSERT_EQ(expected[i],
+                          std::string(buffers[i].data(), targets[i].length));
+        }
+    }
+}
+
+STF_TEST(FanOut, SmallBuffer)
+{
+    auto input = RandomOctets(100);
+    std::vector<char> hex(Base16::MaxEncodedLength(input.size()));
+    std::vector<char> base64(Base64::MaxEncodedLength(input.size()) - 1);
+    std::vector<Bases::FanOutTarget> targets =
+    {
+        {Bases::FanOutEncoding::Base16Lowercase, hex, 5},
+        {Bases::FanOutEncoding::Base64, base64, 5}
+    };
+
+    // No target is written if any buffer is too small
+    STF_ASSERT_FALSE(Bases::EncodeFanOut(input, targets));
+    STF_ASSERT_EQ(std::size_t(0), targets[0].length);
+    STF_ASSERT_EQ(std::size_t(0), targets[1].length);
+
+    // An empty set of targets succeeds
+    STF_ASSERT_TRUE(Bases::EncodeFanOut(input, {}));
+}
@@ -0,0 +1,287 @@
+/*
+ *  test_file.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements test logic for encoding and decoding files.
+ *
+ *  Portability Issues:
+ *      Requires a POSIX system.
+ */
+
+#include <csignal>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <terra/stf/stf.h>
+#include <terra/bases/base16.h>
+#include <terra/bases/base32.h>
+#include <terra/bases/base64.h>
+#include <terra/bases/file.h>
+
+using namespace Terra;
+
+namespace
+{
+
+// Temporary file that is removed on destruction
+class TemporaryFile
+{
+    public:
+        explicit TemporaryFile(const std::string &name) :
+            path{(std::filesystem::temp_directory_path() /
+                  ("test_file_" + std::to_string(getpid()) + "_" + name))
+                     .string()}
+        {
+        }
+        ~TemporaryFile() { std::filesystem::remove(path); }
+
+        const std::string &Path() const noexcept { return path; }
+
+        void Write(const std::string &contents) const
+        {
+            std::ofstream(path, std::ios::binary) << contents;
+        }
+
+        std::string Read() const
+        {
+            std::ifstream file(path, std::ios::binary);
+            return {std::istreambuf_iterator<char>(file), {}};
+        }
+
+    protected:
+        std::string path;
+};
+
+/*
+ *  RandomString
+ *
+ *  Description:
+ *      Produce a string of random octets.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The number of octets to produce.
+ *
+ *  Returns:
+ *      The random octets.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string RandomString(std::size_t length)
+{
+    std::mt19937 generator(length);
+    std::uniform_int_distribution<unsigned> distribution(0, 255);
+    std::string octets(length, '\0');
+
+    for (auto &octet : octets)
+    {
+        octet = static_cast<char>(distribution(generator));
+    }
+
+    return octets;
+}
+
+/*
+ *  AsOctets
+ *
+ *  Description:
+ *      Return a string's contents as a span of octets.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The string.
+ *
+ *  Returns:
+ *      A span over the string's contents.
+ *
+ *  Comments:
+ *      None.
+ */
+std::span<const std::uint8_t> AsOctets(const std::string &data)
+{
+    return {reinterpret_cast<const std::uint8_t *>(data.data()), data.size()};
+}
+
+/*
+ *  Wrap
+ *
+ *  Description:
+ *      Insert a line break after every 76 characters.
+ *
+ *  Parameters:
+ *      text [in]
+ *          The text to wrap.
+ *
+ *  Returns:
+ *      The wrapped text.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string Wrap(const std::string &text)
+{
+    std::string wrapped;
+
+    for (std::size_t i = 0; i < text.size(); i += 76)
+    {
+        wrapped += text.substr(i, 76) + "\r\n";
+    }
+
+    return wrapped;
+}
+
+// Option sets exercising both I/O back ends with many small blocks and with
+// a block size too large to use as given
+const std::vector<Bases::FileOptions> Option_Sets =
+{
+    {},
+    {4096, 3, false, true},
+    {4096, 3, false, false},
+    {8192, 1, true, true},
+    {8192, 2, true, false},
+    {std::numeric_limits<std::size_t>::max(), 2, true, true}
+};
+
+} // namespace
+
+// The following is defined as a macro so that errors will reveal the line
+// number correctly for any failed test
+#define VERIFY_FILE(Codec, encoding) \
+    for (const auto &options : Option_Sets) \
+    { \
+        for (std::size_t n : {0, 1, 4095, 4096, 20481, 100003}) \
+        { \
+            std::string original = RandomString(n); \
+            std::string expected = Codec::Encode(AsOctets(original)); \
+            plain.Write(original); \
+            auto length = Bases::EncodeFile(plain.Path(), \
+                                            encoded.Path(), \
+                                            encoding, \
+                                            options); \
+            STF_ASSERT_TRUE(length.has_value()); \
+            STF_ASSERT_EQ(expected.size(), *length); \
+            STF_ASSERT_EQ(expected, encoded.Read()); \
+            length = Bases::DecodeFile(encoded.Path(), \
+                                       decoded.Path(), \
+                                       encoding, \
+                                       options); \
+            STF_ASSERT_TRUE(length.has_value()); \
+            STF_ASSERT_EQ(n, *length); \
+            STF_ASSERT_EQ(original, decoded.Read()); \
+            encoded.Write(Wrap(expected)); \
+            length = Bases::DecodeFile(encoded.Path(), \
+                                       decoded.Path(), \
+                                       encoding, \
+                                       options); \
+            STF_ASSERT_TRUE(length.has_value()); \
+            STF_ASSERT_EQ(n, *length); \
+            STF_ASSERT_EQ(original, decoded.Read()); \
+        } \
+    }
+
+STF_TEST(File, Codecs)
+{
+    TemporaryFile plain("plain");
+    TemporaryFile encoded("encoded");
+    TemporaryFile decoded("decoded");
+
+    VERIFY_FILE(Base16, Bases::FileEncoding::Base16);
+    VERIFY_FILE(Base32, Bases::FileEncoding::Base32);
+    VERIFY_FILE(Base64, Bases::FileEncoding::Base64);
+}
+
+STF_TEST(File, MatchesInMemoryDecoding)
+{
+    TemporaryFile encoded("encoded");
+    TemporaryFile decoded("decoded");
+    std::string text = Base64::Encode(AsOctets(RandomString(30000)));
+
+    // Padding in the middle ends decoding exactly as it does in memory
+    text[20000] = '=';
+    std::vector<std::uint8_t> expected(Base64::MaxDecodedLength(text.size()));
+    auto expected_length = Base64::Decode(text, expected);
+    STF_ASSERT_TRUE(expected_length.has_value());
+    expected.resize(*expected_length);
+    for (const auto &options : Option_Sets)
+    {
+        encoded.Write(text);
+        auto length = Bases::DecodeFile(encoded.Path(),
+                                        decoded.Path(),
+                                        Bases::FileEncoding::Base64,
+                                        options);
+        STF_ASSERT_TRUE(length.has_value());
+        STF_ASSERT_EQ(*expected_length, *length);
+        std::string result = decoded.Read();
+        STF_ASSERT_EQ(std::string(expected.begin(), expected.end()), result);
+    }
+
+    // An odd number of hexadecimal digits is an error
+    encoded.Write(std::string(10001, 'A'));
+    for (const auto &options : Option_Sets)
+    {
+        STF_ASSERT_FALSE(Bases::DecodeFile(encoded.Path(),
+                                           decoded.Path(),
+                                           Bases::FileEncoding::Base16,
+                                           options)
+                             .has_value());
+    }
+}
+
+STF_TEST(File, Errors)
+{
+    TemporaryFile missing("missing");
+    TemporaryFile output("output");
+
+    STF_ASSERT_FALSE(Bases::EncodeFile(missing.Path(),
+                                       output.Path(),
+                                       Bases::FileEncoding::Base64)
+                         .has_value());
+    STF_ASSERT_FALSE(Bases::DecodeFile(missing.Path(),
+                                       output.Path(),
+                                       Bases::FileEncoding::Base64)
+                         .has_value());
+}
+
+STF_TEST(File, ShortWrite)
+{
+    TemporaryFile plain("plain");
+    TemporaryFile encoded("encoded");
+    std::string original = RandomString(20481);
+    rlimit saved;
+
+    // A file size limit cuts the only write short, which must be reported
+    // rather than leaving a truncated file
+    plain.Write(original);
+    STF_ASSERT_EQ(0, getrlimit(RLIMIT_FSIZE, &saved));
+    auto handler = std::signal(SIGXFSZ, SIG_IGN);
+    for (bool io_uring : {true, false})
+    {
+        Bases::FileOptions options;
+        options.io_uring = io_uring;
+        rlimit limit = saved;
+        limit.rlim_cur = 20000;
+        STF_ASSERT_EQ(0, setrlimit(RLIMIT_FSIZE, &limit));
+        auto length = Bases::EncodeFile(plain.Path(),
+                                        encoded.Path(),
+                                        Bases::FileEncoding::Base64,
+                                        options);
+        STF_ASSERT_EQ(0, setrlimit(RLIMIT_FSIZE, &saved));
+        STF_ASSERT_FALSE(length.has_value());
+    }
+    std::signal(SIGXFSZ, handler);
+}
@@ -0,0 +1,201 @@
+/*
+ *  test_format.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements test logic for formatting encoded octets.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <terra/stf/stf.h>
+#include <terra/bases/base16.h>
+#include <terra/bases/base32.h>
+#include <terra/bases/base64.h>
+#include <terra/bases/format.h>
+
+using namespace Terra;
+
+namespace
+{
+
+/*
+ *  RandomOctets
+ *
+ *  Description:
+ *      Produce a vector of random octets.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The number of octets to produce.
+ *
+ *  Returns:
+ *      The random octets.
+ *
+ *  Comments:
+ *      None.
+ */
+std::vector<std::uint8_t> RandomOctets(std::size_t length)
+{
+    std::mt19937 generator(length);
+    std::uniform_int_distribution<unsigned> distribution(0, 255);
+    std::vector<std::uint8_t> octets(length);
+
+    for (auto &octet : octets) octet = distribution(generator);
+
+    return octets;
+}
+
+/*
+ *  Format
+ *
+ *  Description:
+ *      Format octets with the given format specification using FormatTo().
+ *
+ *  Parameters:
+ *      octets [in]
+ *          The octets to format.
+ *
+ *      encoding [in]
+ *          The encoding.
+ *
+ *      spec [in]
+ *          The format specification.
+ *
+ *  Returns:
+ *      The formatted string, or "<invalid>" if the specification is not
+ *      valid.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string Format(const std::vector<std::uint8_t> &octets,
+                   Bases::FanOutEncoding encoding,
+                   std::string_view spec)
+{
+    Bases::FormatSpec parsed;
+    std::string result;
+
+    if (Bases::ParseFormatSpec(spec, encoding, parsed) != spec.size())
+    {
+        return "<invalid>";
+    }
+
+    Bases::FormatTo(std::back_inserter(result), octets, encoding, parsed);
+
+    return result;
+}
+
+} // namespace
+
+STF_TEST(Format, MatchesEncoders)
+{
+    // Sizes around the block size ensure blocks are joined correctly
+    for (std::size_t n : {0, 1, 2, 3, 4, 5, 32, 239, 240, 241, 1000})
+    {
+        auto input = RandomOctets(n);
+
+        STF_ASSERT_EQ(Base16::Encode(input),
+                      Format(input, Bases::FanOutEncoding::Base16, ""));
+        STF_ASSERT_EQ(Base32::Encode(input),
+                      Format(input, Bases::FanOutEncoding::Base32, ""));
+        STF_ASSERT_EQ(Base64::Encode(input),
+                      Format(input, Bases::FanOutEncoding::Base64, ""));
+        STF_ASSERT_EQ(Base64::Encode(input, Base64::URLAlphabet()),
+                      Format(input, Bases::FanOutEncoding::Base64URL, ""));
+    }
+}
+
+STF_TEST(Format, Hexadecimal)
+{
+    std::vector<std::uint8_t> octets = {0xde, 0xad, 0xbe, 0xef, 0x01};
+
+    STF_ASSERT_EQ(std::string("DEADBEEF01"),
+                  Format(octets, Bases::FanOutEncoding::Base16, "X"));
+    STF_ASSERT_EQ(std::string("deadbeef01"),
+                  Format(octets, Bases::FanOutEncoding::Base16, "x"));
+    STF_ASSERT_EQ(std::string("de:ad:be:ef:01"),
+                  Format(octets, Bases::FanOutEncoding::Base16, "s:x"));
+    STF_ASSERT_EQ(std::string("DE_AD_BE_EF_01"),
+                  Format(octets, Bases::FanOutEncoding::Base16, "s_"));
+    STF_ASSERT_EQ(std::string("deadbeef01"),
+                  Format(octets, Bases::FanOutEncoding::Base16Lowercase, ""));
+
+    // Separators continue across blocks
+    auto input = RandomOctets(500);
+    std::string expected;
+    for (std::size_t i = 0; i < input.size(); i++)
+    {
+        if (i > 0) expected += '-';
+        expected += Base16::Encode(std::span(input).subspan(i, 1));
+    }
+    STF_ASSERT_EQ(expected,
+                  Format(input, Bases::FanOutEncoding::Base16, "s-X"));
+}
+
+STF_TEST(Format, Width)
+{
+    std::vector<std::uint8_t> octets = {0x01, 0x02};
+
+    STF_ASSERT_EQ(std::string("0102  "),
+                  Format(octets, Bases::FanOutEncoding::Base16, "6"));
+    STF_ASSERT_EQ(std::string("  0102"),
+                  Format(octets, Bases::FanOutEncoding::Base16, ">6"));
+    STF_ASSERT_EQ(std::string("*0102**"),
+                  Format(octets, Bases::FanOutEncoding::Base16, "*^7"));
+    STF_ASSERT_EQ(std::string("...01:02"),
+                  Format(octets, Bases::FanOutEncoding::Base16, ".>8s:"));
+    STF_ASSERT_EQ(std::string("AQI="),
+                  Format(octets, Bases::FanOutEncoding::Base64, "2"));
+    STF_ASSERT_EQ(std::string("  AQI"),
+                  Format(octets, Bases::FanOutEncoding::Base64URL, ">5"));
+}
+
+STF_TEST(Format, InvalidSpec)
+{
+    std::vector<std::uint8_t> octets = {0x01};
+    Bases::FormatSpec parsed;
+
+    // Only hexadecimal has a letter case and separator
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  Format(octets, Bases::FanOutEncoding::Base64, "x"));
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  Format(octets, Bases::FanOutEncoding::Base32, "s:"));
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  Format(octets, Bases::FanOutEncoding::Base16, "s"));
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  Format(octets, Bases::FanOutEncoding::Base16, "d"));
+
+    // Parsing stops at the closing brace
+    STF_ASSERT_EQ(std::size_t(3),
+                  Bases::ParseFormatSpec(">4x}rest",
+                                         Bases::FanOutEncoding::Base16,
+                                         parsed));
+    STF_ASSERT_EQ(std::size_t(4), parsed.width);
+    STF_ASSERT_TRUE(parsed.lowercase);
+}
+
+STF_TEST(Format, Stream)
+{
+    std::vector<std::uint8_t> octets = {0xfb, 0xff};
+    std::ostringstream stream;
+
+    stream << Bases::AsHex(octets) << ' ' << Bases::AsBase64(octets) << ' '
+           << Bases::AsBase64URL(octets) << ' ' << Bases::AsBase32(octets);
+
+    STF_ASSERT_EQ(std::string("FBFF +/8= -_8 7P7Q===="), stream.str());
+}
@@ -0,0 +1,1225 @@
+/*
+ *  fuzz_bases.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements differential fuzzing of the Base-N codecs.  Each
+ *      implementation tier exposed by the library (the allocating functions,
+ *      the span-output functions, the alphabet-driven functions, and the C
+ *      interface) is compared against simple reference implementations that
+ *      are written independently of the library code.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <terra/bases/base16.h>
+#include <terra/bases/base32.h>
+#include <terra/bases/base45.h>
+#include <terra/bases/base58.h>
+#include <terra/bases/base64.h>
+#include <terra/bases/bases_c.h>
+#include <terra/bases/tuning.h>
+#include "fuzz_bases.h"
+
+using namespace Terra;
+
+namespace
+{
+
+using Octets = std::vector<std::uint8_t>;
+using DecodeResult = std::optional<Octets>;
+
+// Alphabets used by the reference implementations
+constexpr std::string_view Base16_Alphabet = "0123456789ABCDEF";
+constexpr std::string_view Base32_Alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+constexpr std::string_view Base45_Alphabet =
+    "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+constexpr std::string_view Base58_Alphabet =
+    "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+constexpr std::string_view Base64_Alphabet =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/*
+ *  Fail
+ *
+ *  Description:
+ *      Report a mismatch and abort so the fuzzer records the input.
+ *
+ *  Parameters:
+ *      codec [in]
+ *          Name of the codec being tested.
+ *
+ *      tier [in]
+ *          Name of the implementation tier that failed.
+ *
+ *      what [in]
+ *          Description of the failed check.
+ *
+ *  Returns:
+ *      Does not return.
+ *
+ *  Comments:
+ *      None.
+ */
+[[noreturn]] void Fail(std::string_view codec,
+                       std::string_view tier,
+                       std::string_view what)
+{
+    std::fprintf(stderr,
+                 "Mismatch in %.*s (%.*s): %.*s\n",
+                 static_cast<int>(codec.size()), codec.data(),
+                 static_cast<int>(tier.size()), tier.data(),
+                 static_cast<int>(what.size()), what.data());
+    std::abort();
+}
+
+/*
+ *  Position
+ *
+ *  Description:
+ *      Return the position of c in the alphabet, optionally ignoring case.
+ *
+ *  Parameters:
+ *      alphabet [in]
+ *          The alphabet to search.
+ *
+ *      c [in]
+ *          The character to find.
+ *
+ *      ignore_case [in]
+ *          True if the search should be case insensitive.
+ *
+ *  Returns:
+ *      The position of the character or std::string_view::npos.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Position(std::string_view alphabet, char c, bool ignore_case)
+{
+    if (ignore_case && (c >= 'a') && (c <= 'z')) c = static_cast<char>(c - 32);
+
+    return alphabet.find(c);
+}
+
+// Reference encoders and decoders; each is written for clarity, following
+// the relevant specification and the documented leniency of the library
+std::string ReferenceEncode16(std::span<const std::uint8_t> input)
+{
+    std::string output;
+
+    for (auto octet : input)
+    {
+        output += Base16_Alphabet[octet / 16];
+        output += Base16_Alphabet[octet % 16];
+    }
+
+    return output;
+}
+
+DecodeResult ReferenceDecode16(std::string_view input)
+{
+    std::vector<unsigned> digits;
+    Octets output;
+
+    for (char c : input)
+    {
+        auto p = Position(Base16_Alphabet, c, true);
+        if (p != std::string_view::npos) digits.push_back(unsigned(p));
+    }
+
+    if (digits.size() % 2 != 0) return {};
+
+    for (std::size_t i = 0; i < digits.size(); i += 2)
+    {
+        output.push_back(std::uint8_t(digits[i] * 16 + digits[i + 1]));
+    }
+
+    return output;
+}
+
+std::string ReferenceEncodeBits(std::span<const std::uint8_t> input,
+                                std::string_view alphabet,
+                                unsigned bits_per_character,
+                                std::size_t characters_per_quantum,
+                                bool padding)
+{
+    std::vector<bool> bits;
+    std::string output;
+
+    for (auto octet : input)
+    {
+        for (int i = 7; i >= 0; i--) bits.push_back((octet >> i) & 1);
+    }
+
+    // Pad the bit string with zeros to a multiple of the character width
+    while (bits.size() % bits_per_character != 0) bits.push_back(false);
+
+    for (std::size_t i = 0; i < bits.size(); i += bits_per_character)
+    {
+        unsigned value = 0;
+        for (unsigned j = 0; j < bits_per_character; j++)
+        {
+            value = (value << 1) | (bits[i + j] ? 1 : 0);
+        }
+        output += alphabet[value];
+    }
+
+    while (padding && (output.size() % characters_per_quantum != 0))
+    {
+        output += '=';
+    }
+
+    return output;
+}
+
+std::string ReferenceEncode32(std::span<const std::uint8_t> input)
+{
+    return ReferenceEncodeBits(input, Base32_Alphabet, 5, 8, true);
+}
+
+DecodeResult ReferenceDecode32(std::string_view input)
+{
+    std::vector<bool> bits;
+    Octets output;
+
+    for (char c : input)
+    {
+        if (c == '=') break;
+        auto p = Position(Base32_Alphabet, c, true);
+        if (p == std::string_view::npos) continue;
+        for (int i = 4; i >= 0; i--) bits.push_back((p >> i) & 1);
+    }
+
+    std::size_t i = 0;
+    for (; i + 8 <= bits.size(); i += 8)
+    {
+        unsigned value = 0;
+        for (std::size_t j = 0; j < 8; j++) value = (value << 1) | bits[i + j];
+        output.push_back(std::uint8_t(value));
+    }
+
+    // Residual bits must all be zero
+    for (; i < bits.size(); i++) if (bits[i]) return {};
+
+    return output;
+}
+
+std::string ReferenceEncode45(std::span<const std::uint8_t> input)
+{
+    std::string output;
+
+    for (std::size_t i = 0; i < input.size(); i += 2)
+    {
+        if (i + 1 < input.size())
+        {
+            unsigned value = input[i] * 256u + input[i + 1];
+            output += Base45_Alphabet[value % 45];
+            output += Base45_Alphabet[(value / 45) % 45];
+            output += Base45_Alphabet[value / 2025];
+        }
+        else
+        {
+            output += Base45_Alphabet[input[i] % 45];
+            output += Base45_Alphabet[input[i] / 45];
+        }
+    }
+
+    return output;
+}
+
+DecodeResult ReferenceDecode45(std::string_view input)
+{
+    std::vector<unsigned> digits;
+    Octets output;
+
+    for (char c : input)
+    {
+        auto p = Position(Base45_Alphabet, c, false);
+        if (p != std::string_view::npos) digits.push_back(unsigned(p));
+    }
+
+    if (digits.size() % 3 == 1) return {};
+
+    for (std::size_t i = 0; i < digits.size(); i += 3)
+    {
+        if (i + 2 < digits.size())
+        {
+            // Values above 65535 are not rejected by the library; only the
+            // low 16 bits are used
+            unsigned value = digits[i] + digits[i + 1] * 45 +
+                             digits[i + 2] * 2025;
+            output.push_back(std::uint8_t((value >> 8) & 0xff));
+            output.push_back(std::uint8_t(value & 0xff));
+        }
+        else
+        {
+            output.push_back(std::uint8_t((digits[i] + digits[i + 1] * 45)));
+        }
+    }
+
+    return output;
+}
+
+std::string ReferenceEncode58(std::span<const std::uint8_t> input)
+{
+    // Represent the number as big-endian base-256, repeatedly divide by 58
+    Octets number(input.begin(), input.end());
+    std::string output;
+    std::size_t zeros = 0;
+
+    while ((zeros < number.size()) && (number[zeros] == 0)) zeros++;
+
+    while (std::any_of(number.begin(), number.end(),
+                       [](auto v) { return v != 0; }))
+    {
+        unsigned remainder = 0;
+        for (auto &digit : number)
+        {
+            unsigned value = remainder * 256 + digit;
+            digit = std::uint8_t(value / 58);
+            remainder = value % 58;
+        }
+        output += Base58_Alphabet[remainder];
+    }
+
+    output.append(zeros, '1');
+    std::reverse(output.begin(), output.end());
+
+    return output;
+}
+
+DecodeResult ReferenceDecode58(std::string_view input)
+{
+    std::string text;
+    Octets number;
+    std::size_t zeros = 0;
+
+    for (char c : input)
+    {
+        if (std::isspace(static_cast<unsigned char>(c)) == 0) text += c;
+    }
+
+    while ((zeros < text.size()) && (text[zeros] == '1')) zeros++;
+
+    for (std::size_t i = zeros; i < text.size(); i++)
+    {
+        auto p = Position(Base58_Alphabet, text[i], false);
+        if (p == std::string_view::npos) return {};
+
+        // Multiply the big-endian number by 58 and add the digit
+        unsigned carry = unsigned(p);
+        for (auto it = number.rbegin(); it != number.rend(); ++it)
+        {
+            unsigned value = *it * 58u + carry;
+            *it = std::uint8_t(value & 0xff);
+            carry = value >> 8;
+        }
+        while (carry > 0)
+        {
+            number.insert(number.begin(), std::uint8_t(carry & 0xff));
+            carry >>= 8;
+        }
+    }
+
+    number.insert(number.begin(), zeros, 0);
+
+    return number;
+}
+
+std::string ReferenceEncode64(std::span<const std::uint8_t> input)
+{
+    return ReferenceEncodeBits(input, Base64_Alphabet, 6, 4, true);
+}
+
+DecodeResult ReferenceDecode64(std::string_view input)
+{
+    std::vector<bool> bits;
+    Octets output;
+
+    for (char c : input)
+    {
+        if (c == '=') break;
+        auto p = Position(Base64_Alphabet, c, false);
+        if (p == std::string_view::npos) continue;
+        for (int i = 5; i >= 0; i--) bits.push_back((p >> i) & 1);
+    }
+
+    // Residual bits are discarded, except that a lone residual character
+    // (6 bits) is emitted as an octet as the library does
+    if ((bits.size() % 24) == 6)
+    {
+        bits.push_back(false);
+        bits.push_back(false);
+    }
+
+    for (std::size_t i = 0; i + 8 <= bits.size(); i += 8)
+    {
+        unsigned value = 0;
+        for (std::size_t j = 0; j < 8; j++) value = (value << 1) | bits[i + j];
+        output.push_back(std::uint8_t(value));
+    }
+
+    return output;
+}
+
+// Names of the kernels that may be selected for tunable codecs
+constexpr std::string_view Kernels[] = {"scalar", "block", "small", "simd"};
+
+// An implementation tier of a codec under test
+struct Tier
+{
+    std::string_view name;
+    std::function<std::string(std::span<const std::uint8_t>)> encode;
+    std::function<DecodeResult(std::string_view)> decode;
+    bool reports_errors;                // False if errors yield empty output
+};
+
+// A codec under test along with its reference implementation
+struct Codec
+{
+    std::string_view name;
+    std::string_view alphabet;
+    std::string_view ignored;           // Characters the decoder skips
+    std::size_t encode_quantum;         // Octets per independent group
+    std::size_t decode_quantum;         // Characters per independent group
+    std::function<std::string(std::span<const std::uint8_t>)> encode;
+    std::function<DecodeResult(std::string_view)> decode;
+    std::vector<Tier> tiers;
+    std::function<std::optional<std::size_t>(std::string_view, bool)>
+        validate;                       // IsValid(), strict if true
+};
+
+/*
+ *  MakeTiers
+ *
+ *  Description:
+ *      Create the implementation tiers common to all codecs.
+ *
+ *  Parameters:
+ *      encode_vector [in]
+ *          Allocating encode function.
+ *
+ *      decode_vector [in]
+ *          Allocating decode function.
+ *
+ *      encode_span [in]
+ *          Span-output encode function.
+ *
+ *      decode_span [in]
+ *          Span-output decode function.
+ *
+ *      max_encoded [in]
+ *          Function returning the maximum encoded length.
+ *
+ *      max_decoded [in]
+ *          Function returning the maximum decoded length.
+ *
+ *      encode_c [in]
+ *          C interface encode function.
+ *
+ *      decode_c [in]
+ *          C interface decode function.
+ *
+ *  Returns:
+ *      The vector of tiers.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename EV, typename DV, typename ES, typename DS, typename ML,
+         typename DL>
+std::vector<Tier> MakeTiers(EV encode_vector,
+                            DV decode_vector,
+                            ES encode_span,
+                            DS decode_span,
+                            ML max_encoded,
+                            DL max_decoded,
+                            int (*encode_c)(const uint8_t *, size_t, char *,
+                                            size_t *),
+                            int (*decode_c)(const char *, size_t, uint8_t *,
+                                            size_t *))
+{
+    std::vector<Tier> tiers;
+
+    tiers.push_back({
+        "vector",
+        [=](std::span<const std::uint8_t> input)
+        {
+            return encode_vector(input);
+        },
+        [=](std::string_view input) -> DecodeResult
+        {
+            return decode_vector(input);
+        },
+        false});
+
+    tiers.push_back({
+        "span",
+        [=](std::span<const std::uint8_t> input)
+        {
+            std::string output(max_encoded(input.size()), '\0');
+            output.resize(encode_span(input, std::span<char>(output)));
+            return output;
+        },
+        [=](std::string_view input) -> DecodeResult
+        {
+            Octets output(max_decoded(input.size()));
+            auto length = decode_span(input, std::span<std::uint8_t>(output));
+            if (!length) return {};
+            output.resize(*length);
+            return output;
+        },
+        true});
+
+    tiers.push_back({
+        "c",
+        [=](std::span<const std::uint8_t> input)
+        {
+            std::size_t length = 0;
+            encode_c(input.data(), input.size(), nullptr, &length);
+            std::string output(length, '\0');
+            if (encode_c(input.data(), input.size(), output.data(), &length) !=
+                BASES_OK)
+            {
+                return std::string("<error>");
+            }
+            output.resize(length);
+            return output;
+        },
+        [=](std::string_view input) -> DecodeResult
+        {
+            std::size_t length = 0;
+            decode_c(input.data(), input.size(), nullptr, &length);
+            Octets output(length);
+            if (decode_c(input.data(), input.size(), output.data(), &length) !=
+                BASES_OK)
+            {
+                return {};
+            }
+            output.resize(length);
+            return output;
+        },
+        true});
+
+    return tiers;
+}
+
+/*
+ *  Codecs
+ *
+ *  Description:
+ *      Return the list of codecs under test.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A reference to the list of codecs.
+ *
+ *  Comments:
+ *      None.
+ */
+const std::vector<Codec> &Codecs()
+{
+    static const std::vector<Codec> codecs = []()
+    {
+        std::vector<Codec> list;
+
+        list.push_back({
+            "Base16", Base16_Alphabet, " \t\r\n-:", 1, 2,
+            ReferenceEncode16, ReferenceDecode16,
+            MakeTiers(
+                [](auto in) { return Base16::Encode(in); },
+                [](auto in) { return Base16::Decode(in); },
+                [](auto in, auto out) { return Base16::Encode(in, out); },
+                [](auto in, auto out) { return Base16::Decode(in, out); },
+                Base16::MaxEncodedLength,
+                Base16::MaxDecodedLength,
+                bases_base16_encode,
+                bases_base16_decode),
+            [](std::string_view in, bool strict)
+            {
+                return Base16::IsValid(in,
+                                       strict ? Base16::Mode::Strict :
+                                                Base16::Mode::Lenient);
+            }});
+
+        list.push_back({
+            "Base32", Base32_Alphabet, " \t\r\n", 5, 8,
+            ReferenceEncode32, ReferenceDecode32,
+            MakeTiers(
+                [](auto in) { return Base32::Encode(in); },
+                [](auto in) { return Base32::Decode(in); },
+                [](auto in, auto out) { return Base32::Encode(in, out); },
+                [](auto in, auto out) { return Base32::Decode(in, out); },
+                Base32::MaxEncodedLength,
+                Base32::MaxDecodedLength,
+                bases_base32_encode,
+                bases_base32_decode),
+            [](std::string_view in, bool strict)
+            {
+                return Base32::IsValid(in,
+                                       strict ? Base32::Mode::Strict :
+                                                Base32::Mode::Lenient);
+            }});
+
+        list.push_back({
+            "Base45", Base45_Alphabet, "\t\r\n", 2, 3,
+            ReferenceEncode45, ReferenceDecode45,
+            MakeTiers(
+                [](auto in) { return Base45::Encode(in); },
+                [](auto in) { return Base45::Decode(in); },
+                [](auto in, auto out) { return Base45::Encode(in, out); },
+                [](auto in, auto out) { return Base45::Decode(in, out); },
+                Base45::MaxEncodedLength,
+                Base45::MaxDecodedLength,
+                bases_base45_encode,
+                bases_base45_decode),
+            [](std::string_view in, bool strict)
+            {
+                return Base45::IsValid(in,
+                                       strict ? Base45::Mode::Strict :
+                                                Base45::Mode::Lenient);
+            }});
+
+        list.push_back({
+            "Base58", Base58_Alphabet, " \t\r\n", 0, 0,
+            ReferenceEncode58, ReferenceDecode58,
+            MakeTiers(
+                [](auto in) { return Base58::Encode(in); },
+                [](auto in) { return Base58::Decode(in); },
+                [](auto in, auto out) { return Base58::Encode(in, out); },
+                [](auto in, auto out) { return Base58::Decode(in, out); },
+                Base58::MaxEncodedLength,
+                Base58::MaxDecodedLength,
+                bases_base58_encode,
+                bases_base58_decode),
+            [](std::string_view in, bool strict)
+            {
+                return Base58::IsValid(in,
+                                       strict ? Base58::Mode::Strict :
+                                                Base58::Mode::Lenient);
+            }});
+
+        list.push_back({
+            "Base64", Base64_Alphabet, " \t\r\n", 3, 4,
+            ReferenceEncode64, ReferenceDecode64,
+            MakeTiers(
+                [](auto in) { return Base64::Encode(in); },
+                [](auto in) { return Base64::Decode(in); },
+                [](auto in, auto out) { return Base64::Encode(in, out); },
+                [](auto in, auto out) { return Base64::Decode(in, out); },
+                Base64::MaxEncodedLength,
+                Base64::MaxDecodedLength,
+                bases_base64_encode,
+                bases_base64_decode),
+            [](std::string_view in, bool strict)
+            {
+                return Base64::IsValid(in,
+                                       strict ? Base64::Mode::Strict :
+                                                Base64::Mode::Lenient);
+            }});
+
+        // The alphabet-driven path with the standard alphabet must match
+        list.back().tiers.push_back({
+            "alphabet",
+            [](std::span<const std::uint8_t> input)
+            {
+                return Base64::Encode(input, Base64::StandardAlphabet());
+            },
+            [](std::string_view input) -> DecodeResult
+            {
+                Octets output(Base64::MaxDecodedLength(input.size()));
+                auto length =
+                    Base64::Decode(input, output, Base64::StandardAlphabet());
+                if (!length) return {};
+                output.resize(*length);
+                return output;
+            },
+            true});
+
+        return list;
+    }();
+
+    return codecs;
+}
+
+/*
+ *  CompareDecode
+ *
+ *  Description:
+ *      Compare the decoded result of a tier against the expected result.
+ *
+ *  Parameters:
+ *      codec [in]
+ *          The codec under test.
+ *
+ *      tier [in]
+ *          The tier under test.
+ *
+ *      input [in]
+ *          Text to decode.
+ *
+ *      expected [in]
+ *          The expected result.
+ *
+ *      what [in]
+ *          Description of the check for reporting.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void CompareDecode(const Codec &codec,
+                   const Tier &tier,
+                   std::string_view input,
+                   const DecodeResult &expected,
+                   std::string_view what)
+{
+    DecodeResult actual = tier.decode(input);
+
+    if (tier.reports_errors)
+    {
+        if (actual != expected) Fail(codec.name, tier.name, what);
+    }
+    else
+    {
+        if (actual.value_or(Octets{}) != expected.value_or(Octets{}))
+        {
+            Fail(codec.name, tier.name, what);
+        }
+    }
+}
+
+/*
+ *  CheckValidate
+ *
+ *  Description:
+ *      Verify the codec's validation function against a decoding result.
+ *
+ *  Parameters:
+ *      codec [in]
+ *          The codec under test.
+ *
+ *      input [in]
+ *          Text to validate.
+ *
+ *      expected [in]
+ *          The reference decoding of the text.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Lenient validation must accept exactly what decoding accepts, and
+ *      anything accepted by strict validation must also decode.
+ */
+void CheckValidate(const Codec &codec,
+                   std::string_view input,
+                   const DecodeResult &expected)
+{
+    auto lenient = codec.validate(input, false);
+    auto strict = codec.validate(input, true);
+
+    if (lenient.has_value() != expected.has_value() ||
+        (expected && (*lenient != expected->size())))
+    {
+        Fail(codec.name, "validate", "lenient");
+    }
+    if (strict && (strict != lenient)) Fail(codec.name, "validate", "strict");
+}
+
+/*
+ *  CheckCanonical
+ *
+ *  Description:
+ *      Verify that the codec's validation function accepts canonical text.
+ *
+ *  Parameters:
+ *      codec [in]
+ *          The codec under test.
+ *
+ *      input [in]
+ *          Canonically encoded text.
+ *
+ *      length [in]
+ *          The number of octets the text encodes.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void CheckCanonical(const Codec &codec,
+                    std::string_view input,
+                    std::size_t length)
+{
+    if ((codec.validate(input, true) != length) ||
+        (codec.validate(input, false) != length))
+    {
+        Fail(codec.name, "validate", "canonical");
+    }
+}
+
+/*
+ *  CheckCodec
+ *
+ *  Description:
+ *      Perform all differential checks for one codec.
+ *
+ *  Parameters:
+ *      codec [in]
+ *          The codec under test.
+ *
+ *      payload [in]
+ *          Fuzzer-provided data.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void CheckCodec(const Codec &codec, std::span<const std::uint8_t> payload)
+{
+    // Encode the payload with the reference and with every tier
+    std::string encoded = codec.encode(payload);
+    for (const auto &tier : codec.tiers)
+    {
+        if (tier.encode(payload) != encoded)
+        {
+            Fail(codec.name, tier.name, "encode");
+        }
+
+        // Round-trip decoding must yield the original payload
+        CompareDecode(codec,
+                      tier,
+                      encoded,
+                      Octets(payload.begin(), payload.end()),
+                      "round trip");
+    }
+
+    // Inject ignored characters at positions selected by the payload
+    if (!payload.empty())
+    {
+        std::string spaced;
+        std::size_t selector = 0;
+        for (std::size_t i = 0; i < encoded.size(); i++)
+        {
+            std::uint8_t octet = payload[selector++ % payload.size()];
+            if ((octet & 0x07) == 0)
+            {
+                spaced += codec.ignored[octet % codec.ignored.size()];
+            }
+            spaced += encoded[i];
+        }
+        spaced += codec.ignored[0];
+
+        for (const auto &tier : codec.tiers)
+        {
+            CompareDecode(codec,
+                          tier,
+                          spaced,
+                          Octets(payload.begin(), payload.end()),
+                          "whitespace");
+        }
+    }
+
+    // Encoding chunks split on quantum boundaries must match the whole
+    if (codec.encode_quantum > 0)
+    {
+        std::string joined;
+        Octets chunk_decoded;
+        std::size_t offset = 0;
+        std::size_t selector = 0;
+        while (offset < payload.size())
+        {
+            std::size_t groups = 1 + (payload[selector++] % 8);
+            std::size_t length = std::min(groups * codec.encode_quantum,
+                                          payload.size() - offset);
+            auto chunk = payload.subspan(offset, length);
+            std::string chunk_encoded = codec.tiers[1].encode(chunk);
+            joined += chunk_encoded;
+            offset += length;
+        }
+        if (joined != encoded) Fail(codec.name, "span", "chunked encode");
+
+        // Decoding text split on quantum boundaries must match the whole
+        offset = 0;
+        while (offset < encoded.size())
+        {
+            std::size_t groups = 1 + (payload[selector++ % payload.size()] % 8);
+            std::size_t length = std::min(groups * codec.decode_quantum,
+                                          encoded.size() - offset);
+            auto decoded = codec.tiers[1].decode(
+                std::string_view(encoded).substr(offset, length));
+            if (!decoded) Fail(codec.name, "span", "chunked decode error");
+            chunk_decoded.insert(chunk_decoded.end(),
+                                 decoded->begin(),
+                                 decoded->end());
+            offset += length;
+        }
+        if (chunk_decoded != Octets(payload.begin(), payload.end()))
+        {
+            Fail(codec.name, "span", "chunked decode");
+        }
+    }
+
+    // Decode the payload as raw text and as text drawn mostly from the
+    // alphabet; every tier must agree with the reference, including errors
+    std::string raw(payload.begin(), payload.end());
+    std::string text;
+    for (auto octet : payload)
+    {
+        if (octet < 0xf0)
+        {
+            text += codec.alphabet[octet % codec.alphabet.size()];
+        }
+        else if (octet < 0xfc)
+        {
+            text += codec.ignored[octet % codec.ignored.size()];
+        }
+        else
+        {
+            text += (octet == 0xfc) ? '=' : char(octet);
+        }
+    }
+    DecodeResult raw_expected = codec.decode(raw);
+    DecodeResult text_expected = codec.decode(text);
+    for (const auto &tier : codec.tiers)
+    {
+        CompareDecode(codec, tier, raw, raw_expected, "raw text");
+        CompareDecode(codec, tier, text, text_expected, "alphabet text");
+    }
+
+    // Validation must agree with decoding, and canonical text is strict
+    CheckCanonical(codec, encoded, payload.size());
+    CheckValidate(codec, raw, raw_expected);
+    CheckValidate(codec, text, text_expected);
+}
+
+/*
+ *  CheckAlphabets
+ *
+ *  Description:
+ *      Verify the alternative Base64 alphabets against a translation of the
+ *      reference encoding, or a direct encoding for alphabets that assign
+ *      bits least significant first.
+ *
+ *  Parameters:
+ *      payload [in]
+ *          Fuzzer-provided data.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void CheckAlphabets(std::span<const std::uint8_t> payload)
+{
+    std::string standard = ReferenceEncodeBits(payload, Base64_Alphabet, 6, 4,
+                                               false);
+
+    for (const Base64::Alphabet *alphabet : {&Base64::URLAlphabet(),
+                                             &Base64::BcryptAlphabet(),
+                                             &Base64::CryptAlphabet(),
+                                             &Base64::IMAPAlphabet()})
+    {
+        std::string expected;
+        if (alphabet->Order() == Base64::BitOrder::MostSignificantFirst)
+        {
+            expected = standard;
+            for (auto &c : expected)
+            {
+                c = alphabet->Character(
+                    std::uint8_t(Base64_Alphabet.find(c)));
+            }
+        }
+        else
+        {
+            // Each group is a little-endian value emitted low bits first
+            for (std::size_t i = 0; i < payload.size(); i += 3)
+            {
+                std::size_t count = std::min<std::size_t>(3,
+                                                          payload.size() - i);
+                std::uint32_t group = 0;
+                for (std::size_t j = 0; j < count; j++)
+                {
+                    group |= std::uint32_t(payload[i + j]) << (8 * j);
+                }
+                for (std::size_t j = 0; j <= count; j++)
+                {
+                    expected += alphabet->Character((group >> (6 * j)) & 0x3f);
+                }
+            }
+        }
+
+        std::string encoded = Base64::Encode(payload, *alphabet);
+        if (encoded != expected) Fail("Base64", "alphabet", "encode");
+
+        if (Base64::Decode(encoded, *alphabet) !=
+            Octets(payload.begin(), payload.end()))
+        {
+            Fail("Base64", "alphabet", "round trip");
+        }
+    }
+
+    // The tolerant alphabet decodes a mix of standard and base64url text
+    std::string mixed = ReferenceEncode64(payload);
+    for (std::size_t i = 0; i < mixed.size(); i++)
+    {
+        if ((payload[i % payload.size()] & 0x01) == 0) continue;
+        if (mixed[i] == '+') mixed[i] = '-';
+        if (mixed[i] == '/') mixed[i] = '_';
+    }
+    if (Base64::Decode(mixed, Base64::TolerantAlphabet()) !=
+        Octets(payload.begin(), payload.end()))
+    {
+        Fail("Base64", "tolerant", "mixed alphabets");
+    }
+}
+
+/*
+ *  ReferenceForgiving64
+ *
+ *  Description:
+ *      Decode text using the WHATWG forgiving-base64 algorithm as specified.
+ *
+ *  Parameters:
+ *      input [in]
+ *          Text to decode.
+ *
+ *  Returns:
+ *      The decoded octets, or std::nullopt if the algorithm fails.
+ *
+ *  Comments:
+ *      None.
+ */
+DecodeResult ReferenceForgiving64(std::string_view input)
+{
+    std::string data;
+
+    // Remove all ASCII whitespace
+    for (char c : input)
+    {
+        if (std::string_view(" \t\n\f\r").find(c) == std::string_view::npos)
+        {
+            data += c;
+        }
+    }
+
+    // Remove one or two padding characters completing the final quantum
+    if ((data.size() % 4) == 0)
+    {
+        if (data.ends_with("==")) data.resize(data.size() - 2);
+        else if (data.ends_with('=')) data.resize(data.size() - 1);
+    }
+
+    if ((data.size() % 4) == 1) return {};
+
+    for (char c : data)
+    {
+        if (Position(Base64_Alphabet, c, false) == std::string_view::npos)
+        {
+            return {};
+        }
+    }
+
+    return ReferenceDecode64(data);
+}
+
+/*
+ *  CheckForgiving
+ *
+ *  Description:
+ *      Verify Base64 decoding and validation under the forgiving-base64
+ *      rules against the reference algorithm.
+ *
+ *  Parameters:
+ *      payload [in]
+ *          Fuzzer-provided data.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void CheckForgiving(std::span<const std::uint8_t> payload)
+{
+    constexpr std::string_view Whitespace = " \t\n\f\r\v";
+    std::string encoded = ReferenceEncode64(payload);
+    std::string spaced;
+    std::string text;
+
+    // Encoded text with whitespace anywhere, including within the padding
+    for (std::size_t i = 0; i < encoded.size(); i++)
+    {
+        std::uint8_t octet = payload[i % payload.size()];
+        if ((octet & 0x07) == 0) spaced += Whitespace[octet % 5];
+        spaced += encoded[i];
+    }
+
+    // Text drawn mostly from the alphabet, with occasional padding and
+    // characters that are not permitted (e.g., vertical tab)
+    for (auto octet : payload)
+    {
+        if (octet < 0xe0) text += Base64_Alphabet[octet % 64];
+        else if (octet < 0xfc) text += Whitespace[octet % Whitespace.size()];
+        else text += (octet == 0xfc) ? '-' : '=';
+    }
+
+    for (const std::string &input : {encoded, spaced, text})
+    {
+        DecodeResult expected = ReferenceForgiving64(input);
+        Octets output(Base64::MaxDecodedLength(input.size()));
+        auto length = Base64::Decode(input, output, Base64::Mode::Forgiving);
+
+        if (length) output.resize(*length);
+        if ((length.has_value() != expected.has_value()) ||
+            (expected && (output != *expected)))
+        {
+            Fail("Base64", "forgiving", "decode");
+        }
+        if (Base64::IsValid(input, Base64::Mode::Forgiving) != length)
+        {
+            Fail("Base64", "forgiving", "validate");
+        }
+    }
+}
+
+} // namespace
+
+/*
+ *  SelectKernel
+ *
+ *  Description:
+ *      Use the named kernel for all of the codec's operations.
+ *
+ *  Parameters:
+ *      codec [in]
+ *          The codec whose kernels to select.
+ *
+ *      kernel [in]
+ *          Name of the kernel.
+ *
+ *  Returns:
+ *      True if the kernel was selected, false if the codec does not have a
+ *      kernel having that name.
+ *
+ *  Comments:
+ *      None.
+ */
+bool SelectKernel(const Codec &codec, std::string_view kernel)
+{
+    std::string name(codec.name);
+    std::string configuration = "bases-tuning/1";
+
+    std::transform(name.begin(),
+                   name.end(),
+                   name.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+
+    for (const char *operation : {".encode", ".decode"})
+    {
+        for (const char *size_class : {".small=", ".large="})
+        {
+            configuration += ";" + name + operation + size_class;
+            configuration += kernel;
+        }
+    }
+
+    return Terra::Bases::ImportTuning(configuration);
+}
+
+/*
+ *  FuzzBases
+ *
+ *  Description:
+ *      Exercise every codec implementation with the given input, comparing
+ *      the results against the reference implementations.
+ *
+ *  Parameters:
+ *      data [in]
+ *          Fuzzer-provided input data.
+ *
+ *      size [in]
+ *          Length of the input data.
+ *
+ *  Returns:
+ *      Nothing.  A mismatch is reported on stderr and the process aborts.
+ *
+ *  Comments:
+ *      None.
+ */
+void FuzzBases(const std::uint8_t *data, std::size_t size)
+{
+    if (size == 0) return;
+
+    const auto &codecs = Codecs();
+    std::span<const std::uint8_t> payload(data + 1, size - 1);
+
+    // Base58 is quadratic, so limit its input length to keep runs fast
+    const Codec &codec = codecs[data[0] % codecs.size()];
+    if ((codec.name == "Base58") && (payload.size() > 256))
+    {
+        payload = payload.first(256);
+    }
+
+    // Check the codec with each kernel it has, or once if it has no kernels
+    bool checked = false;
+    for (std::string_view kernel : Kernels)
+    {
+        if (!SelectKernel(codec, kernel)) continue;
+
+        CheckCodec(codec, payload);
+        if (codec.name == "Base64")
+        {
+            CheckAlphabets(payload);
+            if (!payload.empty()) CheckForgiving(payload);
+        }
+        checked = true;
+    }
+    Terra::Bases::ResetTuning();
+
+    if (!checked)
+    {
+        CheckCodec(codec, payload);
+        if (codec.name == "Base64")
+        {
+            CheckAlphabets(payload);
+            if (!payload.empty()) CheckForgiving(payload);
+        }
+    }
+}
+
+#ifdef BASES_LIBFUZZER
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    FuzzBases(data, size);
+
+    return 0;
+}
+#endif
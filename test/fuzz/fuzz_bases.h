@@ -0,0 +1,46 @@
+/*
+ *  fuzz_bases.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the entry point for the differential fuzzing logic
+ *      that is shared by the libFuzzer target and the standalone driver.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ *  FuzzBases
+ *
+ *  Description:
+ *      Exercise every codec implementation with the given input, comparing
+ *      the results against the reference implementations.
+ *
+ *  Parameters:
+ *      data [in]
+ *          Fuzzer-provided input data.
+ *
+ *      size [in]
+ *          Length of the input data.
+ *
+ *  Returns:
+ *      Nothing.  A mismatch is reported on stderr and the process aborts.
+ *
+ *  Comments:
+ *      The first octet of the input selects the codec; the remaining octets
+ *      are used as data to encode, as text to decode, and as parameters for
+ *      whitespace injection and chunk splitting.
+ */
+void FuzzBases(const std::uint8_t *data, std::size_t size);
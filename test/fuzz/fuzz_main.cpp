@@ -0,0 +1,102 @@
+/*
+ *  fuzz_main.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements a standalone driver for the differential fuzzing
+ *      logic.  It generates pseudo-random inputs from a fixed seed so that
+ *      runs are reproducible, or replays input files given on the command
+ *      line (e.g., crash files produced by libFuzzer).
+ *
+ *      Usage: fuzz_bases [-iterations=N] [-seed=S] [file ...]
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "fuzz_bases.h"
+
+int main(int argc, char *argv[])
+{
+    unsigned long iterations = 10000;           // Number of random inputs
+    unsigned long seed = 1;                     // PRNG seed
+    std::vector<std::string> files;             // Input files to replay
+
+    // Parse the command-line arguments
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view argument = argv[i];
+
+        if (argument.starts_with("-iterations="))
+        {
+            iterations = std::strtoul(argv[i] + 12, nullptr, 10);
+        }
+        else if (argument.starts_with("-seed="))
+        {
+            seed = std::strtoul(argv[i] + 6, nullptr, 10);
+        }
+        else
+        {
+            files.emplace_back(argument);
+        }
+    }
+
+    // If files were given, replay each of them
+    if (!files.empty())
+    {
+        for (const auto &file : files)
+        {
+            std::ifstream stream(file, std::ios::binary);
+            if (!stream)
+            {
+                std::cerr << "Unable to open " << file << std::endl;
+                return EXIT_FAILURE;
+            }
+            std::vector<std::uint8_t> data(
+                (std::istreambuf_iterator<char>(stream)),
+                std::istreambuf_iterator<char>());
+            FuzzBases(data.data(), data.size());
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    std::mt19937_64 generator(seed);
+    std::uniform_int_distribution<unsigned> random_octet(0, 255);
+    std::vector<std::uint8_t> data;
+
+    for (unsigned long i = 0; i < iterations; i++)
+    {
+        // Favor short inputs, but occasionally produce longer ones
+        std::size_t length = (i % 16 == 0) ? (generator() % 2048)
+                                           : (generator() % 96);
+
+        data.resize(length);
+        for (auto &octet : data) octet = random_octet(generator);
+
+        // Cycle through each codec selector deterministically
+        if (!data.empty()) data[0] = static_cast<std::uint8_t>(i);
+
+        FuzzBases(data.data(), data.size());
+    }
+
+    std::cout << "Completed " << iterations << " iterations (seed " << seed
+              << ")" << std::endl;
+
+    return EXIT_SUCCESS;
+}
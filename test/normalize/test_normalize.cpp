@@ -0,0 +1,224 @@
+/*
+ *  test_normalize.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements test logic for normalizing encoded text.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <terra/stf/stf.h>
+#include <terra/bases/base16.h>
+#include <terra/bases/base32.h>
+#include <terra/bases/base64.h>
+#include <terra/bases/normalize.h>
+
+using namespace Terra;
+
+namespace
+{
+
+/*
+ *  NormalizeText
+ *
+ *  Description:
+ *      Normalize text into a separate buffer and in place, verifying that
+ *      both produce the same result.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The text to normalize.
+ *
+ *      target [in]
+ *          The form to produce.
+ *
+ *  Returns:
+ *      The normalized text, "<invalid>" if the text is not valid, or
+ *      "<mismatch>" if the two methods disagree.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string NormalizeText(std::string_view input,
+                          Bases::FanOutEncoding target)
+{
+    std::string output(input.size() + Bases::Max_Normalize_Growth, '\0');
+    std::string text(input);
+
+    auto length = Bases::Normalize(input, target, output);
+    bool normalized = Bases::Normalize(text, target);
+
+    if (length.has_value() != normalized) return "<mismatch>";
+    if (!length) return "<invalid>";
+
+    output.resize(*length);
+    if (output != text) return "<mismatch>";
+
+    return output;
+}
+
+} // namespace
+
+STF_TEST(Normalize, Base16)
+{
+    using Bases::FanOutEncoding;
+
+    STF_ASSERT_EQ(std::string("DEADBEEF"),
+                  NormalizeText("deADbeEF", FanOutEncoding::Base16));
+    STF_ASSERT_EQ(std::string("deadbeef"),
+                  NormalizeText(" DE AD\r\nBE EF ",
+                                FanOutEncoding::Base16Lowercase));
+    STF_ASSERT_EQ(std::string(""), NormalizeText("", FanOutEncoding::Base16));
+
+    // Odd lengths, padding, and other characters are errors
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  NormalizeText("ABC", FanOutEncoding::Base16));
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  NormalizeText("AB==", FanOutEncoding::Base16));
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  NormalizeText("AB:CD", FanOutEncoding::Base16));
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  NormalizeText("ABCG", FanOutEncoding::Base16));
+}
+
+STF_TEST(Normalize, Base32)
+{
+    using Bases::FanOutEncoding;
+
+    // Case and padding are corrected
+    STF_ASSERT_EQ(std::string("MZXW6==="),
+                  NormalizeText("mzxw6", FanOutEncoding::Base32));
+    STF_ASSERT_EQ(std::string("MZXW6YQ="),
+                  NormalizeText("MzXw 6yQ=", FanOutEncoding::Base32));
+    STF_ASSERT_EQ(std::string("MY======"),
+                  NormalizeText("my==", FanOutEncoding::Base32));
+
+    // Unused trailing bits are cleared
+    STF_ASSERT_EQ(std::string("MY======"),
+                  NormalizeText("MZ", FanOutEncoding::Base32));
+
+    // Impossible lengths, excessive padding, and other characters
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  NormalizeText("M", FanOutEncoding::Base32));
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  NormalizeText("MZX", FanOutEncoding::Base32));
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  NormalizeText("MY=======", FanOutEncoding::Base32));
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  NormalizeText("MY==MY==", FanOutEncoding::Base32));
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  NormalizeText("MY18", FanOutEncoding::Base32));
+}
+
+STF_TEST(Normalize, Base64)
+{
+    using Bases::FanOutEncoding;
+
+    // Alphabets, padding, and whitespace are converted either way
+    STF_ASSERT_EQ(std::string("+/+/4A=="),
+                  NormalizeText("-_+/4A", FanOutEncoding::Base64));
+    STF_ASSERT_EQ(std::string("-_-_4A"),
+                  NormalizeText("+/-_\r\n4A==", FanOutEncoding::Base64URL));
+    STF_ASSERT_EQ(std::string("Zm8="),
+                  NormalizeText("Zm8", FanOutEncoding::Base64));
+    STF_ASSERT_EQ(std::string("Zm9v"),
+                  NormalizeText("Zm9v", FanOutEncoding::Base64URL));
+
+    // Unused trailing bits are cleared
+    STF_ASSERT_EQ(std::string("Zg=="),
+                  NormalizeText("Zh==", FanOutEncoding::Base64));
+    STF_ASSERT_EQ(std::string("Zm8"),
+                  NormalizeText("Zm9", FanOutEncoding::Base64URL));
+
+    // Impossible lengths, misplaced padding, and other characters
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  NormalizeText("Z", FanOutEncoding::Base64));
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  NormalizeText("Zm9v=", FanOutEncoding::Base64));
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  NormalizeText("Zg===", FanOutEncoding::Base64));
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  NormalizeText("Zg==Zg==", FanOutEncoding::Base64));
+    STF_ASSERT_EQ(std::string("<invalid>"),
+                  NormalizeText("Zm9v.", FanOutEncoding::Base64));
+}
+
+STF_TEST(Normalize, MatchesReencoding)
+{
+    using Bases::FanOutEncoding;
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<unsigned> distribution(0, 255);
+
+    for (std::size_t n : {1, 2, 3, 4, 5, 15, 16, 17, 100, 1000})
+    {
+        std::vector<std::uint8_t> octets(n);
+        for (auto &octet : octets) octet = distribution(generator);
+
+        // Produce non-canonical text with line breaks, no padding, and
+        // (for hexadecimal) mixed case
+        auto scramble = [&](std::string text, bool hex = false)
+        {
+            std::string result;
+            for (std::size_t i = 0; i < text.size(); i++)
+            {
+                char c = text[i];
+                if (hex && (c >= 'A') && (i % 2)) c |= 0x20;
+                if ((i % 37) == 36) result += "\r\n";
+                result += c;
+            }
+            while (result.ends_with('=')) result.pop_back();
+            return result;
+        };
+
+        std::string hex = Base16::Encode(octets);
+        std::string base32 = Base32::Encode(octets);
+        std::string base64 = Base64::Encode(octets);
+        std::string url = Base64::Encode(octets, Base64::URLAlphabet());
+
+        STF_ASSERT_EQ(hex, NormalizeText(scramble(hex, true),
+                                         FanOutEncoding::Base16));
+        STF_ASSERT_EQ(base64,
+                      NormalizeText(scramble(url), FanOutEncoding::Base64));
+        STF_ASSERT_EQ(url,
+                      NormalizeText(scramble(base64),
+                                    FanOutEncoding::Base64URL));
+
+        // Lowercase Base32 without padding
+        std::string lower;
+        for (char c : base32)
+        {
+            if (c != '=') lower += (c >= 'A') ? (c | 0x20) : c;
+        }
+        STF_ASSERT_EQ(base32, NormalizeText(lower, FanOutEncoding::Base32));
+    }
+}
+
+STF_TEST(Normalize, SmallBuffer)
+{
+    std::string input = "Zm8";
+    std::vector<char> output(3);
+
+    // The buffer must have room for padding
+    STF_ASSERT_FALSE(Bases::Normalize(input,
+                                      Bases::FanOutEncoding::Base64,
+                                      output).has_value());
+    output.resize(4);
+    STF_ASSERT_EQ(std::size_t(4),
+                  Bases::Normalize(input,
+                                   Bases::FanOutEncoding::Base64,
+                                   output));
+}
@@ -0,0 +1,122 @@
+/*
+ *  test_scratch.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements test logic for the scratch buffer pool and the
+ *      encoder and decoder overloads that return containers using it.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <terra/stf/stf.h>
+#include <terra/bases/base16.h>
+#include <terra/bases/base32.h>
+#include <terra/bases/base45.h>
+#include <terra/bases/base58.h>
+#include <terra/bases/base64.h>
+#include <terra/bases/scratch.h>
+
+using namespace Terra;
+
+STF_TEST(Scratch, AcquireRelease)
+{
+    // Buffers of every size class, and beyond, are usable and reused
+    for (std::size_t size : {0, 1, 63, 64, 65, 4096, 65536, 65537, 1000000})
+    {
+        void *buffer = Bases::AcquireScratch(size);
+        STF_ASSERT_NE(nullptr, buffer);
+        std::memset(buffer, 0xa5, size);
+        Bases::ReleaseScratch(buffer);
+
+        // A buffer of the same size class is reused
+        void *again = Bases::AcquireScratch(size);
+        if (size <= 65536) STF_ASSERT_EQ(buffer, again);
+        Bases::ReleaseScratch(again);
+    }
+
+    // Releasing nullptr has no effect
+    Bases::ReleaseScratch(nullptr);
+}
+
+STF_TEST(Scratch, CrossThreadRelease)
+{
+    std::vector<void *> buffers;
+
+    // Acquire buffers on this thread and release them on another
+    for (std::size_t i = 0; i < 4; i++)
+    {
+        buffers.push_back(Bases::AcquireScratch(1000));
+    }
+    std::thread([&]() {
+        for (void *buffer : buffers) Bases::ReleaseScratch(buffer);
+    }).join();
+
+    // The buffers are returned to this thread for reuse
+    void *buffer = Bases::AcquireScratch(1000);
+    bool reused = false;
+    for (void *released : buffers) reused |= (buffer == released);
+    STF_ASSERT_TRUE(reused);
+    Bases::ReleaseScratch(buffer);
+}
+
+STF_TEST(Scratch, ReleaseAfterThreadExit)
+{
+    Bases::ScratchString encoded;
+
+    // A container acquired on a thread may outlive that thread
+    std::thread([&]() {
+        encoded = Base64::Encode(std::vector<std::uint8_t>(1000, 0x42),
+                                 Bases::ScratchAllocator<char>());
+    }).join();
+
+    STF_ASSERT_EQ(Base64::Encode(std::vector<std::uint8_t>(1000, 0x42)),
+                  std::string(encoded));
+
+    // Releasing it here frees the exited thread's cache
+    encoded = {};
+    encoded.shrink_to_fit();
+}
+
+STF_TEST(Scratch, CodecContainers)
+{
+    const std::vector<std::uint8_t> original{0x00, 0x01, 0x7f, 0x80, 0xff,
+                                             'H', 'e', 'l', 'l', 'o'};
+    Bases::ScratchAllocator<char> characters;
+    Bases::ScratchAllocator<std::uint8_t> octets;
+
+    // The pooled overloads produce the same results as the default ones
+    STF_ASSERT_EQ(Base16::Encode(original),
+                  std::string(Base16::Encode(original, characters)));
+    STF_ASSERT_EQ(Base32::Encode(original),
+                  std::string(Base32::Encode(original, characters)));
+    STF_ASSERT_EQ(Base45::Encode(original),
+                  std::string(Base45::Encode(original, characters)));
+    STF_ASSERT_EQ(Base58::Encode(original),
+                  std::string(Base58::Encode(original, characters)));
+    STF_ASSERT_EQ(Base64::Encode(original),
+                  std::string(Base64::Encode(original, characters)));
+
+    auto decoded = Base64::Decode(Base64::Encode(original), octets);
+    STF_ASSERT_EQ(original,
+                  std::vector<std::uint8_t>(decoded.begin(), decoded.end()));
+    decoded = Base58::Decode(Base58::Encode(original), octets);
+    STF_ASSERT_EQ(original,
+                  std::vector<std::uint8_t>(decoded.begin(), decoded.end()));
+
+    // Invalid input results in an empty vector
+    STF_ASSERT_TRUE(Base16::Decode("0", octets).empty());
+    STF_ASSERT_TRUE(Base58::Decode("0OIl", octets).empty());
+}
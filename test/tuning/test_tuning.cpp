@@ -0,0 +1,298 @@
+/*
+ *  test_tuning.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements test logic for kernel tuning and the export and
+ *      import of tuning configurations.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <terra/stf/stf.h>
+#include <terra/bases/base16.h>
+#include <terra/bases/base32.h>
+#include <terra/bases/base64.h>
+#include <terra/bases/tuning.h>
+
+namespace
+{
+
+/*
+ *  Configuration
+ *
+ *  Description:
+ *      Produce a configuration using the given kernel for every operation
+ *      and size class.
+ *
+ *  Parameters:
+ *      kernel [in]
+ *          Name of the kernel to use.
+ *
+ *      codecs [in]
+ *          The codecs to configure.
+ *
+ *  Returns:
+ *      The configuration string.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string Configuration(const std::string &kernel,
+                          std::initializer_list<const char *> codecs =
+                              {"base16", "base32", "base64"})
+{
+    std::string configuration = "bases-tuning/1";
+
+    for (const char *codec : codecs)
+    {
+        for (const char *operation : {".encode", ".decode"})
+        {
+            for (const char *size_class : {".small=", ".large="})
+            {
+                configuration += std::string(";") + codec + operation +
+                                 size_class + kernel;
+            }
+        }
+    }
+
+    return configuration;
+}
+
+/*
+ *  VerifyCodecs
+ *
+ *  Description:
+ *      Verify that all tunable codecs produce correct results for small and
+ *      large inputs.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void VerifyCodecs()
+{
+    for (std::size_t size : {0, 1, 2, 3, 4, 5, 31, 64, 65, 1000})
+    {
+        std::vector<std::uint8_t> octets(size);
+        for (std::size_t i = 0; i < size; i++)
+        {
+            octets[i] = static_cast<std::uint8_t>(i * 7 + 3);
+        }
+
+        STF_ASSERT_EQ(octets, Terra::Base16::Decode(
+                                  Terra::Base16::Encode(octets)));
+        STF_ASSERT_EQ(octets, Terra::Base32::Decode(
+                                  Terra::Base32::Encode(octets)));
+        STF_ASSERT_EQ(octets, Terra::Base64::Decode(
+                                  Terra::Base64::Encode(octets)));
+
+        // Alphabets differing from the standard only in the last characters
+        std::string imap = Terra::Base64::Encode(octets);
+        std::replace(imap.begin(), imap.end(), '/', ',');
+        std::erase(imap, '=');
+        std::string url = Terra::Base64::Encode(octets,
+                                                Terra::Base64::URLAlphabet());
+        STF_ASSERT_EQ(imap, Terra::Base64::Encode(
+                                octets,
+                                Terra::Base64::IMAPAlphabet()));
+        STF_ASSERT_EQ(octets, Terra::Base64::Decode(
+                                  imap,
+                                  Terra::Base64::IMAPAlphabet()));
+        STF_ASSERT_EQ(octets, Terra::Base64::Decode(
+                                  url,
+                                  Terra::Base64::TolerantAlphabet()));
+    }
+
+    STF_ASSERT_EQ(std::string("666F6F626172"),
+                  Terra::Base16::Encode(std::string("foobar")));
+    STF_ASSERT_EQ(std::string("MZXW6YTBOI======"),
+                  Terra::Base32::Encode(std::string("foobar")));
+    STF_ASSERT_EQ(std::string("Zm9vYmFy"),
+                  Terra::Base64::Encode(std::string("foobar")));
+
+    // Decoding with embedded whitespace must be unaffected by the kernel
+    std::vector<std::uint8_t> foobar = {0x66, 0x6f, 0x6f, 0x62, 0x61, 0x72};
+    STF_ASSERT_EQ(foobar, Terra::Base16::Decode("66 6f\n6F 62 61 72"));
+    STF_ASSERT_EQ(foobar, Terra::Base32::Decode("MZXW6\nYTBOI"));
+    STF_ASSERT_EQ(foobar, Terra::Base64::Decode("Zm9v\r\nYmFy"));
+}
+
+} // namespace
+
+STF_TEST(Tuning, Defaults)
+{
+    Terra::Bases::ResetTuning();
+    VerifyCodecs();
+}
+
+STF_TEST(Tuning, TuneAndExport)
+{
+    std::string configuration = Terra::Bases::Tune();
+
+    STF_ASSERT_TRUE(configuration.starts_with("bases-tuning/1;"));
+    STF_ASSERT_EQ(configuration, Terra::Bases::ExportTuning());
+    VerifyCodecs();
+
+    Terra::Bases::ResetTuning();
+}
+
+#ifndef BASES_COMPACT
+STF_TEST(Tuning, SmallKernels)
+{
+    std::vector<std::string> texts = {"", "Zg", "Zg=", "Zg==", "Zm9v=",
+                                      "Z", "====", "Zm9v\r\nYmFy", "Zm=9v",
+                                      "6", "66", "6f6F", "66 6f", "666",
+                                      "0123456789abcdefABCDEFgG"};
+    std::vector<std::string> encoded;
+    std::vector<std::vector<std::uint8_t>> decoded;
+
+    // Compute results for inputs around each word size with the block kernel
+    for (std::size_t size = 0; size <= 70; size++)
+    {
+        std::vector<std::uint8_t> octets(size);
+        for (std::size_t i = 0; i < size; i++)
+        {
+            octets[i] = static_cast<std::uint8_t>(i * 37 + size);
+        }
+        texts.push_back(Terra::Base16::Encode(octets));
+        texts.push_back(Terra::Base64::Encode(octets));
+    }
+    STF_ASSERT_TRUE(Terra::Bases::ImportTuning(
+        Configuration("block", {"base16", "base64"})));
+    for (const auto &text : texts)
+    {
+        std::span<const std::uint8_t> octets(
+            reinterpret_cast<const std::uint8_t *>(text.data()),
+            text.size());
+        encoded.push_back(Terra::Base16::Encode(octets));
+        encoded.push_back(Terra::Base64::Encode(octets));
+        encoded.push_back(Terra::Base64::Encode(octets,
+                                                Terra::Base64::URLAlphabet()));
+        decoded.push_back(Terra::Base16::Decode(text));
+        decoded.push_back(Terra::Base64::Decode(text));
+    }
+
+    // The small kernels must produce identical results
+    STF_ASSERT_TRUE(Terra::Bases::ImportTuning(
+        Configuration("small", {"base16", "base64"})));
+    for (std::size_t i = 0; i < texts.size(); i++)
+    {
+        std::span<const std::uint8_t> octets(
+            reinterpret_cast<const std::uint8_t *>(texts[i].data()),
+            texts[i].size());
+        STF_ASSERT_EQ(encoded[i * 3], Terra::Base16::Encode(octets));
+        STF_ASSERT_EQ(encoded[i * 3 + 1], Terra::Base64::Encode(octets));
+        STF_ASSERT_EQ(encoded[i * 3 + 2],
+                      Terra::Base64::Encode(octets,
+                                            Terra::Base64::URLAlphabet()));
+        STF_ASSERT_EQ(decoded[i * 2], Terra::Base16::Decode(texts[i]));
+        STF_ASSERT_EQ(decoded[i * 2 + 1], Terra::Base64::Decode(texts[i]));
+    }
+
+    // Output buffers that are too small are reported
+    std::uint8_t buffer[2];
+    STF_ASSERT_FALSE(Terra::Base16::Decode("666F6F", buffer).has_value());
+    STF_ASSERT_FALSE(Terra::Base64::Decode("Zm9v", buffer).has_value());
+
+    Terra::Bases::ResetTuning();
+}
+
+#else
+STF_TEST(Tuning, CompactKernels)
+{
+    // Only the scalar kernels are built
+    STF_ASSERT_FALSE(Terra::Bases::ImportTuning(Configuration("block")));
+    STF_ASSERT_FALSE(Terra::Bases::ImportTuning(Configuration("small")));
+    STF_ASSERT_TRUE(Terra::Bases::ImportTuning(Configuration("scalar")));
+    VerifyCodecs();
+
+    Terra::Bases::ResetTuning();
+}
+#endif
+
+STF_TEST(Tuning, ImportEachKernel)
+{
+#ifdef BASES_COMPACT
+    for (const std::string kernel : {"scalar"})
+#else
+    for (const std::string kernel : {"scalar", "block", "simd"})
+#endif
+    {
+        std::string configuration = Configuration(kernel);
+
+        // The SIMD kernels are present only if supported by the compiler
+        bool imported = Terra::Bases::ImportTuning(configuration);
+        if (kernel == "simd" && !imported) continue;
+        STF_ASSERT_TRUE(imported);
+        STF_ASSERT_EQ(configuration, Terra::Bases::ExportTuning());
+        VerifyCodecs();
+    }
+
+    Terra::Bases::ResetTuning();
+}
+
+STF_TEST(Tuning, ImportPartial)
+{
+    Terra::Bases::ResetTuning();
+    std::string defaults = Terra::Bases::ExportTuning();
+
+    // Only the named operation is changed
+    STF_ASSERT_TRUE(Terra::Bases::ImportTuning(
+        "bases-tuning/1;base64.decode.small=scalar"));
+#ifndef BASES_COMPACT
+    STF_ASSERT_NE(defaults, Terra::Bases::ExportTuning());
+#endif
+    STF_ASSERT_NE(std::string::npos,
+                  Terra::Bases::ExportTuning().find(
+                      "base64.decode.small=scalar"));
+    VerifyCodecs();
+
+    Terra::Bases::ResetTuning();
+    STF_ASSERT_EQ(defaults, Terra::Bases::ExportTuning());
+}
+
+STF_TEST(Tuning, ImportInvalid)
+{
+    Terra::Bases::ResetTuning();
+    std::string defaults = Terra::Bases::ExportTuning();
+
+    // None of these are valid, so nothing should change
+    STF_ASSERT_FALSE(Terra::Bases::ImportTuning(""));
+    STF_ASSERT_FALSE(Terra::Bases::ImportTuning("bases-tuning/0"));
+    STF_ASSERT_FALSE(Terra::Bases::ImportTuning(
+        "bases-tuning/1;base64.decode.small=scalar;"));
+    STF_ASSERT_FALSE(Terra::Bases::ImportTuning(
+        "bases-tuning/1;base64.decode.small=scalar;"
+        "base64.decode.large=unknown"));
+    STF_ASSERT_FALSE(Terra::Bases::ImportTuning(
+        "bases-tuning/1;base64.decode.medium=scalar"));
+    STF_ASSERT_FALSE(Terra::Bases::ImportTuning(
+        "bases-tuning/1;base99.decode.small=scalar"));
+    STF_ASSERT_FALSE(Terra::Bases::ImportTuning(
+        "bases-tuning/1;base64.decode.small"));
+
+    STF_ASSERT_EQ(defaults, Terra::Bases::ExportTuning());
+
+    // An empty configuration is valid and changes nothing
+    STF_ASSERT_TRUE(Terra::Bases::ImportTuning("bases-tuning/1"));
+    STF_ASSERT_EQ(defaults, Terra::Bases::ExportTuning());
+}